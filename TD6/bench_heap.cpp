@@ -0,0 +1,328 @@
+/*!
+ * \file
+ * \brief Benchmark: throughput of Heap, Heap_Id (for several arities) and Pairing_Heap for several sizes,
+ * of Multi_Queue against one Heap behind a lock for several threads,
+ * then time of the shortest paths on generated random, dense and grid graphs
+ * with each priority queue, and of their minimum spanning trees.
+ *
+ * usage : ./bench_heap [max_vertices]
+ *
+ * The heaps get up to 10^6 values, the graphs have 10^4 vertices to \c max_vertices
+ * (10^6 by default), 10 times more each time.
+ * It should be compiled without \c HEAP_DEBUG (see the Makefile): otherwise
+ * each modification of a heap checks it in linear time.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <sys/time.h>
+# include <stdlib.h> // drand48, lrand48, atoi
+
+# include <cmath>
+# include <iomanip>
+# include <iostream>
+# include <limits>
+# include <string>
+# include <vector>
+
+# include <pthread.h>
+
+# include "graph.hpp"
+# include "heap.hpp"
+# include "heap_id.hpp"
+# include "multi_queue.hpp"
+# include "pairing_heap.hpp"
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Current time, in seconds. */
+  double now () {
+    timeval t ;
+    gettimeofday ( & t , 0 ) ;
+    return t . tv_sec + 1e-6 * t . tv_usec ;
+  }
+
+  /*! Print a line of result: \c nbr operations in \c seconds (arity \c d , 0 for none). */
+  void report ( char const * const name ,
+		unsigned int const d ,
+		unsigned int const n ,
+		unsigned int const nbr ,
+		double const seconds ) {
+    cout << setw ( 24 ) << left << name << right ;
+    if ( 0 < d ) cout << setw ( 4 ) << d ;
+    else cout << setw ( 4 ) << "-" ;
+    cout
+	 << setw ( 10 ) << n
+	 << fixed << setprecision ( 1 )
+	 << setw ( 12 ) << seconds * 1e9 / nbr << " ns/op" << endl ;
+  }
+
+  /*! Random values in [ 0 , 1 ) . */
+  vector < float > random_values ( unsigned int const n ) {
+    vector < float > values ( n ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) values [ i ] = drand48 () ;
+    return values ;
+  }
+
+
+  /*! Push then pop \c n values in a Heap of arity \c D (it grows from capacity 1). */
+  template < unsigned int D >
+  void bench_heap ( unsigned int const n ) {
+    vector < float > values = random_values ( n ) ;
+    Heap < float , D > h ( 1 ) ;
+    double const t0 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) h . push ( values [ i ] ) ;
+    double const t1 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) h . pop () ;
+    double const t2 = now () ;
+    report ( "Heap push" , D , n , n , t1 - t0 ) ;
+    report ( "Heap pop" , D , n , n , t2 - t1 ) ;
+  }
+
+
+  /*! Push \c n values in a Heap_Id of arity \c D , decrease them all, then pop them. */
+  template < unsigned int D >
+  void bench_heap_id ( unsigned int const n ) {
+    vector < float > values = random_values ( n ) ;
+    vector < unsigned int > ids ( n ) ;
+    Heap_Id < float , D > h ( n ) ;
+    double const t0 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) ids [ i ] = h . push ( values [ i ] ) ;
+    double const t1 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      values [ i ] -= drand48 () ;
+      h . decrease_key ( ids [ i ] ) ;
+    }
+    double const t2 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) h . pop () ;
+    double const t3 = now () ;
+    report ( "Heap_Id push" , D , n , n , t1 - t0 ) ;
+    report ( "Heap_Id decrease_key" , D , n , n , t2 - t1 ) ;
+    report ( "Heap_Id pop" , D , n , n , t3 - t2 ) ;
+  }
+
+
+  /*! Same as \c bench_heap_id with a Pairing_Heap. */
+  void bench_pairing_heap ( unsigned int const n ) {
+    vector < float > values = random_values ( n ) ;
+    vector < unsigned int > ids ( n ) ;
+    Pairing_Heap < float > h ( n ) ;
+    double const t0 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) ids [ i ] = h . push ( values [ i ] ) ;
+    double const t1 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      values [ i ] -= drand48 () ;
+      h . decrease_key ( ids [ i ] ) ;
+    }
+    double const t2 = now () ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) h . pop () ;
+    double const t3 = now () ;
+    report ( "Pairing push" , 0 , n , n , t1 - t0 ) ;
+    report ( "Pairing decrease_key" , 0 , n , n , t2 - t1 ) ;
+    report ( "Pairing pop" , 0 , n , n , t3 - t2 ) ;
+  }
+
+
+  /*! One Heap behind one lock, with the interface of Multi_Queue (the reference for the threads). */
+  class Locked_Heap {
+    Heap < float > heap ;
+    pthread_mutex_t lock ;
+  public :
+    Locked_Heap () : heap ( 16 ) { pthread_mutex_init ( & lock , 0 ) ; }
+    ~Locked_Heap () { pthread_mutex_destroy ( & lock ) ; }
+    void push ( float & v ) {
+      pthread_mutex_lock ( & lock ) ;
+      heap . push ( v ) ;
+      pthread_mutex_unlock ( & lock ) ;
+    }
+    float * try_pop () {
+      pthread_mutex_lock ( & lock ) ;
+      float * const e = heap . is_empty () ? 0 : & heap . pop () ;
+      pthread_mutex_unlock ( & lock ) ;
+      return e ;
+    }
+  } ;
+
+  /*! Share of a thread: its values, pushed then popped by bursts of 64. */
+  template < class Queue >
+  struct Producer {
+    Queue * queue ;
+    vector < float > values ;
+  } ;
+
+  /*! Body of the threads of \c bench_concurrent. */
+  template < class Queue >
+  void * produce ( void * p ) {
+    Producer < Queue > & producer = * static_cast < Producer < Queue > * > ( p ) ;
+    unsigned int const n = producer . values . size () ;
+    for ( unsigned int i = 0 ; i < n ; i += 64 ) {
+      unsigned int const last = ( i + 64 < n ) ? i + 64 : n ;
+      for ( unsigned int k = i ; k < last ; k ++ ) producer . queue -> push ( producer . values [ k ] ) ;
+      for ( unsigned int k = i ; k < last ; k ++ ) producer . queue -> try_pop () ;
+    }
+    return 0 ;
+  }
+
+  /*! \c nbr_threads threads push and pop \c n values in all in \c queue . */
+  template < class Queue >
+  void bench_concurrent ( char const * const name ,
+			  Queue & queue ,
+			  unsigned int const nbr_threads ,
+			  unsigned int const n ) {
+    vector < Producer < Queue > > producers ( nbr_threads ) ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      producers [ t ] . queue = & queue ;
+      producers [ t ] . values = random_values ( n / nbr_threads ) ;
+    }
+    vector < pthread_t > threads ( nbr_threads ) ;
+    double const t0 = now () ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      pthread_create ( & threads [ t ] , 0 , produce < Queue > , & producers [ t ] ) ;
+    }
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      pthread_join ( threads [ t ] , 0 ) ;
+    }
+    double const t1 = now () ;
+    // push and pop count for one operation each
+    report ( name , nbr_threads , n , 2 * ( n / nbr_threads ) * nbr_threads , t1 - t0 ) ;
+  }
+
+
+  /*! Integer length in [ 1 , 100 ] (so that both queues of the shortest paths can be used). */
+  float random_length () {
+    return 1 + lrand48 () % 100 ;
+  }
+
+  /*! Graph of \c n vertices, each one linked to 2 random ones (4 edges per vertex on average). */
+  Graph * random_graph ( unsigned int const n ) {
+    Graph * const g = new Graph ( n ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      for ( unsigned int k = 0 ; k < 2 ; k ++ ) {
+	unsigned int const j = lrand48 () % n ;
+	if ( i != j ) g -> add_edge ( i , j , random_length () ) ;
+      }
+    }
+    return g ;
+  }
+
+  /*! Graph of \c n vertices, each one linked to 32 random ones:
+   * Dijkstra's algorithm decreases keys far more often than it pops. */
+  Graph * dense_graph ( unsigned int const n ) {
+    Graph * const g = new Graph ( n ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      for ( unsigned int k = 0 ; k < 32 ; k ++ ) {
+	unsigned int const j = lrand48 () % n ;
+	if ( i != j ) g -> add_edge ( i , j , random_length () ) ;
+      }
+    }
+    return g ;
+  }
+
+  /*! Square grid of about \c n vertices, each one linked to its 4 neighbours. */
+  Graph * grid_graph ( unsigned int const n ) {
+    unsigned int const side = sqrt ( double ( n ) ) ;
+    Graph * const g = new Graph ( side * side ) ;
+    for ( unsigned int l = 0 ; l < side ; l ++ ) {
+      for ( unsigned int c = 0 ; c < side ; c ++ ) {
+	unsigned int const i = l * side + c ;
+	if ( c + 1 < side ) g -> add_edge ( i , i + 1 , random_length () ) ;
+	if ( l + 1 < side ) g -> add_edge ( i , i + side , random_length () ) ;
+      }
+    }
+    return g ;
+  }
+
+  /*! Time the shortest paths from vertex 0 with the queue \c Q . */
+  template < Graph :: Queue Q >
+  void bench_shortest_paths ( char const * const name ,
+			      Graph const & g ) {
+    double const t0 = now () ;
+    Graph :: Shortest_Paths const sp = g . shortest_paths < Q > ( 0 ) ;
+    double const t1 = now () ;
+    unsigned int settled = 0 ;
+    for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+      if ( sp . distance [ k ] < numeric_limits < float > :: infinity () ) settled ++ ;
+    }
+    cout << setw ( 28 ) << left << name << right
+	 << setw ( 10 ) << g . nbr_vertices
+	 << setw ( 10 ) << g . nbr_edges ()
+	 << setw ( 10 ) << settled
+	 << fixed << setprecision ( 3 )
+	 << setw ( 12 ) << ( t1 - t0 ) * 1e3 << " ms"
+	 << setw ( 14 ) << setprecision ( 0 ) << settled / ( t1 - t0 ) << " vertices/s" << endl ;
+  }
+
+  /*! A minimum spanning tree method of Graph. */
+  typedef vector < Graph :: Tree_Edge > ( Graph :: * Spanning ) () const ;
+
+  /*! Time a minimum spanning tree method \c mst of \c g . */
+  void bench_spanning ( char const * const name ,
+			Graph const & g ,
+			Spanning const mst ) {
+    double const t0 = now () ;
+    vector < Graph :: Tree_Edge > const tree = ( g .* mst ) () ;
+    double const t1 = now () ;
+    cout << setw ( 28 ) << left << name << right
+	 << setw ( 10 ) << g . nbr_vertices
+	 << setw ( 10 ) << g . nbr_edges ()
+	 << setw ( 10 ) << tree . size ()
+	 << fixed << setprecision ( 3 )
+	 << setw ( 12 ) << ( t1 - t0 ) * 1e3 << " ms"
+	 << setw ( 14 ) << setprecision ( 0 ) << g . nbr_edges () / ( t1 - t0 ) << " edges/s" << endl ;
+  }
+
+  /*! Time the shortest paths on \c g (built and frozen before) with each queue,
+   * then its minimum spanning tree. */
+  void bench_graph ( string const & name ,
+		     Graph * const g ) {
+    g -> freeze () ;
+    bench_shortest_paths < Graph :: heap_queue > ( ( name + ", Heap_Id" ) . c_str () , * g ) ;
+    bench_shortest_paths < Graph :: pairing_queue > ( ( name + ", Pairing_Heap" ) . c_str () , * g ) ;
+    bench_shortest_paths < Graph :: radix_queue > ( ( name + ", Radix_Heap" ) . c_str () , * g ) ;
+    bench_spanning ( ( name + ", MST Prim" ) . c_str () , * g , & Graph :: minimum_spanning_tree_prim ) ;
+    bench_spanning ( ( name + ", MST Kruskal" ) . c_str () , * g , & Graph :: minimum_spanning_tree_kruskal ) ;
+    delete g ;
+  }
+
+}
+
+
+int main ( int argc ,
+	   char const * argv [] ) {
+  unsigned int const max_vertices = ( 1 < argc ) ? atoi ( argv [ 1 ] ) : 1000000 ;
+  srand48 ( 1 ) ;
+
+  cout << setw ( 24 ) << left << "heap" << right << setw ( 4 ) << "D" << setw ( 10 ) << "size" << setw ( 18 ) << "time" << endl ;
+  for ( unsigned int n = 1000 ; n <= 1000000 ; n *= 10 ) {
+    bench_heap < 2 > ( n ) ;
+    bench_heap < 4 > ( n ) ;
+    bench_heap < 8 > ( n ) ;
+    bench_heap_id < 2 > ( n ) ;
+    bench_heap_id < 4 > ( n ) ;
+    bench_heap_id < 8 > ( n ) ;
+    bench_pairing_heap ( n ) ;
+  }
+
+  cout << endl << setw ( 24 ) << left << "concurrent queue" << right << setw ( 4 ) << "thr" << setw ( 10 ) << "size" << setw ( 18 ) << "time" << endl ;
+  for ( unsigned int t = 1 ; t <= 8 ; t *= 2 ) {
+    Locked_Heap locked ;
+    bench_concurrent ( "Heap + lock" , locked , t , 1000000 ) ;
+    // 2 shards per thread (at least 4 so that 2 random ones seldom collide)
+    Multi_Queue < float > multi ( ( t < 2 ) ? 4 : 2 * t ) ;
+    bench_concurrent ( "Multi_Queue" , multi , t , 1000000 ) ;
+  }
+
+  cout << endl << setw ( 28 ) << left << "shortest paths / MST" << right
+       << setw ( 10 ) << "vertices" << setw ( 10 ) << "edges" << setw ( 10 ) << "settled"
+       << setw ( 15 ) << "time" << setw ( 25 ) << "speed" << endl ;
+  for ( unsigned int n = 10000 ; n <= max_vertices ; n *= 10 ) {
+    bench_graph ( "random" , random_graph ( n ) ) ;
+    bench_graph ( "dense" , dense_graph ( n ) ) ;
+    bench_graph ( "grid" , grid_graph ( n ) ) ;
+  }
+  return 0 ;
+}
@@ -0,0 +1,141 @@
+# ifndef __COUNTERS_HPP_
+# define __COUNTERS_HPP_
+
+/*!
+ * \file
+ * \brief This module provides counters of the hot paths (calls, sifts, allocations…) and timers,
+ * to know what a run does without a profiler.
+ *
+ * They are only compiled with \c COUNTERS defined (see the Makefile),
+ * otherwise the macros are empty and cost nothing:
+ * \li \c COUNTER_ADD ( name ) adds 1 to counter \c name ,
+ * \li \c COUNTER_ADD_N ( name , n ) adds \c n ,
+ * \li \c COUNTER_TIMER ( name ) adds to \c name the nanoseconds till the end of the block.
+ *
+ * Each macro has its own counter, those of the same name are summed by \c Counter :: dump ,
+ * that writes them on \c cerr at the end of the program.
+ * The counters may be used by many threads at a time.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# ifdef COUNTERS
+
+# include <pthread.h>
+# include <stdlib.h> // atexit
+# include <time.h>
+
+# include <iostream>
+# include <map>
+# include <string>
+
+
+/*!
+ * Counter of a place of the code, registered the first time it is used.
+ */
+class Counter {
+
+  /*! Name given to the macro. */
+  char const * const name ;
+
+  /*! Value, updated atomically. */
+  unsigned long value ;
+
+  /*! Next counter registered. */
+  Counter * next ;
+
+  /*! First counter registered (NULL if none). */
+  static Counter * & first () {
+    static Counter * f = NULL ;
+    return f ;
+  }
+
+  /*! Dump the counters on \c cerr (called at exit). */
+  static void dump_at_exit () {
+    dump ( std :: cerr ) ;
+  }
+
+  Counter ( Counter const & ) ;
+  Counter & operator = ( Counter const & ) ;
+
+public :
+
+  /*! Register a counter (the first one also registers the dump at exit). */
+  Counter ( char const * const _name )
+    : name ( _name )
+    , value ( 0 )
+    , next ( NULL ) {
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER ;
+    pthread_mutex_lock ( & mutex ) ;
+    if ( NULL == first () ) atexit ( dump_at_exit ) ;
+    next = first () ;
+    first () = this ;
+    pthread_mutex_unlock ( & mutex ) ;
+  }
+
+  /*! Add \c n to the counter. */
+  void add ( unsigned long const n ) {
+    __sync_add_and_fetch ( & value , n ) ;
+  }
+
+  /*! Current time, in nanoseconds. */
+  static unsigned long now_ns () {
+    timespec t ;
+    clock_gettime ( CLOCK_MONOTONIC , & t ) ;
+    return t . tv_sec * 1000000000UL + t . tv_nsec ;
+  }
+
+  /*! Write each counter name and its value (summed over the counters of the same name), by name. */
+  static void dump ( std :: ostream & out ) {
+    std :: map < std :: string , unsigned long > sums ;
+    for ( Counter * c = first () ; NULL != c ; c = c -> next ) {
+      sums [ c -> name ] += __sync_add_and_fetch ( & c -> value , 0 ) ;
+    }
+    out << "counters:" << std :: endl ;
+    for ( std :: map < std :: string , unsigned long > :: const_iterator it = sums . begin () ;
+	  it != sums . end () ;
+	  ++ it ) {
+      out << "  " << it -> first << " " << it -> second << std :: endl ;
+    }
+  }
+} ;
+
+
+/*! Adds to a counter the time from its construction to its destruction. */
+class Counter_Timer {
+  Counter & counter ;
+  unsigned long const start ;
+public :
+  Counter_Timer ( Counter & _counter )
+    : counter ( _counter )
+    , start ( Counter :: now_ns () )
+  {}
+  ~ Counter_Timer () {
+    counter . add ( Counter :: now_ns () - start ) ;
+  }
+} ;
+
+
+# define COUNTER_ADD_N( name , n )				\
+  do {								\
+    static Counter counter_ ( name ) ;				\
+    counter_ . add ( n ) ;					\
+  } while ( 0 )
+
+# define COUNTER_ADD( name ) COUNTER_ADD_N ( name , 1 )
+
+# define COUNTER_TIMER( name )					\
+  static Counter counter_timer_ ( name ) ;			\
+  Counter_Timer counter_timer_scope_ ( counter_timer_ )
+
+# else
+
+# define COUNTER_ADD_N( name , n ) ( ( void ) 0 )
+# define COUNTER_ADD( name ) ( ( void ) 0 )
+# define COUNTER_TIMER( name )
+
+# endif
+
+
+# endif
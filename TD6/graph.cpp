@@ -6,8 +6,13 @@
  * \date 2017
  */
 
+# include <limits>
+# include <sstream>
+
 # include "graph.hpp"
 # include "heap_id.hpp"
+# include "pairing_heap.hpp"
+# include "radix_heap.hpp"
 
 
 using namespace std ;
@@ -15,6 +20,9 @@ using namespace std ;
 
 namespace {
 
+  template < class Queue >
+  class Search ;
+
   /*!
    * Class used to put a Head_Id to store, for a vertex (identifyed by \c i ):
    */
@@ -29,6 +37,9 @@ namespace {
     /*! From where to come from to get this distance. */
     unsigned int from ;
 
+    /*! Key in the heap: \c distance, plus the estimate to the target for A*. */
+    float bound ;
+
     
   public :
 
@@ -37,43 +48,62 @@ namespace {
     //  CONSTRUCTORS
     //
     
-    Vertex_Distance () {} 
+    Vertex_Distance ()
+      : i ( 0 )
+      , distance ( 0 )
+      , from ( 0 )
+      , bound ( 0 )
+    {}
     Vertex_Distance ( unsigned int _i ,
 		      float _distance ,
-		      unsigned int _from )
+		      unsigned int _from ,
+		      float _bound )
       : i ( _i )
       , distance ( _distance )
       , from ( _from )
+      , bound ( _bound )
     {}
       
     //
     //  PUBLIC METHODS
     //
 
-    /*! Comparison according to distance.
+    /*! Comparison according to bound.
      * \param cd2 Vertex_Distance to compare to.
-     * \return true if vd2 is at a longer distance.
+     * \return true if vd2 has a greater bound.
      */
     bool operator < ( Vertex_Distance const & vd2 ) const {
-      return distance < vd2 . distance ;
+      return bound < vd2 . bound ;
     }
 
-    /*! Comparison according to distance.
+    /*! Comparison according to bound.
      * \param cd2 Vertex_Distance to compare to.
-     * \return true if vd2 is at a longer or equal distance.
+     * \return true if vd2 has a greater or equal bound.
      */
     bool operator <= ( Vertex_Distance const & vd2 ) const {
-      return distance <= vd2 . distance ;
+      return bound <= vd2 . bound ;
+    }
+
+    /*! Key for a Radix_Heap.
+     * \pre bound is a non negative integer (integer lengths). */
+    unsigned int key () const {
+      return static_cast < unsigned int > ( bound ) ;
     }
 
     /*! 
      * To change the value held.
      * \param _distance new value for distance.
      * \param _from new value for from.
+     * \param _bound new value for bound.
      * \pre distance should be decreasing.
      */
     void update ( float const _distance ,
-		  unsigned int const _from ) {
+		  unsigned int const _from ,
+		  float const _bound ) {
+      assert ( _distance <= distance ) ;
+      distance = _distance ;
+      from = _from ;
+      bound = _bound ;
     }
 
 
@@ -82,6 +112,8 @@ namespace {
     //
     
     friend class :: Graph ;
+    template < class Queue >
+    friend class Search ;
     
   } ;
 
@@ -91,10 +123,325 @@ namespace {
   /*! Constant to indicate that the node was treated. */
   int const id_treated = -2 ;
 
+
+  /*!
+   * State of a search from one vertex: the best path found to each vertex
+   * and the heap of the vertices reached but not treated yet.
+   * \param Queue priority queue of Vertex_Distance with the interface of Heap_Id.
+   */
+  template < class Queue = Heap_Id < Vertex_Distance > >
+  class Search {
+
+  public :
+
+    /*! Id in the heap of each vertex, or id_undefined / id_treated. */
+    vector < int > id ;
+
+    /*! Best path found to each reached vertex. */
+    vector < Vertex_Distance > vd ;
+
+    /*! Vertices reached and not treated, by bound. */
+    Queue heap ;
+
+    /*! Nothing is reached yet. */
+    Search ( unsigned int nbr_vertices )
+      : id ( nbr_vertices , id_undefined )
+      , vd ( nbr_vertices )
+      , heap ( nbr_vertices )
+    {}
+
+    /*! \return true iff a path to \c v was found. */
+    bool reached ( unsigned int v ) const {
+      return id [ v ] != id_undefined ;
+    }
+
+    /*! \return length of the best path found to \c v.
+     * \pre \c v is reached. */
+    float distance ( unsigned int v ) const {
+      assert ( reached ( v ) ) ;
+      return vd [ v ] . distance ;
+    }
+
+    /*! \return the vertex before \c v on the best path found to it. */
+    unsigned int from ( unsigned int v ) const {
+      assert ( reached ( v ) ) ;
+      return vd [ v ] . from ;
+    }
+
+    /*! \pre the heap is not empty.
+     * \return the vertex with the lowest bound. */
+    Vertex_Distance const & top () {
+      return heap . top () ;
+    }
+
+    /*!
+     * Remove the vertex with the lowest bound from the heap and mark it treated.
+     * \pre the heap is not empty.
+     */
+    Vertex_Distance const & settle () {
+      Vertex_Distance const & u = heap . pop () ;
+      id [ u . i ] = id_treated ;
+      return u ;
+    }
+
+    /*!
+     * Record a path of length \c d to \c v coming from \c from if it is shorter than the best known.
+     * \param bound key of \c v in the heap for this path.
+     * \param reopen whether a treated vertex can be put back in the heap
+     * (needed by A* when the heuristic is admissible but not consistent).
+     */
+    void relax ( unsigned int v ,
+		 float d ,
+		 unsigned int from ,
+		 float bound ,
+		 bool reopen = false ) {
+      if ( id [ v ] == id_undefined
+	   || ( reopen && id [ v ] == id_treated && d < vd [ v ] . distance ) ) {
+	vd [ v ] = Vertex_Distance ( v , d , from , bound ) ;
+	id [ v ] = heap . push ( vd [ v ] ) ;
+      } else if ( id [ v ] != id_treated && d < vd [ v ] . distance ) {
+	vd [ v ] . update ( d , from , bound ) ;
+	heap . decrease_key ( id [ v ] ) ;
+      }
+    }
+
+  } ;
+
+
+  /*! Priority queue used by \c Graph :: shortest_paths for each \c Graph :: Queue. */
+  template < Graph :: Queue Q >
+  struct Queue_Of ;
+
+  template <>
+  struct Queue_Of < Graph :: heap_queue > {
+    typedef Heap_Id < Vertex_Distance > type ;
+  } ;
+
+  template <>
+  struct Queue_Of < Graph :: radix_queue > {
+    typedef Radix_Heap < Vertex_Distance > type ;
+  } ;
+
+  template <>
+  struct Queue_Of < Graph :: pairing_queue > {
+    typedef Pairing_Heap < Vertex_Distance > type ;
+  } ;
+
+}
+
+
+void Graph :: freeze () const {
+  if ( pending . empty () ) {
+    return ;
+  }
+  // new offsets: old degree plus the pending edges at each end
+  vector < unsigned int > off ( nbr_vertices + 1 , 0 ) ;
+  for ( unsigned int k = 0 ; k < nbr_vertices ; k ++ ) {
+    off [ k + 1 ] = offsets [ k + 1 ] - offsets [ k ] ;
+  }
+  for ( vector < Pending_Edge > :: const_iterator e = pending . begin () ;
+	e != pending . end () ;
+	++ e ) {
+    off [ e -> i + 1 ] ++ ;
+    off [ e -> j + 1 ] ++ ;
+  }
+  for ( unsigned int k = 0 ; k < nbr_vertices ; k ++ ) {
+    off [ k + 1 ] += off [ k ] ;
+  }
+  vector < unsigned int > tar ( off [ nbr_vertices ] ) ;
+  vector < float > wei ( off [ nbr_vertices ] ) ;
+  // next free cell of each vertex, the old edges come first
+  vector < unsigned int > next ( off . begin () , off . end () - 1 ) ;
+  for ( unsigned int k = 0 ; k < nbr_vertices ; k ++ ) {
+    for ( unsigned int p = offsets [ k ] ; p < offsets [ k + 1 ] ; p ++ ) {
+      tar [ next [ k ] ] = targets [ p ] ;
+      wei [ next [ k ] ++ ] = weights [ p ] ;
+    }
+  }
+  for ( vector < Pending_Edge > :: const_iterator e = pending . begin () ;
+	e != pending . end () ;
+	++ e ) {
+    tar [ next [ e -> i ] ] = e -> j ;
+    wei [ next [ e -> i ] ++ ] = e -> len ;
+    tar [ next [ e -> j ] ] = e -> i ;
+    wei [ next [ e -> j ] ++ ] = e -> len ;
+  }
+  offsets_vector . swap ( off ) ;
+  targets_vector . swap ( tar ) ;
+  weights_vector . swap ( wei ) ;
+  point_to_vectors () ;
+  // release the memory, not only the content
+  vector < Pending_Edge > () . swap ( pending ) ;
+}
+
+
+string const & Graph :: name ( unsigned int k ) const {
+  assert ( k < nbr_vertices ) ;
+  if ( names . empty () ) {
+    names . resize ( nbr_vertices ) ;
+    ostringstream os ;
+    for ( unsigned int i = 0 ; i < nbr_vertices ; i ++ ) {
+      os . str ( "" ) ;
+      os << "n" << i ;
+      names [ i ] = os . str () ;
+    }
+  }
+  return names [ k ] ;
+}
+
+
+Graph :: Shortest_Paths Graph :: shortest_paths ( unsigned int source ) const {
+  return shortest_paths < heap_queue > ( source ) ;
+}
+
+
+template < Graph :: Queue Q >
+Graph :: Shortest_Paths Graph :: shortest_paths ( unsigned int source ) const {
+  assert ( source < nbr_vertices ) ;
+  freeze () ;
+  Shortest_Paths sp ;
+  sp . source = source ;
+  sp . distance . assign ( nbr_vertices , numeric_limits < float > :: infinity () ) ;
+  sp . predecessor . assign ( nbr_vertices , nbr_vertices ) ;
+
+  Search < typename Queue_Of < Q > :: type > s ( nbr_vertices ) ;
+  s . relax ( source , 0 , nbr_vertices , 0 ) ;
+  while ( ! s . heap . is_empty () ) {
+    Vertex_Distance const & u = s . settle () ;
+    sp . distance [ u . i ] = u . distance ;
+    sp . predecessor [ u . i ] = u . from ;
+    for ( unsigned int p = offsets [ u . i ] ;
+	  p < offsets [ u . i + 1 ] ;
+	  p ++ ) {
+      float const d = u . distance + weights [ p ] ;
+      s . relax ( targets [ p ] , d , u . i , d ) ;
+    }
+  }
+  return sp ;
+}
+
+template Graph :: Shortest_Paths Graph :: shortest_paths < Graph :: heap_queue > ( unsigned int ) const ;
+template Graph :: Shortest_Paths Graph :: shortest_paths < Graph :: radix_queue > ( unsigned int ) const ;
+template Graph :: Shortest_Paths Graph :: shortest_paths < Graph :: pairing_queue > ( unsigned int ) const ;
+
+
+Graph :: Shortest_Paths Graph :: shortest_path_bidirectional ( unsigned int from ,
+							   unsigned int to ) const {
+  assert ( from < nbr_vertices ) ;
+  assert ( to < nbr_vertices ) ;
+  freeze () ;
+  Shortest_Paths sp ;
+  sp . source = from ;
+  sp . distance . assign ( nbr_vertices , numeric_limits < float > :: infinity () ) ;
+  sp . predecessor . assign ( nbr_vertices , nbr_vertices ) ;
+
+  // forward from from, backward from to (the graph is undirected)
+  Search <> fw ( nbr_vertices ) ;
+  Search <> bw ( nbr_vertices ) ;
+  fw . relax ( from , 0 , nbr_vertices , 0 ) ;
+  bw . relax ( to , 0 , nbr_vertices , 0 ) ;
+  // shortest path found through a vertex reached by both searches
+  float best = ( from == to ) ? 0 : numeric_limits < float > :: infinity () ;
+  unsigned int meet = from ;
+  while ( ! fw . heap . is_empty () && ! bw . heap . is_empty ()
+	  && fw . top () . distance + bw . top () . distance < best ) {
+    bool const forward = fw . top () <= bw . top () ;
+    Search <> & s = forward ? fw : bw ;
+    Search <> const & other = forward ? bw : fw ;
+    Vertex_Distance const & u = s . settle () ;
+    for ( unsigned int p = offsets [ u . i ] ;
+	  p < offsets [ u . i + 1 ] ;
+	  p ++ ) {
+      unsigned int const v = targets [ p ] ;
+      float const d = u . distance + weights [ p ] ;
+      s . relax ( v , d , u . i , d ) ;
+      if ( other . reached ( v ) && s . distance ( v ) + other . distance ( v ) < best ) {
+	best = s . distance ( v ) + other . distance ( v ) ;
+	meet = v ;
+      }
+    }
+  }
+  if ( best == numeric_limits < float > :: infinity () ) {
+    return sp ;
+  }
+
+  // from meet back to from with the forward search...
+  for ( unsigned int k = meet ;
+	k != nbr_vertices ;
+	k = fw . from ( k ) ) {
+    sp . distance [ k ] = fw . distance ( k ) ;
+    sp . predecessor [ k ] = fw . from ( k ) ;
+  }
+  // ... and from meet to to with the backward one
+  for ( unsigned int prev = meet , k = bw . from ( meet ) ;
+	k != nbr_vertices ;
+	prev = k , k = bw . from ( k ) ) {
+    sp . distance [ k ] = best - bw . distance ( k ) ;
+    sp . predecessor [ k ] = prev ;
+  }
+  return sp ;
+}
+
+
+Graph :: Shortest_Paths Graph :: shortest_path_a_star ( unsigned int from ,
+						    unsigned int to ,
+						    Heuristic const & h ) const {
+  assert ( from < nbr_vertices ) ;
+  assert ( to < nbr_vertices ) ;
+  freeze () ;
+  Shortest_Paths sp ;
+  sp . source = from ;
+  sp . distance . assign ( nbr_vertices , numeric_limits < float > :: infinity () ) ;
+  sp . predecessor . assign ( nbr_vertices , nbr_vertices ) ;
+
+  Search <> s ( nbr_vertices ) ;
+  s . relax ( from , 0 , nbr_vertices , h ( from ) ) ;
+  while ( ! s . heap . is_empty () ) {
+    Vertex_Distance const & u = s . settle () ;
+    if ( u . i == to ) {
+      break ;
+    }
+    for ( unsigned int p = offsets [ u . i ] ;
+	  p < offsets [ u . i + 1 ] ;
+	  p ++ ) {
+      unsigned int const v = targets [ p ] ;
+      float const d = u . distance + weights [ p ] ;
+      s . relax ( v , d , u . i , d + h ( v ) , true ) ;
+    }
+  }
+  if ( ! s . reached ( to ) ) {
+    return sp ;
+  }
+  for ( unsigned int k = to ;
+	k != nbr_vertices ;
+	k = s . from ( k ) ) {
+    sp . distance [ k ] = s . distance ( k ) ;
+    sp . predecessor [ k ] = s . from ( k ) ;
+  }
+  return sp ;
+}
+
+
+void Graph :: print_path ( Shortest_Paths const & sp ,
+			   unsigned int to ,
+			   ostream & out ) const {
+  assert ( to < nbr_vertices ) ;
+  if ( sp . distance [ to ] == numeric_limits < float > :: infinity () ) {
+    return ;
+  }
+  for ( unsigned int k = to ;
+	k != sp . source ;
+	k = sp . predecessor [ k ] ) {
+    out << name ( k ) << " " << sp . distance [ k ] << endl ;
+  }
+  out << name ( sp . source ) << endl ;
 }
 
 
 void Graph :: print_dijkstra ( unsigned int from ,
 			       unsigned int to ) const {
+  assert ( from < nbr_vertices ) ;
+  assert ( to < nbr_vertices ) ;
+  print_path ( shortest_paths ( from ) , to ) ;
 }
 
@@ -10,13 +10,17 @@
  */
 
 
-# include <sstream>
+# include <iostream>
+# include <string>
 
+# include <cstddef> // size_t
 # include <utility> // pair
 # include <vector>
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -41,22 +45,111 @@ public :
   typedef std :: pair < unsigned int ,
 			float > Edge ;
 
-  /*! 
-   * Type to store vertices:
-   * \li String to name it,
-   * \li Vector to store the edges going out of it.
-   */
-  typedef std :: pair < std :: string ,
-			std :: vector < Edge > >  Vertex ;
-
   /* Number of vertices. */
   unsigned int const nbr_vertices ;
 
+  /*!
+   * Result of Dijkstra's algorithm from one source, for every vertex \c k:
+   * \li \c distance [ k ] length of a shortest path from the source
+   * (infinity if \c k is not reachable),
+   * \li \c predecessor [ k ] vertex before \c k on this path
+   * (\c nbr_vertices for the source and unreachable vertices).
+   */
+  struct Shortest_Paths {
+    unsigned int source ;
+    std :: vector < float > distance ;
+    std :: vector < unsigned int > predecessor ;
+  } ;
+
+  /*!
+   * Edge of a spanning tree: extremities \c i and \c j , and length \c len .
+   */
+  struct Tree_Edge {
+    unsigned int i ;
+    unsigned int j ;
+    float len ;
+  } ;
+
+  /*!
+   * Priority queue of the vertices for \c shortest_paths:
+   * \li \c heap_queue a Heap_Id (any non negative lengths),
+   * \li \c radix_queue a Radix_Heap, O ( m + n log C ) with C the greatest length,
+   * for integer lengths only,
+   * \li \c pairing_queue a Pairing_Heap (any non negative lengths), whose decrease_key
+   * is cheaper than the one of Heap_Id: for dense graphs.
+   */
+  enum Queue { heap_queue , radix_queue , pairing_queue } ;
+
+  /*!
+   * Estimate of the distance from a vertex to the target of \c shortest_path_a_star.
+   * It must be admissible: never more than the length of a shortest path to the target.
+   */
+  class Heuristic {
+  public :
+    virtual ~Heuristic () {}
+    /*! \param k vertex number.
+     * \return a lower bound of the distance from \c k to the target. */
+    virtual float operator () ( unsigned int k ) const = 0 ;
+  } ;
+
   
 private :
 
-  /*! Array to store the vertices. */
-  Vertex * const vertices ;
+  /*! Edge given to \c add_edge and not yet packed by \c freeze. */
+  struct Pending_Edge {
+    unsigned int i ;
+    unsigned int j ;
+    float len ;
+  } ;
+
+  /*! Edges added since the last \c freeze. */
+  mutable std :: vector < Pending_Edge > pending ;
+
+  /*!
+   * Compressed sparse row adjacency:
+   * the edges going out of vertex \c k are at positions
+   * \c offsets [ k ] to \c offsets [ k + 1 ] - 1 of \c targets (other extremity)
+   * and \c weights (length).
+   * \c offsets has \c nbr_vertices + 1 cells, \c targets and \c weights \c nbr_arcs.
+   * The arrays are the ones of the vectors below, or in the mapped file for a graph from \c load.
+   */
+  mutable unsigned int const * offsets ;
+  mutable unsigned int const * targets ;
+  mutable float const * weights ;
+  mutable unsigned int nbr_arcs ;
+
+  /*! Arrays built by \c freeze. */
+  mutable std :: vector < unsigned int > offsets_vector ;
+  mutable std :: vector < unsigned int > targets_vector ;
+  mutable std :: vector < float > weights_vector ;
+
+  /*! File mapped in memory by \c load (0 otherwise) and its size. */
+  void * const map ;
+  size_t const map_size ;
+
+  /*! Names of the vertices, built on the first call to \c name. */
+  mutable std :: vector < std :: string > names ;
+
+  /*! Set the adjacency arrays to the ones of the vectors. */
+  void point_to_vectors () const {
+    offsets = & offsets_vector [ 0 ] ;
+    targets = targets_vector . empty () ? 0 : & targets_vector [ 0 ] ;
+    weights = weights_vector . empty () ? 0 : & weights_vector [ 0 ] ;
+    nbr_arcs = targets_vector . size () ;
+  }
+
+  /*!
+   * Read-only graph on a file mapped by \c load.
+   * \param _nbr_vertices number of vertices.
+   * \param _map,_map_size mapped file, checked by \c load.
+   */
+  Graph ( unsigned int _nbr_vertices ,
+	  void * _map ,
+	  size_t _map_size ) ;
+
+  /*! Graph is not copyable (the adjacency arrays may be a mapped file). */
+  Graph ( Graph const & ) ;
+  Graph & operator = ( Graph const & ) ;
 
   
 public :
@@ -68,33 +161,35 @@ public :
 
   /*!
    * Create a graph with given number of vertices.
-   * Names are provided for vertices: n0, n1…
+   * Names are provided for vertices: n0, n1… (they are only built when first asked for).
    * \param _nbr_vertices number of vertices.
    * The graph has no edges.
    */
   Graph ( unsigned int _nbr_vertices )
     : nbr_vertices ( _nbr_vertices )
-    , vertices ( new Vertex [ _nbr_vertices ] )
+    , offsets_vector ( _nbr_vertices + 1 , 0 )
+    , map ( 0 )
+    , map_size ( 0 )
   {
-    std :: string prefix ( "n" ) ;
-    for ( unsigned int i = 0 ;
-	  i < nbr_vertices ;
-	  i ++ ) {
-      // "magic formula" for to_string ()
-      vertices [ i ] . first = prefix + static_cast < std :: ostringstream * > ( & ( std :: ostringstream () << i ) ) -> str() ;
-      // still looking for better (and yet not C++11)
-    }
+    point_to_vectors () ;
   }
 
-  
+  /*!
+   * Open a graph written by \c save, without copying it: the file is mapped in memory
+   * and the adjacency arrays are read directly from it.
+   * The graph is read-only (no edge can be added).
+   * \param file name of the file.
+   * \return the graph, to be deleted, or 0 if the file cannot be read or is not a graph file.
+   */
+  static Graph * load ( char const * file ) ;
+
+
   //
   //  DESTRUCTOR
   //
 
-  /*! Release the resources. */
-  ~Graph () { 
-    delete[] vertices ;
-  }
+  /*! Release the mapped file, if any. */
+  ~Graph () ;
 
   
   //
@@ -114,10 +209,80 @@ public :
     assert ( i < nbr_vertices ) ;
     assert ( j < nbr_vertices ) ;
     assert ( 0 < len ) ;
-    vertices  [ i ] . second . push_back ( Edge ( j , len ) ) ;
-    vertices  [ j ] . second . push_back ( Edge ( i , len ) ) ;
+    assert ( ! is_read_only () ) ;
+    Pending_Edge const e = { i , j , len } ;
+    pending . push_back ( e ) ;
+  }
+
+  /*!
+   * Pack the edges added since the last call into the contiguous adjacency arrays.
+   * The edges of a vertex stay in the order they were added.
+   * It is called by the traversals, so it only needs to be called explicitly
+   * to pay for it at a chosen moment.
+   * The parallel traversals call it before starting their threads:
+   * a frozen graph is only read and can be shared between threads.
+   */
+  void freeze () const ;
+
+  /*! \return true iff the graph comes from \c load (then \c add_edge cannot be used). */
+  bool is_read_only () const {
+    return map != 0 ;
+  }
+
+  /*!
+   * Write the graph in a file, read back by \c load: a header
+   * (\c "PASDGRPH", version, number of vertices, number of arcs, all \c unsigned \c int)
+   * followed by the arrays \c offsets, \c targets and \c weights, in the byte order of the machine.
+   * The graph is frozen first.
+   * \param file name of the file.
+   * \return true iff the file was written.
+   */
+  bool save ( char const * file ) const ;
+
+  /*! \return true iff every edge added is in the adjacency arrays. */
+  bool is_frozen () const {
+    return pending . empty () ;
+  }
+
+  /*! \return the number of edges (each counted once). */
+  unsigned int nbr_edges () const {
+    return ( nbr_arcs / 2 ) + pending . size () ;
+  }
+
+  /*!
+   * The edges going out of vertex \c k are numbered from \c first_edge ( k )
+   * to \c first_edge ( k + 1 ) - 1.
+   * \param k vertex number, or \c nbr_vertices.
+   * \pre The graph is frozen.
+   * \return the number of the first edge going out of \c k.
+   */
+  unsigned int first_edge ( unsigned int k ) const {
+    assert ( k <= nbr_vertices ) ;
+    assert ( is_frozen () ) ;
+    return offsets [ k ] ;
+  }
+
+  /*! \param e edge number (see \c first_edge).
+   * \return the other extremity of edge \c e. */
+  unsigned int target ( unsigned int e ) const {
+    assert ( e < nbr_arcs ) ;
+    return targets [ e ] ;
+  }
+
+  /*! \param e edge number (see \c first_edge).
+   * \return the length of edge \c e. */
+  float weight ( unsigned int e ) const {
+    assert ( e < nbr_arcs ) ;
+    return weights [ e ] ;
   }
 
+  /*!
+   * \param k vertex number.
+   * \pre \c k is a legal vertex number.
+   * \return the name of vertex \c k.
+   */
+  std :: string const & name ( unsigned int k ) const ;
+
   /*!
    * Print the result of Dijkstra's algorithm in the form:
    * \verbatim
@@ -133,6 +298,114 @@ public :
   void print_dijkstra ( unsigned int i ,
 			unsigned int j ) const ;
 
+  /*!
+   * Dijkstra's algorithm from \c source to every vertex, with a Heap_Id:
+   * a vertex is pushed once and its distance is decreased in place when a shorter path is found.
+   * \param source initial vertex.
+   * \pre \c source is a legal vertex number.
+   * \return distances and predecessors for all vertices (one run answers all targets).
+   */
+  Shortest_Paths shortest_paths ( unsigned int source ) const ;
+
+  /*!
+   * Same as \c shortest_paths with the priority queue given by \c Q.
+   * \pre \c source is a legal vertex number.
+   * \pre with \c radix_queue, the lengths are integers.
+   */
+  template < Queue Q >
+  Shortest_Paths shortest_paths ( unsigned int source ) const ;
+
+  /*!
+   * Bidirectional Dijkstra's algorithm: a search from \c from and one from \c to
+   * are advanced in turn (the one with the closest vertex first) until they meet,
+   * so only the vertices around the two ends are treated.
+   * \param from,to endpoints of the path to search.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \return a shortest path from \c from to \c to (for \c print_path):
+   * only the distances and predecessors of the vertices on this path are filled.
+   */
+  Shortest_Paths shortest_path_bidirectional ( unsigned int from ,
+					       unsigned int to ) const ;
+
+  /*!
+   * A* search: Dijkstra's algorithm where a vertex \c k is taken by increasing
+   * distance from \c from plus \c h ( k ), and that stops when \c to is treated.
+   * The better the heuristic, the fewer vertices are treated
+   * (with \c h always 0 it is Dijkstra's algorithm stopped at \c to).
+   * \param from,to endpoints of the path to search.
+   * \param h admissible estimate of the distance to \c to.
+   * \pre \c from and \c to are legal vertex numbers.
+   * \return a shortest path from \c from to \c to, filled as by \c shortest_path_bidirectional.
+   */
+  Shortest_Paths shortest_path_a_star ( unsigned int from ,
+					unsigned int to ,
+					Heuristic const & h ) const ;
+
+  /*!
+   * Delta-stepping: the vertices are put in buckets of width \c delta by distance,
+   * all the vertices of the first non empty bucket are relaxed at the same time
+   * (shared among \c nbr_threads threads), first by their light edges (length at most \c delta)
+   * till the bucket stays empty, then by their heavy edges.
+   * A \c delta about the mean length of the edges is usually a good choice.
+   * \param source initial vertex.
+   * \param delta width of the buckets.
+   * \param nbr_threads number of threads (the calling thread is one of them).
+   * \pre \c source is a legal vertex number, \c delta and \c nbr_threads are positive.
+   * \return the same distances as \c shortest_paths (the predecessors may differ between shortest paths of equal length).
+   */
+  Shortest_Paths shortest_paths_delta_stepping ( unsigned int source ,
+						 float delta ,
+						 unsigned int nbr_threads ) const ;
+
+  /*!
+   * Run \c shortest_paths from every source, \c nbr_threads sources at a time.
+   * The graph is frozen first, then the threads only read it.
+   * \param sources initial vertices.
+   * \param nbr_threads number of threads (the calling thread is one of them).
+   * \pre the sources are legal vertex numbers, \c nbr_threads is positive.
+   * \return the result for \c sources [ k ] at position \c k.
+   */
+  std :: vector < Shortest_Paths > shortest_paths ( std :: vector < unsigned int > const & sources ,
+						    unsigned int nbr_threads ) const ;
+
+  /*!
+   * Prim's algorithm on the adjacency arrays, with a Heap_Id of the vertices
+   * by length of their lightest edge to the tree (decreased in place).
+   * A tree is grown from each vertex not reached yet, so a graph with many components
+   * gives a minimum spanning forest.
+   * \return the edges of the forest, in the order they are added (\c i is the vertex already in the tree).
+   */
+  std :: vector < Tree_Edge > minimum_spanning_tree_prim () const ;
+
+  /*!
+   * Kruskal's algorithm on the adjacency arrays: the edges are sorted by length
+   * (then by extremities, so that the result does not depend on the sort)
+   * and kept when they join two components of an array union-find
+   * (union by rank, path halving).
+   * \return the edges of the minimum spanning forest, by increasing length (\c i < \c j).
+   */
+  std :: vector < Tree_Edge > minimum_spanning_tree_kruskal () const ;
+
+  /*!
+   * Connected components, by breadth first traversals of the adjacency arrays.
+   * \param component filled with the number of the component of each vertex:
+   * the components are numbered from 0 in the order of their lowest vertex.
+   * \return the number of components.
+   */
+  unsigned int connected_components ( std :: vector < unsigned int > & component ) const ;
+
+  /*!
+   * Print the path from \c sp.source to \c to in the format of \c print_dijkstra.
+   * Nothing is printed if \c to is not reachable.
+   * \param sp result of \c shortest_paths.
+   * \param to last vertex of the path.
+   * \param out \c ostream to output to.
+   * \pre \c to is a legal vertex number.
+   */
+  void print_path ( Shortest_Paths const & sp ,
+		    unsigned int to ,
+		    std :: ostream & out = std :: cout ) const ;
+
 } ;
 
 # endif
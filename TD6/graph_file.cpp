@@ -0,0 +1,124 @@
+/*!
+ * \file
+ * \brief This module provides the binary file format of graph:
+ * \c Graph :: save writes the adjacency arrays, \c Graph :: load maps them in memory (POSIX mmap).
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <cstdio>
+# include <cstring>
+
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "graph.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Header of a graph file, followed by the arrays. */
+  struct Header {
+    char magic [ 8 ] ;
+    unsigned int version ;
+    unsigned int nbr_vertices ;
+    unsigned int nbr_arcs ;
+    unsigned int unused ;
+  } ;
+
+  /*! Beginning of every graph file. */
+  char const magic [ 8 ] = { 'P' , 'A' , 'S' , 'D' , 'G' , 'R' , 'P' , 'H' } ;
+
+  /*! Version of the format. */
+  unsigned int const version = 1 ;
+
+  /*! \return the size of a graph file with given numbers of vertices and arcs. */
+  size_t file_size ( unsigned int nbr_vertices ,
+		     unsigned int nbr_arcs ) {
+    return sizeof ( Header )
+      + ( static_cast < size_t > ( nbr_vertices ) + 1 ) * sizeof ( unsigned int )
+      + static_cast < size_t > ( nbr_arcs ) * ( sizeof ( unsigned int ) + sizeof ( float ) ) ;
+  }
+
+}
+
+
+Graph :: Graph ( unsigned int _nbr_vertices ,
+		 void * _map ,
+		 size_t _map_size )
+  : nbr_vertices ( _nbr_vertices )
+  , map ( _map )
+  , map_size ( _map_size )
+{
+  Header const * const h = static_cast < Header const * > ( map ) ;
+  char const * const arrays = static_cast < char const * > ( map ) + sizeof ( Header ) ;
+  offsets = reinterpret_cast < unsigned int const * > ( arrays ) ;
+  targets = offsets + nbr_vertices + 1 ;
+  weights = reinterpret_cast < float const * > ( targets + h -> nbr_arcs ) ;
+  nbr_arcs = h -> nbr_arcs ;
+}
+
+
+Graph :: ~Graph () {
+  if ( map != 0 ) {
+    munmap ( map , map_size ) ;
+  }
+}
+
+
+bool Graph :: save ( char const * file ) const {
+  freeze () ;
+  FILE * const f = fopen ( file , "wb" ) ;
+  if ( f == 0 ) {
+    return false ;
+  }
+  Header h ;
+  memcpy ( h . magic , magic , sizeof ( magic ) ) ;
+  h . version = version ;
+  h . nbr_vertices = nbr_vertices ;
+  h . nbr_arcs = nbr_arcs ;
+  h . unused = 0 ;
+  bool const ok = fwrite ( & h , sizeof ( h ) , 1 , f ) == 1
+    && fwrite ( offsets , sizeof ( unsigned int ) , nbr_vertices + 1 , f ) == nbr_vertices + 1
+    && fwrite ( targets , sizeof ( unsigned int ) , nbr_arcs , f ) == nbr_arcs
+    && fwrite ( weights , sizeof ( float ) , nbr_arcs , f ) == nbr_arcs ;
+  return ( fclose ( f ) == 0 ) && ok ;
+}
+
+
+Graph * Graph :: load ( char const * file ) {
+  int const fd = open ( file , O_RDONLY ) ;
+  if ( fd < 0 ) {
+    return 0 ;
+  }
+  struct stat st ;
+  if ( fstat ( fd , & st ) != 0 || static_cast < size_t > ( st . st_size ) < sizeof ( Header ) ) {
+    close ( fd ) ;
+    return 0 ;
+  }
+  size_t const size = st . st_size ;
+  void * const m = mmap ( 0 , size , PROT_READ , MAP_SHARED , fd , 0 ) ;
+  // the mapping stays valid after the file is closed
+  close ( fd ) ;
+  if ( m == MAP_FAILED ) {
+    return 0 ;
+  }
+  Header const * const h = static_cast < Header const * > ( m ) ;
+  // only the header and the ends of offsets are checked, the arrays are read when used
+  unsigned int const * const off = reinterpret_cast < unsigned int const * > ( h + 1 ) ;
+  if ( memcmp ( h -> magic , magic , sizeof ( magic ) ) != 0
+       || h -> version != version
+       || file_size ( h -> nbr_vertices , h -> nbr_arcs ) != size
+       || off [ 0 ] != 0
+       || off [ h -> nbr_vertices ] != h -> nbr_arcs ) {
+    munmap ( m , size ) ;
+    return 0 ;
+  }
+  return new Graph ( h -> nbr_vertices , m , size ) ;
+}
@@ -0,0 +1,381 @@
+/*!
+ * \file
+ * \brief This module provides the parallel shortest paths on graph (with POSIX threads):
+ * delta-stepping from one source and independent Dijkstra's algorithms from many sources.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <limits>
+# include <pthread.h>
+
+# include "graph.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Proposal of a path of length \c distance to \c to, coming from \c from. */
+  struct Request {
+    unsigned int to ;
+    float distance ;
+    unsigned int from ;
+  } ;
+
+
+  /*!
+   * State shared by the threads of a delta-stepping.
+   *
+   * Each step is done by all the threads between barriers:
+   * \li thread 0 chooses the vertices to relax (\c frontier), the others wait;
+   * \li each thread proposes new paths through the edges of its share of the frontier;
+   * \li each thread applies the proposals to the vertices \c v such that \c v % \c nbr_threads is its number,
+   * so that no two threads write the same distance;
+   * \li thread 0 puts the improved vertices in their buckets.
+   *
+   * A bucket may hold vertices that moved to a lower bucket since (they are skipped).
+   */
+  class Delta_Stepping {
+
+    Graph const & g ;
+    float const delta ;
+    unsigned int const nbr_threads ;
+
+    /*! Vertices by bucket, bucket \c b is for distances in [ b * delta , ( b + 1 ) * delta ). */
+    vector < vector < unsigned int > > buckets ;
+
+    /*! Bucket being emptied. */
+    unsigned int current ;
+
+    /*! Vertices to relax at this step. */
+    vector < unsigned int > frontier ;
+
+    /*! Whether the heavy edges of the frontier are relaxed (otherwise the light ones). */
+    bool heavy ;
+
+    /*! Vertices taken from the current bucket, to relax their heavy edges when it is empty. */
+    vector < unsigned int > settled ;
+
+    /*! Step in which each vertex was last put in the frontier (to put it once). */
+    vector < unsigned int > step_in_frontier ;
+
+    /*! Number of the step. */
+    unsigned int step ;
+
+    /*! Whether each vertex is in \c settled. */
+    vector < bool > is_settled ;
+
+    /*! Proposals made by each thread. */
+    vector < vector < Request > > requests ;
+
+    /*! Vertices improved by each thread. */
+    vector < vector < unsigned int > > improved ;
+
+    /*! Set by thread 0 when all the buckets are empty. */
+    bool done ;
+
+    pthread_barrier_t barrier ;
+
+    /*! \return the number of the bucket for distance \c d */
+    unsigned int bucket ( float d ) const {
+      return static_cast < unsigned int > ( d / delta ) ;
+    }
+
+    /*! Put \c v in the bucket of its distance. */
+    void put ( unsigned int v ) {
+      unsigned int const b = bucket ( sp . distance [ v ] ) ;
+      if ( buckets . size () <= b ) {
+	buckets . resize ( b + 1 ) ;
+      }
+      buckets [ b ] . push_back ( v ) ;
+    }
+
+    /*! Thread 0: fill the frontier, or set \c done. */
+    void prepare () ;
+
+    /*! Thread \c t: proposals for its share of the frontier. */
+    void propose ( unsigned int t ) ;
+
+    /*! Thread \c t: apply the proposals for its vertices. */
+    void apply ( unsigned int t ) ;
+
+    /*! Thread 0: put the improved vertices in their buckets. */
+    void merge () ;
+
+    /*! Argument of the threads. */
+    struct Worker {
+      Delta_Stepping * ds ;
+      unsigned int t ;
+    } ;
+
+    static void * start ( void * w ) {
+      static_cast < Worker * > ( w ) -> ds -> work ( static_cast < Worker * > ( w ) -> t ) ;
+      return 0 ;
+    }
+
+  public :
+
+    /*! Result. */
+    Graph :: Shortest_Paths sp ;
+
+    Delta_Stepping ( Graph const & _g ,
+		     unsigned int source ,
+		     float _delta ,
+		     unsigned int _nbr_threads )
+      : g ( _g )
+      , delta ( _delta )
+      , nbr_threads ( _nbr_threads )
+      , current ( 0 )
+      , heavy ( false )
+      , step_in_frontier ( _g . nbr_vertices , 0 )
+      , step ( 0 )
+      , is_settled ( _g . nbr_vertices , false )
+      , requests ( _nbr_threads )
+      , improved ( _nbr_threads )
+      , done ( false )
+    {
+      sp . source = source ;
+      sp . distance . assign ( g . nbr_vertices , numeric_limits < float > :: infinity () ) ;
+      sp . predecessor . assign ( g . nbr_vertices , g . nbr_vertices ) ;
+      sp . distance [ source ] = 0 ;
+      put ( source ) ;
+      pthread_barrier_init ( & barrier , 0 , nbr_threads ) ;
+    }
+
+    ~Delta_Stepping () {
+      pthread_barrier_destroy ( & barrier ) ;
+    }
+
+    /*! Loop of thread \c t till all the buckets are empty. */
+    void work ( unsigned int t ) ;
+
+    /*! Start the other threads, work as thread 0 and wait for them. */
+    void run () ;
+
+  } ;
+
+
+  void Delta_Stepping :: prepare () {
+    heavy = false ;
+    while ( current < buckets . size () ) {
+      step ++ ;
+      frontier . clear () ;
+      vector < unsigned int > & b = buckets [ current ] ;
+      for ( vector < unsigned int > :: const_iterator it = b . begin () ;
+	    it != b . end () ;
+	    ++ it ) {
+	unsigned int const v = * it ;
+	if ( bucket ( sp . distance [ v ] ) == current && step_in_frontier [ v ] != step ) {
+	  step_in_frontier [ v ] = step ;
+	  frontier . push_back ( v ) ;
+	  if ( ! is_settled [ v ] ) {
+	    is_settled [ v ] = true ;
+	    settled . push_back ( v ) ;
+	  }
+	}
+      }
+      b . clear () ;
+      if ( ! frontier . empty () ) {
+	return ;
+      }
+      // the bucket stays empty: its vertices are final, relax their heavy edges
+      current ++ ;
+      if ( ! settled . empty () ) {
+	frontier . swap ( settled ) ;
+	for ( vector < unsigned int > :: const_iterator it = frontier . begin () ;
+	      it != frontier . end () ;
+	      ++ it ) {
+	  is_settled [ * it ] = false ;
+	}
+	heavy = true ;
+	return ;
+      }
+    }
+    done = true ;
+  }
+
+
+  void Delta_Stepping :: propose ( unsigned int t ) {
+    vector < Request > & r = requests [ t ] ;
+    r . clear () ;
+    unsigned int const first = frontier . size () * t / nbr_threads ;
+    unsigned int const last = frontier . size () * ( t + 1 ) / nbr_threads ;
+    for ( unsigned int k = first ; k < last ; k ++ ) {
+      unsigned int const u = frontier [ k ] ;
+      float const du = sp . distance [ u ] ;
+      for ( unsigned int e = g . first_edge ( u ) ;
+	    e < g . first_edge ( u + 1 ) ;
+	    e ++ ) {
+	float const w = g . weight ( e ) ;
+	if ( heavy == ( delta < w ) ) {
+	  Request const q = { g . target ( e ) , du + w , u } ;
+	  r . push_back ( q ) ;
+	}
+      }
+    }
+  }
+
+
+  void Delta_Stepping :: apply ( unsigned int t ) {
+    vector < unsigned int > & imp = improved [ t ] ;
+    imp . clear () ;
+    for ( unsigned int s = 0 ; s < nbr_threads ; s ++ ) {
+      for ( vector < Request > :: const_iterator q = requests [ s ] . begin () ;
+	    q != requests [ s ] . end () ;
+	    ++ q ) {
+	if ( q -> to % nbr_threads == t && q -> distance < sp . distance [ q -> to ] ) {
+	  sp . distance [ q -> to ] = q -> distance ;
+	  sp . predecessor [ q -> to ] = q -> from ;
+	  imp . push_back ( q -> to ) ;
+	}
+      }
+    }
+  }
+
+
+  void Delta_Stepping :: merge () {
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      for ( vector < unsigned int > :: const_iterator it = improved [ t ] . begin () ;
+	    it != improved [ t ] . end () ;
+	    ++ it ) {
+	put ( * it ) ;
+      }
+    }
+  }
+
+
+  void Delta_Stepping :: work ( unsigned int t ) {
+    for ( ; ; ) {
+      if ( t == 0 ) {
+	prepare () ;
+      }
+      pthread_barrier_wait ( & barrier ) ;
+      if ( done ) {
+	return ;
+      }
+      propose ( t ) ;
+      pthread_barrier_wait ( & barrier ) ;
+      apply ( t ) ;
+      pthread_barrier_wait ( & barrier ) ;
+      if ( t == 0 ) {
+	merge () ;
+      }
+    }
+  }
+
+
+  void Delta_Stepping :: run () {
+    vector < Worker > workers ( nbr_threads ) ;
+    vector < pthread_t > threads ( nbr_threads ) ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      workers [ t ] . ds = this ;
+      workers [ t ] . t = t ;
+    }
+    for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+      int const ret = pthread_create ( & threads [ t ] , 0 , start , & workers [ t ] ) ;
+      assert ( ret == 0 ) ;
+    }
+    work ( 0 ) ;
+    for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+      pthread_join ( threads [ t ] , 0 ) ;
+    }
+  }
+
+
+  /*!
+   * Sources shared by the threads of \c Graph :: shortest_paths:
+   * each thread takes the next source not taken yet till there is none.
+   */
+  class Multi_Source {
+
+    Graph const & g ;
+    vector < unsigned int > const & sources ;
+    vector < Graph :: Shortest_Paths > & results ;
+
+    /*! Position of the next source to take. */
+    unsigned int next ;
+    pthread_mutex_t mutex ;
+
+    static void * start ( void * ms ) {
+      static_cast < Multi_Source * > ( ms ) -> work () ;
+      return 0 ;
+    }
+
+  public :
+
+    Multi_Source ( Graph const & _g ,
+		   vector < unsigned int > const & _sources ,
+		   vector < Graph :: Shortest_Paths > & _results )
+      : g ( _g )
+      , sources ( _sources )
+      , results ( _results )
+      , next ( 0 )
+    {
+      pthread_mutex_init ( & mutex , 0 ) ;
+    }
+
+    ~Multi_Source () {
+      pthread_mutex_destroy ( & mutex ) ;
+    }
+
+    /*! Loop of a thread till there is no source left. */
+    void work () {
+      for ( ; ; ) {
+	pthread_mutex_lock ( & mutex ) ;
+	unsigned int const k = next ++ ;
+	pthread_mutex_unlock ( & mutex ) ;
+	if ( sources . size () <= k ) {
+	  return ;
+	}
+	results [ k ] = g . shortest_paths ( sources [ k ] ) ;
+      }
+    }
+
+    /*! Start the other threads, work too and wait for them. */
+    void run ( unsigned int nbr_threads ) {
+      vector < pthread_t > threads ( nbr_threads ) ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	int const ret = pthread_create ( & threads [ t ] , 0 , start , this ) ;
+	assert ( ret == 0 ) ;
+      }
+      work () ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	pthread_join ( threads [ t ] , 0 ) ;
+      }
+    }
+
+  } ;
+
+}
+
+
+Graph :: Shortest_Paths Graph :: shortest_paths_delta_stepping ( unsigned int source ,
+							     float delta ,
+							     unsigned int nbr_threads ) const {
+  assert ( source < nbr_vertices ) ;
+  assert ( 0 < delta ) ;
+  assert ( 0 < nbr_threads ) ;
+  freeze () ;
+  Delta_Stepping ds ( * this , source , delta , nbr_threads ) ;
+  ds . run () ;
+  return ds . sp ;
+}
+
+
+vector < Graph :: Shortest_Paths > Graph :: shortest_paths ( vector < unsigned int > const & sources ,
+							     unsigned int nbr_threads ) const {
+  assert ( 0 < nbr_threads ) ;
+  for ( vector < unsigned int > :: const_iterator it = sources . begin () ;
+	it != sources . end () ;
+	++ it ) {
+    assert ( * it < nbr_vertices ) ;
+  }
+  freeze () ;
+  vector < Shortest_Paths > results ( sources . size () ) ;
+  Multi_Source ms ( * this , sources , results ) ;
+  ms . run ( nbr_threads < sources . size () ? nbr_threads : sources . size () ) ;
+  return results ;
+}
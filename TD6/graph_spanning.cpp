@@ -0,0 +1,188 @@
+/*!
+ * \file
+ * \brief This module provides the minimum spanning trees (Prim and Kruskal)
+ * and the connected components of graph, on the adjacency arrays.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <algorithm>
+
+# include "graph.hpp"
+# include "heap_id.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! For Prim's algorithm: lightest edge found from the tree to vertex \c i. */
+  struct Vertex_Link {
+    unsigned int i ;
+    unsigned int from ;
+    float len ;
+
+    /*! Comparison according to the length of the edge. */
+    bool operator < ( Vertex_Link const & vl2 ) const {
+      return len < vl2 . len ;
+    }
+
+    /*! Comparison according to the length of the edge. */
+    bool operator <= ( Vertex_Link const & vl2 ) const {
+      return len <= vl2 . len ;
+    }
+  } ;
+
+  /*! Constant to indicate that the vertex is not reached yet. */
+  int const id_undefined = -1 ;
+
+  /*! Constant to indicate that the vertex is in the tree. */
+  int const id_treated = -2 ;
+
+  /*! Order of Kruskal's algorithm: by length, then by extremities. */
+  bool lighter ( Graph :: Tree_Edge const & e1 ,
+		 Graph :: Tree_Edge const & e2 ) {
+    if ( e1 . len != e2 . len ) return e1 . len < e2 . len ;
+    if ( e1 . i != e2 . i ) return e1 . i < e2 . i ;
+    return e1 . j < e2 . j ;
+  }
+
+  /*!
+   * Union-find on arrays: \c father [ k ] is \c k for a representative.
+   */
+  class Union_Find {
+
+    vector < unsigned int > father ;
+
+    /*! Upper bound of the height of the tree of each representative. */
+    vector < unsigned char > rank ;
+
+  public :
+
+    /*! \c n singletons. */
+    Union_Find ( unsigned int n )
+      : father ( n )
+      , rank ( n , 0 )
+    {
+      for ( unsigned int k = 0 ; k < n ; k ++ ) father [ k ] = k ;
+    }
+
+    /*! \return the representative of \c k (every other node on the way then points to its grandfather). */
+    unsigned int find ( unsigned int k ) {
+      while ( father [ k ] != k ) {
+	father [ k ] = father [ father [ k ] ] ;
+	k = father [ k ] ;
+      }
+      return k ;
+    }
+
+    /*! Join the sets of \c a and \c b.
+     * \return false iff they were already the same. */
+    bool join ( unsigned int a ,
+		unsigned int b ) {
+      a = find ( a ) ;
+      b = find ( b ) ;
+      if ( a == b ) return false ;
+      if ( rank [ a ] < rank [ b ] ) swap ( a , b ) ;
+      father [ b ] = a ;
+      if ( rank [ a ] == rank [ b ] ) rank [ a ] ++ ;
+      return true ;
+    }
+
+  } ;
+
+}
+
+
+vector < Graph :: Tree_Edge > Graph :: minimum_spanning_tree_prim () const {
+  freeze () ;
+  vector < Tree_Edge > tree ;
+  tree . reserve ( nbr_vertices > 0 ? nbr_vertices - 1 : 0 ) ;
+  vector < int > id ( nbr_vertices , id_undefined ) ;
+  vector < Vertex_Link > vl ( nbr_vertices ) ;
+  Heap_Id < Vertex_Link > heap ( nbr_vertices ) ;
+  for ( unsigned int root = 0 ; root < nbr_vertices ; root ++ ) {
+    if ( id [ root ] != id_undefined ) continue ;
+    Vertex_Link const r = { root , nbr_vertices , 0 } ;
+    vl [ root ] = r ;
+    id [ root ] = heap . push ( vl [ root ] ) ;
+    while ( ! heap . is_empty () ) {
+      Vertex_Link const & u = heap . pop () ;
+      id [ u . i ] = id_treated ;
+      if ( u . from != nbr_vertices ) {
+	Tree_Edge const e = { u . from , u . i , u . len } ;
+	tree . push_back ( e ) ;
+      }
+      for ( unsigned int p = offsets [ u . i ] ;
+	    p < offsets [ u . i + 1 ] ;
+	    p ++ ) {
+	unsigned int const v = targets [ p ] ;
+	if ( id [ v ] == id_undefined ) {
+	  Vertex_Link const l = { v , u . i , weights [ p ] } ;
+	  vl [ v ] = l ;
+	  id [ v ] = heap . push ( vl [ v ] ) ;
+	} else if ( id [ v ] != id_treated && weights [ p ] < vl [ v ] . len ) {
+	  vl [ v ] . from = u . i ;
+	  vl [ v ] . len = weights [ p ] ;
+	  heap . decrease_key ( id [ v ] ) ;
+	}
+      }
+    }
+  }
+  return tree ;
+}
+
+
+vector < Graph :: Tree_Edge > Graph :: minimum_spanning_tree_kruskal () const {
+  freeze () ;
+  // each edge is twice in the adjacency arrays: it is taken from its lower extremity
+  vector < Tree_Edge > edges ;
+  edges . reserve ( nbr_arcs / 2 ) ;
+  for ( unsigned int k = 0 ; k < nbr_vertices ; k ++ ) {
+    for ( unsigned int p = offsets [ k ] ; p < offsets [ k + 1 ] ; p ++ ) {
+      if ( k < targets [ p ] ) {
+	Tree_Edge const e = { k , targets [ p ] , weights [ p ] } ;
+	edges . push_back ( e ) ;
+      }
+    }
+  }
+  sort ( edges . begin () , edges . end () , lighter ) ;
+  vector < Tree_Edge > tree ;
+  tree . reserve ( nbr_vertices > 0 ? nbr_vertices - 1 : 0 ) ;
+  Union_Find sets ( nbr_vertices ) ;
+  for ( vector < Tree_Edge > :: const_iterator e = edges . begin () ;
+	e != edges . end () && tree . size () + 1 < nbr_vertices ;
+	++ e ) {
+    if ( sets . join ( e -> i , e -> j ) ) tree . push_back ( * e ) ;
+  }
+  return tree ;
+}
+
+
+unsigned int Graph :: connected_components ( vector < unsigned int > & component ) const {
+  freeze () ;
+  component . assign ( nbr_vertices , nbr_vertices ) ;
+  vector < unsigned int > queue ;
+  queue . reserve ( nbr_vertices ) ;
+  unsigned int nbr = 0 ;
+  for ( unsigned int root = 0 ; root < nbr_vertices ; root ++ ) {
+    if ( component [ root ] != nbr_vertices ) continue ;
+    // the queue is the vector, read from its beginning
+    queue . clear () ;
+    queue . push_back ( root ) ;
+    component [ root ] = nbr ;
+    for ( unsigned int q = 0 ; q < queue . size () ; q ++ ) {
+      unsigned int const u = queue [ q ] ;
+      for ( unsigned int p = offsets [ u ] ; p < offsets [ u + 1 ] ; p ++ ) {
+	if ( component [ targets [ p ] ] == nbr_vertices ) {
+	  component [ targets [ p ] ] = nbr ;
+	  queue . push_back ( targets [ p ] ) ;
+	}
+      }
+    }
+    nbr ++ ;
+  }
+  return nbr ;
+}
@@ -11,42 +11,45 @@
 
 # include <iostream>
 
+# include "counters.hpp"
 
-# undef NDEBUG 
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
 # include <assert.h>
 
 
 
 // Pre-declaration to be able to declare operator <<
-template <class Element>
+template <class Element, unsigned int D = 4>
 class Heap;
 
 
 // Pre-declaration to declare friend after
-template <class Element>
-std :: ostream & operator <<(std :: ostream & out, Heap <Element> const & h);
+template <class Element, unsigned int D>
+std :: ostream & operator <<(std :: ostream & out, Heap <Element, D> const & h);
 
 
 /*!
  * \brief This class implements a generic heap.
  *
- * It uses a binary tree such that the value held in any node is greater (or equal) to the value in its sons.
+ * It uses a D-ary tree such that the value held in any node is greater (or equal) to the value in its sons.
  *
  * \pre \c Element must be comparable: operators < and <= must be defined.
+ * \pre \c D is at least 2 (2 is the usual binary heap).
  *
  * Implementation: 
- * \li the tree is folded into an array.
+ * \li the tree is folded into an array: the sons of node i are D*i+1 to D*i+D.
+ * With D = 4 (default) the tree is half as high as a binary one and the
+ * sons scanned by \c lower are contiguous in the array.
  * \li reference / pointers are used to store elements (i.e. no copy is made)
  */
-template <class Element>
+template <class Element, unsigned int D>
 class Heap {
 
-public :
-
-  /*! Maximal capacity of the heap. */ 
-  const unsigned int capacity;
-
-private:
+  /*! Allocated size of the array, doubled when full. */ 
+  unsigned int capacity;
 
   /*! Nature of the nodes: pointers to elements.
    * The number of elements is \c capacity. */
@@ -54,7 +57,7 @@ private:
   
   /*! Pointer to array of size capacity. 
     The array holds the values. */
-  Node* const elements;
+  Node* elements;
 
   /*! Number of values in the heap.
    * It is always at most the capacity. */
@@ -83,27 +86,15 @@ private:
   	 return (*(elements[pos_1])<=*(elements[pos_2]));
   }
   /*!
-   * To compute the index of the left son.
+   * To compute the index of the first son (the others follow it).
    * \param i position of the node.
    * \pre \c i is a legal position
-   * \post returns a legal position.
-   * \return the index (in the array) of the left son of the node (indicated by index i). 
+   * \return the index (in the array) of the first son of the node (indicated by index i),
+   * it may be beyond the last element. 
    */
-  unsigned int get_pos_left_son(unsigned int i) const {
+  unsigned int get_pos_first_son(unsigned int i) const {
   	assert(i<=nb_elem);
-    	return (2*i)+1; 
-  };
-  
-  /*!
-   * To compute the index of the left son.
-   * \param i position of the node.
-   * \pre \c i is a legal position
-   * \post returns a legal position.
-   * \return the index (in the array) of the right son of the node (indicated by index i). 
-   */
-  unsigned int get_pos_right_son(const unsigned int i) const {
-	assert(i<=nb_elem);
-    	return (2*i)+2;
+    	return (D*i)+1; 
   };
   
   /*!
@@ -111,36 +102,40 @@ private:
    * \param i position of the node.
    * \pre \c i is a legal position.
    * \post returns a legal position.
-   * \return the index (in the array) of the right son of the node (indicated by index i), except for the root (it returns 0). 
+   * \return the index (in the array) of the father of the node (indicated by index i), except for the root (it returns 0). 
    */
   unsigned int get_pos_father(const unsigned int i) const {
-	assert(i>=0 && i<=nb_elem);
-    	return (i-1)/2; 
+	assert(i<=nb_elem);
+    	return (i-1)/D; 
   };
   
   /*!
-   * Exchange two elements in the array. 
-   * \param pos_a position of one node.
-   * \param pos_b position of other node.
-   * \pre \c pos_a and \c pos_b are legal positions.
+   * Double the capacity of the array.
    */
-  void swap(const unsigned int pos_a, const unsigned int pos_b) {
-	assert(pos_a<=nb_elem);
-	assert(pos_b<=nb_elem);
-	Node e=elements[pos_b];
-	elements[pos_b]=elements[pos_a];
-	elements[pos_a]=e;
-  }
-  
+  void grow();
+
+  /*!
+   * Restore the heap property on the whole array by lowering every inner node,
+   * from the last one to the root (Floyd's heapify, linear time).
+   */
+  void heapify();
+
+  /*! Heap is not copyable (it only holds pointers to the elements). */
+  Heap(Heap const &);
+  Heap & operator = (Heap const &);
+
   /*!
    * To check the validity of the head.
    * \return true iff the heap is correct (each father less than or equal to sons).
-   * This should to be used in asserts.
+   * This should to be used in asserts: it takes linear time, so push, pop and assign
+   * only check it when \c HEAP_DEBUG is defined.
    */
   bool is_valid () const;
 
   /*! 
-   * Swap the node pos down throughout the heap till consistency is restored.
+   * Move the node pos down throughout the heap till consistency is restored.
+   * At each level the smallest son is found once and moved up into the "hole",
+   * the node is written once at its final place.
    * \param pos position of the node to lower
    * \pre pos is a valid location.
    * \post The heap is valid.
@@ -148,7 +143,8 @@ private:
   void lower(unsigned pos);
 
   /*! 
-   * Swap the node pos up throughout the heap till consistency is restored.
+   * Move the node pos up throughout the heap till consistency is restored
+   * (the fathers are moved down into the "hole").
    * \pre pos is a valid location.
    * \post The heap is valid.
    */
@@ -162,15 +158,28 @@ public :
   //  CONSTRUCTOR
   //
 
-  /*! Build an empty heap with given capacity. */
+  /*! Build an empty heap with given initial capacity. */
   Heap(unsigned int _capacity)
-    : capacity(_capacity)
-    , elements(new Node [ _capacity ])
+    : capacity(_capacity > 0 ? _capacity : 1)
+    , elements(new Node [ capacity ])
     , nb_elem(0) 
   {
     assert(is_valid ());
   };
 
+  /*!
+   * Build a heap holding (pointers to) all the elements of [first,last), in linear time.
+   * \param first,last range of lvalues of type \c Element (forward iterators).
+   */
+  template <class Iterator>
+  Heap(Iterator first, Iterator last)
+    : capacity(1)
+    , elements(new Node [ 1 ])
+    , nb_elem(0)
+  {
+    assign(first,last);
+  }
+
   
   //
   //  DESTRUCTOR
@@ -192,6 +201,20 @@ public :
   bool is_empty () const { 
   	return(nb_elem==0);
   }
+
+  /*! \return the allocated size of the array (the heap grows beyond it when needed). */
+  unsigned int get_capacity () const {
+	return capacity;
+  }
+
+  /*!
+   * Replace the content of the heap by (pointers to) all the elements of [first,last).
+   * The array is filled then heapified, in linear time (instead of n push).
+   * \param first,last range of lvalues of type \c Element (forward iterators).
+   * \post The heap is valid.
+   */
+  template <class Iterator>
+  void assign(Iterator first, Iterator last);
   
   /*! 
    * Remove and return the root of the heap.
@@ -202,8 +225,18 @@ public :
    */
   Element & pop();
 
+  /*!
+   * \pre The heap is not empty.
+   * \return the minimum of the heap (it stays in the heap).
+   */
+  Element & top() const {
+	assert(!is_empty());
+	return *(elements[0]);
+  }
+
   /*!
    * Add a value at the bottom of the tree (first empty cell) and swap it up (raise).
+   * The array grows if needed.
    * \param v value to add.
    * \pre The heap is valid.
    * \post The heap is valid.
@@ -215,7 +248,7 @@ public :
   //  FRIENDS
   //
 
-  friend std :: ostream & operator << <Element>(std :: ostream &, Heap const &);
+  friend std :: ostream & operator << <Element, D>(std :: ostream &, Heap const &);
   
 };
 
@@ -227,71 +260,111 @@ public :
 //
 
 
-template <class Element>
-bool Heap <Element> :: is_valid () const {
-	if(is_empty() || nb_elem==1 || nb_elem==2) return true; 
-	for(int i=0; i<nb_elem-2;i++){
-		if(elements[i]>elements[get_pos_right_son(i)] || elements[i]>elements[get_pos_left_son(i)]) return false;
+template <class Element, unsigned int D>
+bool Heap <Element, D> :: is_valid () const {
+	for(unsigned int i=1;i<nb_elem;i++){
+		if(lt(i,get_pos_father(i))) return false;
 	}
 	return true;
 }
 
 
-template <class Element>
-void Heap <Element> :: lower(unsigned int pos) {
-	//assert(pos<nb_elem);
-	//assert(is_valid());
-	while(get_pos_right_son(pos)<nb_elem && get_pos_left_son(pos)<nb_elem && (*(elements[pos]) > *(elements[get_pos_left_son(pos)]) || *(elements[pos]) >*(elements[get_pos_right_son(pos)]))){
-		if(le(get_pos_left_son(pos),get_pos_right_son(pos))){
-			swap(pos,get_pos_left_son(pos));
-			pos=get_pos_left_son(pos);
-		}
-		else{
-			 swap(pos,get_pos_right_son(pos));
-			 pos=get_pos_right_son(pos);
+template <class Element, unsigned int D>
+void Heap <Element, D> :: lower(unsigned int pos) {
+	assert(pos<nb_elem);
+	COUNTER_ADD("Heap::lower");
+	Node const moved=elements[pos];
+	unsigned int son;
+	while((son=get_pos_first_son(pos))<nb_elem){
+		// smallest son, the first one in case of equality
+		unsigned int const last=(son+D<nb_elem) ? son+D : nb_elem;
+		Node min=elements[son];
+		for(unsigned int s=son+1;s<last;s++){
+			if(*(elements[s])<*min){
+				min=elements[s];
+				son=s;
+			}
 		}
+		if(!(*min<*moved)) break;
+		elements[pos]=min;
+		pos=son;
 	}
-	if(get_pos_left_son(pos)==nb_elem-1){
-		if(lt(get_pos_left_son(pos),pos)){
-		 	swap(pos,get_pos_left_son(pos));
-		}
-	}
-	
+	elements[pos]=moved;
 }
 
 
-template <class Element>
-void Heap <Element> :: push(Element & v) {
-	//assert(is_valid());
-	if(is_empty()){
-		elements[nb_elem]=&v;
-		nb_elem++;
-	}
-	else{
-		elements[nb_elem]=&v;
-		raise(nb_elem);
-		nb_elem++;
+template <class Element, unsigned int D>
+void Heap <Element, D> :: grow() {
+	Node* e=new Node [ 2*capacity ];
+	for(unsigned int i=0;i<nb_elem;i++) e[i]=elements[i];
+	delete [] elements;
+	elements=e;
+	capacity*=2;
+}
+
+
+template <class Element, unsigned int D>
+void Heap <Element, D> :: heapify() {
+	// the last inner node is the father of the last element
+	for(unsigned int i=(nb_elem>1) ? get_pos_father(nb_elem-1)+1 : 0;i>0;i--) lower(i-1);
+}
+
+
+template <class Element, unsigned int D>
+template <class Iterator>
+void Heap <Element, D> :: assign(Iterator first, Iterator last) {
+	unsigned int n=0;
+	for(Iterator it=first;it!=last;++it) n++;
+	if(n>capacity){
+		delete [] elements;
+		elements=new Node [ n ];
+		capacity=n;
 	}
+	nb_elem=0;
+	for(Iterator it=first;it!=last;++it) elements[nb_elem++]=&(*it);
+	heapify();
+# ifdef HEAP_DEBUG
+	assert(is_valid());
+# endif
 }
 
 
-template <class Element>
-void Heap <Element> :: raise(unsigned int pos) {
-	assert(pos<=nb_elem);
-	while(pos>0 && *(elements[pos]) < *(elements[get_pos_father(pos)])){
-		swap(pos,get_pos_father(pos));
+template <class Element, unsigned int D>
+void Heap <Element, D> :: push(Element & v) {
+	if(nb_elem==capacity) grow();
+	elements[nb_elem]=&v;
+	nb_elem++;
+	raise(nb_elem-1);
+# ifdef HEAP_DEBUG
+	assert(is_valid());
+# endif
+}
+
+
+template <class Element, unsigned int D>
+void Heap <Element, D> :: raise(unsigned int pos) {
+	assert(pos<nb_elem);
+	COUNTER_ADD("Heap::raise");
+	Node const moved=elements[pos];
+	while(pos>0 && *moved < *(elements[get_pos_father(pos)])){
+		elements[pos]=elements[get_pos_father(pos)];
 		pos=get_pos_father(pos);
-	
 	}
+	elements[pos]=moved;
 }
 
-template <class Element>
-Element & Heap <Element> :: pop() {
-	//assert(is_empty());
+template <class Element, unsigned int D>
+Element & Heap <Element, D> :: pop() {
+	assert(!is_empty());
 	Node min=elements[0];
-	elements[0]=elements[nb_elem-1];
 	nb_elem--;
-	if(nb_elem>1) lower(0);
+	if(nb_elem>0){
+		elements[0]=elements[nb_elem];
+		lower(0);
+	}
+# ifdef HEAP_DEBUG
+	assert(is_valid());
+# endif
 	return *min;
 }
 
@@ -302,12 +375,13 @@ Element & Heap <Element> :: pop() {
  * \param h Heap to output
  * \return the ostream
  */
-template <class Element> std :: ostream & operator <<(std :: ostream & out, Heap<Element> const & h) {
+template <class Element, unsigned int D> std :: ostream & operator <<(std :: ostream & out, Heap<Element, D> const & h) {
 	out<<"[ ";
-	for(int i=0;i<h.nb_elem-1;i++){
-		out<<*((h.elements)[i])<<" , ";
+	for(unsigned int i=0;i<h.nb_elem;i++){
+		if(i>0) out<<" , ";
+		out<<*((h.elements)[i]);
 	}
-	out<<*((h.elements)[h.nb_elem-1])<<" ]";
+	out<<" ]";
   	return out;
 }
 
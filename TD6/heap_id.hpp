@@ -13,20 +13,26 @@
 
 # include <iostream>
 # include <utility> // pair
+# include <vector>
+# include <algorithm> // push_heap pop_heap
 
+# include "counters.hpp"
 
-# undef NDEBUG 
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
 # include <assert.h>
 
 
 // Pre-declaration to declare operator <<
-template <class Element>
+template <class Element, unsigned int D = 4>
 class Heap_Id ;
 
 
 // Pre-declaration to declare friend after
-template <class Element>
-std :: ostream & operator <<(std :: ostream &, Heap_Id <Element> const &);
+template <class Element, unsigned int D>
+std :: ostream & operator <<(std :: ostream &, Heap_Id <Element, D> const &);
 
 
 
@@ -34,17 +40,19 @@ std :: ostream & operator <<(std :: ostream &, Heap_Id <Element> const &);
 /*!
  * \brief This class implements a generic heap with id for the elements.
  *
- * It uses a binary tree such that the value held in any node is greater (or equal) to the value in its sons.
+ * It uses a D-ary tree such that the value held in any node is greater (or equal) to the value in its sons.
  * 
  * Auxiliary arrays are used to go from id to positions and to record available id.
  *
  * \pre \c Element must be comparable: operators < and <= must be defined.
+ * \pre \c D is at least 2 (2 is the usual binary heap).
  *
  * Implementation: 
- * \li the tree is folded into an array.
+ * \li the tree is folded into an array: the sons of node i are D*i+1 to D*i+D
+ * (with D = 4, the default, the tree is half as high as a binary one).
  * \li reference / pointers are used to store elements (i.e. no copy is made)
  */
-template <class Element>
+template <class Element, unsigned int D>
 class Heap_Id {
 
 public :
@@ -103,28 +111,32 @@ private :
 
 
   /*!
-   * To compute the index of the left son.
+   * To compute the index of the first son (the others follow it).
    * \param i position of the node.
    * \pre \c i is a legal position
-   * \post returns a legal position.
-   * \return the index (in the array) of the left son of the node (indicated by index i). 
+   * \return the index (in the array) of the first son of the node (indicated by index i),
+   * it may be beyond the last element. 
    */
-  unsigned int get_pos_left_son(unsigned int i)const {
+  unsigned int get_pos_first_son(unsigned int i)const {
     assert(i<nb_elem);
-    return 2*i+1;
-
+    return D*i+1;
   } ;
   
   /*!
-   * To compute the index of the left son.
+   * To compute the index of the smallest son.
    * \param i position of the node.
-   * \pre \c i is a legal position
-   * \post returns a legal position.
-   * \return the index (in the array) of the right son of the node (indicated by index i). 
+   * \pre \c i has at least one son.
+   * \return the index (in the array) of the son holding the smallest value (the first one in case of equality). 
    */
-  unsigned int get_pos_right_son(unsigned int i)const {
-    assert(i<nb_elem);
-    return 2*i+2;
+  unsigned int get_pos_min_son(unsigned int i)const {
+    unsigned int son=get_pos_first_son(i);
+    assert(son<nb_elem);
+    unsigned int const last=(son+D<nb_elem) ? son+D : nb_elem;
+    unsigned int min=son;
+    for(son++;son<last;son++){
+      if(lt(son,min)) min=son;
+    }
+    return min;
   } ;
   
   /*!
@@ -132,51 +144,68 @@ private :
    * \param i position of the node.
    * \pre \c i is a legal position.
    * \post returns a legal position.
-   * \return the index (in the array) of the right son of the node (indicated by index i), except for the root (it returns 0). 
+   * \return the index (in the array) of the father of the node (indicated by index i), except for the root (it returns 0). 
    */
   unsigned int get_pos_father(unsigned int i)const {
-    assert(i<nb_elem-2);
-    return (i-1)/2;
+    assert(i<=nb_elem);
+    return (i-1)/D;
   } ;
 
 
   /*!
-   * Exchange two elements in the array. 
-   * \param pos_a position of one node.
-   * \param pos_b position of other node.
-   * \param i position of the node.
-   * \pre \c pos_a and \c pos_b are legal positions.
+   * Put a node in the array and record its position.
+   * \param pos position where to put it.
+   * \param n node to put.
+   * \pre \c pos is a legal position.
    */
-  void swap(const unsigned int pos_a, const unsigned int pos_b){
-    assert(pos_a<=nb_elem);
-  	assert(pos_b<=nb_elem);
-  	Node e=elements[pos_b];
-  	elements[pos_b]=elements[pos_a];
-  	elements[pos_a]=e;  
+  void place(const unsigned int pos, Node const & n){
+    assert(pos<nb_elem);
+    elements[pos]=n;
+    id_to_pos[n.second]=pos;
   }
 
+  /*!
+   * Order on positions, reversed to use the std heap functions as a min-heap (see \c peek_k).
+   */
+  class Greater_Pos {
+    /*! Array of the nodes of the Heap_Id. */
+    Node const * const elements ;
+  public :
+    /*! \param _elements array of the nodes of the Heap_Id. */
+    Greater_Pos(Node const * const _elements) : elements(_elements) {}
+    /*! \return true iff the value at \c pos_1 is GREATER THAN the one at \c pos_2. */
+    bool operator()(unsigned int const pos_1, unsigned int const pos_2) const {
+      return *(elements[pos_2].first)<*(elements[pos_1].first);
+    }
+  } ;
+
   /*! 
    * To check the validity of the head_ip.
    * \return true iff the Heap_Id is correct (each father less than or equal to sons) and indexing array are ok and free index array is ok.
-   * This should to be used in asserts.
+   * This should to be used in asserts: it takes linear time, so push and pop
+   * only check it when \c HEAP_DEBUG is defined.
    */
   bool is_valid () const ;
 
 
   /*! 
-   * Swap the node pos down throughout the Heap_Id till consistency is restored.
+   * Move the node pos down throughout the Heap_Id till consistency is restored
+   * (the smallest son is moved up into the "hole" at each level).
    * \param pos position of the node to lower
    * \pre pos is a valid location.
    * \post The Heap_Id is valid.
+   * \return the final position of the node.
    */
-  void lower(unsigned pos);
+  unsigned int lower(unsigned pos);
 
   /*! 
-   * Swap the node pos up throughout the Heap_Id till consistency is restored.
+   * Move the node pos up throughout the Heap_Id till consistency is restored
+   * (the fathers are moved down into the "hole").
    * \pre pos is a valid location.
    * \post The Heap_Id is valid.
+   * \return the final position of the node.
    */
-  void raise(unsigned pos);
+  unsigned int raise(unsigned pos);
 
 
 public :
@@ -190,6 +219,10 @@ public :
   
   Heap_Id(unsigned int _capacity) : capacity(_capacity ), elements(new Node [ _capacity ] ), nb_elem(0 ), id_to_pos(new unsigned int [ _capacity ] ), id_free(new unsigned int [ _capacity ])
   {
+    for(unsigned int i=0;i<capacity;i++){
+      id_free[i]=i;
+      id_to_pos[i]=capacity;
+    }
     assert(is_valid());
   };
 
@@ -200,6 +233,9 @@ public :
   
   /*! Release the arrays. */
   ~Heap_Id () {
+    delete [] elements;
+    delete [] id_to_pos;
+    delete [] id_free;
   }
 
   
@@ -224,25 +260,101 @@ public :
    */
   Element & pop () ;
 
-  // TODO
-  void reposition(const unsigned int id);
+  /*!
+   * \pre The Heap_Id  is not empty.
+   * \return the minimum of the heap (it stays in the heap).
+   */
+  Element & top () const {
+    assert(!is_empty());
+    return *(elements[0].first);
+  }
+
+  /*!
+   * To test whether an id is held by a value in the heap.
+   * \param id an id.
+   * \return true iff \c id was returned by push and its value was not popped since.
+   */
+  bool contains(const unsigned int id) const {
+    return id<capacity && id_to_pos[id]<nb_elem && elements[id_to_pos[id]].second==id;
+  }
+
+  /*!
+   * To access the value of an id.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \return the value (to modify it, call then \c decrease_key or \c update).
+   */
+  Element & get(const unsigned int id) const {
+    assert(contains(id));
+    return *(elements[id_to_pos[id]].first);
+  }
+
+  /*!
+   * Restore the heap after the value of id was decreased (it is raised), in O(log n).
+   * \param id id of a value in the heap.
+   * \pre \c contains(id) and the value did not increase.
+   * \post The Heap_Id  is valid.
+   */
+  void decrease_key(const unsigned int id);
+
+  /*!
+   * Restore the heap after the value of id was changed (it is raised or lowered), in O(log n).
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \post The Heap_Id  is valid.
+   */
+  void update(const unsigned int id);
+
+  /*! Same as \c update. */
+  void reposition(const unsigned int id) {
+    update(id);
+  }
   
 
   /*!
-   * Add a value at the bottom of the tree (first empty cell) and swap it up (raise).
+   * Add a value at the bottom of the tree (first empty cell) and raise it.
    * \param v value to add.
-   * \pre The Heap_Id  is valid.
+   * \pre The Heap_Id  is valid and not full.
    * \post The Heap_Id  is valid.
    * \return The id of inserted value.
    */
   unsigned int push(Element & v);
 
+  /*!
+   * Add all the values of an array; when they are more than the values already in the heap,
+   * the whole array is heapified at once (bottom-up, in linear time) instead of raising each value.
+   * \param values array of the values to add.
+   * \param nbr number of values in \c values.
+   * \param ids if not null, array of size \c nbr receiving the id of each value.
+   * \pre The Heap_Id  is valid and has room for \c nbr more values.
+   * \post The Heap_Id  is valid.
+   */
+  void push_many(Element values [], unsigned int const nbr, unsigned int ids [] = 0);
+
+  /*!
+   * Remove a value from anywhere in the heap, its id is free again.
+   * The last value takes its place and is raised or lowered, in O(log n).
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \post The Heap_Id  is valid.
+   * \return the removed value.
+   */
+  Element & erase(const unsigned int id);
+
+  /*!
+   * To get the k smallest values without removing them, in O(k log k):
+   * the tree is explored best first from the root, the frontier being a heap of positions.
+   * \param k number of values wanted.
+   * \return the ids of the \c k smallest values (all of them if there are fewer), in increasing order of value.
+   */
+  std :: vector<unsigned int> peek_k(unsigned int const k) const;
+
   
   //
   //  FRIENDS
   //
   
-  friend std :: ostream & operator << <Element>(std :: ostream &, Heap_Id <Element> const &);  
+  friend std :: ostream & operator << <Element, D>(std :: ostream &, Heap_Id const &);  
 } ;
 
 
@@ -253,75 +365,168 @@ public :
 //
 
 
-template <class Element>
-bool Heap_Id <Element> :: is_valid () const {
-  if(is_empty() || nb_elem==1 || nb_elem==2) return true; 
-	for(int i=0; i<nb_elem-2;i++){
-		if(elements[i]>elements[get_pos_right_son(i)] || elements[i]>elements[get_pos_left_son(i)]) return false;
-	}
-	return true;
+template <class Element, unsigned int D>
+bool Heap_Id <Element, D> :: is_valid () const {
+  for(unsigned int i=0;i<nb_elem;i++){
+    if(i>0 && lt(i,get_pos_father(i))) return false;
+    if(elements[i].second>=capacity || id_to_pos[elements[i].second]!=i) return false;
+  }
+  // free ids are the ones not in the heap
+  for(unsigned int i=nb_elem;i<capacity;i++){
+    if(id_free[i]>=capacity || contains(id_free[i])) return false;
+  }
+  return true;
+}
+
+
+template <class Element, unsigned int D>
+unsigned int Heap_Id <Element, D> :: lower(unsigned int pos){
+  assert(pos<nb_elem);
+  COUNTER_ADD("Heap_Id::lower");
+  Node const moved=elements[pos];
+  unsigned int son;
+  while((son=get_pos_first_son(pos))<nb_elem){
+    son=get_pos_min_son(pos);
+    if(!(*(elements[son].first)<*(moved.first))) break;
+    place(pos,elements[son]);
+    pos=son;
+  }
+  place(pos,moved);
+  return pos;
+}
+
+
+template <class Element, unsigned int D>
+unsigned int Heap_Id <Element, D> :: push(Element & v){
+  assert(nb_elem<capacity);
+  Node const n(&v,id_free[nb_elem]);
+  nb_elem++;
+  place(nb_elem-1,n);
+  raise(nb_elem-1);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return n.second;
 }
 
 
-template <class Element>
-void Heap_Id <Element> :: lower(unsigned int pos){
-  while(get_pos_right_son(pos)<nb_elem && get_pos_left_son(pos)<nb_elem && (*(elements[pos]) > *(elements[get_pos_left_son(pos)]) || *(elements[pos]) >*(elements[get_pos_right_son(pos)]))){
-		if( le(get_pos_left_son(pos),get_pos_right_son(pos))){
-			swap(pos,get_pos_left_son(pos));
-			pos=get_pos_left_son(pos);
-		}
-		else{
-			 swap(pos,get_pos_right_son(pos));
-			 pos=get_pos_right_son(pos);
-    }  
+template <class Element, unsigned int D>
+void Heap_Id <Element, D> :: push_many(Element values [], unsigned int const nbr, unsigned int ids []){
+  assert(nbr<=capacity-nb_elem);
+  unsigned int const old_nb_elem=nb_elem;
+  for(unsigned int i=0;i<nbr;i++){
+    Node const n(&values[i],id_free[nb_elem]);
+    nb_elem++;
+    place(nb_elem-1,n);
+    if(0!=ids) ids[i]=n.second;
   }
-  if( get_pos_left_son(pos)==nb_elem-1 && lt(get_pos_left_son(pos),pos)){
-    swap(pos,get_pos_left_son(pos));
+  if(nbr>old_nb_elem){
+    // every node with a son, from the last one up to the root
+    for(unsigned int pos=(nb_elem>1) ? get_pos_father(nb_elem-1)+1 : 0;pos>0;pos--){
+      lower(pos-1);
+    }
+  }else{
+    for(unsigned int pos=old_nb_elem;pos<nb_elem;pos++){
+      raise(pos);
+    }
   }
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+}
 
+
+template <class Element, unsigned int D>
+Element & Heap_Id <Element, D> :: erase(const unsigned int id){
+  assert(contains(id));
+  unsigned int const pos=id_to_pos[id];
+  Node const removed=elements[pos];
+  nb_elem--;
+  id_free[nb_elem]=id;
+  if(pos<nb_elem){
+    place(pos,elements[nb_elem]);
+    if(raise(pos)==pos) lower(pos);
+  }
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return *(removed.first);
 }
 
 
-template <class Element>
-unsigned int Heap_Id <Element> :: push(Element & v){
-  //assert(is_valid());
-	if(is_empty()){
-    elements[nb_elem].first=&v;
-    elements[nb_elem].second=nb_elem;
-		nb_elem++;
-	}
-	else{
-    elements[nb_elem].first=&v;
-    elements[nb_elem].second=nb_elem;
-		raise(nb_elem);
-		nb_elem++;
-	}
+template <class Element, unsigned int D>
+std :: vector<unsigned int> Heap_Id <Element, D> :: peek_k(unsigned int const k) const{
+  std :: vector<unsigned int> ids;
+  if(0==k || is_empty()) return ids;
+  ids.reserve(std :: min(k,nb_elem));
+  Greater_Pos const greater(elements);
+  // the smallest value not taken yet is always in the frontier
+  std :: vector<unsigned int> frontier(1,0);
+  while(ids.size()<k && !frontier.empty()){
+    std :: pop_heap(frontier.begin(),frontier.end(),greater);
+    unsigned int const pos=frontier.back();
+    frontier.pop_back();
+    ids.push_back(elements[pos].second);
+    unsigned int const first=get_pos_first_son(pos);
+    for(unsigned int son=first;son<first+D && son<nb_elem;son++){
+      frontier.push_back(son);
+      std :: push_heap(frontier.begin(),frontier.end(),greater);
+    }
+  }
+  return ids;
 }
 
 
-template <class Element>
-void Heap_Id <Element> :: raise(unsigned int pos){
-  assert(pos<=nb_elem);
-	while(pos>0 && *(elements[pos]) < *(elements[get_pos_father(pos)])){
-		swap(pos,get_pos_father(pos));
-		pos=get_pos_father(pos);
-	
-	}
+template <class Element, unsigned int D>
+unsigned int Heap_Id <Element, D> :: raise(unsigned int pos){
+  assert(pos<nb_elem);
+  COUNTER_ADD("Heap_Id::raise");
+  Node const moved=elements[pos];
+  while(pos>0 && *(moved.first)<*(elements[get_pos_father(pos)].first)){
+    place(pos,elements[get_pos_father(pos)]);
+    pos=get_pos_father(pos);
+  }
+  place(pos,moved);
+  return pos;
+}
+
+
+template <class Element, unsigned int D>
+Element & Heap_Id <Element, D> :: pop () {
+  assert(!is_empty());
+  Node const min=elements[0];
+  nb_elem--;
+  // the id of the minimum is free again
+  id_free[nb_elem]=min.second;
+  if(nb_elem>0){
+    place(0,elements[nb_elem]);
+    lower(0);
+  }
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return *(min.first);
 }
 
 
-template <class Element>
-Element & Heap_Id <Element> :: pop () {
-  Node min=elements[0];
-	elements[0]=elements[nb_elem-1];
-	nb_elem--;
-	if(nb_elem>2) lower(0);
-	return *min;
+template <class Element, unsigned int D>
+void Heap_Id <Element, D> :: decrease_key(const unsigned int id){
+  assert(contains(id));
+  raise(id_to_pos[id]);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
 }
 
 
-template <class Element>
-void Heap_Id <Element> :: reposition(const unsigned int id){
+template <class Element, unsigned int D>
+void Heap_Id <Element, D> :: update(const unsigned int id){
+  assert(contains(id));
+  unsigned int const pos=id_to_pos[id];
+  if(raise(pos)==pos) lower(pos);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
 }
 
 
@@ -331,13 +536,14 @@ void Heap_Id <Element> :: reposition(const unsigned int id){
  * \param h Heap_Id to output
  * \return the ostream
  */
-template <class Element>
-std :: ostream & operator <<(std :: ostream & out, Heap_Id <Element> const & h){
+template <class Element, unsigned int D>
+std :: ostream & operator <<(std :: ostream & out, Heap_Id <Element, D> const & h){
   out<<"[ ";
-	for(int i=0;i<h.nb_elem-1;i++){
-		out<<*((h.elements)[i])<<" , ";
+  for(unsigned int i=0;i<h.nb_elem;i++){
+    if(i>0) out<<" , ";
+    out<<*((h.elements)[i].first);
   }
-	out<<*((h.elements)[h.nb_elem-1])<<" ]";
+  out<<" ]";
   return out;
 }
 
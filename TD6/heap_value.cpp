@@ -0,0 +1,4 @@
+# include "heap_value.hpp"
+
+
+/* Nothing non TEMPLATE  -> EMPTY  */
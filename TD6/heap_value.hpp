@@ -0,0 +1,323 @@
+# ifndef __HEAP_VALUE_HPP_
+# define __HEAP_VALUE_HPP_
+
+/*!
+ * \file
+ * \brief This module provide a generic (template) heap holding copies of the elements.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <iostream>
+
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+
+// Pre-declaration to be able to declare operator <<
+template <class Element>
+class Heap_Value;
+
+
+// Pre-declaration to declare friend after
+template <class Element>
+std :: ostream & operator <<(std :: ostream & out, Heap_Value <Element> const & h);
+
+
+/*!
+ * \brief This class implements a generic heap storing the elements by value.
+ *
+ * It uses a binary tree such that the value held in any node is greater (or equal) to the value in its sons.
+ *
+ * \pre \c Element must be comparable: operator < must be defined.
+ * \pre \c Element must be default constructible and copyable.
+ *
+ * Implementation:
+ * \li the tree is folded into an array that holds the elements themselves,
+ *  so that sifting only reads the array (no pointer is followed);
+ * \li the array is doubled when full;
+ * \li sifting moves a "hole" and writes the sifted element once, at its final place.
+ *
+ * To be used for small elements (\c int, small structures…) where copies are cheap.
+ */
+template <class Element>
+class Heap_Value {
+
+  /*! Allocated size of the array. */
+  unsigned int capacity;
+
+  /*! Array of size capacity.
+    The array holds the values. */
+  Element* elements;
+
+  /*! Number of values in the heap.
+   * It is always at most the capacity. */
+  unsigned int nb_elem;
+
+  /*!
+   * To compute the index of the father.
+   * \param i position of the node.
+   * \pre \c i is a legal position, not the root.
+   * \return the index (in the array) of the father of the node (indicated by index i).
+   */
+  static unsigned int get_pos_father(const unsigned int i) {
+    assert(i>0);
+    return (i-1)/2;
+  }
+
+  /*!
+   * Double the capacity of the array.
+   */
+  void grow();
+
+  /*!
+   * Move the hole at pos down till v can be put in it.
+   * \param pos position of the hole.
+   * \param v value to put in the hole.
+   * \post The heap is valid.
+   */
+  void lower(unsigned int pos, Element const & v);
+
+  /*!
+   * Move the hole at pos up till v can be put in it.
+   * \param pos position of the hole.
+   * \param v value to put in the hole.
+   * \post The heap is valid.
+   */
+  void raise(unsigned int pos, Element const & v);
+
+  /*!
+   * Restore the heap property on the whole array by lowering every inner node,
+   * from the last one to the root (Floyd's heapify, linear time).
+   */
+  void heapify();
+
+
+public :
+
+
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*! Build an empty heap with given initial capacity. */
+  Heap_Value(unsigned int _capacity = 16)
+    : capacity(_capacity > 0 ? _capacity : 1)
+    , elements(new Element [ capacity ])
+    , nb_elem(0)
+  {}
+
+  /*!
+   * Build a heap holding copies of the elements of [first,last), in linear time.
+   * \param first,last range of values of type \c Element (input iterators).
+   */
+  template <class Iterator>
+  Heap_Value(Iterator first, Iterator last)
+    : capacity(16)
+    , elements(new Element [ capacity ])
+    , nb_elem(0)
+  {
+    assign(first,last);
+  }
+
+  /*! Copy constructor (copies the values). */
+  Heap_Value(Heap_Value const & h)
+    : capacity(h.capacity)
+    , elements(new Element [ h.capacity ])
+    , nb_elem(h.nb_elem)
+  {
+    for(unsigned int i=0;i<nb_elem;i++) elements[i]=h.elements[i];
+  }
+
+  /*! Assignment (copies the values). */
+  Heap_Value & operator = (Heap_Value const & h) {
+    if(this!=&h){
+      Element* e=new Element [ h.capacity ];
+      for(unsigned int i=0;i<h.nb_elem;i++) e[i]=h.elements[i];
+      delete [] elements;
+      elements=e;
+      capacity=h.capacity;
+      nb_elem=h.nb_elem;
+    }
+    return *this;
+  }
+
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the array. */
+  ~Heap_Value () {
+    delete [] elements;
+  }
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To test the emptyness of the heap.
+   * \return true iff the heap is empty
+   */
+  bool is_empty () const {
+    return(nb_elem==0);
+  }
+
+  /*! \return the number of values in the heap. */
+  unsigned int size () const {
+    return nb_elem;
+  }
+
+  /*!
+   * \pre The heap is not empty.
+   * \return the minimum of the heap (it stays in the heap).
+   */
+  Element const & top () const {
+    assert(!is_empty());
+    return elements[0];
+  }
+
+  /*!
+   * Remove and return the root of the heap.
+   * The heap is re equilibrated by lowering the last element from the root.
+   * \pre The heap is not empty.
+   * \post The heap is valid.
+   * \return a copy of the minimum of the heap.
+   */
+  Element pop();
+
+  /*!
+   * Replace the content of the heap by copies of the elements of [first,last).
+   * The array is filled then heapified, in linear time (instead of n push).
+   * \param first,last range of values of type \c Element (input iterators).
+   * \post The heap is valid.
+   */
+  template <class Iterator>
+  void assign(Iterator first, Iterator last);
+
+  /*!
+   * Add a copy of v at the bottom of the tree (first empty cell) and raise it.
+   * The array grows if needed.
+   * \param v value to add.
+   * \post The heap is valid.
+   */
+  void push(Element const & v);
+
+
+  //
+  //  FRIENDS
+  //
+
+  friend std :: ostream & operator << <Element>(std :: ostream &, Heap_Value const &);
+
+};
+
+
+
+//
+// TEMPLATE
+// => METHODS MUST BE HERE
+//
+
+
+template <class Element>
+void Heap_Value <Element> :: grow() {
+  Element* e=new Element [ 2*capacity ];
+  for(unsigned int i=0;i<nb_elem;i++) e[i]=elements[i];
+  delete [] elements;
+  elements=e;
+  capacity*=2;
+}
+
+
+template <class Element>
+void Heap_Value <Element> :: lower(unsigned int pos, Element const & v) {
+  assert(pos<nb_elem);
+  unsigned int son;
+  while((son=2*pos+1)<nb_elem){
+    // smaller son, left one in case of equality
+    if(son+1<nb_elem && elements[son+1]<elements[son]) son++;
+    if(!(elements[son]<v)) break;
+    elements[pos]=elements[son];
+    pos=son;
+  }
+  elements[pos]=v;
+}
+
+
+template <class Element>
+void Heap_Value <Element> :: raise(unsigned int pos, Element const & v) {
+  assert(pos<nb_elem);
+  while(pos>0 && v<elements[get_pos_father(pos)]){
+    elements[pos]=elements[get_pos_father(pos)];
+    pos=get_pos_father(pos);
+  }
+  elements[pos]=v;
+}
+
+
+template <class Element>
+void Heap_Value <Element> :: heapify() {
+  for(unsigned int i=nb_elem/2;i>0;i--){
+    Element const v=elements[i-1];
+    lower(i-1,v);
+  }
+}
+
+
+template <class Element>
+template <class Iterator>
+void Heap_Value <Element> :: assign(Iterator first, Iterator last) {
+  nb_elem=0;
+  for(Iterator it=first;it!=last;++it){
+    if(nb_elem==capacity) grow();
+    elements[nb_elem++]=*it;
+  }
+  heapify();
+}
+
+
+template <class Element>
+void Heap_Value <Element> :: push(Element const & v) {
+  // v may be in the array, which is moved by grow and overwritten by raise
+  Element const e=v;
+  if(nb_elem==capacity) grow();
+  nb_elem++;
+  raise(nb_elem-1,e);
+}
+
+
+template <class Element>
+Element Heap_Value <Element> :: pop() {
+  assert(!is_empty());
+  Element min=elements[0];
+  nb_elem--;
+  if(nb_elem>0) lower(0,elements[nb_elem]);
+  return min;
+}
+
+
+/*! Print the heap on the \c ostream as an array with the format:
+ * \verbatim [ e0 , e1 , ... , en ] \endverbatim
+ * \param out \c ostream to output to.
+ * \param h Heap_Value to output
+ * \return the ostream
+ */
+template <class Element> std :: ostream & operator <<(std :: ostream & out, Heap_Value<Element> const & h) {
+  out<<"[ ";
+  for(unsigned int i=0;i<h.nb_elem;i++){
+    if(i>0) out<<" , ";
+    out<<h.elements[i];
+  }
+  out<<" ]";
+  return out;
+}
+
+
+# endif
@@ -0,0 +1,4 @@
+# include "multi_queue.hpp"
+
+
+/* Nothing non TEMPLATE  -> EMPTY  */
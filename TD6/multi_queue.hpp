@@ -0,0 +1,239 @@
+# ifndef __MULTI_QUEUE_HPP_
+# define __MULTI_QUEUE_HPP_
+
+/*!
+ * \file
+ * \brief This module provide a generic (template) concurrent priority queue made of several heaps (a "MultiQueue").
+ *
+ * Many threads may push and pop at the same time: each heap (shard) has its own lock,
+ * so that threads working on different shards do not wait for one another.
+ * The order is relaxed: \c pop returns one of the smallest values, not always the minimum.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+# include <algorithm> // swap
+# include <pthread.h>
+
+# include "heap.hpp"
+
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * To draw a shard at random, without any shared state between the threads
+ * (xorshift generator, one state per thread).
+ * \param n number of shards.
+ * \pre \c n is positive.
+ * \return a random number in [ 0 , n ).
+ */
+inline unsigned int multi_queue_random(unsigned int const n) {
+  static __thread unsigned int state = 0;
+  if(0==state){
+    // seeded by the address of the state, that differs from one thread to another
+    state=(unsigned int)(((unsigned long)&state)>>4)*2654435761u|1u;
+  }
+  state^=state<<13;
+  state^=state>>17;
+  state^=state<<5;
+  return state%n;
+}
+
+
+/*!
+ * \brief This class implements a concurrent priority queue as a set of heaps with a lock each.
+ *
+ * \li \c push puts the value in a random shard.
+ * \li \c pop locks two random shards and takes the smaller of their minima.
+ * It only scans all the shards when both are empty.
+ *
+ * With \c nbr_shards a small multiple of the number of threads (2 to 4 per thread),
+ * the locks are seldom contended and the values popped stay among the
+ * few (about \c nbr_shards) smallest ones.
+ * With one shard it is an ordinary heap behind one lock.
+ *
+ * \pre \c Element must be comparable: operators < and <= must be defined.
+ * \pre \c D is at least 2 (arity of the heaps, see \c Heap).
+ *
+ * Implementation:
+ * \li two shards are always locked in increasing order (no deadlock).
+ * \li the number of values is kept with atomic operations, so that \c is_empty does not lock.
+ * \li reference / pointers are used to store elements (i.e. no copy is made)
+ */
+template <class Element, unsigned int D = 4>
+class Multi_Queue {
+
+public :
+
+  /*! Number of heaps (and locks). */
+  unsigned int const nbr_shards ;
+
+private :
+
+  /*! The heaps, \c nbr_shards of them. */
+  std :: vector<Heap<Element, D> *> shards ;
+
+  /*! The locks of the heaps, array of size \c nbr_shards. */
+  pthread_mutex_t * const locks ;
+
+  /*! Number of values in all the heaps (updated atomically). */
+  unsigned int nb_elem ;
+
+  /*! Multi_Queue is not copyable (neither are the heaps and the locks). */
+  Multi_Queue(Multi_Queue const &);
+  Multi_Queue & operator = (Multi_Queue const &);
+
+  /*!
+   * Pop from shard \c s and update the count.
+   * \pre The lock of shard \c s is held and the shard is not empty.
+   * \return the popped value.
+   */
+  Element * pop_shard(unsigned int const s);
+
+
+public :
+
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*!
+   * Build an empty Multi_Queue.
+   * \param _nbr_shards number of heaps (if 0 then 1).
+   * \param capacity initial capacity of each heap (they grow when needed).
+   */
+  Multi_Queue(unsigned int const _nbr_shards, unsigned int const capacity = 16)
+    : nbr_shards(_nbr_shards > 0 ? _nbr_shards : 1)
+    , shards(nbr_shards)
+    , locks(new pthread_mutex_t [ nbr_shards ])
+    , nb_elem(0)
+  {
+    for(unsigned int s=0;s<nbr_shards;s++){
+      shards[s]=new Heap<Element, D> (capacity);
+      pthread_mutex_init(&locks[s],0);
+    }
+  }
+
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the heaps and the locks. */
+  ~Multi_Queue() {
+    for(unsigned int s=0;s<nbr_shards;s++){
+      delete shards[s];
+      pthread_mutex_destroy(&locks[s]);
+    }
+    delete [] locks;
+  }
+
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To test the emptyness of the queue (without locking: other threads may change it just after).
+   * \return true iff the Multi_Queue is empty
+   */
+  bool is_empty() const {
+    return 0==__sync_add_and_fetch(const_cast<unsigned int *>(&nb_elem),0);
+  }
+
+  /*! \return the number of values (without locking, as \c is_empty). */
+  unsigned int size() const {
+    return __sync_add_and_fetch(const_cast<unsigned int *>(&nb_elem),0);
+  }
+
+  /*!
+   * Add a value to a random shard.
+   * May be called by many threads at the same time.
+   * \param v value to add.
+   */
+  void push(Element & v);
+
+  /*!
+   * Remove and return one of the smallest values: the smaller of the minima of two random shards.
+   * May be called by many threads at the same time.
+   * \return a pointer to the value, null if every shard was found empty.
+   */
+  Element * try_pop();
+
+  /*!
+   * Same as \c try_pop for a queue known not to be empty.
+   * \pre The Multi_Queue is not empty (and no other thread empties it meanwhile).
+   * \return one of the smallest values.
+   */
+  Element & pop() {
+    Element * const e=try_pop();
+    assert(0!=e);
+    return *e;
+  }
+} ;
+
+
+
+//
+// TEMPLATE
+// => METHODS MUST BE HERE
+//
+
+
+template <class Element, unsigned int D>
+void Multi_Queue <Element, D> :: push(Element & v){
+  unsigned int const s=multi_queue_random(nbr_shards);
+  pthread_mutex_lock(&locks[s]);
+  shards[s]->push(v);
+  __sync_add_and_fetch(&nb_elem,1);
+  pthread_mutex_unlock(&locks[s]);
+}
+
+
+template <class Element, unsigned int D>
+Element * Multi_Queue <Element, D> :: pop_shard(unsigned int const s){
+  Element & e=shards[s]->pop();
+  __sync_sub_and_fetch(&nb_elem,1);
+  return &e;
+}
+
+
+template <class Element, unsigned int D>
+Element * Multi_Queue <Element, D> :: try_pop(){
+  if(nbr_shards>1){
+    unsigned int i=multi_queue_random(nbr_shards);
+    unsigned int j=multi_queue_random(nbr_shards-1);
+    // j is another shard than i, and i < j
+    if(j>=i) j++;
+    else std :: swap(i,j);
+    pthread_mutex_lock(&locks[i]);
+    pthread_mutex_lock(&locks[j]);
+    Element * e=0;
+    if(!shards[i]->is_empty() && (shards[j]->is_empty() || shards[i]->top()<=shards[j]->top())){
+      e=pop_shard(i);
+    }else if(!shards[j]->is_empty()){
+      e=pop_shard(j);
+    }
+    pthread_mutex_unlock(&locks[j]);
+    pthread_mutex_unlock(&locks[i]);
+    if(0!=e) return e;
+  }
+  // both were empty: look at every shard
+  for(unsigned int s=0;s<nbr_shards && !is_empty();s++){
+    pthread_mutex_lock(&locks[s]);
+    Element * const e=shards[s]->is_empty() ? 0 : pop_shard(s);
+    pthread_mutex_unlock(&locks[s]);
+    if(0!=e) return e;
+  }
+  return 0;
+}
+
+
+
+# endif
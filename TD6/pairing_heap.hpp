@@ -0,0 +1,431 @@
+# ifndef __PAIRING_HEAP_HPP_
+# define __PAIRING_HEAP_HPP_
+
+/*!
+ * \file
+ * \brief This module provide a generic (template) pairing heap with id,
+ * with the same interface as Heap_Id and a cheaper decrease_key.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <iostream>
+# include <vector>
+
+# include "counters.hpp"
+
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+// Pre-declaration to declare operator <<
+template <class Element>
+class Pairing_Heap ;
+
+
+// Pre-declaration to declare friend after
+template <class Element>
+std :: ostream & operator <<(std :: ostream &, Pairing_Heap <Element> const &);
+
+
+
+/*!
+ * \brief This class implements a pairing heap with id for the elements.
+ *
+ * The heap is a tree where the value of each node is lower than or equal to the ones of its sons.
+ * Two trees are linked in constant time by making the root with the greater value a son of the other root.
+ * \li \c push links a one node tree with the root, in O(1);
+ * \li \c decrease_key cuts the subtree of the node and links it with the root, in O(1)
+ * (O(log n) amortized is the proven bound, constant time is observed in practice);
+ * \li \c pop links the sons of the root by pairs, left to right, then the pairs right to left,
+ * in O(log n) amortized.
+ * On dense graphs, where Dijkstra's algorithm decreases keys far more often than it pops,
+ * it does less work than the D-ary tree of Heap_Id.
+ *
+ * \pre \c Element must be comparable: operators < and <= must be defined.
+ *
+ * Implementation:
+ * \li the nodes are in an array indexed by id: the tree is made of ids (first son, next brother,
+ * and previous: the father for a first son, the previous brother otherwise);
+ * \li \c capacity stands for "no node";
+ * \li the free ids are recorded as in Heap_Id;
+ * \li reference / pointers are used to store elements (i.e. no copy is made).
+ */
+template <class Element>
+class Pairing_Heap {
+
+public :
+
+  /*! Maximal capacity of the Pairing_Heap */
+  const unsigned int capacity ;
+
+private :
+
+  /*! Nature of the nodes: pointer to the element (null when the id is free) and links in the tree. */
+  struct Node {
+    Element * value ;
+    unsigned int son ;
+    unsigned int brother ;
+    unsigned int previous ;
+  } ;
+
+  /*! Array of size capacity, indexed by id. */
+  Node * const nodes ;
+
+  /*! Id of the root (\c capacity if the heap is empty). */
+  unsigned int root ;
+
+  /*! Number of values in the Pairing_Heap. */
+  unsigned int nb_elem ;
+
+  /*! Record the ids, used then free.
+   * Free are in position \c nb_elem to \c capacity -1.
+   */
+  unsigned int * const id_free ;
+
+  /*! Roots of the trees to link by \c link_brothers (kept to avoid an allocation by pop). */
+  std :: vector <unsigned int> trees ;
+
+  /*! Not copyable. */
+  Pairing_Heap(Pairing_Heap const &);
+  Pairing_Heap & operator = (Pairing_Heap const &);
+
+  /*!
+   * Link two trees.
+   * \param a,b roots of two trees (without father nor brother).
+   * \return the root of the tree: the one with the lower value, the other one is its first son.
+   */
+  unsigned int link(unsigned int a, unsigned int b);
+
+  /*!
+   * Take the subtree of \c id out of the tree (it has no father nor brother afterwards).
+   * \pre \c id is in the heap and is not the root.
+   */
+  void cut(unsigned int id);
+
+  /*!
+   * Link a list of brothers into one tree (two passes: by pairs, then right to left).
+   * \param first first of the brothers, or \c capacity.
+   * \return the root of the tree, or \c capacity if there is no brother.
+   */
+  unsigned int link_brothers(unsigned int first);
+
+  /*!
+   * To check the validity of the Pairing_Heap.
+   * \return true iff each father is lower than or equal to its sons, the links are consistent
+   * and ids are ok.
+   * This should to be used in asserts: it takes linear time, so the modifications
+   * only check it when \c HEAP_DEBUG is defined.
+   */
+  bool is_valid () const ;
+
+
+public :
+
+
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*! Build an empty Pairing_Heap with given capacity. */
+  Pairing_Heap(unsigned int _capacity) : capacity(_capacity ), nodes(new Node [ _capacity ] ), root(_capacity ), nb_elem(0 ), id_free(new unsigned int [ _capacity ])
+  {
+    for(unsigned int i=0;i<capacity;i++){
+      id_free[i]=i;
+      nodes[i].value=0;
+    }
+    assert(is_valid());
+  };
+
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Pairing_Heap () {
+    delete [] nodes;
+    delete [] id_free;
+  }
+
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To test the emptyness of the heap.
+   * \return true iff the Pairing_Heap is empty
+   */
+  bool is_empty () const {
+    return(nb_elem==0);
+  }
+
+  /*!
+   * Remove and return the root of the heap; its sons are linked into the new tree.
+   * \pre The Pairing_Heap is not empty.
+   * \post The Pairing_Heap is valid.
+   * \return the minimum of the heap.
+   */
+  Element & pop () ;
+
+  /*!
+   * \pre The Pairing_Heap is not empty.
+   * \return the minimum of the heap (it stays in the heap).
+   */
+  Element & top () const {
+    assert(!is_empty());
+    return *(nodes[root].value);
+  }
+
+  /*!
+   * To test whether an id is held by a value in the heap.
+   * \param id an id.
+   * \return true iff \c id was returned by push and its value was not popped since.
+   */
+  bool contains(const unsigned int id) const {
+    return id<capacity && nodes[id].value!=0;
+  }
+
+  /*!
+   * To access the value of an id.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \return the value (to modify it, call then \c decrease_key or \c update).
+   */
+  Element & get(const unsigned int id) const {
+    assert(contains(id));
+    return *(nodes[id].value);
+  }
+
+  /*!
+   * Restore the heap after the value of id was decreased, in O(1):
+   * its subtree is cut and linked with the root.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id) and the value did not increase.
+   * \post The Pairing_Heap is valid.
+   */
+  void decrease_key(const unsigned int id);
+
+  /*!
+   * Restore the heap after the value of id was changed:
+   * its sons are linked together and with the rest of the tree, then it is linked alone.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \post The Pairing_Heap is valid.
+   */
+  void update(const unsigned int id);
+
+  /*! Same as \c update. */
+  void reposition(const unsigned int id) {
+    update(id);
+  }
+
+  /*!
+   * Add a value as a one node tree linked with the root, in O(1).
+   * \param v value to add.
+   * \pre The Pairing_Heap is not full.
+   * \post The Pairing_Heap is valid.
+   * \return The id of inserted value.
+   */
+  unsigned int push(Element & v);
+
+
+  //
+  //  FRIENDS
+  //
+
+  friend std :: ostream & operator << <Element>(std :: ostream &, Pairing_Heap const &);
+} ;
+
+
+
+//
+// TEMPLATE
+// => METHODS MUST BE HERE
+//
+
+
+template <class Element>
+bool Pairing_Heap <Element> :: is_valid () const {
+  unsigned int n=0;
+  if(root<capacity){
+    if(nodes[root].value==0 || nodes[root].brother!=capacity || nodes[root].previous!=capacity) return false;
+    // depth first, each node checked against its father
+    std :: vector <unsigned int> stack(1,root);
+    while(!stack.empty()){
+      unsigned int const father=stack.back();
+      stack.pop_back();
+      n++;
+      unsigned int previous=father;
+      for(unsigned int s=nodes[father].son;s!=capacity;s=nodes[s].brother){
+	if(s>=capacity || nodes[s].value==0 || nodes[s].previous!=previous) return false;
+	if(*(nodes[s].value)<*(nodes[father].value)) return false;
+	previous=s;
+	stack.push_back(s);
+      }
+    }
+  }
+  if(n!=nb_elem) return false;
+  // free ids are the ones not in the heap
+  for(unsigned int i=nb_elem;i<capacity;i++){
+    if(id_free[i]>=capacity || contains(id_free[i])) return false;
+  }
+  return true;
+}
+
+
+template <class Element>
+unsigned int Pairing_Heap <Element> :: link(unsigned int a, unsigned int b){
+  assert(a<capacity && b<capacity);
+  COUNTER_ADD("Pairing_Heap::link");
+  if(*(nodes[b].value)<*(nodes[a].value)){
+    unsigned int const t=a;
+    a=b;
+    b=t;
+  }
+  // b becomes the first son of a
+  nodes[b].brother=nodes[a].son;
+  if(nodes[b].brother!=capacity) nodes[nodes[b].brother].previous=b;
+  nodes[b].previous=a;
+  nodes[a].son=b;
+  return a;
+}
+
+
+template <class Element>
+void Pairing_Heap <Element> :: cut(unsigned int id){
+  assert(contains(id) && id!=root);
+  unsigned int const previous=nodes[id].previous;
+  unsigned int const brother=nodes[id].brother;
+  if(nodes[previous].son==id) nodes[previous].son=brother;
+  else nodes[previous].brother=brother;
+  if(brother!=capacity) nodes[brother].previous=previous;
+  nodes[id].brother=capacity;
+  nodes[id].previous=capacity;
+}
+
+
+template <class Element>
+unsigned int Pairing_Heap <Element> :: link_brothers(unsigned int first){
+  trees.clear();
+  // left to right, by pairs
+  while(first!=capacity){
+    unsigned int const a=first;
+    unsigned int const b=nodes[a].brother;
+    if(b==capacity){
+      nodes[a].previous=capacity;
+      trees.push_back(a);
+      break;
+    }
+    first=nodes[b].brother;
+    nodes[a].brother=nodes[a].previous=capacity;
+    nodes[b].brother=nodes[b].previous=capacity;
+    trees.push_back(link(a,b));
+  }
+  if(trees.empty()) return capacity;
+  // right to left, each pair linked with the tree built so far
+  unsigned int t=trees.back();
+  for(unsigned int i=trees.size()-1;i>0;i--) t=link(trees[i-1],t);
+  return t;
+}
+
+
+template <class Element>
+unsigned int Pairing_Heap <Element> :: push(Element & v) {
+  assert(nb_elem<capacity);
+  unsigned int const id=id_free[nb_elem];
+  nb_elem++;
+  Node & n=nodes[id];
+  n.value=&v;
+  n.son=n.brother=n.previous=capacity;
+  root=(root==capacity) ? id : link(root,id);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return id;
+}
+
+
+template <class Element>
+Element & Pairing_Heap <Element> :: pop () {
+  assert(!is_empty());
+  unsigned int const min=root;
+  Element & e=*(nodes[min].value);
+  root=link_brothers(nodes[min].son);
+  nodes[min].value=0;
+  nb_elem--;
+  // the id of the minimum is free again
+  id_free[nb_elem]=min;
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return e;
+}
+
+
+template <class Element>
+void Pairing_Heap <Element> :: decrease_key(const unsigned int id){
+  assert(contains(id));
+  if(id!=root){
+    cut(id);
+    root=link(root,id);
+  }
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+}
+
+
+template <class Element>
+void Pairing_Heap <Element> :: update(const unsigned int id){
+  assert(contains(id));
+  // the sons may now be lower than id: they leave as one tree
+  unsigned int const sons=link_brothers(nodes[id].son);
+  nodes[id].son=capacity;
+  if(id==root){
+    root=sons;
+  }else{
+    cut(id);
+    if(sons!=capacity) root=link(root,sons);
+  }
+  root=(root==capacity) ? id : link(root,id);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+}
+
+
+/*! Print the heap on the \c ostream, in depth first order from the root, with the format:
+ * \verbatim [ e0 , e1 , ... , en ] \endverbatim
+ * \param out \c ostream to output to.
+ * \param h Pairing_Heap to output
+ * \return the ostream
+ */
+template <class Element>
+std :: ostream & operator <<(std :: ostream & out, Pairing_Heap <Element> const & h){
+  out<<"[ ";
+  std :: vector <unsigned int> stack;
+  if(h.root<h.capacity) stack.push_back(h.root);
+  bool first=true;
+  while(!stack.empty()){
+    unsigned int const id=stack.back();
+    stack.pop_back();
+    if(!first) out<<" , ";
+    first=false;
+    out<<*(h.nodes[id].value);
+    // the next brother after the whole subtree
+    if(h.nodes[id].brother<h.capacity) stack.push_back(h.nodes[id].brother);
+    if(h.nodes[id].son<h.capacity) stack.push_back(h.nodes[id].son);
+  }
+  out<<" ]";
+  return out;
+}
+
+
+
+# endif
@@ -0,0 +1,378 @@
+# ifndef __RADIX_HEAP_HPP_
+# define __RADIX_HEAP_HPP_
+
+/*!
+ * \file
+ * \brief This module provide a generic (template) monotone radix heap with id,
+ * with the same interface as Heap_Id for elements with (small) integer keys.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <iostream>
+# include <utility> // pair
+# include <vector>
+
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * Key of the elements of a Radix_Heap: \c e.key ().
+ * It is specialized for \c unsigned \c int (the value itself).
+ */
+template <class Element>
+struct Radix_Key {
+  unsigned int operator () (Element const & e) const {
+    return e.key();
+  }
+};
+
+template <>
+struct Radix_Key <unsigned int> {
+  unsigned int operator () (unsigned int const & e) const {
+    return e;
+  }
+};
+
+
+// Pre-declaration to declare operator <<
+template <class Element, class Key = Radix_Key <Element> >
+class Radix_Heap ;
+
+
+// Pre-declaration to declare friend after
+template <class Element, class Key>
+std :: ostream & operator <<(std :: ostream &, Radix_Heap <Element, Key> const &);
+
+
+
+/*!
+ * \brief This class implements a monotone radix heap with id for the elements.
+ *
+ * The key of an element is an \c unsigned \c int given by \c Key.
+ * The heap is monotone: no key may be lower than the last key popped
+ * (as in Dijkstra's algorithm, where the distances popped never decrease).
+ *
+ * Implementation:
+ * \li the elements are in 33 buckets: bucket 0 holds the keys equal to the last key popped,
+ * bucket b > 0 the keys whose highest bit different from the last key popped is bit b - 1;
+ * \li when bucket 0 is empty, the first non empty bucket is emptied into the lower ones
+ * after setting the last key to its minimum; each element goes down at most 32 times,
+ * so push, decrease_key and pop take O(log C) amortized time, C being the range of the keys;
+ * \li auxiliary arrays give the bucket and the position in it for each id;
+ * \li reference / pointers are used to store elements (i.e. no copy is made).
+ */
+template <class Element, class Key>
+class Radix_Heap {
+
+public :
+
+  /*! Maximal capacity of the Radix_Heap */
+  const unsigned int capacity ;
+
+private :
+
+  /*! Number of buckets: one for the last key, one for each bit. */
+  static unsigned int const nb_buckets = 33 ;
+
+  /*! Nature of the nodes: pointers to elements together with an id. */
+  typedef std :: pair<Element*, unsigned int> Node ;
+
+  /*! The buckets. */
+  std :: vector <Node> buckets [ nb_buckets ] ;
+
+  /*! Last key popped (0 at the beginning). */
+  unsigned int last ;
+
+  /*! Number of values in the Radix_Heap. */
+  unsigned int nb_elem ;
+
+  /*! Record the map id to bucket (\c nb_buckets for the free ids). */
+  unsigned int * const id_to_bucket ;
+
+  /*! Record the map id to position in its bucket. */
+  unsigned int * const id_to_pos ;
+
+  /*! Record the ids, used then free.
+   * Free are in position \c nb_elem to \c capacity -1.
+   */
+  unsigned int * const id_free ;
+
+  /*! \return the key of node \c n. */
+  static unsigned int key(Node const & n) {
+    return Key()(*(n.first));
+  }
+
+  /*! \return the bucket for key \c k.
+   * \pre \c k is not lower than \c last. */
+  unsigned int get_bucket(unsigned int k) const {
+    assert(last<=k);
+    return k==last ? 0 : 32-__builtin_clz(k^last);
+  }
+
+  /*! Put \c n at the end of the bucket of its key. */
+  void insert(Node const & n) {
+    unsigned int const b=get_bucket(key(n));
+    id_to_bucket[n.second]=b;
+    id_to_pos[n.second]=buckets[b].size();
+    buckets[b].push_back(n);
+  }
+
+  /*! Remove and return the node of \c id from its bucket (the last one takes its place). */
+  Node remove(unsigned int id) {
+    std :: vector <Node> & b=buckets[id_to_bucket[id]];
+    unsigned int const pos=id_to_pos[id];
+    Node const n=b[pos];
+    b[pos]=b.back();
+    id_to_pos[b[pos].second]=pos;
+    b.pop_back();
+    id_to_bucket[id]=nb_buckets;
+    return n;
+  }
+
+  /*! Make bucket 0 non empty by emptying the first non empty bucket into the lower ones.
+   * \pre The Radix_Heap is not empty. */
+  void fill_first_bucket();
+
+  /*! Not copyable. */
+  Radix_Heap(Radix_Heap const &);
+  Radix_Heap & operator = (Radix_Heap const &);
+
+  /*!
+   * To check the validity of the Radix_Heap.
+   * \return true iff every node is in the bucket of its key and ids are consistent.
+   */
+  bool is_valid () const ;
+
+
+public :
+
+
+  //
+  //  CONSTRUCTOR
+  //
+
+  /*! Build an empty Radix_Heap with given capacity. */
+  Radix_Heap(unsigned int _capacity) : capacity(_capacity ), last(0), nb_elem(0 ), id_to_bucket(new unsigned int [ _capacity ] ), id_to_pos(new unsigned int [ _capacity ] ), id_free(new unsigned int [ _capacity ])
+  {
+    for(unsigned int i=0;i<capacity;i++){
+      id_free[i]=i;
+      id_to_bucket[i]=nb_buckets;
+    }
+    assert(is_valid());
+  };
+
+
+  //
+  //  DESTRUCTOR
+  //
+
+  /*! Release the arrays. */
+  ~Radix_Heap () {
+    delete [] id_to_bucket;
+    delete [] id_to_pos;
+    delete [] id_free;
+  }
+
+
+  //
+  //  PUBLIC METHODS
+  //
+
+  /*!
+   * To test the emptyness of the heap.
+   * \return true iff the Radix_Heap is empty
+   */
+  bool is_empty () const {
+    return(nb_elem==0);
+  }
+
+  /*!
+   * Remove and return an element of minimal key.
+   * \pre The Radix_Heap is not empty.
+   * \return the minimum of the heap.
+   */
+  Element & pop () ;
+
+  /*!
+   * \pre The Radix_Heap is not empty.
+   * \return an element of minimal key, the one \c pop returns (it stays in the heap).
+   */
+  Element & top () {
+    fill_first_bucket();
+    return *(buckets[0].back().first);
+  }
+
+  /*!
+   * To test whether an id is held by a value in the heap.
+   * \param id an id.
+   * \return true iff \c id was returned by push and its value was not popped since.
+   */
+  bool contains(const unsigned int id) const {
+    return id<capacity && id_to_bucket[id]<nb_buckets;
+  }
+
+  /*!
+   * To access the value of an id.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id).
+   * \return the value (to modify it, call then \c decrease_key or \c update).
+   */
+  Element & get(const unsigned int id) const {
+    assert(contains(id));
+    return *(buckets[id_to_bucket[id]][id_to_pos[id]].first);
+  }
+
+  /*!
+   * To be called after the key of the value of \c id was decreased.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id), the new key is not lower than the last key popped.
+   */
+  void decrease_key(const unsigned int id) {
+    update(id);
+  }
+
+  /*!
+   * To be called after the key of the value of \c id was changed.
+   * \param id id of a value in the heap.
+   * \pre \c contains(id), the new key is not lower than the last key popped.
+   */
+  void update(const unsigned int id);
+
+  /*! Same as \c update. */
+  void reposition(const unsigned int id) {
+    update(id);
+  }
+
+  /*!
+   * Add a value and return its id.
+   * \param v value to add.
+   * \pre The Radix_Heap is not full, the key of \c v is not lower than the last key popped.
+   * \return the id for \c v, valid till it is popped.
+   */
+  unsigned int push(Element & v);
+
+
+  //
+  //  FRIENDS
+  //
+
+  friend std :: ostream & operator << <Element, Key>(std :: ostream &, Radix_Heap const &);
+} ;
+
+
+
+//
+// TEMPLATE
+// => METHODS MUST BE HERE
+//
+
+
+template <class Element, class Key>
+bool Radix_Heap <Element, Key> :: is_valid () const {
+  unsigned int n=0;
+  for(unsigned int b=0;b<nb_buckets;b++){
+    for(unsigned int pos=0;pos<buckets[b].size();pos++){
+      unsigned int const id=buckets[b][pos].second;
+      if(id>=capacity || id_to_bucket[id]!=b || id_to_pos[id]!=pos) return false;
+      if(key(buckets[b][pos])<last || get_bucket(key(buckets[b][pos]))!=b) return false;
+      n++;
+    }
+  }
+  if(n!=nb_elem) return false;
+  // free ids are the ones not in the heap
+  for(unsigned int i=nb_elem;i<capacity;i++){
+    if(id_free[i]>=capacity || contains(id_free[i])) return false;
+  }
+  return true;
+}
+
+
+template <class Element, class Key>
+void Radix_Heap <Element, Key> :: fill_first_bucket () {
+  assert(!is_empty());
+  if(!buckets[0].empty()) return;
+  unsigned int b=1;
+  while(buckets[b].empty()) b++;
+  std :: vector <Node> & full=buckets[b];
+  unsigned int min=key(full[0]);
+  for(unsigned int pos=1;pos<full.size();pos++){
+    if(key(full[pos])<min) min=key(full[pos]);
+  }
+  last=min;
+  // all the keys of the bucket now differ from last at a lower bit
+  std :: vector <Node> moved;
+  moved.swap(full);
+  for(unsigned int pos=0;pos<moved.size();pos++) insert(moved[pos]);
+  // keep the memory of the bucket
+  moved.clear();
+  full.swap(moved);
+}
+
+
+template <class Element, class Key>
+unsigned int Radix_Heap <Element, Key> :: push(Element & v) {
+  assert(nb_elem<capacity);
+  Node const n(&v,id_free[nb_elem]);
+  nb_elem++;
+  insert(n);
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return n.second;
+}
+
+
+template <class Element, class Key>
+Element & Radix_Heap <Element, Key> :: pop () {
+  fill_first_bucket();
+  Node const min=remove(buckets[0].back().second);
+  nb_elem--;
+  // the id of the minimum is free again
+  id_free[nb_elem]=min.second;
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+  return *(min.first);
+}
+
+
+template <class Element, class Key>
+void Radix_Heap <Element, Key> :: update(const unsigned int id){
+  assert(contains(id));
+  if(get_bucket(Key()(get(id)))!=id_to_bucket[id]) insert(remove(id));
+# ifdef HEAP_DEBUG
+  assert(is_valid());
+# endif
+}
+
+
+/*! Print the heap on the \c ostream, bucket after bucket, with the format:
+ * \verbatim [ e0 , e1 , ... , en ] \endverbatim
+ * \param out \c ostream to output to.
+ * \param h Radix_Heap to output
+ * \return the ostream
+ */
+template <class Element, class Key>
+std :: ostream & operator <<(std :: ostream & out, Radix_Heap <Element, Key> const & h){
+  out<<"[ ";
+  bool first=true;
+  for(unsigned int b=0;b<h.nb_buckets;b++){
+    for(unsigned int pos=0;pos<h.buckets[b].size();pos++){
+      if(!first) out<<" , ";
+      first=false;
+      out<<*(h.buckets[b][pos].first);
+    }
+  }
+  out<<" ]";
+  return out;
+}
+
+
+
+# endif
@@ -1,11 +1,49 @@
 /*! 
  * \file
- * \brief Test file: constructs a graph and call print_dijkstra on it.
+ * \brief Test file: constructs a graph and call print_dijkstra, shortest_paths, the point to point and the parallel searches on it,
+ * its minimum spanning trees and connected components, then writes it in a file and maps it back.
  */
 
+# include <cstdio>
+
 # include "graph.hpp"
 
 
+namespace {
+
+  /*! Admissible heuristic for A*: half the exact distance to the target. */
+  class Half_Distance : public Graph :: Heuristic {
+    Graph :: Shortest_Paths const & exact ;
+  public :
+    Half_Distance ( Graph :: Shortest_Paths const & _exact )
+      : exact ( _exact )
+    {}
+    float operator () ( unsigned int k ) const {
+      return exact . distance [ k ] / 2 ;
+    }
+  } ;
+
+  /*! Print the edges of a spanning tree and its total length. */
+  void print_tree ( std :: vector < Graph :: Tree_Edge > const & tree ) {
+    float total = 0 ;
+    for ( unsigned int k = 0 ; k < tree . size () ; k ++ ) {
+      std :: cout << tree [ k ] . i << "-" << tree [ k ] . j << " " << tree [ k ] . len << " " ;
+      total += tree [ k ] . len ;
+    }
+    std :: cout << ": " << tree . size () << " edges , length " << total << std :: endl ;
+  }
+
+  /*! Estimate 0 everywhere: A* is then Dijkstra stopped at the target. */
+  class Zero : public Graph :: Heuristic {
+  public :
+    float operator () ( unsigned int ) const {
+      return 0 ;
+    }
+  } ;
+
+}
+
+
 int main () {
 
   // 10 vertices
@@ -33,5 +71,97 @@ int main () {
   g . add_edge ( 8 , 9 , 4.0 ) ;
 
   g . print_dijkstra ( 0 , 9 ) ;
+
+  // one run answers all the targets
+  Graph :: Shortest_Paths const sp = g . shortest_paths ( 0 ) ;
+  for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+    std :: cout << k << " " << sp . distance [ k ] << " " << sp . predecessor [ k ] << std :: endl ;
+  }
+  g . print_path ( sp , 6 ) ;
+
+  // the lengths are integers: the radix heap gives the same distances
+  std :: cout << "radix heap" << std :: endl ;
+  Graph :: Shortest_Paths const sr = g . shortest_paths < Graph :: radix_queue > ( 0 ) ;
+  for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+    std :: cout << sr . distance [ k ] << " " ;
+  }
+  std :: cout << std :: endl ;
+
+  // so does the pairing heap
+  std :: cout << "pairing heap" << std :: endl ;
+  Graph :: Shortest_Paths const spa = g . shortest_paths < Graph :: pairing_queue > ( 0 ) ;
+  for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+    std :: cout << spa . distance [ k ] << " " ;
+  }
+  std :: cout << std :: endl ;
+
+  // point to point searches give the same paths
+  std :: cout << "bidirectional" << std :: endl ;
+  g . print_path ( g . shortest_path_bidirectional ( 0 , 9 ) , 9 ) ;
+  g . print_path ( g . shortest_path_bidirectional ( 6 , 6 ) , 6 ) ;
+  std :: cout << "A*" << std :: endl ;
+  g . print_path ( g . shortest_path_a_star ( 0 , 9 , Zero () ) , 9 ) ;
+  Graph :: Shortest_Paths const to_9 = g . shortest_paths ( 9 ) ;
+  Half_Distance const h ( to_9 ) ;
+  g . print_path ( g . shortest_path_a_star ( 0 , 9 , h ) , 9 ) ;
+
+  // parallel searches give the same distances
+  std :: cout << "delta-stepping" << std :: endl ;
+  for ( unsigned int nbr_threads = 1 ; nbr_threads <= 4 ; nbr_threads *= 2 ) {
+    Graph :: Shortest_Paths const ds = g . shortest_paths_delta_stepping ( 0 , 3.0 , nbr_threads ) ;
+    for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+      std :: cout << ds . distance [ k ] << " " ;
+    }
+    std :: cout << std :: endl ;
+  }
+  std :: cout << "multi-source" << std :: endl ;
+  std :: vector < unsigned int > sources ;
+  for ( unsigned int k = 0 ; k < g . nbr_vertices ; k ++ ) {
+    sources . push_back ( k ) ;
+  }
+  std :: vector < Graph :: Shortest_Paths > const all = g . shortest_paths ( sources , 3 ) ;
+  for ( unsigned int k = 0 ; k < all . size () ; k ++ ) {
+    std :: cout << all [ k ] . source << " :" ;
+    for ( unsigned int l = 0 ; l < g . nbr_vertices ; l ++ ) {
+      std :: cout << " " << all [ k ] . distance [ l ] ;
+    }
+    std :: cout << std :: endl ;
+  }
+
+  // the two minimum spanning trees have the same length
+  std :: cout << "Prim" << std :: endl ;
+  print_tree ( g . minimum_spanning_tree_prim () ) ;
+  std :: cout << "Kruskal" << std :: endl ;
+  print_tree ( g . minimum_spanning_tree_kruskal () ) ;
+
+  // a forest: 3 components, one of them a single vertex
+  std :: cout << "components" << std :: endl ;
+  Graph f ( 7 ) ;
+  f . add_edge ( 0 , 4 , 1.0 ) ;
+  f . add_edge ( 1 , 2 , 5.0 ) ;
+  f . add_edge ( 2 , 3 , 2.0 ) ;
+  f . add_edge ( 1 , 3 , 1.0 ) ;
+  f . add_edge ( 4 , 6 , 3.0 ) ;
+  std :: vector < unsigned int > component ;
+  std :: cout << f . connected_components ( component ) << " :" ;
+  for ( unsigned int k = 0 ; k < f . nbr_vertices ; k ++ ) {
+    std :: cout << " " << component [ k ] ;
+  }
+  std :: cout << std :: endl ;
+  print_tree ( f . minimum_spanning_tree_prim () ) ;
+  print_tree ( f . minimum_spanning_tree_kruskal () ) ;
+
+  // the same graph written and mapped back
+  std :: cout << "file" << std :: endl ;
+  char const * const file = "test_graph.bin" ;
+  assert ( g . save ( file ) ) ;
+  Graph * const l = Graph :: load ( file ) ;
+  assert ( l != 0 ) ;
+  assert ( l -> is_read_only () ) ;
+  std :: cout << l -> nbr_vertices << " vertices " << l -> nbr_edges () << " edges" << std :: endl ;
+  l -> print_dijkstra ( 0 , 9 ) ;
+  delete l ;
+  std :: remove ( file ) ;
+  assert ( Graph :: load ( "test_graph.cpp" ) == 0 ) ;
   return 0 ;
 }
@@ -22,17 +22,19 @@ namespace {
 
   /*! Template function to test Heap.
    * \param V Type of the values.
+   * \param D Arity of the heap.
    * \param a Array holding the values.
    * \param nbr Number of elements in the array \c a.
    * \param e1 Value to insert.
    * \param e2 Value to insert after.
+   * The heap starts with a capacity of 1 and grows.
    */
-  template < class V >
+  template < class V , unsigned int D >
   void test_trier ( V a [] ,
 		    const unsigned int size ,
 		    V e1 ,
 		    V e2 ) {
-    Heap < V > h ( size );
+    Heap < V , D > h ( 1 );
   
     for ( unsigned int i = 0 ; i < size ; i ++ ) {
       h.push ( a [ i ] ) ;
@@ -56,6 +58,25 @@ namespace {
     cout << endl ;
   }
 
+  /*! Template function to test the construction of a Heap from a range (heapify).
+   * \param V Type of the values.
+   * \param D Arity of the heap.
+   * \param a Array holding the values.
+   * \param nbr Number of elements in the array \c a.
+   */
+  template < class V , unsigned int D >
+  void test_tas ( V a [] ,
+		  const unsigned int nbr ) {
+    Heap < V , D > h ( a , a + nbr ) ;
+    cout << h << endl ;
+
+    cout << "Sorted output" << endl ; 
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
+
 
 }
 
@@ -68,12 +89,21 @@ int main () {
   int ti []  = { 115 , 182 , 129 , 223 , -235 , 286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , -136 ,  192 , 293 , 136 , 177 , 267 , 283 , 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , 11 , 62 , 62 , 126 , -68 , 127 , 67 , 226 , -172 , 121 ,  286 , 259 , 263 , 3 , 8 , 199 } ;
 
   //  int ti []  = { 115 , 182 , 129 , 223 , -235};// , 286 , 240 , 249 , 8 , 7 , 72};
-  test_trier ( ti , sizeof ( ti ) / sizeof ( int ) , -5 , 43 ) ;
+  test_trier < int , 2 > ( ti , sizeof ( ti ) / sizeof ( int ) , -5 , 43 ) ;
+  test_tas < int , 2 > ( ti , sizeof ( ti ) / sizeof ( int ) ) ;
 
   string ts []  = { "valgrind" , "./test_heap" , "Memcheck," , "a" , "memory" , "error" , "detector" , "Copyright" , "(C)" , "2002-2013," , "and" , "GNU" , "GPL'd," , "by" , "Julian" , "Seward" , "et" , "al." , "Using" , "Valgrind-3.10.1" , "and" , "LibVEX;" , "rerun" , "with" , "-h" , "for" , "copyright" , "info" , "Command:" , "./test_heap" } ;
 
   //  string ts []  = {"a","b","a","c","d"  } ;
-  test_trier ( ts , sizeof ( ts ) / sizeof ( string ) , ( string ) "Afd",  ( string ) "Asf" ) ;
+  test_trier < string , 2 > ( ts , sizeof ( ts ) / sizeof ( string ) , ( string ) "Afd",  ( string ) "Asf" ) ;
+  test_tas < string , 2 > ( ts , sizeof ( ts ) / sizeof ( string ) ) ;
+
+  // same tests with the default arity
+  cout << "4-ary heap" << endl ;
+  test_trier < int , 4 > ( ti , sizeof ( ti ) / sizeof ( int ) , -5 , 43 ) ;
+  test_tas < int , 4 > ( ti , sizeof ( ti ) / sizeof ( int ) ) ;
+  test_trier < string , 4 > ( ts , sizeof ( ts ) / sizeof ( string ) , ( string ) "Afd",  ( string ) "Asf" ) ;
+  test_tas < string , 4 > ( ts , sizeof ( ts ) / sizeof ( string ) ) ;
   
   return 0 ;
 }
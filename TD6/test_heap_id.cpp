@@ -21,19 +21,20 @@ namespace {
   /*! Capacity for the heap. */
   unsigned int const size = 33 ; 
 
-  /*! Template function to test Heap.
+  /*! Template function to test Heap_Id.
    * \param V Type of the values.
+   * \param D Arity of the heap.
    * \param a Array holding the values.
    * \param nbr Number of elements in the array \c a.
    * \param e1 Value to insert after.
    * \param e2 Value new value for e1.
    */
-  template < class V >
+  template < class V , unsigned int D >
   void test_trier ( V a [] ,
 		    const unsigned int nbr ,
 		    V e1 ,
 		    V e2 ) {
-    Heap_Id < V > h ( nbr + 1 );
+    Heap_Id < V , D > h ( nbr + 1 );
     // Insert the value in the heap.
     for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
       h.push ( a [ i ] ) ;
@@ -58,7 +59,78 @@ namespace {
     cout << endl ;
   }
 
+  /*! Template function to test decrease_key: every value is in turn decreased below the minimum.
+   * \param V Type of the values.
+   * \param D Arity of the heap.
+   * \param a Array holding the values (they are modified).
+   * \param nbr Number of elements in the array \c a.
+   * \param step Value subtracted from the minimum at each change.
+   */
+  template < class V , unsigned int D >
+  void test_decrease_key ( V a [] ,
+			   const unsigned int nbr ,
+			   V step ) {
+    Heap_Id < V , D > h ( nbr );
+    vector < unsigned int > id ( nbr ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      id [ i ] = h.push ( a [ i ] ) ;
+    }
+    V min = a [ 0 ] ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      if ( a [ i ] < min ) min = a [ i ] ;
+    }
+    for ( unsigned int i = nbr ; i > 0 ; i -= 3 ) {
+      min = min - step ;
+      h.get ( id [ i - 1 ] ) = min ;
+      h.decrease_key ( id [ i - 1 ] ) ;
+      if ( i < 3 ) break ;
+    }
+    cout << h << endl ;
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
 
+  /*! Template function to test push_many, peek_k and erase.
+   * \param V Type of the values.
+   * \param D Arity of the heap.
+   * \param a Array holding the values.
+   * \param nbr Number of elements in the array \c a.
+   * \param k Number of smallest values to peek.
+   */
+  template < class V , unsigned int D >
+  void test_peek_erase ( V a [] ,
+			 const unsigned int nbr ,
+			 const unsigned int k ) {
+    Heap_Id < V , D > h ( nbr );
+    vector < unsigned int > id ( nbr ) ;
+    // the first half at once (heapified), then the second half (raised)
+    h.push_many ( a , nbr / 2 , & id [ 0 ] ) ;
+    h.push_many ( a + nbr / 2 , nbr - nbr / 2 , & id [ nbr / 2 ] ) ;
+    cout << h << endl ;
+    vector < unsigned int > const smallest = h.peek_k ( k ) ;
+    cout << "peek_k (" << k << ") :" ;
+    for ( unsigned int i = 0 ; i < smallest . size () ; i ++ ) {
+      cout << " " << h.get ( smallest [ i ] ) ;
+    }
+    cout << endl ;
+    // erase one value out of three, the smallest one included
+    h.erase ( smallest [ 0 ] ) ;
+    for ( unsigned int i = 1 ; i < nbr ; i += 3 ) {
+      if ( h.contains ( id [ i ] ) ) {
+	h.erase ( id [ i ] ) ;
+      }
+    }
+    cout << "erased: " << h << endl ;
+    // a freed id is given again
+    V extra = a [ 1 ] ;
+    cout << "id " << h.push ( extra ) << " pushed back" << endl ;
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
 
 }
 
@@ -68,12 +140,26 @@ int main () {
   // Test with int
   int ti []  = { 115 , 182 , 129 , 223 , 235 , -286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 ,- 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , -11 , 62 , 62 , 126 , 68 , -127 , 67 , 226 , 172 , 121 ,  286 , 259 , -263 , 3 , 8 , 199 } ;
   // int ti []  = { 115 , 182 , 129 , 223 , 235 , -286 };//, 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 ,- 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , -11 , 62 , 62 , 126 , 68 , -127 , 67 , 226 , 172 , 121 ,  286 , 259 , -263 , 3 , 8 , 199 } ;
-  test_trier ( ti , sizeof ( ti ) / sizeof ( int ) , 2 , 180 ) ;
+  test_trier < int , 2 > ( ti , sizeof ( ti ) / sizeof ( int ) , 2 , 180 ) ;
   
     
   // Test with string
   string ts []  = { "valgrind" , "./test_heap" , "Memcheck," , "a" , "memory" , "error" , "detector" , "Copyright" , "(C)" , "2002-2013," , "and" , "GNU" , "GPL'd," , "by" , "Julian" , "Seward" , "et" , "al." , "Using" , "Valgrind-3.10.1" , "and" , "LibVEX;" , "rerun" , "with" , "-h" , "for" , "copyright" , "info" , "Command:" , "./test_heap" } ;
-  test_trier < std :: basic_string < char > > ( ts , sizeof ( ts ) / sizeof ( string ) , "Abacus" , "index" ) ;
+  test_trier < std :: basic_string < char > , 2 > ( ts , sizeof ( ts ) / sizeof ( string ) , "Abacus" , "index" ) ;
+
+  // same tests with the default arity
+  cout << "4-ary heap" << endl ;
+  test_trier < int , 4 > ( ti , sizeof ( ti ) / sizeof ( int ) , 2 , 180 ) ;
+  test_trier < std :: basic_string < char > , 4 > ( ts , sizeof ( ts ) / sizeof ( string ) , "Abacus" , "index" ) ;
+
+  cout << "decrease_key" << endl ;
+  test_decrease_key < int , 4 > ( ti , sizeof ( ti ) / sizeof ( int ) , 10 ) ;
+
+  cout << "push_many, peek_k and erase" << endl ;
+  int tp []  = { 115 , 182 , 129 , 223 , 235 , -286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 } ;
+  test_peek_erase < int , 2 > ( tp , sizeof ( tp ) / sizeof ( int ) , 6 ) ;
+  test_peek_erase < int , 4 > ( tp , sizeof ( tp ) / sizeof ( int ) , 30 ) ;
+  test_peek_erase < std :: basic_string < char > , 4 > ( ts , sizeof ( ts ) / sizeof ( string ) , 8 ) ;
   
   return 0 ;
 }
@@ -0,0 +1,117 @@
+/*!
+ * \file
+ * \brief Test file: tries the Multi_Queue with one shard (sorting \c int ),
+ * then with several shards and threads (every value pushed is popped once).
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+# include <algorithm>
+
+# include <pthread.h>
+
+# include "multi_queue.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Number of values pushed by each thread. */
+  unsigned int const nbr_per_thread = 10000 ;
+
+  /*! Work of a thread: push its values, then pop until the queue is empty. */
+  struct Worker {
+    Multi_Queue < int > * queue ;
+    vector < int > pushed ;
+    vector < int > popped ;
+  } ;
+
+  /*! Body of the threads.
+   * \param w the \c Worker of the thread.
+   */
+  void * work ( void * w ) {
+    Worker & worker = * static_cast < Worker * > ( w ) ;
+    for ( unsigned int i = 0 ; i < worker . pushed . size () ; i ++ ) {
+      worker . queue -> push ( worker . pushed [ i ] ) ;
+    }
+    int * e ;
+    while ( 0 != ( e = worker . queue -> try_pop () ) ) {
+      worker . popped . push_back ( * e ) ;
+    }
+    return 0 ;
+  }
+
+  /*! With one shard the Multi_Queue is an exact heap: the values come out sorted.
+   * \param a Array holding the values.
+   * \param nbr Number of elements in the array \c a.
+   */
+  void test_trier ( int a [] ,
+		    const unsigned int nbr ) {
+    Multi_Queue < int , 2 > q ( 1 ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      q.push ( a [ i ] ) ;
+    }
+    cout << q.size () << " values" << endl ;
+    while ( ! q.is_empty () ) {
+      cout << q.pop () << " " ;
+    }
+    cout << endl ;
+    cout << "try_pop on empty: " << ( 0 == q.try_pop () ) << endl ;
+  }
+
+  /*! Threads push different values and pop concurrently in \c nbr_shards shards.
+   * \param nbr_threads Number of threads.
+   * \param nbr_shards Number of shards.
+   */
+  void test_threads ( unsigned int const nbr_threads ,
+		      unsigned int const nbr_shards ) {
+    Multi_Queue < int > q ( nbr_shards ) ;
+    vector < Worker > workers ( nbr_threads ) ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      workers [ t ] . queue = & q ;
+      for ( unsigned int i = 0 ; i < nbr_per_thread ; i ++ ) {
+	workers [ t ] . pushed . push_back ( ( i * 7919 + t ) % ( nbr_per_thread * nbr_threads ) ) ;
+      }
+    }
+    vector < pthread_t > threads ( nbr_threads ) ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      int const ret = pthread_create ( & threads [ t ] , 0 , work , & workers [ t ] ) ;
+      assert ( 0 == ret ) ;
+    }
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      pthread_join ( threads [ t ] , 0 ) ;
+    }
+    // the values popped by all the threads are the values pushed
+    vector < int > pushed ;
+    vector < int > popped ;
+    for ( unsigned int t = 0 ; t < nbr_threads ; t ++ ) {
+      pushed . insert ( pushed . end () , workers [ t ] . pushed . begin () , workers [ t ] . pushed . end () ) ;
+      popped . insert ( popped . end () , workers [ t ] . popped . begin () , workers [ t ] . popped . end () ) ;
+    }
+    sort ( pushed . begin () , pushed . end () ) ;
+    sort ( popped . begin () , popped . end () ) ;
+    cout << nbr_threads << " threads , " << q.nbr_shards << " shards : "
+	 << popped . size () << " popped out of " << pushed . size ()
+	 << " , same values " << ( pushed == popped )
+	 << " , empty " << q.is_empty () << endl ;
+  }
+
+}
+
+
+int main () {
+
+  int ti []  = { 115 , 182 , 129 , 223 , 235 , -286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 ,- 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , -11 , 62 , 62 , 126 , 68 , -127 , 67 , 226 , 172 , 121 ,  286 , 259 , -263 , 3 , 8 , 199 } ;
+  test_trier ( ti , sizeof ( ti ) / sizeof ( int ) ) ;
+
+  test_threads ( 1 , 4 ) ;
+  test_threads ( 4 , 1 ) ;
+  test_threads ( 4 , 8 ) ;
+  test_threads ( 8 , 16 ) ;
+
+  return 0 ;
+}
@@ -0,0 +1,110 @@
+/*!
+ * \file
+ * \brief Test file: tries the Pairing_Heap for sorting \c int and \c string, with decrease_key and update.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+# include <string>
+
+# include "pairing_heap.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Template function to test Pairing_Heap by sorting.
+   * \param V Type of the values.
+   * \param a Array holding the values.
+   * \param nbr Number of elements in the array \c a.
+   * \param e1 Value to insert after.
+   * \param e2 Value new value for e1.
+   */
+  template < class V >
+  void test_trier ( V a [] ,
+		    const unsigned int nbr ,
+		    V e1 ,
+		    V e2 ) {
+    Pairing_Heap < V > h ( nbr + 1 ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      h.push ( a [ i ] ) ;
+    }
+    cout << h << endl ;
+
+    // add a value.
+    unsigned int const id1 = h.push ( e1 ) ;
+    cout << e1 << " inserted, top " << h.top () << endl ;
+
+    // Change the value of e1 (it may increase)
+    cout << "value " << e1 << " changed to " << e2 << endl ;
+    e1 = e2 ;
+    h.update ( id1 ) ;
+
+    // sorted output
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
+
+  /*! Function to test decrease_key: values are popped in between,
+   * then every third value left is decreased below the minimum, then some are increased.
+   * \param a Array holding the values (they are modified).
+   * \param nbr Number of elements in the array \c a.
+   * \param step Value subtracted from the minimum at each change.
+   */
+  void test_decrease_key ( int a [] ,
+			   const unsigned int nbr ,
+			   int step ) {
+    Pairing_Heap < int > h ( nbr ) ;
+    vector < unsigned int > id ( nbr ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      id [ i ] = h.push ( a [ i ] ) ;
+    }
+    // the tree gets some depth
+    for ( unsigned int i = 0 ; i < nbr / 4 ; i ++ ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+    int min = h.top () ;
+    for ( unsigned int i = 0 ; i < nbr ; i += 3 ) {
+      if ( h.contains ( id [ i ] ) ) {
+	min = min - step ;
+	h.get ( id [ i ] ) = min ;
+	h.decrease_key ( id [ i ] ) ;
+      }
+    }
+    for ( unsigned int i = 1 ; i < nbr ; i += 5 ) {
+      if ( h.contains ( id [ i ] ) ) {
+	h.get ( id [ i ] ) += 1000 ;
+	h.update ( id [ i ] ) ;
+      }
+    }
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
+
+}
+
+
+int main () {
+
+  // Test with int
+  int ti []  = { 115 , 182 , 129 , 223 , 235 , -286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 ,- 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , -11 , 62 , 62 , 126 , 68 , -127 , 67 , 226 , 172 , 121 ,  286 , 259 , -263 , 3 , 8 , 199 } ;
+  test_trier < int > ( ti , sizeof ( ti ) / sizeof ( int ) , 2 , 180 ) ;
+
+  // Test with string
+  string ts []  = { "valgrind" , "./test_heap" , "Memcheck," , "a" , "memory" , "error" , "detector" , "Copyright" , "(C)" , "2002-2013," , "and" , "GNU" , "GPL'd," , "by" , "Julian" , "Seward" , "et" , "al." , "Using" , "Valgrind-3.10.1" , "and" , "LibVEX;" , "rerun" , "with" , "-h" , "for" , "copyright" , "info" , "Command:" , "./test_heap" } ;
+  test_trier < std :: basic_string < char > > ( ts , sizeof ( ts ) / sizeof ( string ) , "Abacus" , "index" ) ;
+
+  cout << "decrease_key" << endl ;
+  test_decrease_key ( ti , sizeof ( ti ) / sizeof ( int ) , 10 ) ;
+
+  return 0 ;
+}
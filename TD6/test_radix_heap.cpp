@@ -0,0 +1,81 @@
+/*!
+ * \file
+ * \brief Test file: tries the Radix_Heap for sorting \c unsigned \c int and with decrease_key.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+
+# include "radix_heap.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Function to test Radix_Heap by sorting.
+   * \param a Array holding the values.
+   * \param nbr Number of elements in the array \c a.
+   */
+  void test_trier ( unsigned int a [] ,
+		    const unsigned int nbr ) {
+    Radix_Heap < unsigned int > h ( nbr ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      h.push ( a [ i ] ) ;
+    }
+    cout << h << endl ;
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
+
+  /*! Function to test decrease_key: half of the values are popped,
+   * then every third value left is decreased to the last value popped plus \c step.
+   * \param a Array holding the values (they are modified).
+   * \param nbr Number of elements in the array \c a.
+   * \param step Value added to the last value popped.
+   */
+  void test_decrease_key ( unsigned int a [] ,
+			   const unsigned int nbr ,
+			   unsigned int step ) {
+    Radix_Heap < unsigned int > h ( nbr ) ;
+    vector < unsigned int > id ( nbr ) ;
+    for ( unsigned int i = 0 ; i < nbr ; i ++ ) {
+      id [ i ] = h.push ( a [ i ] ) ;
+    }
+    unsigned int last = 0 ;
+    for ( unsigned int i = 0 ; i < nbr / 2 ; i ++ ) {
+      last = h.pop () ;
+      cout << last << " " ;
+    }
+    cout << endl ;
+    for ( unsigned int i = 0 ; i < nbr ; i += 3 ) {
+      if ( h.contains ( id [ i ] ) && last + step < a [ i ] ) {
+	h.get ( id [ i ] ) = last + step ;
+	h.decrease_key ( id [ i ] ) ;
+      }
+    }
+    cout << h << endl ;
+    while ( ! h.is_empty () ) {
+      cout << h.pop () << " " ;
+    }
+    cout << endl ;
+  }
+
+}
+
+
+int main () {
+
+  unsigned int tu []  = { 115 , 182 , 129 , 223 , 235 , 286 , 240 , 249 , 8 , 7 , 72 , 23 , 50 , 43 , 136 ,  192 , 293 , 136 , 177 , 267 , 283 , 235 , 290 ,  272 , 69 , 237 , 170 , 235 , 242 , 230 , 11 , 62 , 62 , 126 , 68 , 127 , 67 , 226 , 172 , 121 ,  286 , 259 , 263 , 3 , 8 , 199 , 0 , 4000000000u } ;
+  test_trier ( tu , sizeof ( tu ) / sizeof ( unsigned int ) ) ;
+
+  cout << "decrease_key" << endl ;
+  test_decrease_key ( tu , sizeof ( tu ) / sizeof ( unsigned int ) , 5 ) ;
+
+  return 0 ;
+}
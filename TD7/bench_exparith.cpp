@@ -0,0 +1,169 @@
+/*!
+ * \file
+ * Benchmark: random postfix expressions (in the format of the \c data_expression_*.txt files)
+ * of 10^3 nodes to \c max_nodes (10^6 by default, 10 times more each time) are loaded,
+ * then evaluated by the tree ( \c evaluate ), by its code ( \c evaluate_compiled )
+ * and by blocks of valuations ( \c evaluate_batch ).
+ *
+ * usage : ./bench_exparith [max_nodes [file]]
+ * (the largest expression is written in \c file , if given).
+ *
+ * The expressions read \c nb_variables variables, with constants in [ 0.5 , 1.5 ]
+ * and the operators + - * / ; the trees are split at random, so that their depth stays
+ * logarithmic (the evaluations are recursive).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <sys/time.h>
+# include <stdlib.h> // drand48, lrand48, atoi
+
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <map>
+# include <sstream>
+# include <string>
+# include <vector>
+
+# include "evaluation_context.hpp"
+# include "loader_evaluator.hpp"
+
+
+using namespace std ; 
+
+namespace {
+
+  /*! Number of variables of the expressions: x0, x1… */
+  unsigned int const nb_variables = 10 ;
+
+  /*! Number of valuations of \c evaluate_batch . */
+  unsigned int const batch_size = 1024 ;
+
+  /*! Least time of a measure, in seconds. */
+  double const min_seconds = 0.2 ;
+
+  /*! Current time, in seconds. */
+  double now () {
+    timeval t ;
+    gettimeofday ( & t , 0 ) ;
+    return t . tv_sec + 1e-6 * t . tv_usec ;
+  }
+
+  /*! Name of variable \c k . */
+  string variable ( unsigned int const k ) {
+    ostringstream name ;
+    name << "x" << k ;
+    return name . str () ;
+  }
+
+  /*! Write on \c out a random expression of \c nb_leaves leaves in postfix form, one element per line. */
+  void generate ( ostream & out ,
+		  unsigned int const nb_leaves ) {
+    if ( 1 == nb_leaves ) {
+      if ( 0 == lrand48 () % 2 ) {
+	out << variable ( lrand48 () % nb_variables ) << "\n" ;
+      } else {
+	out << 0.5 + drand48 () << "\n" ;
+      }
+      return ;
+    }
+    unsigned int const left = 1 + lrand48 () % ( nb_leaves - 1 ) ;
+    generate ( out , left ) ;
+    generate ( out , nb_leaves - left ) ;
+    static char const * const operators [] = { "+" , "-" , "*" , "/" } ;
+    out << operators [ lrand48 () % 4 ] << "\n" ;
+  }
+
+  /*! Print a line of result. */
+  void report ( char const * const name ,
+		unsigned int const nodes ,
+		unsigned int const nb_evaluations ,
+		double const seconds ) {
+    double const s = seconds / nb_evaluations ;
+    cout << setw ( 20 ) << left << name << right
+	 << setw ( 10 ) << nodes
+	 << fixed << setprecision ( 3 )
+	 << setw ( 14 ) << s * 1e6 << " us"
+	 << setw ( 14 ) << setprecision ( 0 ) << 1 / s << " evaluations/s"
+	 << setw ( 10 ) << setprecision ( 2 ) << s * 1e9 / nodes << " ns/node" << endl ;
+  }
+
+  /*! Load and evaluate a random expression of \c nb_leaves leaves. */
+  void bench ( unsigned int const nb_leaves ,
+	       char const * const file_name ) {
+    ostringstream out ;
+    generate ( out , nb_leaves ) ;
+    out << sign_read_stop << "\n" ;
+    string const text = out . str () ;
+    if ( NULL != file_name ) {
+      ofstream file ( file_name ) ;
+      file << text ;
+    }
+
+    double const t0 = now () ;
+    Loader_Evaluator el ( text . data () , text . data () + text . size () ) ;
+    double const t1 = now () ;
+    unsigned int const nodes = el . nb_nodes () ;
+    cout << setw ( 20 ) << left << "load" << right
+	 << setw ( 10 ) << nodes
+	 << fixed << setprecision ( 3 )
+	 << setw ( 14 ) << ( t1 - t0 ) * 1e6 << " us"
+	 << setw ( 14 ) << setprecision ( 1 ) << text . size () / ( t1 - t0 ) * 1e-6 << " MB/s"
+	 << setw ( 23 ) << setprecision ( 2 ) << ( t1 - t0 ) * 1e9 / nodes << " ns/node" << endl ;
+
+    Evaluation_Context_Slots ec ( el . get_symbols () ) ;
+    for ( unsigned int k = 0 ; k < nb_variables ; k ++ ) ec . valuate ( variable ( k ) , 0.5 + drand48 () ) ;
+
+    unsigned int runs = 0 ;
+    double begin = now () ;
+    do {
+      el . evaluate ( ec ) ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "evaluate" , nodes , runs , now () - begin ) ;
+
+    el . compile () ; // not timed
+    runs = 0 ;
+    begin = now () ;
+    do {
+      el . evaluate_compiled ( ec ) ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "evaluate_compiled" , nodes , runs , now () - begin ) ;
+
+    vector < vector < double > > values ( nb_variables , vector < double > ( batch_size ) ) ;
+    map < string , double const * > columns ;
+    for ( unsigned int k = 0 ; k < nb_variables ; k ++ ) {
+      for ( unsigned int i = 0 ; i < batch_size ; i ++ ) values [ k ] [ i ] = 0.5 + drand48 () ;
+      columns [ variable ( k ) ] = & values [ k ] [ 0 ] ;
+    }
+    vector < double > results ( batch_size ) ;
+    runs = 0 ;
+    begin = now () ;
+    do {
+      el . evaluate_batch ( columns , batch_size , & results [ 0 ] ) ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "evaluate_batch" , nodes , runs * batch_size , now () - begin ) ;
+  }
+
+}
+
+
+int main ( int argc ,
+	   char const * argv [] ) {
+  unsigned int const max_nodes = ( 1 < argc ) ? atoi ( argv [ 1 ] ) : 1000000 ;
+  char const * const file_name = ( 2 < argc ) ? argv [ 2 ] : NULL ;
+  srand48 ( 1 ) ;
+  cout << setw ( 20 ) << left << "operation" << right << setw ( 10 ) << "nodes"
+       << setw ( 17 ) << "time" << setw ( 28 ) << "speed" << endl ;
+  // a tree of n leaves has 2 n - 1 nodes
+  unsigned int largest = 0 ;
+  for ( unsigned int nodes = 1000 ; nodes <= max_nodes ; nodes *= 10 ) largest = nodes ;
+  for ( unsigned int nodes = 1000 ; nodes <= max_nodes ; nodes *= 10 ) {
+    bench ( ( nodes + 1 ) / 2 , ( largest == nodes ) ? file_name : NULL ) ;
+  }
+  return 0 ;
+}
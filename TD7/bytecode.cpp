@@ -0,0 +1,239 @@
+# include <sstream>
+
+# include "bytecode.hpp"
+
+
+using namespace std ;
+
+
+void Bytecode :: emit ( opcode_enum opcode ,
+			unsigned int arg ,
+			int delta ) {
+  assert ( 0 <= ( int ) depth + delta ) ;
+  Instruction const i = { opcode , arg } ;
+  code . push_back ( i ) ;
+  depth += delta ;
+  if ( max_depth < depth ) max_depth = depth ;
+}
+
+
+unsigned int Bytecode :: slot ( string const & id ,
+			       unsigned int symbol ) {
+  for ( unsigned int s = 0 ; s < variables . size () ; s ++ ) {
+    if ( id == variables [ s ] ) return s ;
+  }
+  variables . push_back ( id ) ;
+  symbols . push_back ( symbol ) ;
+  return variables . size () - 1 ;
+}
+
+
+void Bytecode :: emit_constant ( double value ) {
+  constants . push_back ( value ) ;
+  emit ( op_constant , constants . size () - 1 , 1 ) ;
+}
+
+
+void Bytecode :: emit_variable ( string const & id ,
+				unsigned int symbol ) {
+  emit ( op_variable , slot ( id , symbol ) , 1 ) ;
+}
+
+
+void Bytecode :: emit_set ( string const & id ,
+			   unsigned int symbol ) {
+  assert ( 1 <= depth ) ;
+  emit ( op_set , slot ( id , symbol ) , 0 ) ;
+}
+
+
+void Bytecode :: emit_operation ( opcode_enum opcode ) {
+  switch ( opcode ) {
+  case op_add :
+  case op_sub :
+  case op_mul :
+  case op_div :
+    emit ( opcode , 0 , -1 ) ;
+    break ;
+  case op_exp :
+  case op_log :
+    emit ( opcode , 0 , 0 ) ;
+    break ;
+  default :
+    assert ( false ) ;
+  }
+}
+
+
+double Bytecode :: run ( Evaluation_Context & ec ) const {
+  assert ( 1 == depth ) ;
+  stack . resize ( max_depth ) ;
+  values . resize ( variables . size () ) ;
+  known . assign ( variables . size () , 0 ) ;
+  // next free cell of the stack
+  double * s = & stack [ 0 ] ;
+  for ( vector < Instruction > :: const_iterator i = code . begin () ;
+	i != code . end () ;
+	++ i ) {
+    switch ( i -> opcode ) {
+    case op_constant :
+      * s ++ = constants [ i -> arg ] ;
+      break ;
+    case op_variable :
+      if ( ! known [ i -> arg ] ) {
+	values [ i -> arg ] = ec . get_value ( symbols [ i -> arg ] , variables [ i -> arg ] ) ;
+	known [ i -> arg ] = 1 ;
+      }
+      * s ++ = values [ i -> arg ] ;
+      break ;
+    case op_set :
+      values [ i -> arg ] = s [ -1 ] ;
+      known [ i -> arg ] = 1 ;
+      ec . valuate ( symbols [ i -> arg ] , variables [ i -> arg ] , s [ -1 ] ) ;
+      break ;
+    case op_add :
+      -- s ;
+      s [ -1 ] = s [ -1 ] + s [ 0 ] ;
+      break ;
+    case op_sub :
+      -- s ;
+      s [ -1 ] = s [ -1 ] - s [ 0 ] ;
+      break ;
+    case op_mul :
+      -- s ;
+      s [ -1 ] = s [ -1 ] * s [ 0 ] ;
+      break ;
+    case op_div :
+      -- s ;
+      s [ -1 ] = s [ -1 ] / s [ 0 ] ;
+      break ;
+    case op_exp :
+      s [ -1 ] = exp ( s [ -1 ] ) ;
+      break ;
+    case op_log :
+      s [ -1 ] = log ( s [ -1 ] ) ;
+      break ;
+    }
+  }
+  return stack [ 0 ] ;
+}
+
+
+namespace {
+
+  /*! Number of valuations in a block of \c run_batch . */
+  unsigned int const block_size = 256 ;
+
+  //
+  // Operations on blocks: the blocks do not overlap (__restrict__),
+  // so that the loops can be vectorized.
+  //
+
+  void fill_block ( double * __restrict__ x , double v , unsigned int len ) {
+    for ( unsigned int k = 0 ; k < len ; k ++ ) x [ k ] = v ;
+  }
+
+  void copy_block ( double * __restrict__ x , double const * __restrict__ y , unsigned int len ) {
+    for ( unsigned int k = 0 ; k < len ; k ++ ) x [ k ] = y [ k ] ;
+  }
+
+  // help write the four binary operations
+# define BLOCK_BINARY( name , op )					\
+  void name ( double * __restrict__ x , double const * __restrict__ y , unsigned int len ) { \
+    for ( unsigned int k = 0 ; k < len ; k ++ ) x [ k ] = x [ k ] op y [ k ] ; \
+  }
+
+  BLOCK_BINARY ( add_block , + )
+  BLOCK_BINARY ( sub_block , - )
+  BLOCK_BINARY ( mul_block , * )
+  BLOCK_BINARY ( div_block , / )
+
+  // help write the two unary operations
+# define BLOCK_UNARY( name , f )				\
+  void name ( double * __restrict__ x , unsigned int len ) {	\
+    for ( unsigned int k = 0 ; k < len ; k ++ ) x [ k ] = f ( x [ k ] ) ; \
+  }
+
+  BLOCK_UNARY ( exp_block , exp )
+  BLOCK_UNARY ( log_block , log )
+
+}
+
+
+void Bytecode :: run_batch ( vector < double const * > const & columns ,
+			     unsigned int n ,
+			     double * out ) const {
+  assert ( 1 == depth ) ;
+  assert ( variables . size () == columns . size () ) ;
+  // one block per cell of the stack and per variable
+  stack . resize ( max_depth * block_size ) ;
+  values . resize ( variables . size () * block_size ) ;
+  for ( unsigned int first = 0 ; first < n ; first += block_size ) {
+    unsigned int const len = ( n - first < block_size ) ? n - first : block_size ;
+    known . assign ( variables . size () , 0 ) ;
+    // block of the next free cell of the stack
+    double * s = & stack [ 0 ] ;
+    for ( vector < Instruction > :: const_iterator i = code . begin () ;
+	  i != code . end () ;
+	  ++ i ) {
+      unsigned int const arg = i -> arg ;
+      switch ( i -> opcode ) {
+      case op_constant :
+	fill_block ( s , constants [ arg ] , len ) ;
+	s += block_size ;
+	break ;
+      case op_variable :
+	if ( ! known [ arg ] ) {
+	  assert ( NULL != columns [ arg ] ) ;
+	  copy_block ( & values [ arg * block_size ] , columns [ arg ] + first , len ) ;
+	  known [ arg ] = 1 ;
+	}
+	copy_block ( s , & values [ arg * block_size ] , len ) ;
+	s += block_size ;
+	break ;
+      case op_set :
+	copy_block ( & values [ arg * block_size ] , s - block_size , len ) ;
+	known [ arg ] = 1 ;
+	break ;
+      case op_add :
+	s -= block_size ;
+	add_block ( s - block_size , s , len ) ;
+	break ;
+      case op_sub :
+	s -= block_size ;
+	sub_block ( s - block_size , s , len ) ;
+	break ;
+      case op_mul :
+	s -= block_size ;
+	mul_block ( s - block_size , s , len ) ;
+	break ;
+      case op_div :
+	s -= block_size ;
+	div_block ( s - block_size , s , len ) ;
+	break ;
+      case op_exp :
+	exp_block ( s - block_size , len ) ;
+	break ;
+      case op_log :
+	log_block ( s - block_size , len ) ;
+	break ;
+      }
+    }
+    for ( unsigned int k = 0 ; k < len ; k ++ ) out [ first + k ] = stack [ k ] ;
+  }
+}
+
+
+string Bytecode :: toString () const {
+  static char const * const names [] = { "constant" , "variable" , "set" , "add" , "sub" , "mul" , "div" , "exp" , "log" } ;
+  ostringstream out ;
+  for ( vector < Instruction > :: const_iterator i = code . begin () ;
+	i != code . end () ;
+	++ i ) {
+    out << names [ i -> opcode ] ;
+    if ( op_constant == i -> opcode ) out << " " << constants [ i -> arg ] ;
+    if ( op_variable == i -> opcode || op_set == i -> opcode ) out << " " << variables [ i -> arg ] ;
+    out << endl ;
+  }
+  return out . str () ;
+}
@@ -0,0 +1,148 @@
+# ifndef __BYTECODE_HPP_
+# define __BYTECODE_HPP_
+
+/*!
+ * \file
+ * This module provides a linear form of arithmetical expressions: code for a stack machine,
+ * with an interpreter that computes the same value as \c Expr :: eval .
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <string>
+# include <vector>
+
+# include "evaluation_context.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+
+/*!
+ * enum to provide the instructions of the stack machine.
+ */
+typedef enum {
+  /*! Push constant number \c arg . */
+  op_constant ,
+  /*! Push the value of variable number \c arg . */
+  op_variable ,
+  /*! Give the top of the stack to variable number \c arg (it stays on the stack). */
+  op_set ,
+  /*! Replace the two values on top by their sum. */
+  op_add ,
+  /*! Replace the two values on top by their difference (the top one is subtracted). */
+  op_sub ,
+  /*! Replace the two values on top by their product. */
+  op_mul ,
+  /*! Replace the two values on top by their quotient (the top one divides). */
+  op_div ,
+  /*! Replace the value on top by its exponential. */
+  op_exp ,
+  /*! Replace the value on top by its logarithm. */
+  op_log
+} opcode_enum ;
+
+
+/*! One instruction: opcode and argument (for op_constant, op_variable and op_set). */
+struct Instruction {
+  opcode_enum opcode ;
+  unsigned int arg ;
+} ;
+
+
+/*!
+ * Code of an expression for a stack machine, built by \c Expr :: compile .
+ * Constants are in a table and variables are numbered (slots) at compilation,
+ * so that running the code does no string comparison.
+ *
+ * When the code is run, the value of a variable is asked to the context the first time
+ * it is read (unless it was set before), then kept in its slot.
+ * Values set are also given to the context, as \c Set :: eval does.
+ */
+class Bytecode {
+  /*! Instructions, in order. */
+  std :: vector < Instruction > code ;
+  /*! Constants used by op_constant. */
+  std :: vector < double > constants ;
+  /*! Names of the variables, by slot. */
+  std :: vector < std :: string > variables ;
+  /*! Slots of the variables in the \c Symbol_Table of the expression, by slot. */
+  std :: vector < unsigned int > symbols ;
+  /*! Number of values on the stack after each instruction so far. */
+  unsigned int depth ;
+  /*! Maximal number of values on the stack. */
+  unsigned int max_depth ;
+  /*! Stack used by \c run . */
+  mutable std :: vector < double > stack ;
+  /*! Values of the variables during \c run . */
+  mutable std :: vector < double > values ;
+  /*! Whether each variable has a value in \c values during \c run . */
+  mutable std :: vector < char > known ;
+  /*! Add an instruction and update the depth of the stack. */
+  void emit ( opcode_enum opcode ,
+	      unsigned int arg ,
+	      int delta ) ;
+public :
+  // CONSTRUCTOR
+  /*! Empty code. */
+  Bytecode ()
+    : depth ( 0 )
+    , max_depth ( 0 )
+  {} ;
+  /*!
+   * Return the slot of a variable, a new one for a variable not in the code yet.
+   * \param id Variable name.
+   * \param symbol Slot of the variable in the \c Symbol_Table of the expression.
+   */
+  unsigned int slot ( std :: string const & id ,
+		      unsigned int symbol = Symbol_Table :: none ) ;
+  /*! Add the push of a constant. */
+  void emit_constant ( double value ) ;
+  /*! Add the push of the value of variable \c id ( \c symbol in the \c Symbol_Table ). */
+  void emit_variable ( std :: string const & id ,
+		       unsigned int symbol = Symbol_Table :: none ) ;
+  /*! Add the setting of variable \c id ( \c symbol in the \c Symbol_Table ) to the value on top. */
+  void emit_set ( std :: string const & id ,
+		  unsigned int symbol = Symbol_Table :: none ) ;
+  /*! Add an arithmetical operation (op_add to op_log). */
+  void emit_operation ( opcode_enum opcode ) ;
+  /*! Number of instructions. */
+  unsigned int size () const {
+    return code . size () ;
+  } ;
+  /*! Names of the variables, by slot. */
+  std :: vector < std :: string > const & get_variables () const {
+    return variables ;
+  } ;
+  /*!
+   * Run the code.
+   * \pre The code is the one of a whole expression (it leaves one value on the stack).
+   * \param ec Context for the values of the variables.
+   * \return The computed value.
+   */
+  double run ( Evaluation_Context & ec ) const ;
+  /*!
+   * Run the code for many valuations at a time.
+   * Instruction after instruction, each operation is done on a whole block of valuations
+   * (inner loops over contiguous arrays, that the compiler can vectorize).
+   * \pre The code is the one of a whole expression.
+   * \param columns For each slot, the array of the values of the variable,
+   * or NULL for a variable that is set before being read.
+   * \param n Number of valuations.
+   * \param out Array of size \c n for the computed values.
+   */
+  void run_batch ( std :: vector < double const * > const & columns ,
+		   unsigned int n ,
+		   double * out ) const ;
+  /*!
+   * Output the instructions, one per line.
+   */
+  std :: string toString () const ;
+} ;
+
+
+# endif
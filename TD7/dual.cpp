@@ -0,0 +1,92 @@
+# include <math.h>
+
+# include "dual.hpp"
+
+
+using namespace std ;
+
+
+void Dual :: constant ( double v ,
+			unsigned int size ) {
+  value = v ;
+  gradient . assign ( size , 0 ) ;
+}
+
+
+void Dual :: add ( Dual const & d ) {
+  assert ( gradient . size () == d . gradient . size () ) ;
+  value += d . value ;
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) gradient [ k ] += d . gradient [ k ] ;
+}
+
+
+void Dual :: sub ( Dual const & d ) {
+  assert ( gradient . size () == d . gradient . size () ) ;
+  value -= d . value ;
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) gradient [ k ] -= d . gradient [ k ] ;
+}
+
+
+void Dual :: mul ( Dual const & d ) {
+  assert ( gradient . size () == d . gradient . size () ) ;
+  // ( u v )' = u' v + u v'
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) {
+    gradient [ k ] = gradient [ k ] * d . value + value * d . gradient [ k ] ;
+  }
+  value *= d . value ;
+}
+
+
+void Dual :: div ( Dual const & d ) {
+  assert ( gradient . size () == d . gradient . size () ) ;
+  // ( u / v )' = ( u' - ( u / v ) v' ) / v
+  value /= d . value ;
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) {
+    gradient [ k ] = ( gradient [ k ] - value * d . gradient [ k ] ) / d . value ;
+  }
+}
+
+
+void Dual :: exp () {
+  value = :: exp ( value ) ;
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) gradient [ k ] *= value ;
+}
+
+
+void Dual :: log () {
+  for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) gradient [ k ] /= value ;
+  value = :: log ( value ) ;
+}
+
+
+void Dual_Context :: read ( unsigned int slot ,
+			    string const & id ,
+			    Dual & result ) {
+  result . value = ec . get_value ( slot , id ) ;
+  if ( slot < size && ! set_gradients [ slot ] . empty () ) {
+    result . gradient = set_gradients [ slot ] ;
+    return ;
+  }
+  result . gradient . assign ( size , 0 ) ;
+  if ( slot < size ) result . gradient [ slot ] = 1 ;
+}
+
+
+void Dual_Context :: valuate ( unsigned int slot ,
+			       string const & id ,
+			       Dual const & d ) {
+  ec . valuate ( slot , id , d . value ) ;
+  ec . new_epoch () ;
+  if ( slot < size ) set_gradients [ slot ] = d . gradient ;
+  // the shared expressions may read the variable
+  done . clear () ;
+}
+
+
+bool Dual_Context :: get_done ( Expr const * e ,
+				Dual & result ) const {
+  map < Expr const * , Dual > :: const_iterator it = done . find ( e ) ;
+  if ( done . end () == it ) return false ;
+  result = it -> second ;
+  return true ;
+}
@@ -0,0 +1,118 @@
+# ifndef __DUAL_HPP_
+# define __DUAL_HPP_
+
+/*!
+ * \file
+ * This module provides dual numbers (a value with its gradient) for the forward mode
+ * of automatic differentiation of arithmetical expressions (see \c Expr :: eval_dual ).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <map>
+# include <string>
+# include <vector>
+
+# include "evaluation_context.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+class Expr ;
+
+
+/*!
+ * A value with its derivative with respect to each variable, by slot (see \c Symbol_Table ).
+ * The operations compute the value and the gradient of the result in place.
+ */
+struct Dual {
+  /*! The value. */
+  double value ;
+  /*! Derivative of \c value with respect to each slot. */
+  std :: vector < double > gradient ;
+  /*! Become constant \c v (null gradient for \c size slots). */
+  void constant ( double v ,
+		  unsigned int size ) ;
+  /*! Become \c this + \c d . */
+  void add ( Dual const & d ) ;
+  /*! Become \c this - \c d . */
+  void sub ( Dual const & d ) ;
+  /*! Become \c this * \c d . */
+  void mul ( Dual const & d ) ;
+  /*! Become \c this / \c d . */
+  void div ( Dual const & d ) ;
+  /*! Become exp ( \c this ) . */
+  void exp () ;
+  /*! Become log ( \c this ) . */
+  void log () ;
+} ;
+
+
+/*!
+ * Context of a differentiation: the values of the variables are the ones of an \c Evaluation_Context ,
+ * each variable read is derived with respect to its own slot,
+ * unless it was set by the expression (it then has the gradient of the value it was given).
+ * Variables without a slot are seen as constants.
+ * The shared expressions keep their dual value till the next setting,
+ * so that each one is differentiated once.
+ */
+class Dual_Context {
+  /*! Context for the values of the variables. */
+  Evaluation_Context & ec ;
+  /*! Number of slots (size of the gradients). */
+  unsigned int const size ;
+  /*! Gradient of each slot set so far (empty if not set). */
+  std :: vector < std :: vector < double > > set_gradients ;
+  /*! Dual value of the shared expressions differentiated since the last setting. */
+  std :: map < Expr const * , Dual > done ;
+public :
+  /*!
+   * \param _ec Context for the values of the variables.
+   * \param _size Number of slots of the variables to derive with respect to.
+   */
+  Dual_Context ( Evaluation_Context & _ec ,
+		 unsigned int _size )
+    : ec ( _ec )
+    , size ( _size )
+    , set_gradients ( _size )
+  {} ;
+  /*! Number of slots (size of the gradients). */
+  unsigned int get_size () const {
+    return size ;
+  } ;
+  /*!
+   * Read a variable.
+   * \param slot Variable slot (see \c Symbol_Table ).
+   * \param id Variable name.
+   * \param result Set to the value of the variable and its gradient.
+   */
+  void read ( unsigned int slot ,
+	      std :: string const & id ,
+	      Dual & result ) ;
+  /*!
+   * Set a variable to \c d and start a new epoch of the context.
+   * \param slot Variable slot (see \c Symbol_Table ).
+   * \param id Variable name.
+   */
+  void valuate ( unsigned int slot ,
+		 std :: string const & id ,
+		 Dual const & d ) ;
+  /*!
+   * Get the dual value of a shared expression differentiated since the last setting, if any.
+   * \return true iff there is one.
+   */
+  bool get_done ( Expr const * e ,
+		  Dual & result ) const ;
+  /*! Record the dual value of a shared expression. */
+  void set_done ( Expr const * e ,
+		  Dual const & d ) {
+    done [ e ] = d ;
+  } ;
+} ;
+
+
+# endif
@@ -4,6 +4,20 @@
 using namespace std ;
 
 
+namespace {
+
+  /*! Last stamp given to an epoch. */
+  unsigned long last_epoch = 0 ;
+
+}
+
+
+void Evaluation_Context :: new_epoch () {
+  // contexts may be used by different threads (see Program)
+  epoch = __sync_add_and_fetch ( & last_epoch , 1 ) ;
+}
+
+
 double Evaluation_Context_No_Variable :: get_value ( string const & id ) {
   assert ( false ) ;
   return NAN ;
@@ -16,12 +30,65 @@ void Evaluation_Context_No_Variable :: valuate ( string const & id ,double value
 
 double  Evaluation_Context_Simple :: get_value ( string const & id ) { 
   std::map<std::string,double>::  iterator it = valuation.find(id);
-  if(id != it->first) return NAN;
+  if(valuation.end() == it) return NAN;
   else return it->second;
 }
 
 
 void  Evaluation_Context_Simple :: valuate ( string const & id ,double value ) { 
-  valuation.erase(id);
-  valuation.insert(std::pair<std::string,double> (id,value));
+  valuation[id]=value;
+}
+
+
+unsigned int Symbol_Table :: intern ( string const & id ) {
+  map < string , unsigned int > :: iterator it = slots . find ( id ) ;
+  if ( slots . end () != it ) return it -> second ;
+  slots . insert ( pair < string , unsigned int > ( id , names . size () ) ) ;
+  names . push_back ( id ) ;
+  return names . size () - 1 ;
+}
+
+
+unsigned int Symbol_Table :: find ( string const & id ) const {
+  map < string , unsigned int > :: const_iterator it = slots . find ( id ) ;
+  return ( slots . end () == it ) ? none : it -> second ;
+}
+
+
+double Evaluation_Context_Slots :: get_value ( string const & id ) {
+  unsigned int const slot = symbols . find ( id ) ;
+  return ( Symbol_Table :: none == slot || values . size () <= slot ) ? NAN : values [ slot ] ;
+}
+
+
+void Evaluation_Context_Slots :: valuate ( string const & id ,
+					   double value ) {
+  valuate ( symbols . intern ( id ) , id , value ) ;
+}
+
+
+void Evaluation_Context_Slots :: valuate ( unsigned int slot ,
+					   string const & id ,
+					   double value ) {
+  if ( Symbol_Table :: none == slot ) {
+    valuate ( id , value ) ;
+    return ;
+  }
+  if ( values . size () <= slot ) values . resize ( symbols . size () , NAN ) ;
+  values [ slot ] = value ;
+}
+
+
+void Evaluation_Context_Incremental :: valuate ( unsigned int slot ,
+						 string const & id ,
+						 double value ) {
+  if ( Symbol_Table :: none == slot ) {
+    // gets a slot and comes back
+    Evaluation_Context_Slots :: valuate ( id , value ) ;
+    return ;
+  }
+  if ( get_value ( slot , id ) == value ) return ;
+  Evaluation_Context_Slots :: valuate ( slot , id , value ) ;
+  if ( changes . size () <= slot ) changes . resize ( slot + 1 , 0 ) ;
+  changes [ slot ] = ++ last_change ;
 }
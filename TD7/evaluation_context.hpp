@@ -11,19 +11,94 @@
 
 # include <string>
 # include <map>
+# include <vector>
 
 # include <math.h>
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
+/*!
+ * Numbering of variables: each name gets a slot (0, 1…) the first time it is interned.
+ * Expressions loaded with the same table use the same slots,
+ * so that an \c Evaluation_Context_Slots can hold the values in an array.
+ */
+class Symbol_Table {
+  /*! Slot of each name. */
+  std :: map < std :: string , unsigned int > slots ;
+  /*! Name of each slot. */
+  std :: vector < std :: string > names ;
+public :
+  /*! Slot of no variable (e.g. variables built without a table). */
+  static unsigned int const none = ( unsigned int ) -1 ;
+  /*!
+   * Return the slot of a name, a new one if it was not interned yet.
+   * \param id Variable name.
+   */
+  unsigned int intern ( std :: string const & id ) ;
+  /*!
+   * Return the slot of a name or \c none if it was not interned.
+   * \param id Variable name.
+   */
+  unsigned int find ( std :: string const & id ) const ;
+  /*! Return the name of a slot. */
+  std :: string const & get_name ( unsigned int slot ) const {
+    assert ( slot < names . size () ) ;
+    return names [ slot ] ;
+  } ;
+  /*! Number of slots. */
+  unsigned int size () const {
+    return names . size () ;
+  } ;
+} ;
+
+
+
 /*! 
  * Abstract class used to provide a context for evaluation.
  * In particular, it manages the value of variables.
  */
 class Evaluation_Context {
+  /*! Stamp of the current epoch (see \c new_epoch ). */
+  unsigned long epoch ;
+  /*! Whether all the operators cache their value, not only the shared ones. */
+  bool const cache_all ;
+protected :
+
+  /*! Same as below, with \c _cache_all telling whether all the operators cache their value. */
+  Evaluation_Context ( bool _cache_all )
+    : cache_all ( _cache_all ) {
+    new_epoch () ;
+  }
+
 public :
+
+  /*! The context starts a new epoch. */
+  Evaluation_Context ()
+    : cache_all ( false ) {
+    new_epoch () ;
+  }
+
+  /*! \return true iff all the operators cache their value, not only the shared ones. */
+  bool caches_all () const {
+    return cache_all ;
+  }
+
+  /*!
+   * Start a new epoch, with a stamp that no context had before.
+   * The values cached by the shared expressions (see \c Expr ) are only valid for one epoch:
+   * a new one starts with each evaluation and after each setting of a variable by an expression.
+   */
+  void new_epoch () ;
+
+  /*! \return the stamp of the current epoch. */
+  unsigned long get_epoch () const {
+    return epoch ;
+  }
+
   
   /*! 
    * Retrieve the value of a variable.
@@ -41,6 +116,31 @@ public :
   virtual void valuate ( std :: string const & id ,
 			 double value ) = 0 ;
 
+  /*!
+   * Retrieve the value of a variable by slot.
+   * By default, by name (contexts not based on slots need not redefine it).
+   * \param slot Variable slot (see \c Symbol_Table ).
+   * \param id Variable name.
+   * \return the value associated to the variable or NAN if undefined.
+   */
+  virtual double get_value ( unsigned int slot ,
+			     std :: string const & id ) {
+    return get_value ( id ) ;
+  }
+
+  /*!
+   * Set the value of a variable by slot.
+   * By default, by name.
+   * \param slot Variable slot (see \c Symbol_Table ).
+   * \param id Variable name.
+   * \param value Value to associate to the variable.
+   */
+  virtual void valuate ( unsigned int slot ,
+			 std :: string const & id ,
+			 double value ) {
+    valuate ( id , value ) ;
+  }
+
   /*! Destructor. */
   virtual ~ Evaluation_Context () {} ;
 } ;
@@ -77,4 +177,91 @@ public :
 } ;
 
 
+
+/*!
+ * Concrete instance where the values are in an array indexed by the slots of a \c Symbol_Table ,
+ * so that reading a variable by slot is a single access.
+ * Variables accessed by name are looked for in the table.
+ */
+class Evaluation_Context_Slots
+  : public Evaluation_Context {
+  /*! Numbering of the variables. */
+  Symbol_Table & symbols ;
+  /*! Value of each slot (NAN if undefined), it grows with the table. */
+  std :: vector < double > values ;
+public :
+  /*! All the variables are undefined. */
+  Evaluation_Context_Slots ( Symbol_Table & _symbols )
+    : symbols ( _symbols )
+    , values ( _symbols . size () , NAN )
+  {} ;
+protected :
+  /*! Same as above, for contexts caching all the values. */
+  Evaluation_Context_Slots ( Symbol_Table & _symbols ,
+			     bool _cache_all )
+    : Evaluation_Context ( _cache_all )
+    , symbols ( _symbols )
+    , values ( _symbols . size () , NAN )
+  {} ;
+public :
+  double get_value ( std :: string const & id ) ;
+  void valuate ( std :: string const & id ,
+		 double value ) ;
+  double get_value ( unsigned int slot ,
+		     std :: string const & id ) {
+    if ( slot < values . size () ) return values [ slot ] ;
+    return ( Symbol_Table :: none == slot ) ? get_value ( id ) : NAN ;
+  }
+  void valuate ( unsigned int slot ,
+		 std :: string const & id ,
+		 double value ) ;
+  /*!
+   * Make room for all the slots of the table, so that setting a variable with a slot
+   * no longer changes the array (e.g. different threads may then set different variables).
+   */
+  void fit () {
+    if ( values . size () < symbols . size () ) values . resize ( symbols . size () , NAN ) ;
+  } ;
+} ;
+
+
+
+/*!
+ * Context with slots for incremental evaluation (see \c Loader_Evaluator :: evaluate_incremental ):
+ * all the operators keep their value from an evaluation to the next,
+ * and each setting of a variable to a new value is stamped,
+ * so that only the operators reading the variables changed since the last evaluation are computed again.
+ */
+class Evaluation_Context_Incremental
+  : public Evaluation_Context_Slots {
+  /*! Stamp of the last change of each slot (0 if none). */
+  std :: vector < unsigned long > changes ;
+  /*! Last stamp given. */
+  unsigned long last_change ;
+public :
+  /*! All the variables are undefined. */
+  Evaluation_Context_Incremental ( Symbol_Table & _symbols )
+    : Evaluation_Context_Slots ( _symbols , true )
+    , last_change ( 0 )
+  {} ;
+  using Evaluation_Context_Slots :: valuate ;
+  /*! Same as for \c Evaluation_Context_Slots , the change is stamped if the value is a new one. */
+  void valuate ( unsigned int slot ,
+		 std :: string const & id ,
+		 double value ) ;
+  /*! \return the last stamp given (0 if none). */
+  unsigned long get_last_change () const {
+    return last_change ;
+  } ;
+  /*! \return the stamp of the last change of \c slot (0 if none). */
+  unsigned long get_change ( unsigned int slot ) const {
+    return ( slot < changes . size () ) ? changes [ slot ] : 0 ;
+  } ;
+  /*! \return the number of slots with a stamp. */
+  unsigned int nb_changes () const {
+    return changes . size () ;
+  } ;
+} ;
+
+
 # endif
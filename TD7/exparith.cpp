@@ -1,5 +1,6 @@
 # include <sstream>
 
+# include "counters.hpp"
 # include "exparith.hpp"
 
 
@@ -10,17 +11,70 @@
 using namespace std ; 
 
 
+Expr * Expr :: optimize ( map < Expr * , Expr * > & done ) {
+  // the other expressions holding this one get the same result
+  // (the keys of done are alive: only the nodes of the initial expression are looked for)
+  map < Expr * , Expr * > :: iterator it = done . find ( this ) ;
+  if ( done . end () != it ) {
+    Expr * const result = it -> second -> share () ;
+    release ( this ) ;
+    return result ;
+  }
+  if ( ! is_shared () ) return simplify ( done ) ;
+  Expr * const result = simplify ( done ) ;
+  done [ this ] = result ;
+  return result ;
+}
+
+
+string Expr :: toString () const {
+  ostringstream out ;
+  print ( out ) ;
+  return out . str () ;
+}
+
+
+void Expr :: eval_dual ( Dual_Context & dc ,
+			 Dual & result ) const {
+  if ( ! is_shared () ) {
+    compute_dual ( dc , result ) ;
+    return ;
+  }
+  if ( dc . get_done ( this , result ) ) return ;
+  compute_dual ( dc , result ) ;
+  dc . set_done ( this , result ) ;
+}
+
+
+void Expr :: collect ( set < Expr const * > & nodes ) const {
+  // depth first, without recursion (expressions may be very deep)
+  vector < Expr const * > to_visit ( 1 , this ) ;
+  while ( ! to_visit . empty () ) {
+    Expr const * const e = to_visit . back () ;
+    to_visit . pop_back () ;
+    if ( nodes . insert ( e ) . second ) e -> get_arguments ( to_visit ) ;
+  }
+}
+
 
 double Constant :: eval ( Evaluation_Context & ec ) const{ 
+  COUNTER_ADD ( "Expr::eval" ) ;
   return value;
 }
 
 
-string Constant :: toString () const { 
-  string s="";
-  ostringstream strs;
-  strs << value;
-  s = strs.str();
-  return s;
+void Constant :: compile ( Bytecode & b ) const {
+  b . emit_constant ( value ) ;
+}
+
+
+void Constant :: compute_dual ( Dual_Context & dc ,
+				Dual & result ) const {
+  result . constant ( value , dc . get_size () ) ;
+}
+
+
+void Constant :: print ( ostream & out ) const { 
+  out << value ;
 }
 
@@ -12,11 +12,18 @@
  */
 
 # include "evaluation_context.hpp"
+# include "bytecode.hpp"
+# include "dual.hpp"
 
 
+# include <map>
+# include <ostream>
+# include <set>
 # include <string>
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -45,10 +52,62 @@ typedef enum {
  * This is ground class for the all arithmetical (sub-)expression.
  * This class should not be instantiated and is virtual.
  * It only manage the priority.
+ *
+ * An expression may be shared by many expressions (e.g. by \c Loader_Evaluator ,
+ * the expressions then form a DAG): it is deleted with the last one (see \c share and \c release ).
+ * Nodes may also be owned by an \c Expr_Arena .
+ * A shared expression caches its value for the epoch of the \c Evaluation_Context ,
+ * so that it is computed once per evaluation.
+ * With a context that caches all (see \c Evaluation_Context_Incremental ), every operator does,
+ * and the values stay valid from an evaluation to the next till they are invalidated.
  */
 class Expr {
   /*! Priority level of the expression. */
   priority_enum const priority ; 
+  /*! Number of expressions holding this one, besides the first one. */
+  unsigned int shares ;
+  /*! Value computed by the last \c eval (only recorded if shared). */
+  mutable double cached_value ;
+  /*! Epoch of the context for which \c cached_value is valid. */
+  mutable unsigned long cached_epoch ;
+  /*! Whether the node is owned by an \c Expr_Arena (it is then not deleted by \c release ). */
+  bool in_arena ;
+  friend class Expr_Arena ;
+protected :
+  /*!
+   * Get the value cached for the current epoch of \c ec , if any.
+   * \param value Set to the cached value.
+   * \return true iff the expression is shared and its value is cached.
+   */
+  bool get_cached ( Evaluation_Context const & ec ,
+		    double & value ) const {
+    if ( ( 0 == shares && ! ec . caches_all () ) || ec . get_epoch () != cached_epoch ) return false ;
+    value = cached_value ;
+    return true ;
+  } ;
+  /*!
+   * Cache the value for the current epoch of \c ec , if shared (or if \c ec caches all).
+   * \return \c value .
+   */
+  double set_cached ( Evaluation_Context const & ec ,
+		      double value ) const {
+    if ( 0 < shares || ec . caches_all () ) {
+      cached_value = value ;
+      cached_epoch = ec . get_epoch () ;
+    }
+    return value ;
+  } ;
+  /*!
+   * Simplification of \c optimize , done once for each expression.
+   * \return The simplified expression, holding one share that the caller gets.
+   * \post One share of \c this is given up (see \c release ).
+   */
+  virtual Expr * simplify ( std :: map < Expr * , Expr * > & done ) {
+    return this ;
+  } ;
+  /*! Differentiation of \c eval_dual , done once for each shared expression ( \c result is set). */
+  virtual void compute_dual ( Dual_Context & dc ,
+			      Dual & result ) const = 0 ;
 public:
   // CONSTRUCTOR
   /*! 
@@ -57,16 +116,82 @@ public:
    */
   Expr ( priority_enum p ) 
     : priority ( p ) 
+    , shares ( 0 )
+    , cached_value ( NAN )
+    , cached_epoch ( 0 )
+    , in_arena ( false )
   {} ; 
+  /*!
+   * One more expression holds this one.
+   * \return \c this .
+   */
+  Expr * share () {
+    ++ shares ;
+    return this ;
+  } ;
+  /*!
+   * Forget the cached value (e.g. a variable read by the expression changed).
+   * \return false iff there was no cached value.
+   */
+  bool invalidate () const {
+    if ( 0 == cached_epoch ) return false ;
+    cached_epoch = 0 ;
+    return true ;
+  } ;
+  /*! \return true iff more than one expression holds this one. */
+  bool is_shared () const {
+    return 0 < shares ;
+  } ;
+  /*!
+   * One expression less holds \c e : it is deleted if it was the last one
+   * (nothing if NULL, and nodes of an \c Expr_Arena are left to it).
+   */
+  static void release ( Expr * e ) {
+    if ( NULL == e ) return ;
+    if ( 0 < e -> shares ) -- e -> shares ;
+    else if ( ! e -> in_arena ) delete e ;
+  } ;
   /*!
    * Evaluate the expression.
    * \return The double value of the expression. 
    */
   virtual double eval ( Evaluation_Context & ec ) const = 0 ;
   /*!
-   * Output the expression to \c cout .
+   * Evaluate the expression and its gradient in one pass (forward mode automatic differentiation).
+   * The value and the settings are the ones of \c eval .
+   * \param dc Context for the values and the gradients of the variables.
+   * \param result Set to the value of the expression and its derivative with respect to each slot.
+   */
+  void eval_dual ( Dual_Context & dc ,
+		   Dual & result ) const ;
+  /*!
+   * Write the expression on \c out , each node once (no temporary string is built).
    */
-  virtual std :: string toString () const = 0 ;
+  virtual void print ( std :: ostream & out ) const = 0 ;
+  /*!
+   * Return the expression as a string (written by \c print ).
+   */
+  std :: string toString () const ;
+  /*!
+   * Add the code of the expression at the end of \c b (postfix order).
+   * Running the code gives the value of \c eval .
+   */
+  virtual void compile ( Bytecode & b ) const = 0 ;
+  /*! Add the arguments of the expression (the nodes it holds) at the end of \c arguments . */
+  virtual void get_arguments ( std :: vector < Expr const * > & arguments ) const {} ;
+  /*! Add the nodes of the expression (each shared one once) to \c nodes . */
+  void collect ( std :: set < Expr const * > & nodes ) const ;
+  /*!
+   * Simplify the expression: constant sub-expressions are folded into a \c Constant
+   * and the identities x * 1 , 1 * x , x / 1 , x + 0 , 0 + x , x - 0 and log ( exp ( x ) ) are applied.
+   * The value of the expression and the order of the reading of the variables are kept
+   * (except that - 0 + 0 gives 0 , and log ( exp ( x ) ) gives x even where exp ( x ) overflows).
+   * \param done Result for each shared expression already simplified (empty at first).
+   * \return The simplified expression, made of the nodes of this one.
+   * \post The share of \c this held by the caller is given up:
+   * only the returned expression should be used.
+   */
+  Expr * optimize ( std :: map < Expr * , Expr * > & done ) ;
   /*!
    * Return the priority level of the expression.
    */
@@ -96,8 +221,16 @@ public:
   {} ; 
   /*! Destructor. */
   ~ Constant () {} ; 
-  std :: string  toString () const ; 
+  /*! Value of the constant. */
+  double get_value () const {
+    return value ;
+  } ;
+  void print ( std :: ostream & out ) const ;
   double eval ( Evaluation_Context & ec ) const ; 
+  void compile ( Bytecode & b ) const ;
+protected :
+  void compute_dual ( Dual_Context & dc ,
+		      Dual & result ) const ;
 } ; 
 
 
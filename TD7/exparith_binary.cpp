@@ -1,3 +1,4 @@
+# include "counters.hpp"
 # include "exparith_binary.hpp"
 
 
@@ -16,33 +17,110 @@ std :: string const sign_div = "/" ;
 
 
 double Op_Binary :: eval ( Evaluation_Context & ec ) const { 
-  if("+"==sign){
-    return left->eval(ec)+right->eval(ec);
+  COUNTER_ADD ( "Expr::eval" ) ;
+  double value ;
+  if ( get_cached ( ec , value ) ) return value ;
+  double const l = left -> eval ( ec ) ;
+  double const r = right -> eval ( ec ) ;
+  switch ( opcode ) {
+  case op_add :
+    value = l + r ;
+    break ;
+  case op_sub :
+    value = l - r ;
+    break ;
+  case op_mul :
+    value = l * r ;
+    break ;
+  default :
+    value = l / r ;
+    break ;
   }
-  else if("-"==sign){
-    return left->eval(ec)-right->eval(ec);
+  return set_cached ( ec , value ) ;
+}
+
+
+void Op_Binary :: compute_dual ( Dual_Context & dc ,
+				 Dual & result ) const {
+  left -> eval_dual ( dc , result ) ;
+  Dual r ;
+  right -> eval_dual ( dc , r ) ;
+  switch ( opcode ) {
+  case op_add :
+    result . add ( r ) ;
+    break ;
+  case op_sub :
+    result . sub ( r ) ;
+    break ;
+  case op_mul :
+    result . mul ( r ) ;
+    break ;
+  default :
+    result . div ( r ) ;
+    break ;
   }
-  else if("*"==sign){
-    return left->eval(ec)*right->eval(ec);
-  }else{
-    return left->eval(ec)/right->eval(ec);
+}
+
+
+void Op_Binary :: compile ( Bytecode & b ) const {
+  left -> compile ( b ) ;
+  right -> compile ( b ) ;
+  b . emit_operation ( opcode ) ;
+}
+
+
+void Op_Binary :: get_arguments ( vector < Expr const * > & arguments ) const {
+  arguments . push_back ( left ) ;
+  arguments . push_back ( right ) ;
+}
+
+
+Expr * Op_Binary :: simplify ( map < Expr * , Expr * > & done ) {
+  left = left -> optimize ( done ) ;
+  right = right -> optimize ( done ) ;
+  Constant const * const c_left = dynamic_cast < Constant const * > ( left ) ;
+  Constant const * const c_right = dynamic_cast < Constant const * > ( right ) ;
+  Expr * kept = NULL ;
+  if ( NULL != c_left && NULL != c_right ) {
+    kept = new Constant ( compute ( c_left -> get_value () , c_right -> get_value () ) ) ;
+  } else if ( NULL != c_right
+	      && ( ( 1 == c_right -> get_value () && ( op_mul == opcode || op_div == opcode ) )
+		   || ( 0 == c_right -> get_value () && ( op_add == opcode || op_sub == opcode ) ) ) ) {
+    kept = left -> share () ;
+  } else if ( NULL != c_left
+	      && ( ( 1 == c_left -> get_value () && op_mul == opcode )
+		   || ( 0 == c_left -> get_value () && op_add == opcode ) ) ) {
+    kept = right -> share () ;
   }
+  if ( NULL == kept ) return this ;
+  release ( this ) ;
+  return kept ;
 }
 
 
-string Op_Binary :: toString () const { 
-  string s1=left->toString();
-  string s2 = right->toString();
-  if(left->get_priority()<20) s1="( " + s1 + " )";
-  if(right->get_priority()<20) s2="( " + s2 + " )";
-  return s1+" "+sign+" "+s2;
+void Op_Binary :: print ( ostream & out ) const { 
+  if ( left -> get_priority () < 20 ) {
+    out << "( " ;
+    left -> print ( out ) ;
+    out << " )" ;
+  } else {
+    left -> print ( out ) ;
+  }
+  out << " " << sign << " " ;
+  if ( right -> get_priority () < 20 ) {
+    out << "( " ;
+    right -> print ( out ) ;
+    out << " )" ;
+  } else {
+    right -> print ( out ) ;
+  }
 }
 
 
 # define COMPUTE_BINARY( class , op )				\
     double class :: compute ( double left ,			\
     double right ) const {					\
-    return NAN ;						\
+    return left op right ;					\
   }
 
 COMPUTE_BINARY ( Add , + )
@@ -14,7 +14,9 @@
 # include "exparith.hpp"
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -36,6 +38,8 @@ extern std :: string const sign_div ;
 class Op_Binary : public Expr {
   /*! + ou - ou * ou / */
   std :: string sign ;
+  /*! Same as \c sign (op_add, op_sub, op_mul or op_div), so that \c eval is a switch. */
+  opcode_enum const opcode ;
   /*! argument à gauche de l'opérateur */
   Expr * left ; 
   /*! argument à droite de l'opérateur */
@@ -44,25 +48,36 @@ public:
   // CONSTRUCTOR 
   Op_Binary ( priority_enum priority , 
 	      std :: string sign , 
+	      opcode_enum opcode ,
 	      Expr * left , 
 	      Expr * right ) 
     : Expr ( priority ) 
     , sign ( sign ) 
+    , opcode ( opcode )
     , left ( left ) 
     , right ( right ) 
   {} ; 
   /*! Destructor. */
   ~ Op_Binary () {
-    delete left ; 
-    delete right ; 
+    release ( left ) ; 
+    release ( right ) ; 
   } ; 
-  std :: string  toString () const ; 
+  void print ( std :: ostream & out ) const ;
   /*! Ensures that left is evaluated before right. */
   double eval ( Evaluation_Context & ec ) const ;
+  void compile ( Bytecode & b ) const ;
+  void get_arguments ( std :: vector < Expr const * > & arguments ) const ;
   /*! renvoie l'opérateur */
   std :: string get_sign () const ; 
+  /*! The operator, as an instruction of \c Bytecode . */
+  opcode_enum get_opcode () const {
+    return opcode ;
+  } ;
 protected :
-  /*!  */
+  Expr * simplify ( std :: map < Expr * , Expr * > & done ) ;
+  void compute_dual ( Dual_Context & dc ,
+		      Dual & result ) const ;
+  /*! The operation (used to fold constants, \c eval inlines it). */
   virtual double compute ( double left ,
 			   double right ) const = 0 ;
 } ; 
@@ -72,13 +87,14 @@ protected :
 //
 // SAME
 //
-# define CLASS_OP_BINARY( name , priority, sign )	\
+# define CLASS_OP_BINARY( name , priority, sign , opcode )	\
   class name : public Op_Binary {			\
   public:						\
   name ( Expr * exp1 ,					\
 	 Expr * exp2 )					\
     : Op_Binary ( priority				\
 		  , sign				\
+		  , opcode				\
 		  , exp1				\
 		  , exp2 ) {} ;				\
   /*! Destructor. */					\
@@ -89,10 +105,10 @@ protected :
   } ; 
 
 
-CLASS_OP_BINARY ( Add , priority_add_sub , sign_add )
-CLASS_OP_BINARY ( Sub , priority_add_sub , sign_sub )
-CLASS_OP_BINARY ( Mul , priority_mul_div , sign_mul )
-CLASS_OP_BINARY ( Div , priority_mul_div , sign_div )
+CLASS_OP_BINARY ( Add , priority_add_sub , sign_add , op_add )
+CLASS_OP_BINARY ( Sub , priority_add_sub , sign_sub , op_sub )
+CLASS_OP_BINARY ( Mul , priority_mul_div , sign_mul , op_mul )
+CLASS_OP_BINARY ( Div , priority_mul_div , sign_div , op_div )
 
 
 
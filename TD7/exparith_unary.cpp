@@ -1,3 +1,4 @@
+# include "counters.hpp"
 # include "exparith_unary.hpp"
 
 
@@ -16,17 +17,69 @@ std :: string const sign_log = "log" ;
 
 
 double Op_Unary :: eval ( Evaluation_Context & ec ) const { 
-  if("exp"==sign){
-    return exp(argument->eval(ec));
-  }else if("log"==sign){
-    return log(argument->eval(ec));
+  COUNTER_ADD ( "Expr::eval" ) ;
+  double value ;
+  if ( get_cached ( ec , value ) ) return value ;
+  double const x = argument -> eval ( ec ) ;
+  switch ( opcode ) {
+  case op_exp :
+    value = exp ( x ) ;
+    break ;
+  default :
+    value = log ( x ) ;
+    break ;
   }
-  return NAN;
+  return set_cached ( ec , value ) ;
 }
 
 
-string Op_Unary :: toString () const { 
-  return sign+" ( "+argument->toString()+" )";
+void Op_Unary :: compute_dual ( Dual_Context & dc ,
+				Dual & result ) const {
+  argument -> eval_dual ( dc , result ) ;
+  switch ( opcode ) {
+  case op_exp :
+    result . exp () ;
+    break ;
+  default :
+    result . log () ;
+    break ;
+  }
+}
+
+
+void Op_Unary :: compile ( Bytecode & b ) const {
+  argument -> compile ( b ) ;
+  b . emit_operation ( opcode ) ;
+}
+
+
+void Op_Unary :: get_arguments ( vector < Expr const * > & arguments ) const {
+  arguments . push_back ( argument ) ;
+}
+
+
+Expr * Op_Unary :: simplify ( map < Expr * , Expr * > & done ) {
+  argument = argument -> optimize ( done ) ;
+  Expr * kept = NULL ;
+  Constant const * const c = dynamic_cast < Constant const * > ( argument ) ;
+  if ( NULL != c ) {
+    kept = new Constant ( compute ( c -> get_value () ) ) ;
+  } else {
+    Op_Unary const * const inner = dynamic_cast < Op_Unary const * > ( argument ) ;
+    if ( op_log == opcode && NULL != inner && op_exp == inner -> opcode ) {
+      kept = inner -> argument -> share () ;
+    }
+  }
+  if ( NULL == kept ) return this ;
+  release ( this ) ;
+  return kept ;
+}
+
+
+void Op_Unary :: print ( ostream & out ) const { 
+  out << sign << " ( " ;
+  argument -> print ( out ) ;
+  out << " )" ;
 }
 
 
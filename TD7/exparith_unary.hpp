@@ -14,7 +14,9 @@
 # include "exparith.hpp"
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 /*! Symbol for operator \c exp . */
@@ -27,27 +29,40 @@ extern std :: string const sign_log ;
 class Op_Unary : public Expr {
   /*! Exp ou Log */
   std :: string sign ;
+  /*! Same as \c sign (op_exp or op_log), so that \c eval is a switch. */
+  opcode_enum const opcode ;
   /*! Valeur à laquelle on applique l'opérateur */
   Expr * argument ;
 public:
   // CONSTRUCTOR
   Op_Unary ( priority_enum priority ,
 	     std :: string sign ,
+	     opcode_enum opcode ,
 	     Expr * exp ) 
     : Expr ( priority ) 
     , sign ( sign ) 
+    , opcode ( opcode )
     , argument ( exp ) 
   {
     assert ( NULL != exp ) ;
   } ; 
   /*! Destructor. */
   ~ Op_Unary () {
-    delete argument ; 
+    release ( argument ) ; 
   } ;
-  std :: string  toString () const ; 
+  void print ( std :: ostream & out ) const ;
   double eval ( Evaluation_Context & ec ) const ;
+  void compile ( Bytecode & b ) const ;
+  void get_arguments ( std :: vector < Expr const * > & arguments ) const ;
+  /*! The operator, as an instruction of \c Bytecode . */
+  opcode_enum get_opcode () const {
+    return opcode ;
+  } ;
 protected :
-  /*! ??? */
+  Expr * simplify ( std :: map < Expr * , Expr * > & done ) ;
+  void compute_dual ( Dual_Context & dc ,
+		      Dual & result ) const ;
+  /*! The operation (used to fold constants, \c eval inlines it). */
   virtual double compute ( double x ) const = 0 ;
 } ; 
 
@@ -59,20 +74,21 @@ protected :
 // in C++11 lambda / functional approach even better
 //
 /*! This is used to defined simpli similar things: classes for binary operators. */
-# define CLASS_OP_UNARY( name , priority , sign )	\
+# define CLASS_OP_UNARY( name , priority , sign , opcode )	\
   class name : public Op_Unary {			\
   public:						\
   name ( Expr * Exp )					\
     : Op_Unary ( priority ,				\
 		 sign ,					\
+		 opcode ,				\
 		 Exp ) {} ;				\
   ~ name () {} ;					\
   protected :						\
   double compute ( double x ) const ;			\
   } ; 
 
-CLASS_OP_UNARY ( Exp , priority_exp_log , sign_exp )
-CLASS_OP_UNARY ( Log , priority_exp_log , sign_log )
+CLASS_OP_UNARY ( Exp , priority_exp_log , sign_exp , op_exp )
+CLASS_OP_UNARY ( Log , priority_exp_log , sign_log , op_log )
 
 
 
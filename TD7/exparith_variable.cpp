@@ -1,3 +1,4 @@
+# include "counters.hpp"
 # include "exparith_variable.hpp"
 
 
@@ -12,22 +13,63 @@ std :: string const sign_set = ":=" ;
 
 
 double Variable :: eval ( Evaluation_Context & ec ) const{ 
-  return ec.get_value(id);
+  COUNTER_ADD ( "Expr::eval" ) ;
+  return ec.get_value(slot,id);
 }
 
 
-string Variable :: toString () const { 
-  return id;
+void Variable :: print ( ostream & out ) const { 
+  out << id ;
 } 
 
 
+void Variable :: compile ( Bytecode & b ) const {
+  b . emit_variable ( id , slot ) ;
+}
+
+
 double Set :: eval ( Evaluation_Context & ec ) const { 
-  ec.valuate(variable->get_id(),(double) value->eval(ec));
-  return value->eval(ec);
+  COUNTER_ADD ( "Expr::eval" ) ;
+  double const v = value->eval(ec);
+  ec.valuate(variable->get_slot(),variable->get_id(),v);
+  ec.new_epoch();
+  return v;
+}
+
+void Variable :: compute_dual ( Dual_Context & dc ,
+				Dual & result ) const {
+  dc . read ( slot , id , result ) ;
+}
+
+
+void Set :: compute_dual ( Dual_Context & dc ,
+			   Dual & result ) const {
+  value -> eval_dual ( dc , result ) ;
+  dc . valuate ( variable -> get_slot () , variable -> get_id () , result ) ;
+}
+
+
+void Set :: compile ( Bytecode & b ) const {
+  value -> compile ( b ) ;
+  b . emit_set ( variable -> get_id () , variable -> get_slot () ) ;
+}
+
+
+void Set :: get_arguments ( vector < Expr const * > & arguments ) const {
+  arguments . push_back ( variable ) ;
+  arguments . push_back ( value ) ;
 }
 
-string Set :: toString () const { 
-  string s="";
-  return s+variable->toString()+ " := "+value->toString();
+
+Expr * Set :: simplify ( map < Expr * , Expr * > & done ) {
+  value = value -> optimize ( done ) ;
+  return this ;
+}
+
+
+void Set :: print ( ostream & out ) const { 
+  variable -> print ( out ) ;
+  out << " := " ;
+  value -> print ( out ) ;
 }
 
@@ -14,7 +14,9 @@
 # include "exparith.hpp"
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 /*! Symbol for operator \c := . */
@@ -29,20 +31,34 @@ extern std :: string const sign_set ;
 class Variable : public Expr {
   /* Variable name. */
   std :: string const id ;
+  /* Variable slot in the \c Symbol_Table of the expression, if any. */
+  unsigned int const slot ;
 public :
   // CONSTRUCTORS
-  Variable ( std :: string const & _id
+  /*!
+   * \param _id Variable name.
+   * \param _slot Slot of \c _id in the \c Symbol_Table used to load the expression
+   * (contexts with slots then find the value without looking for the name).
+   */
+  Variable ( std :: string const & _id ,
+	     unsigned int _slot = Symbol_Table :: none
 	     ) 
     : Expr ( priority_var_con ) 
     , id ( _id )
+    , slot ( _slot )
   {
     assert ( "" != _id ) ;
   } ; 
   /*! Destructor. */
   ~ Variable () {} ;
   std :: string const & get_id () { return id ; }
+  unsigned int get_slot () const { return slot ; }
   double eval ( Evaluation_Context & ec ) const ;
-  std :: string  toString () const ; 
+  void print ( std :: ostream & out ) const ;
+  void compile ( Bytecode & b ) const ;
+protected :
+  void compute_dual ( Dual_Context & dc ,
+		      Dual & result ) const ;
 } ; 
 
 
@@ -50,6 +66,8 @@ public :
  * This is the affectation operation.
  * Left operand (or first in postfix form) should be a variable.
  * The value of the expression is the one of affected to the value.
+ * Its value is computed once, and a new epoch of the context starts after the setting
+ * (the values cached by the shared expressions may have changed).
  */
 class Set : public Expr {
   /*! Variable to valuate. */
@@ -69,11 +87,27 @@ public:
   } ; 
   /*! Destructor. */
   ~ Set () {
-    delete variable ; 
-    delete value ; 
+    release ( variable ) ; 
+    release ( value ) ; 
   } ; 
-  std :: string  toString () const ; 
+  /*! Variable to valuate. */
+  Variable const * get_variable () const {
+    return variable ;
+  } ;
+  /*! Expression to compute its value. */
+  Expr const * get_value () const {
+    return value ;
+  } ;
+  void print ( std :: ostream & out ) const ;
   double eval ( Evaluation_Context & ec ) const ;
+  void compile ( Bytecode & b ) const ;
+  void get_arguments ( std :: vector < Expr const * > & arguments ) const ;
+protected :
+  /*! Only the value is simplified. */
+  Expr * simplify ( std :: map < Expr * , Expr * > & done ) ;
+  /*! The variable gets the gradient of the value. */
+  void compute_dual ( Dual_Context & dc ,
+		      Dual & result ) const ;
 } ; 
 
 
@@ -0,0 +1,36 @@
+# include "counters.hpp"
+# include "expr_arena.hpp"
+
+
+using namespace std ;
+
+
+void * Expr_Arena :: allocate ( size_t size ) {
+  // keep the next node aligned
+  size = ( size + alignment - 1 ) / alignment * alignment ;
+  assert ( size <= block_size ) ;
+  COUNTER_ADD ( "Expr_Arena::allocate" ) ;
+  if ( left < size ) {
+    COUNTER_ADD ( "Expr_Arena blocks" ) ;
+    blocks . push_back ( new char [ block_size ] ) ;
+    left = block_size ;
+  }
+  void * const room = blocks . back () + ( block_size - left ) ;
+  left -= size ;
+  return room ;
+}
+
+
+Expr_Arena :: ~ Expr_Arena () {
+  // parents are built after their arguments, so they are destroyed before
+  for ( vector < Expr * > :: reverse_iterator it = nodes . rbegin () ;
+	it != nodes . rend () ;
+	++ it ) {
+    ( * it ) -> ~ Expr () ;
+  }
+  for ( vector < char * > :: iterator it = blocks . begin () ;
+	it != blocks . end () ;
+	++ it ) {
+    delete [] * it ;
+  }
+}
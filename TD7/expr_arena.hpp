@@ -0,0 +1,84 @@
+# ifndef __EXPR_ARENA_HPP_
+# define __EXPR_ARENA_HPP_
+
+/*!
+ * \file
+ * This module provides an arena for the nodes of arithmetical expressions:
+ * they are allocated in large blocks, one after the other, and are all released with the arena.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <cstddef>
+# include <new>
+# include <vector>
+
+# include "exparith.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+
+/*!
+ * Owner of the nodes built by \c make .
+ * \c Expr :: release does not delete these nodes, they are destroyed in the reverse order of
+ * their creation and their memory is freed block by block by the destructor of the arena.
+ * Nodes built by plain \c new (e.g. by \c Expr :: optimize ) may be mixed with them.
+ */
+class Expr_Arena {
+  /*! Size of a block (a node should be much smaller). */
+  static std :: size_t const block_size = 64 * 1024 ;
+  /*! Alignment of the nodes in a block. */
+  static std :: size_t const alignment = 16 ;
+  /*! The blocks, in order. */
+  std :: vector < char * > blocks ;
+  /*! Free room left at the end of the last block. */
+  std :: size_t left ;
+  /*! The nodes, in creation order. */
+  std :: vector < Expr * > nodes ;
+  /*! Room for a node of \c size bytes. */
+  void * allocate ( std :: size_t size ) ;
+  /*! Record a node built in the arena. */
+  template < class T >
+  T * hold ( T * e ) {
+    e -> in_arena = true ;
+    nodes . push_back ( e ) ;
+    return e ;
+  }
+  /*! Not copyable. */
+  Expr_Arena ( Expr_Arena const & ) ;
+  Expr_Arena & operator = ( Expr_Arena const & ) ;
+public :
+  /*! Empty arena. */
+  Expr_Arena ()
+    : left ( 0 )
+  {} ;
+  /*!
+   * Build a node of class \c T in the arena (as \c new \c T ( a1 ) ).
+   */
+  template < class T , class A1 >
+  T * make ( A1 const & a1 ) {
+    return hold ( new ( allocate ( sizeof ( T ) ) ) T ( a1 ) ) ;
+  }
+  /*!
+   * Build a node of class \c T in the arena (as \c new \c T ( a1 , a2 ) ).
+   */
+  template < class T , class A1 , class A2 >
+  T * make ( A1 const & a1 ,
+	     A2 const & a2 ) {
+    return hold ( new ( allocate ( sizeof ( T ) ) ) T ( a1 , a2 ) ) ;
+  }
+  /*! Number of nodes built in the arena. */
+  unsigned int size () const {
+    return nodes . size () ;
+  } ;
+  /*! Destroy the nodes and free the blocks. */
+  ~ Expr_Arena () ;
+} ;
+
+
+# endif
@@ -1,3 +1,6 @@
+# include <cctype>
+# include <cstring>
+# include <set>
 # include <stack>
 # include <stdlib.h>
 
@@ -20,13 +23,110 @@ using namespace std ;
 
 string const sign_read_stop = "." ;
 
+namespace {
+
+  /*!
+   * Scanner of the tokens of an expression in a buffer: operators, numbers and variables, separated by spaces.
+   * The text of each token is copied in the same string, the numbers are read by \c strtod .
+   */
+  class Scanner {
+    /*! Next character to read. */
+    char const * next ;
+    /*! End of the buffer. */
+    char const * const end ;
+  public :
+    Scanner ( char const * begin ,
+	      char const * _end )
+      : next ( begin )
+      , end ( _end )
+    {}
+    /*!
+     * Read the next token.
+     * \param token Set to the text of the token.
+     * \param is_number Set to whether the token is a number (it starts with a digit or a point,
+     * after a sign if any, and is not the stop sign).
+     * \param value Set to the value of a number.
+     * \return false iff there is no token left.
+     */
+    bool scan ( string & token ,
+		bool & is_number ,
+		double & value ) {
+      while ( next != end && isspace ( ( unsigned char ) * next ) ) ++ next ;
+      if ( next == end ) return false ;
+      char const * const first = next ;
+      while ( next != end && ! isspace ( ( unsigned char ) * next ) ) ++ next ;
+      size_t const length = next - first ;
+      token . assign ( first , length ) ;
+      char const * digits = first ;
+      if ( 1 < length && ( '-' == * digits || '+' == * digits ) ) ++ digits ;
+      is_number = ( isdigit ( ( unsigned char ) * digits ) || '.' == * digits ) && sign_read_stop != token ;
+      if ( is_number ) {
+	// the token is not followed by a '\0' in the buffer
+	value = strtod ( token . c_str () , NULL ) ;
+      }
+      return true ;
+    }
+  } ;
+
+
+  /*! Key of a sub-expression: token and arguments (NULL if none). */
+  typedef pair < string , pair < Expr * , Expr * > > Node_Key ;
+
+  /*!
+   * Sub-expressions already built while loading, so that identical ones are shared (hash-consing).
+   * The ones with a setting are not shared: they have to be evaluated each time.
+   */
+  class Hash_Cons {
+    /*! Sub-expressions without setting, by key. */
+    map < Node_Key , Expr * > nodes ;
+    /*! Sub-expressions with a setting. */
+    set < Expr const * > with_set ;
+    /*! \return true iff the arguments of \c key have no setting. */
+    bool is_pure ( Node_Key const & key ) const {
+      return with_set . end () == with_set . find ( key . second . first )
+	&& with_set . end () == with_set . find ( key . second . second ) ;
+    }
+  public :
+    /*!
+     * Look for a sub-expression.
+     * \return The sub-expression of \c key , shared once more, or NULL.
+     * \post If found, the shares of the arguments of \c key are given up.
+     */
+    Expr * find ( Node_Key const & key ) {
+      if ( ! is_pure ( key ) ) return NULL ;
+      map < Node_Key , Expr * > :: iterator it = nodes . find ( key ) ;
+      if ( nodes . end () == it ) return NULL ;
+      Expr :: release ( key . second . first ) ;
+      Expr :: release ( key . second . second ) ;
+      return it -> second -> share () ;
+    }
+    /*!
+     * Record a new sub-expression.
+     * \param with_setting Whether \c e sets a variable itself.
+     * \return \c e .
+     */
+    Expr * add ( Node_Key const & key ,
+		 Expr * e ,
+		 bool with_setting = false ) {
+      if ( with_setting || ! is_pure ( key ) ) with_set . insert ( e ) ;
+      else nodes [ key ] = e ;
+      return e ;
+    }
+  } ;
+
+}
+
+
 // help write a lot of simular cases
 # define CASE_UNARY( sign , exp )		\
   else if ( sign == string_read ) {		\
     assert ( 1 <= l . size () ) ;		\
     Expr * f = l.top () ; 			\
     l.pop () ;					\
-    l.push ( new exp ( f ) ) ;			\
+    Node_Key const key ( string_read , pair < Expr * , Expr * > ( f , NULL ) ) ; \
+    Expr * e = cons . find ( key ) ;		\
+    if ( NULL == e ) e = cons . add ( key , arena . make < exp > ( f ) ) ; \
+    l.push ( e ) ;				\
   }
 
 
@@ -38,17 +138,101 @@ string const sign_read_stop = "." ;
     l.pop () ;					\
     Expr * f2 = l.top () ;			\
     l.pop () ;					\
-    l.push ( new exp ( f2 , f1) ) ;		\
+    Node_Key const key ( string_read , pair < Expr * , Expr * > ( f2 , f1 ) ) ; \
+    Expr * e = cons . find ( key ) ;		\
+    if ( NULL == e ) e = cons . add ( key , arena . make < exp > ( f2 , f1 ) ) ; \
+    l.push ( e ) ;				\
   }
     
-Loader_Evaluator :: Loader_Evaluator ( istream & postfixe_stream ) {
-	assert(NULL!=postfixe_stream);
+Loader_Evaluator :: Loader_Evaluator ( istream & postfixe_stream )
+  : code ( NULL )
+  , nodes_saved ( 0 )
+  , has_setting ( false )
+  , synced_context ( NULL )
+  , synced_change ( 0 )
+  , nb_invalidated ( 0 )
+  , symbols ( own_symbols ) {
+  load ( postfixe_stream ) ;
+}
+
+
+Loader_Evaluator :: Loader_Evaluator ( istream & postfixe_stream ,
+				       Symbol_Table & _symbols )
+  : code ( NULL )
+  , nodes_saved ( 0 )
+  , has_setting ( false )
+  , synced_context ( NULL )
+  , synced_change ( 0 )
+  , nb_invalidated ( 0 )
+  , symbols ( _symbols ) {
+  load ( postfixe_stream ) ;
+}
+
+
+Loader_Evaluator :: Loader_Evaluator ( char const * begin ,
+				       char const * end )
+  : code ( NULL )
+  , nodes_saved ( 0 )
+  , has_setting ( false )
+  , synced_context ( NULL )
+  , synced_change ( 0 )
+  , nb_invalidated ( 0 )
+  , symbols ( own_symbols ) {
+  load ( begin , end ) ;
+}
+
+
+Loader_Evaluator :: Loader_Evaluator ( char const * begin ,
+				       char const * end ,
+				       Symbol_Table & _symbols )
+  : code ( NULL )
+  , nodes_saved ( 0 )
+  , has_setting ( false )
+  , synced_context ( NULL )
+  , synced_change ( 0 )
+  , nb_invalidated ( 0 )
+  , symbols ( _symbols ) {
+  load ( begin , end ) ;
+}
+
+
+void Loader_Evaluator :: load ( istream & postfixe_stream ) {
+	// copy the characters up to the stop sign (alone between spaces),
+	// the rest is left on the stream
+	std::vector<char> buffer;
+	streambuf * const sb = postfixe_stream.rdbuf();
+	int previous = ' ';
+	for(int c=sb->sbumpc();char_traits<char>::eof()!=c;c=sb->sbumpc()){
+		buffer.push_back((char) c);
+		if(sign_read_stop[0]==c && isspace(previous)){
+			int const following=sb->sgetc();
+			if(char_traits<char>::eof()==following || isspace(following)) break;
+		}
+		previous=c;
+	}
+	char const * const begin = buffer.empty() ? NULL : &buffer[0];
+	load(begin,begin+buffer.size());
+}
+
+
+void Loader_Evaluator :: load ( char const * begin ,
+				char const * end ) {
+	Scanner scanner(begin,end);
 	string string_read;
-	postfixe_stream >> string_read;
+	bool is_number;
+	double d;
 	std::stack<Expr*> l;
-	while(true){
+	Hash_Cons cons;
+	while(scanner.scan(string_read,is_number,d)){
 		if(string_read==sign_read_stop)  break;
 
+		else if(is_number){
+			Node_Key const key(string_read,pair<Expr*,Expr*>(NULL,NULL));
+			Expr * e = cons.find(key);
+			if(NULL==e) e = cons.add(key,arena.make<Constant>(d));
+			l.push(e);
+		}
+
 		CASE_BINARY("*",Mul)
 		
 		CASE_BINARY("/",Div)
@@ -67,25 +251,19 @@ Loader_Evaluator :: Loader_Evaluator ( istream & postfixe_stream ) {
     			l.pop () ;		
     			Expr * f2 = l.top () ;
     			l.pop () ;		
-			l.push(new Set((Variable*) f2,f1));
+			Node_Key const key(string_read,pair<Expr*,Expr*>(f2,f1));
+			l.push(cons.add(key,arena.make<Set>((Variable*) f2,f1),true));
 		}
-		/*else if(isalpha(string_read[0]))
-				l.push(new Variable(string_read));*/
 		else {
-				/*double d = atof(string_read.c_str());
-				l.push(new Constant(d));*/
-			double d;
-			std::istringstream iss(string_read);
-			if(iss >>d){
-				l.push(new Constant(d));
-			}
-			else  l.push(new Variable(string_read));
+			Node_Key const key(string_read,pair<Expr*,Expr*>(NULL,NULL));
+			Expr * e = cons.find(key);
+			if(NULL==e) e = cons.add(key,arena.make<Variable>(string_read,symbols.intern(string_read)));
+			l.push(e);
 		}
-		postfixe_stream >> string_read;
 	}
+	assert(1==l.size());
 	expression=l.top();
 	l.pop();
-	assert(0==l.size());	
 }
 
 
@@ -122,5 +300,163 @@ double Loader_Evaluator :: evaluate ( istream & in ) {
 
 
 double Loader_Evaluator :: evaluate ( Evaluation_Context & ec ) { 
+  ec.new_epoch();
   return expression->eval(ec);
+}
+
+
+double Loader_Evaluator :: evaluate_gradient ( Evaluation_Context & ec ,
+					       vector < double > & gradient ) {
+  ec . new_epoch () ;
+  Dual_Context dc ( ec , symbols . size () ) ;
+  Dual result ;
+  expression -> eval_dual ( dc , result ) ;
+  gradient . swap ( result . gradient ) ;
+  return result . value ;
+}
+
+
+void Loader_Evaluator :: build_parents () {
+  parents . clear () ;
+  readers . clear () ;
+  has_setting = false ;
+  set < Expr const * > nodes ;
+  expression -> collect ( nodes ) ;
+  for ( set < Expr const * > :: const_iterator it = nodes . begin () ;
+	it != nodes . end () ;
+	++ it ) {
+    vector < Expr const * > arguments ;
+    ( * it ) -> get_arguments ( arguments ) ;
+    for ( unsigned int k = 0 ; k < arguments . size () ; k ++ ) {
+      parents [ arguments [ k ] ] . push_back ( * it ) ;
+    }
+    if ( NULL != dynamic_cast < Set const * > ( * it ) ) has_setting = true ;
+    Variable const * const v = dynamic_cast < Variable const * > ( * it ) ;
+    if ( NULL != v && Symbol_Table :: none != v -> get_slot () ) {
+      if ( readers . size () <= v -> get_slot () ) readers . resize ( v -> get_slot () + 1 ) ;
+      readers [ v -> get_slot () ] . push_back ( v ) ;
+    }
+  }
+}
+
+
+double Loader_Evaluator :: evaluate_incremental ( Evaluation_Context_Incremental & ec ) {
+  nb_invalidated = 0 ;
+  if ( parents . empty () ) build_parents () ;
+  if ( has_setting ) {
+    ec . new_epoch () ;
+  } else if ( & ec != synced_context ) {
+    // values cached for another context (at another epoch) may be taken for valid ones
+    set < Expr const * > nodes ;
+    expression -> collect ( nodes ) ;
+    for ( set < Expr const * > :: const_iterator it = nodes . begin () ;
+	  it != nodes . end () ;
+	  ++ it ) {
+      if ( ( * it ) -> invalidate () ) ++ nb_invalidated ;
+    }
+  } else if ( synced_change < ec . get_last_change () ) {
+    // from the variables changed up, stopping at the nodes already invalid
+    // (their holders are too: they are computed again together)
+    vector < Expr const * > to_visit ;
+    unsigned int const nb_slots = ( ec . nb_changes () < readers . size () ) ? ec . nb_changes () : readers . size () ;
+    for ( unsigned int slot = 0 ; slot < nb_slots ; slot ++ ) {
+      if ( synced_change < ec . get_change ( slot ) ) {
+	to_visit . insert ( to_visit . end () , readers [ slot ] . begin () , readers [ slot ] . end () ) ;
+      }
+    }
+    while ( ! to_visit . empty () ) {
+      Expr const * const e = to_visit . back () ;
+      to_visit . pop_back () ;
+      vector < Expr const * > const & holders = parents [ e ] ;
+      for ( unsigned int k = 0 ; k < holders . size () ; k ++ ) {
+	if ( holders [ k ] -> invalidate () ) {
+	  ++ nb_invalidated ;
+	  to_visit . push_back ( holders [ k ] ) ;
+	}
+      }
+    }
+  }
+  synced_context = & ec ;
+  synced_change = ec . get_last_change () ;
+  return expression -> eval ( ec ) ;
+}
+
+
+void Loader_Evaluator :: get_slots ( set < unsigned int > & read ,
+				     set < unsigned int > & written ) const {
+  set < Expr const * > visited ;
+  vector < Expr const * > to_visit ( 1 , expression ) ;
+  while ( ! to_visit . empty () ) {
+    Expr const * const e = to_visit . back () ;
+    to_visit . pop_back () ;
+    if ( ! visited . insert ( e ) . second ) continue ;
+    Set const * const s = dynamic_cast < Set const * > ( e ) ;
+    if ( NULL != s ) {
+      // the variable of a setting is not read
+      written . insert ( s -> get_variable () -> get_slot () ) ;
+      to_visit . push_back ( s -> get_value () ) ;
+      continue ;
+    }
+    Variable const * const v = dynamic_cast < Variable const * > ( e ) ;
+    if ( NULL != v ) read . insert ( v -> get_slot () ) ;
+    e -> get_arguments ( to_visit ) ;
+  }
+}
+
+
+unsigned int Loader_Evaluator :: nb_nodes () const {
+  set < Expr const * > nodes ;
+  expression -> collect ( nodes ) ;
+  return nodes . size () ;
+}
+
+
+unsigned int Loader_Evaluator :: optimize () {
+  set < Expr const * > before ;
+  expression -> collect ( before ) ;
+  map < Expr * , Expr * > done ;
+  expression = expression -> optimize ( done ) ;
+  set < Expr const * > after ;
+  expression -> collect ( after ) ;
+  unsigned int const saved = ( after . size () < before . size () ) ? before . size () - after . size () : 0 ;
+  nodes_saved += saved ;
+  delete code ;
+  code = NULL ;
+  parents . clear () ;
+  readers . clear () ;
+  synced_context = NULL ;
+  return saved ;
+}
+
+
+Bytecode const & Loader_Evaluator :: compile () {
+  if ( NULL == code ) {
+    code = new Bytecode () ;
+    expression -> compile ( * code ) ;
+  }
+  return * code ;
+}
+
+
+double Loader_Evaluator :: evaluate_compiled ( istream & in ) {
+  Evaluation_Context_IStream ec ( in ) ;
+  return evaluate_compiled ( ec ) ;
+}
+
+
+double Loader_Evaluator :: evaluate_compiled ( Evaluation_Context & ec ) {
+  return compile () . run ( ec ) ;
+}
+
+
+void Loader_Evaluator :: evaluate_batch ( map < string , double const * > const & columns ,
+					  unsigned int n ,
+					  double * out ) {
+  vector < string > const & variables = compile () . get_variables () ;
+  vector < double const * > by_slot ( variables . size () , NULL ) ;
+  for ( unsigned int s = 0 ; s < variables . size () ; s ++ ) {
+    map < string , double const * > :: const_iterator it = columns . find ( variables [ s ] ) ;
+    if ( columns . end () != it ) by_slot [ s ] = it -> second ;
+  }
+  compile () . run_batch ( by_slot , n , out ) ;
 }
\ No newline at end of file
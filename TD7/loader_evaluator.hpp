@@ -13,11 +13,17 @@
 
 
 # include <list>
+# include <map>
+# include <set>
 # include <istream>
 
 # include "exparith.hpp"
+# include "bytecode.hpp"
+# include "expr_arena.hpp"
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -28,19 +34,82 @@ extern std :: string const sign_read_stop ;
 
 /*!
  * This class is used to read an expression in postfix form on an input stream and then to evaluate it at will.
+ * Identical sub-expressions without setting are shared when read (the expression is a DAG),
+ * each one is then computed once per evaluation.
  */
 class Loader_Evaluator {
+  /*! Owner of the nodes read (they are built and freed without a heap call each). */
+  Expr_Arena arena ;
   /*! Expression read on the \c postfixe_stream. 
     Ready for evaluation. */
   Expr * expression ;
+  /*! Code of \c expression, built by the first call to \c compile (NULL before). */
+  Bytecode * code ;
+  /*! Number of nodes removed from \c expression by \c optimize . */
+  unsigned int nodes_saved ;
+  /*! The nodes holding each node of \c expression (built by \c evaluate_incremental ). */
+  std :: map < Expr const * , std :: vector < Expr const * > > parents ;
+  /*! The variable nodes of \c expression , by slot (built with \c parents ). */
+  std :: vector < std :: vector < Expr const * > > readers ;
+  /*! Whether \c expression has a setting (built with \c parents ). */
+  bool has_setting ;
+  /*! Context of the last call to \c evaluate_incremental (NULL if none). */
+  Evaluation_Context_Incremental const * synced_context ;
+  /*! Last stamp of \c synced_context taken into account. */
+  unsigned long synced_change ;
+  /*! Number of operators invalidated by the last call to \c evaluate_incremental . */
+  unsigned int nb_invalidated ;
+  /*! Fill \c parents and \c readers . */
+  void build_parents () ;
+  /*! Table used when none is given to the constructor. */
+  Symbol_Table own_symbols ;
+  /*! Slots of the variables of \c expression . */
+  Symbol_Table & symbols ;
+  /*! Read the expression (for the constructors). */
+  void load ( std :: istream & postfixe_stream ) ;
+  /*! Read the expression in a buffer (for the constructors). */
+  void load ( char const * begin ,
+	      char const * end ) ;
 public:
   /*! 
    * Constructor.
    * Elements of the expression should be separated by spaces.
    * The expression reading stops when a point (\c '.' ) is read.
+   * The variables get slots in a table of their own (see \c get_symbols ).
    * \param postfixe_stream
    */
   Loader_Evaluator ( std :: istream & postfixe_stream ) ;
+  /*! 
+   * Same as above, but the variables get their slots in \c symbols ,
+   * so that expressions loaded with the same table can share an \c Evaluation_Context_Slots .
+   * \param postfixe_stream
+   * \param symbols Table for the slots of the variables.
+   */
+  Loader_Evaluator ( std :: istream & postfixe_stream ,
+		     Symbol_Table & symbols ) ;
+  /*!
+   * Same as above, but the expression is read in the buffer [ \c begin , \c end ) ,
+   * e.g. a whole file read at once or mapped in memory (reading stops at the stop sign).
+   * \param begin First character.
+   * \param end Character past the last one.
+   */
+  Loader_Evaluator ( char const * begin ,
+		     char const * end ) ;
+  /*! Same as above, with the table \c symbols for the slots of the variables. */
+  Loader_Evaluator ( char const * begin ,
+		     char const * end ,
+		     Symbol_Table & symbols ) ;
+  /*!
+   * Slots of the variables read and of the variables set by the held expression.
+   * \param read Filled with the slots of the variables read.
+   * \param written Filled with the slots of the variables set.
+   */
+  void get_slots ( std :: set < unsigned int > & read ,
+		   std :: set < unsigned int > & written ) const ;
+  /*! Table of the slots of the variables, e.g. to build an \c Evaluation_Context_Slots . */
+  Symbol_Table & get_symbols () {
+    return symbols ;
+  } ;
   /*!
    * Evaluate the held expression with a given context.
    * \param ec Context for the evaluation.
@@ -53,9 +122,82 @@ public:
    * \return The computed value.
    */
   double evaluate ( std :: istream & in ) ;
+  /*!
+   * Evaluate the held expression and its gradient in one pass (see \c Expr :: eval_dual ),
+   * instead of one evaluation per variable for finite differences.
+   * \param ec Context for the evaluation.
+   * \param gradient Set to the derivative with respect to each slot of \c get_symbols .
+   * \return The computed value.
+   */
+  double evaluate_gradient ( Evaluation_Context & ec ,
+			     std :: vector < double > & gradient ) ;
+  /*!
+   * Evaluate the held expression again after some variables changed in \c ec :
+   * only the operators reading them (directly or not) are computed again,
+   * the others give the value cached by the previous call.
+   * The first call with a context computes everything,
+   * and so does every call if the expression has a setting (its side effect has to be done again).
+   * \pre The slots of \c ec are the ones of \c get_symbols .
+   * \param ec Context for the evaluation.
+   * \return The computed value.
+   */
+  double evaluate_incremental ( Evaluation_Context_Incremental & ec ) ;
+  /*! Number of operators invalidated by the last call to \c evaluate_incremental . */
+  unsigned int get_nb_invalidated () const {
+    return nb_invalidated ;
+  } ;
+  /*!
+   * Simplify the held expression (see \c Expr :: optimize ).
+   * The code is built again by the next \c compile .
+   * \return The number of nodes removed.
+   */
+  unsigned int optimize () ;
+  /*! Number of nodes removed by all the calls to \c optimize . */
+  unsigned int get_nodes_saved () const {
+    return nodes_saved ;
+  } ;
+  /*! Number of nodes of the held expression (each shared one counted once). */
+  unsigned int nb_nodes () const ;
+  /*! Write the held expression in infix form on \c out . */
+  void print ( std :: ostream & out ) const {
+    expression -> print ( out ) ;
+  } ;
+  /*! The held expression in infix form. */
+  std :: string toString () const {
+    return expression -> toString () ;
+  } ;
+  /*!
+   * Compile the held expression for the stack machine (only done once).
+   * \return The code.
+   */
+  Bytecode const & compile () ;
+  /*!
+   * Same as \c evaluate but by running the code of the expression (see \c compile ).
+   * \param ec Context for the evaluation.
+   * \return The computed value.
+   */
+  double evaluate_compiled ( Evaluation_Context & ec ) ;
+  /*!
+   * Same as \c evaluate but by running the code of the expression (see \c compile ).
+   * \param in \c istream to read the value from.
+   * \return The computed value.
+   */
+  double evaluate_compiled ( std :: istream & in ) ;
+  /*!
+   * Evaluate the held expression for \c n valuations given by columns,
+   * by running its code block by block (see \c Bytecode :: run_batch ).
+   * \param columns The array of the \c n values of each variable, by name
+   * (variables set before being read may be omitted).
+   * \param n Number of valuations.
+   * \param out Array of size \c n for the computed values.
+   */
+  void evaluate_batch ( std :: map < std :: string , double const * > const & columns ,
+			unsigned int n ,
+			double * out ) ;
   /*! Destructor. */
   ~ Loader_Evaluator () {
-    delete expression ; 
+    Expr :: release ( expression ) ; 
+    delete code ;
   } ; 
 } ; 
 
@@ -0,0 +1,182 @@
+# include <fstream>
+
+# include <pthread.h>
+
+# include "program.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*!
+   * Context of a thread: the values are the ones of the program, the epochs are its own
+   * (the values cached by the expressions are not mixed up).
+   * \pre The variables are read and set by slot, all the slots fit in \c values .
+   */
+  class Evaluation_Context_Thread
+    : public Evaluation_Context {
+    Evaluation_Context_Slots & values ;
+  public :
+    Evaluation_Context_Thread ( Evaluation_Context_Slots & _values )
+      : values ( _values ) {}
+    double get_value ( string const & id ) {
+      return values . get_value ( id ) ;
+    }
+    void valuate ( string const & id ,
+		   double value ) {
+      values . valuate ( id , value ) ;
+    }
+    double get_value ( unsigned int slot ,
+		       string const & id ) {
+      return values . get_value ( slot , id ) ;
+    }
+    void valuate ( unsigned int slot ,
+		   string const & id ,
+		   double value ) {
+      values . valuate ( slot , id , value ) ;
+    }
+  } ;
+
+
+  /*! Evaluation of the expressions of one level by threads. */
+  class Level {
+
+    vector < Loader_Evaluator * > const & expressions ;
+    /*! Indices of the expressions of the level. */
+    vector < unsigned int > const & indices ;
+    Evaluation_Context_Slots & values ;
+    vector < double > & results ;
+
+    /*! Position of the next expression to take. */
+    unsigned int next ;
+    pthread_mutex_t mutex ;
+
+    static void * start ( void * l ) {
+      static_cast < Level * > ( l ) -> work () ;
+      return 0 ;
+    }
+
+  public :
+
+    Level ( vector < Loader_Evaluator * > const & _expressions ,
+	    vector < unsigned int > const & _indices ,
+	    Evaluation_Context_Slots & _values ,
+	    vector < double > & _results )
+      : expressions ( _expressions )
+      , indices ( _indices )
+      , values ( _values )
+      , results ( _results )
+      , next ( 0 )
+    {
+      pthread_mutex_init ( & mutex , 0 ) ;
+    }
+
+    ~Level () {
+      pthread_mutex_destroy ( & mutex ) ;
+    }
+
+    /*! Loop of a thread till there is no expression left. */
+    void work () {
+      Evaluation_Context_Thread ec ( values ) ;
+      for ( ; ; ) {
+	pthread_mutex_lock ( & mutex ) ;
+	unsigned int const k = next ++ ;
+	pthread_mutex_unlock ( & mutex ) ;
+	if ( indices . size () <= k ) {
+	  return ;
+	}
+	results [ indices [ k ] ] = expressions [ indices [ k ] ] -> evaluate ( ec ) ;
+      }
+    }
+
+    /*! Start the other threads, work too and wait for them. */
+    void run ( unsigned int nbr_threads ) {
+      vector < pthread_t > threads ( nbr_threads ) ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	int const ret = pthread_create ( & threads [ t ] , 0 , start , this ) ;
+	assert ( ret == 0 ) ;
+      }
+      work () ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	pthread_join ( threads [ t ] , 0 ) ;
+      }
+    }
+
+  } ;
+
+
+  /*! \return true iff \c a and \c b have a common element. */
+  bool meet ( set < unsigned int > const & a ,
+	      set < unsigned int > const & b ) {
+    set < unsigned int > :: const_iterator i = a . begin () ;
+    set < unsigned int > :: const_iterator j = b . begin () ;
+    while ( i != a . end () && j != b . end () ) {
+      if ( * i < * j ) ++ i ;
+      else if ( * j < * i ) ++ j ;
+      else return true ;
+    }
+    return false ;
+  }
+
+}
+
+
+unsigned int Program :: record ( Loader_Evaluator * e ) {
+  unsigned int const index = expressions . size () ;
+  expressions . push_back ( e ) ;
+  reads . push_back ( set < unsigned int > () ) ;
+  writes . push_back ( set < unsigned int > () ) ;
+  e -> get_slots ( reads [ index ] , writes [ index ] ) ;
+  // after the levels of the previous expressions it depends on
+  unsigned int level = 0 ;
+  for ( unsigned int k = 0 ; k < index ; k ++ ) {
+    if ( level <= levels [ k ]
+	 && ( meet ( writes [ k ] , reads [ index ] )
+	      || meet ( writes [ k ] , writes [ index ] )
+	      || meet ( reads [ k ] , writes [ index ] ) ) ) {
+      level = levels [ k ] + 1 ;
+    }
+  }
+  levels . push_back ( level ) ;
+  if ( nbr_levels <= level ) nbr_levels = level + 1 ;
+  results . push_back ( NAN ) ;
+  return index ;
+}
+
+
+unsigned int Program :: add ( istream & postfixe_stream ) {
+  return record ( new Loader_Evaluator ( postfixe_stream , symbols ) ) ;
+}
+
+
+unsigned int Program :: add_file ( char const * file_name ) {
+  ifstream file ( file_name ) ;
+  assert ( file . is_open () ) ;
+  return add ( file ) ;
+}
+
+
+void Program :: run ( unsigned int nbr_threads ) {
+  assert ( 0 < nbr_threads ) ;
+  // the threads set different slots of the array, it must not move
+  values . fit () ;
+  vector < vector < unsigned int > > by_level ( nbr_levels ) ;
+  for ( unsigned int k = 0 ; k < expressions . size () ; k ++ ) {
+    by_level [ levels [ k ] ] . push_back ( k ) ;
+  }
+  for ( unsigned int l = 0 ; l < nbr_levels ; l ++ ) {
+    Level level ( expressions , by_level [ l ] , values , results ) ;
+    level . run ( nbr_threads < by_level [ l ] . size () ? nbr_threads : by_level [ l ] . size () ) ;
+  }
+}
+
+
+Program :: ~ Program () {
+  for ( vector < Loader_Evaluator * > :: iterator it = expressions . begin () ;
+	it != expressions . end () ;
+	++ it ) {
+    delete * it ;
+  }
+}
@@ -0,0 +1,116 @@
+# ifndef __PROGRAM_HPP_
+# define __PROGRAM_HPP_
+
+/*!
+ * \file
+ * This module provides a program: many expressions loaded with the same table of variables
+ * and evaluated in one context, the settings of an expression feeding the next ones.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <istream>
+# include <set>
+# include <string>
+# include <vector>
+
+# include "evaluation_context.hpp"
+# include "loader_evaluator.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+
+/*!
+ * Sequence of expressions sharing their variables.
+ * An expression depends on a previous one if one sets a variable that the other reads or sets:
+ * \c run evaluates the expressions level after level (an expression is at the level after
+ * the ones it depends on), the expressions of a level being independent, they are shared by threads.
+ * The values are the same as when the expressions are evaluated one after the other.
+ */
+class Program {
+  /*! Slots of the variables of all the expressions. */
+  Symbol_Table symbols ;
+  /*! Values of the variables, shared by all the expressions. */
+  Evaluation_Context_Slots values ;
+  /*! The expressions, in order. */
+  std :: vector < Loader_Evaluator * > expressions ;
+  /*! Slots of the variables read by each expression. */
+  std :: vector < std :: set < unsigned int > > reads ;
+  /*! Slots of the variables set by each expression. */
+  std :: vector < std :: set < unsigned int > > writes ;
+  /*! Level of each expression. */
+  std :: vector < unsigned int > levels ;
+  /*! Number of levels. */
+  unsigned int nbr_levels ;
+  /*! Value of each expression at the last \c run (NAN before). */
+  std :: vector < double > results ;
+  /*! Record the last expression loaded. */
+  unsigned int record ( Loader_Evaluator * e ) ;
+  /*! Not copyable. */
+  Program ( Program const & ) ;
+  Program & operator = ( Program const & ) ;
+public :
+  /*! Empty program. */
+  Program ()
+    : values ( symbols )
+    , nbr_levels ( 0 )
+  {} ;
+  /*!
+   * Load an expression at the end of the program (see \c Loader_Evaluator ).
+   * \return Its index.
+   */
+  unsigned int add ( std :: istream & postfixe_stream ) ;
+  /*!
+   * Load the expression of a file at the end of the program.
+   * \pre The file can be read.
+   * \return Its index.
+   */
+  unsigned int add_file ( char const * file_name ) ;
+  /*! Number of expressions. */
+  unsigned int size () const {
+    return expressions . size () ;
+  } ;
+  /*! Number of levels (an expression is at the level after the ones it depends on). */
+  unsigned int nb_levels () const {
+    return nbr_levels ;
+  } ;
+  /*! Level of expression \c index . */
+  unsigned int get_level ( unsigned int index ) const {
+    assert ( index < size () ) ;
+    return levels [ index ] ;
+  } ;
+  /*! Set a variable before \c run . */
+  void valuate ( std :: string const & id ,
+		 double value ) {
+    values . valuate ( id , value ) ;
+  } ;
+  /*! Value of a variable (NAN if undefined). */
+  double get_value ( std :: string const & id ) {
+    return values . get_value ( id ) ;
+  } ;
+  /*!
+   * Evaluate all the expressions, level after level.
+   * \param nbr_threads Number of threads evaluating the expressions of a level.
+   */
+  void run ( unsigned int nbr_threads = 1 ) ;
+  /*! Value of expression \c index at the last \c run . */
+  double get_result ( unsigned int index ) const {
+    assert ( index < size () ) ;
+    return results [ index ] ;
+  } ;
+  /*! Expression \c index . */
+  Loader_Evaluator & get_expression ( unsigned int index ) {
+    assert ( index < size () ) ;
+    return * expressions [ index ] ;
+  } ;
+  /*! Destructor. */
+  ~ Program () ;
+} ;
+
+
+# endif
@@ -1,6 +1,8 @@
 # include <string>
 # include <iostream>
 # include <sstream>
+# include <cstring>
+# include <ctime>
 
 # include "exparith.hpp"
 # include "exparith_unary.hpp"
@@ -201,10 +203,49 @@ namespace {
 			     ) ) ; 
   }
 
+
+
+  /*!
+   * Micro-benchmark: evaluate many times a tree of 8 n + 1 nodes
+   * ( ( x * 0.5 + ( 3 / 2 - 1 ) ) * 0.5 + … ) and print the time per node.
+   * \param n Number of steps of the tree (its depth).
+   * \param rounds Number of evaluations.
+   */
+  void bench_eval ( unsigned int n ,
+		    unsigned int rounds ) {
+    Expr * e = new Variable ( "x" ) ;
+    for ( unsigned int k = 0 ; k < n ; k ++ ) {
+      e = new Add ( new Mul ( e , new Constant ( 0.5 ) ) ,
+		    new Sub ( new Div ( new Constant ( 3 ) , new Constant ( 2 ) ) ,
+			      new Constant ( 1 ) ) ) ;
+    }
+    Evaluation_Context_Simple ec ;
+    ec . valuate ( "x" , 1 ) ;
+    double sum = 0 ;
+    clock_t const start = clock () ;
+    for ( unsigned int r = 0 ; r < rounds ; r ++ ) {
+      sum += e -> eval ( ec ) ;
+    }
+    double const seconds = ( double ) ( clock () - start ) / CLOCKS_PER_SEC ;
+    cout << "eval: " << seconds * 1e9 / ( ( 8.0 * n + 1 ) * rounds ) << " ns per node"
+	 << " (sum " << sum << ")" << endl ;
+    delete e ;
+  }
+
 }
 
 
-int main () {
+/*!
+ * Run the tests, or the micro-benchmark if the argument \c bench is given
+ * (its output depends on the machine, it is not compared).
+ */
+int main ( int argc ,
+	   char * * argv ) {
+
+  if ( 1 < argc && 0 == strcmp ( "bench" , argv [ 1 ] ) ) {
+    bench_eval ( 1000 , 2000 ) ;
+    return 0 ;
+  }
 
   test_without_variables () ;
 
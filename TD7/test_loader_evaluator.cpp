@@ -3,9 +3,11 @@
 # include <iostream> 
 # include <sstream> 
 # include <list>
+# include <map>
 
 # include "exparith.hpp"
 # include "loader_evaluator.hpp"
+# include "program.hpp"
 
 
 using namespace std ; 
@@ -18,7 +20,181 @@ namespace {
     Loader_Evaluator el ( file ) ;
     file . close () ;
     stringstream in ( " 90 -3.5  77 0 ") ;
-    cout << el . evaluate ( in ) << endl ;
+    cout << el . evaluate ( in ) ;
+    // same values with the compiled code
+    stringstream in_compiled ( " 90 -3.5  77 0 ") ;
+    cout << " " << el . evaluate_compiled ( in_compiled ) << endl ;
+  }
+
+  /*! Evaluate the expression of a file in a context with slots. */
+  void test_slots ( char const * const file_name ) {
+    std::ifstream file ( file_name ) ; 
+    Loader_Evaluator el ( file ) ;
+    file . close () ;
+    Evaluation_Context_Slots ec ( el . get_symbols () ) ;
+    ec . valuate ( "x" , 90 ) ;
+    ec . valuate ( "y" , -3.5 ) ;
+    cout << el . evaluate ( ec ) << " " << el . evaluate_compiled ( ec ) << " " << ec . get_value ( "a" ) << endl ;
+  }
+
+  /*! Evaluate the expression of a file for 3 valuations of x, y and a at a time,
+   * and one by one. */
+  void test_batch ( char const * const file_name ) {
+    std::ifstream file ( file_name ) ; 
+    Loader_Evaluator el ( file ) ;
+    file . close () ;
+    double const x [] = { 90 , 1 , -2.5 } ;
+    double const y [] = { -3.5 , 2 , 0.25 } ;
+    double const a [] = { 77 , 3 , 1e3 } ;
+    map < string , double const * > columns ;
+    columns [ "x" ] = x ;
+    columns [ "y" ] = y ;
+    columns [ "a" ] = a ;
+    double out [ 3 ] ;
+    el . evaluate_batch ( columns , 3 , out ) ;
+    for ( unsigned int k = 0 ; k < 3 ; k ++ ) {
+      stringstream in ;
+      in << x [ k ] << " " << y [ k ] << " " << a [ k ] ;
+      cout << out [ k ] << " " << el . evaluate ( in ) << "   " ;
+    }
+    cout << endl ;
+  }
+
+  /*! Simplify an expression, print it with the number of nodes saved,
+   * and check that the value is the same. */
+  void test_optimize ( istream & postfixe ) {
+    Loader_Evaluator el ( postfixe ) ;
+    stringstream in ( " 90 -3.5  77 0 ") ;
+    double const before = el . evaluate ( in ) ;
+    unsigned int const saved = el . optimize () ;
+    stringstream in_after ( " 90 -3.5  77 0 ") ;
+    double const after = el . evaluate ( in_after ) ;
+    stringstream in_compiled ( " 90 -3.5  77 0 ") ;
+    double const compiled = el . evaluate_compiled ( in_compiled ) ;
+    cout << el . toString () << "   saved " << saved << "   "
+	 << before << " " << after << " " << compiled << endl ;
+  }
+
+  /*! Same as above for the expression of a file. */
+  void test_optimize_file ( char const * const file_name ) {
+    std::ifstream file ( file_name ) ; 
+    test_optimize ( file ) ;
+  }
+
+  /*! Same as above for an expression in a string. */
+  void test_optimize_string ( char const * const postfixe ) {
+    stringstream in ( postfixe ) ;
+    test_optimize ( in ) ;
+  }
+
+  /*! Load an expression with repeated sub-expressions, print its number of nodes and its value. */
+  void test_shared ( char const * const postfixe ) {
+    stringstream postfixe_stream ( postfixe ) ;
+    Loader_Evaluator el ( postfixe_stream ) ;
+    stringstream in ( " 90 -3.5  77 0 ") ;
+    stringstream in_compiled ( " 90 -3.5  77 0 ") ;
+    cout << el . toString () << "   nodes " << el . nb_nodes () << "   "
+	 << el . evaluate ( in ) << " " << el . evaluate_compiled ( in_compiled ) << endl ;
+  }
+
+  /*! Load and evaluate x + 1 + 2 + … + n (a long expression, its nodes fill many blocks of the arena). */
+  void test_long ( unsigned int n ) {
+    stringstream postfixe_stream ;
+    postfixe_stream << "x" ;
+    for ( unsigned int k = 1 ; k <= n ; k ++ ) {
+      postfixe_stream << " " << k << " +" ;
+    }
+    postfixe_stream << " ." ;
+    Loader_Evaluator el ( postfixe_stream ) ;
+    stringstream in ( " 90 " ) ;
+    cout << "nodes " << el . nb_nodes () << "   " << el . evaluate ( in ) << endl ;
+  }
+
+  /*! Load the expression of a file read at once in a buffer. */
+  void test_buffer ( char const * const file_name ) {
+    std::ifstream file ( file_name ) ; 
+    stringstream whole ;
+    whole << file . rdbuf () ;
+    string const buffer = whole . str () ;
+    Loader_Evaluator el ( buffer . data () , buffer . data () + buffer . size () ) ;
+    stringstream in ( " 90 -3.5  77 0 ") ;
+    cout << el . toString () << "   " << el . evaluate ( in ) << endl ;
+  }
+
+  /*! Load two expressions one after the other from the same stream. */
+  void test_two_expressions () {
+    stringstream postfixe_stream ( "x 1.5 + .\n-2 y .5 -1e1 * * / x. + ." ) ;
+    Loader_Evaluator first ( postfixe_stream ) ;
+    Loader_Evaluator second ( postfixe_stream ) ;
+    cout << first . toString () << " ; " << second . toString () << endl ;
+  }
+
+  /*!
+   * Evaluate an expression incrementally while x, then y, then nothing, then x and y change,
+   * and print the value with the number of operators invalidated, and the value computed from scratch.
+   */
+  void test_incremental ( char const * const postfixe ) {
+    stringstream postfixe_stream ( postfixe ) ;
+    Loader_Evaluator el ( postfixe_stream ) ;
+    Evaluation_Context_Incremental ec ( el . get_symbols () ) ;
+    double const x [] = { 90 , 2 , 2 , 2 , -1 } ;
+    double const y [] = { -3.5 , -3.5 , 0.25 , 0.25 , 4 } ;
+    cout << el . toString () << endl ;
+    for ( unsigned int k = 0 ; k < 5 ; k ++ ) {
+      ec . valuate ( "x" , x [ k ] ) ;
+      ec . valuate ( "y" , y [ k ] ) ;
+      ec . valuate ( "a" , 77 ) ;
+      double const value = el . evaluate_incremental ( ec ) ;
+      unsigned int const invalidated = el . get_nb_invalidated () ;
+      Evaluation_Context_Slots scratch ( el . get_symbols () ) ;
+      scratch . valuate ( "x" , x [ k ] ) ;
+      scratch . valuate ( "y" , y [ k ] ) ;
+      scratch . valuate ( "a" , 77 ) ;
+      cout << "  " << value << " " << invalidated << " " << el . evaluate ( scratch ) << endl ;
+    }
+  }
+
+  /*!
+   * Evaluate an expression and its gradient with x = 0.5 and y = 2,
+   * and print the value, the value of \c evaluate and the derivative with respect to each variable.
+   */
+  void test_gradient ( char const * const postfixe ) {
+    stringstream postfixe_stream ( postfixe ) ;
+    Loader_Evaluator el ( postfixe_stream ) ;
+    Evaluation_Context_Slots ec ( el . get_symbols () ) ;
+    ec . valuate ( "x" , 0.5 ) ;
+    ec . valuate ( "y" , 2 ) ;
+    vector < double > gradient ;
+    double const value = el . evaluate_gradient ( ec , gradient ) ;
+    Evaluation_Context_Slots scratch ( el . get_symbols () ) ;
+    scratch . valuate ( "x" , 0.5 ) ;
+    scratch . valuate ( "y" , 2 ) ;
+    cout << el . toString () << "   " << value << " " << el . evaluate ( scratch ) ;
+    for ( unsigned int k = 0 ; k < gradient . size () ; k ++ ) {
+      cout << "   d" << el . get_symbols () . get_name ( k ) << " " << gradient [ k ] ;
+    }
+    cout << endl ;
+  }
+
+  /*!
+   * Load all the files in a program, run it with x = 90 and y = -3.5,
+   * and print the level and the value of each expression, then the values of x and a.
+   */
+  void test_program ( unsigned int nbr_threads ) {
+    Program p ;
+    char const * const files [] = { "data_expression_1.txt" , "data_expression_2.txt" , "data_expression_3.txt" ,
+				    "data_expression_4.txt" , "data_expression_5.txt" , "data_expression_6.txt" } ;
+    for ( unsigned int k = 0 ; k < 6 ; k ++ ) {
+      p . add_file ( files [ k ] ) ;
+    }
+    p . valuate ( "x" , 90 ) ;
+    p . valuate ( "y" , -3.5 ) ;
+    p . run ( nbr_threads ) ;
+    cout << p . nb_levels () << " levels:" ;
+    for ( unsigned int k = 0 ; k < p . size () ; k ++ ) {
+      cout << "   " << p . get_level ( k ) << " " << p . get_result ( k ) ;
+    }
+    cout << "   x " << p . get_value ( "x" ) << " a " << p . get_value ( "a" ) << endl ;
   }
 
 }
@@ -33,6 +209,55 @@ int main () {
   test_file ( "data_expression_5.txt" ) ;
   test_file ( "data_expression_6.txt" ) ;
 
+  cout << "slots" << endl ;
+  test_slots ( "data_expression_3.txt" ) ;
+  test_slots ( "data_expression_5.txt" ) ;
+  test_slots ( "data_expression_6.txt" ) ;
+
+  cout << "batch" << endl ;
+  test_batch ( "data_expression_2.txt" ) ;
+  test_batch ( "data_expression_5.txt" ) ;
+  test_batch ( "data_expression_6.txt" ) ;
+
+  cout << "optimize" << endl ;
+  test_optimize_file ( "data_expression_1.txt" ) ;
+  test_optimize_file ( "data_expression_2.txt" ) ;
+  test_optimize_file ( "data_expression_3.txt" ) ;
+  test_optimize_file ( "data_expression_6.txt" ) ;
+  test_optimize_string ( "x 1 * 0 + 1 y * - ." ) ;
+  test_optimize_string ( "x exp log 2 3 * / ." ) ;
+  test_optimize_string ( "a 0 x 1 / + := a * ." ) ;
+  test_optimize_string ( "1 x - exp log 0 1 - + ." ) ;
+  test_optimize_string ( "x 2 3 * * y 2 3 * * + ." ) ;
+
+  cout << "shared" << endl ;
+  test_shared ( "x y + exp x y + exp * ." ) ;
+  test_shared ( "x x 1 + := x x 1 + := + ." ) ;
+  test_shared ( "a x y * := a x y * + + ." ) ;
+
+  cout << "buffer" << endl ;
+  test_buffer ( "data_expression_3.txt" ) ;
+  test_buffer ( "data_expression_6.txt" ) ;
+  test_two_expressions () ;
+
+  cout << "incremental" << endl ;
+  test_incremental ( "x 2 * exp log y y * + a 3 + 4 * - ." ) ;
+  test_incremental ( "a 1 + x * y a / * ." ) ;
+  test_incremental ( "a 1 + x * y a := * a + ." ) ;
+
+  cout << "gradient" << endl ;
+  test_gradient ( "x y * x exp + ." ) ;
+  test_gradient ( "x y / log 3 x - * ." ) ;
+  test_gradient ( "x y + exp x y + exp * ." ) ;
+  test_gradient ( "a x x * := a y * + ." ) ;
+
+  cout << "program" << endl ;
+  test_program ( 1 ) ;
+  test_program ( 4 ) ;
+
+  cout << "long" << endl ;
+  test_long ( 20000 ) ;
+
   return 0 ; 
 }
  
@@ -0,0 +1,183 @@
+/*!
+ * \file
+ * Benchmark: generate a large Xml document, then time \c Xml :: load ,
+ * a traversal of its tree and its serialization.
+ *
+ * usage : ./bench_xml file depth fan_out size_MB
+ *
+ * The document is a root holding as many records as needed to reach \c size_MB megabytes,
+ * each record being a complete tree of \c depth levels of \c fan_out sons, with data on the leaves.
+ * It is written in \c file (by an \c Out_Buffer , so the size is not limited by the memory),
+ * which can then be given to the other loaders (e.g. \c bench_arbre_xml of TDM4).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <sys/resource.h>
+# include <sys/time.h>
+# include <stdlib.h> // atoi, atof
+
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <sstream>
+# include <vector>
+
+# include "out_buffer.hpp"
+# include "xml.hpp"
+
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+using namespace std ; 
+
+
+namespace {
+
+  /*! Current time, in seconds. */
+  double now () {
+    timeval t ;
+    gettimeofday ( & t , 0 ) ;
+    return t . tv_sec + 1e-6 * t . tv_usec ;
+  }
+
+  /*! Peak resident memory of the process, in MB. */
+  double peak_MB () {
+    rusage r ;
+    getrusage ( RUSAGE_SELF , & r ) ;
+    return r . ru_maxrss / 1024.0 ;
+  }
+
+  /*! Characters written by \c generate_record . */
+  unsigned long written ;
+
+  /*! Write \c s (counted in \c written ). */
+  void put ( Out_Buffer & out ,
+	     char const * const s ,
+	     size_t const n ) {
+    out . write ( s , n ) ;
+    written += n ;
+  }
+
+  /*! Write a complete tree of \c depth levels of \c fan_out sons, indented by \c level . */
+  void generate_record ( Out_Buffer & out ,
+			 unsigned int const level ,
+			 unsigned int const depth ,
+			 unsigned int const fan_out ,
+			 unsigned long & leaf ) {
+    string const indent ( 2 * level , ' ' ) ;
+    put ( out , indent . data () , indent . size () ) ;
+    if ( 0 == depth ) {
+      ostringstream data ;
+      data << "<leaf>data " << leaf ++ << "</leaf>\n" ;
+      put ( out , data . str () . data () , data . str () . size () ) ;
+      return ;
+    }
+    put ( out , "<node>\n" , 7 ) ;
+    for ( unsigned int k = 0 ; k < fan_out ; k ++ ) {
+      generate_record ( out , level + 1 , depth - 1 , fan_out , leaf ) ;
+    }
+    put ( out , indent . data () , indent . size () ) ;
+    put ( out , "</node>\n" , 8 ) ;
+  }
+
+  /*! Write the document in \c file_name , return the number of records. */
+  unsigned long generate ( char const * const file_name ,
+			   unsigned int const depth ,
+			   unsigned int const fan_out ,
+			   double const size_MB ) {
+    ofstream file ( file_name , ios :: out | ios :: binary | ios :: trunc ) ;
+    assert ( file ) ;
+    Out_Buffer out ( file ) ;
+    written = 0 ;
+    put ( out , "<root>\n" , 7 ) ;
+    unsigned long records = 0 ;
+    unsigned long leaf = 0 ;
+    do {
+      generate_record ( out , 1 , depth , fan_out , leaf ) ;
+      records ++ ;
+    } while ( written < size_MB * 1e6 ) ;
+    put ( out , "</root>\n" , 8 ) ;
+    return records ;
+  }
+
+  /*! Print a line of result. */
+  void report ( char const * const name ,
+		double const seconds ,
+		double const bytes ) {
+    cout << setw ( 14 ) << left << name << right
+	 << fixed << setprecision ( 3 )
+	 << setw ( 12 ) << seconds * 1e3 << " ms"
+	 << setw ( 12 ) << setprecision ( 1 ) << bytes / seconds * 1e-6 << " MB/s"
+	 << setw ( 12 ) << peak_MB () << " MB peak" << endl ;
+  }
+
+  /*! Visit the nodes of the tree in prefix order, return their number (the data lengths are added to \c data ). */
+  unsigned long traverse ( Xml const & xml ,
+			   unsigned long & data ) {
+    Xml :: Tag_Tree const & tree = xml . get_tree () ;
+    Xml :: index const none = Xml :: Tag_Tree :: none ;
+    unsigned long nb = 0 ;
+    Xml :: index n = tree . get_root () ;
+    while ( none != n ) {
+      nb ++ ;
+      Tag_Data const * const d = dynamic_cast < Tag_Data const * > ( tree . get_value ( n ) ) ;
+      if ( NULL != d ) data += d -> get_data () . size () ;
+      if ( none != tree . get_left_son ( n ) ) {
+	n = tree . get_left_son ( n ) ;
+	continue ;
+      }
+      while ( none != n && none == tree . get_right_brother ( n ) ) n = tree . get_father ( n ) ;
+      if ( none != n ) n = tree . get_right_brother ( n ) ;
+    }
+    return nb ;
+  }
+
+}
+
+
+int main ( int argc ,
+	   char const * argv [] ) {
+  if ( argc < 5 ) {
+    cerr << "usage : " << argv [ 0 ] << " file depth fan_out size_MB" << endl ;
+    return 1 ;
+  }
+  char const * const file_name = argv [ 1 ] ;
+  unsigned int const depth = atoi ( argv [ 2 ] ) ;
+  unsigned int const fan_out = atoi ( argv [ 3 ] ) ;
+  double const size_MB = atof ( argv [ 4 ] ) ;
+
+  double t = now () ;
+  unsigned long const records = generate ( file_name , depth , fan_out , size_MB ) ;
+  double const bytes = written ;
+  cout << file_name << " : " << records << " records of depth " << depth << " and fan-out " << fan_out
+       << " , " << setprecision ( 1 ) << fixed << bytes * 1e-6 << " MB" << endl ;
+  report ( "generation" , now () - t , bytes ) ;
+
+  t = now () ;
+  Xml * const xml = Xml :: load ( file_name ) ;
+  if ( NULL == xml ) return 1 ;
+  report ( "Xml::load" , now () - t , bytes ) ;
+
+  t = now () ;
+  unsigned long data = 0 ;
+  unsigned long const nb = traverse ( * xml , data ) ;
+  report ( "traversal" , now () - t , bytes ) ;
+  cout << "  " << nb << " nodes , " << data << " bytes of data" << endl ;
+
+  ofstream null ( "/dev/null" ) ;
+  t = now () ;
+  {
+    Out_Buffer out ( null ) ;
+    xml -> print ( out ) ;
+  }
+  report ( "print" , now () - t , bytes ) ;
+
+  delete xml ;
+  return 0 ;
+}
@@ -0,0 +1,228 @@
+# ifndef __FLAT_TREE_HPP_
+# define __FLAT_TREE_HPP_
+
+/*!
+ * \file
+ * This module provides generic unbounded trees with all their nodes in one array
+ * (same links as \c Tree , as 32-bit indices instead of pointers).
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <vector>
+# include <ostream>
+
+# include <stdint.h>
+
+# include "tree.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * This class is to represent a tree with the nodes in a contiguous array.
+ * The nodes are designed by their index (the root is 0), in creation order.
+ * Building a tree whose size is known (see \c reserve ) makes a single allocation,
+ * and the traversals only read the array.
+ * \param T Type for nodes.
+ * \param delete_T Deletion function.
+ */
+template < class T ,
+	   void ( * delete_T ) ( T & ) = delete_not < T > >
+class Flat_Tree {
+
+public :
+
+  /*! Index of a node. */
+  typedef uint32_t index ;
+
+  /*! Index of no node (e.g. the father of the root). */
+  static index const none = 0xFFFFFFFF ;
+
+private :
+
+  /*! A node: value held and links to its relatives. */
+  struct Flat_Node {
+    /*! Value held. */
+    T value ;
+    /*! Link to the father (cannot be changed). */
+    index father ;
+    /*! Link to the leftmost son. */
+    index left_son ;
+    /*! Link to the leftmost right brother. */
+    index right_brother ;
+  } ;
+
+  /*! The nodes, by index. */
+  std :: vector < Flat_Node > nodes ;
+
+  /*! Not copyable (the values are deleted with the tree). */
+  Flat_Tree ( Flat_Tree const & ) ;
+  Flat_Tree & operator = ( Flat_Tree const & ) ;
+
+  /*! Add a node holding \c val and return its index. */
+  index add_node ( T const & val ,
+		   index father ,
+		   index right_brother ) {
+    assert ( nodes . size () < none ) ;
+    Flat_Node const n = { val , father , none , right_brother } ;
+    nodes . push_back ( n ) ;
+    return nodes . size () - 1 ;
+  }
+
+public :
+
+  /*!
+   * A tree is built from its root value (there is no empty tree).
+   * \param val Value for the root node.
+   * \param capacity Number of nodes to make room for.
+   */
+  Flat_Tree ( T const & val ,
+	      index capacity = 1 ) {
+    nodes . reserve ( capacity ) ;
+    add_node ( val , none , none ) ;
+  } ;
+
+  /*! Make room for \c capacity nodes (no allocation till then). */
+  void reserve ( index capacity ) {
+    nodes . reserve ( capacity ) ;
+  } ;
+
+  /*! \return the number of nodes. */
+  index size () const {
+    return nodes . size () ;
+  } ;
+
+  /*! \return the index of the root. */
+  index get_root () const {
+    return 0 ;
+  } ;
+
+  /*! \return the index of the leftmost son of \c n ( \c none if none). */
+  index get_left_son ( index n ) const {
+    assert ( n < nodes . size () ) ;
+    return nodes [ n ] . left_son ;
+  } ;
+
+  /*! \return the index of the leftmost right brother of \c n ( \c none if none). */
+  index get_right_brother ( index n ) const {
+    assert ( n < nodes . size () ) ;
+    return nodes [ n ] . right_brother ;
+  } ;
+
+  /*! \return the index of the father of \c n ( \c none for the root). */
+  index get_father ( index n ) const {
+    assert ( n < nodes . size () ) ;
+    return nodes [ n ] . father ;
+  } ;
+
+  /*! \return the value held by \c n . */
+  T const & get_value ( index n ) const {
+    assert ( n < nodes . size () ) ;
+    return nodes [ n ] . value ;
+  } ;
+
+  /*!
+   * To add a left son to \c n (to the left of any other existing son).
+   * \param val Value for the added son.
+   * \return The index of the newly created node.
+   */
+  index add_left_son ( index n ,
+		       T const & val ) {
+    assert ( n < nodes . size () ) ;
+    index const s = add_node ( val , n , nodes [ n ] . left_son ) ;
+    nodes [ n ] . left_son = s ;
+    return s ;
+  } ;
+
+  /*!
+   * To add a brother to the right of \c n (to the left of any other existing brother).
+   * \pre \c n is not the root.
+   * \param val Value for the added brother.
+   * \return The index of the newly created node.
+   */
+  index add_right_brother ( index n ,
+			    T const & val ) {
+    assert ( n < nodes . size () ) ;
+    assert ( none != nodes [ n ] . father ) ;
+    index const b = add_node ( val , nodes [ n ] . father , nodes [ n ] . right_brother ) ;
+    nodes [ n ] . right_brother = b ;
+    return b ;
+  } ;
+
+  /*!
+   * Destructor.
+   * \c delete_T is called on each value, in index order (no traversal),
+   * then all the nodes are released at once with the array.
+   */
+  ~ Flat_Tree () {
+    for ( typename std :: vector < Flat_Node > :: iterator it = nodes . begin () ;
+	  it != nodes . end () ;
+	  ++ it ) {
+      delete_T ( it -> value ) ;
+    }
+  } ;
+
+  /*!
+   * Output the tree in the same form as \c Tree :: out_put :
+   * each value is followed by its sons between \c open_sons and \c close_sons ,
+   * brothers are separated by \c sep_brothers .
+   * The links are followed without any stack (the fathers are known).
+   */
+  template < char const * const open_sons ,
+	     char const * const sep_brothers ,
+	     char const * const close_sons >
+  void out_put ( Out_Buffer & out ) const ;
+
+  /*!
+   * Same as above, through an \c Out_Buffer on \c ost .
+   */
+  template < char const * const open_sons ,
+	     char const * const sep_brothers ,
+	     char const * const close_sons >
+  std :: ostream & out_put ( std :: ostream & ost ) const {
+    {
+      Out_Buffer out ( ost ) ;
+      out_put < open_sons , sep_brothers , close_sons > ( out ) ;
+    }
+    return ost ;
+  }
+} ;
+
+
+template < class T ,
+	   void ( * delete_T ) ( T & ) >
+typename Flat_Tree < T , delete_T > :: index const Flat_Tree < T , delete_T > :: none ;
+
+
+template < class T ,
+	   void ( * delete_T ) ( T & ) >
+template < char const * const open_sons ,
+	   char const * const sep_brothers ,
+	   char const * const close_sons >
+void Flat_Tree < T , delete_T > :: out_put ( Out_Buffer & out ) const {
+  index n = get_root () ;
+  while ( none != n ) {
+    out << nodes [ n ] . value ;
+    if ( none != nodes [ n ] . left_son ) {
+      out << open_sons ;
+      n = nodes [ n ] . left_son ;
+      continue ;
+    }
+    // go up till a node with a right brother (the sons of each node left are closed)
+    while ( none != n && none == nodes [ n ] . right_brother ) {
+      n = nodes [ n ] . father ;
+      if ( none != n ) out << close_sons ;
+    }
+    if ( none != n ) {
+      out << sep_brothers ;
+      n = nodes [ n ] . right_brother ;
+    }
+  }
+}
+
+# endif
@@ -0,0 +1,104 @@
+# ifndef __OUT_BUFFER_HPP_
+# define __OUT_BUFFER_HPP_
+
+/*!
+ * \file
+ * This module provides a buffer for the outputs made of many small pieces (e.g. trees):
+ * the pieces are copied in a large buffer that is written on the stream in big chunks.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <cstddef>
+# include <cstring>
+# include <ostream>
+# include <sstream>
+# include <string>
+# include <vector>
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * Buffer in front of an output stream.
+ * The buffer is written on the stream when full, by \c flush , and at the destruction,
+ * and it is reused from a chunk to the next (the same \c Out_Buffer may be used for many outputs).
+ * Strings are copied directly, other values are formatted as by the \c << of \c std :: ostream .
+ */
+class Out_Buffer {
+  /*! Stream written. */
+  std :: ostream & out ;
+  /*! The characters not written yet are the first \c used ones. */
+  std :: vector < char > buffer ;
+  /*! Number of characters in \c buffer . */
+  std :: size_t used ;
+  /*! Stream to format the values that are not strings (reused). */
+  std :: ostringstream format ;
+  /*! Not copyable. */
+  Out_Buffer ( Out_Buffer const & ) ;
+  Out_Buffer & operator = ( Out_Buffer const & ) ;
+public :
+  /*!
+   * \param _out Stream to write.
+   * \param capacity Size of the buffer.
+   */
+  Out_Buffer ( std :: ostream & _out ,
+	       std :: size_t capacity = 1 << 20 )
+    : out ( _out )
+    , buffer ( capacity )
+    , used ( 0 )
+  {
+    assert ( 0 < capacity ) ;
+  } ;
+  /*! Add the \c n characters at \c s (written directly if more than the buffer). */
+  void write ( char const * s ,
+	       std :: size_t n ) {
+    if ( buffer . size () - used < n ) {
+      flush () ;
+      if ( buffer . size () <= n ) {
+	out . write ( s , n ) ;
+	return ;
+      }
+    }
+    memcpy ( & buffer [ used ] , s , n ) ;
+    used += n ;
+  }
+  /*! Add one character. */
+  void put ( char c ) {
+    if ( buffer . size () == used ) flush () ;
+    buffer [ used ++ ] = c ;
+  }
+  /*! Write the characters of the buffer on the stream. */
+  void flush () {
+    if ( 0 < used ) out . write ( & buffer [ 0 ] , used ) ;
+    used = 0 ;
+  }
+  /*! Add a string. */
+  Out_Buffer & operator << ( char const * s ) {
+    write ( s , strlen ( s ) ) ;
+    return * this ;
+  }
+  /*! Add a string. */
+  Out_Buffer & operator << ( std :: string const & s ) {
+    write ( s . data () , s . size () ) ;
+    return * this ;
+  }
+  /*! Add a value as formatted by \c std :: ostream . */
+  template < class T >
+  Out_Buffer & operator << ( T const & value ) {
+    format . str ( "" ) ;
+    format << value ;
+    return * this << format . str () ;
+  }
+  /*! The characters left are written. */
+  ~ Out_Buffer () {
+    flush () ;
+  }
+} ;
+
+
+# endif
@@ -0,0 +1,64 @@
+
+# include <pthread.h>
+
+# include "tag.hpp"
+
+
+using namespace std ;
+
+
+unsigned int const Tag_Names :: none ;
+
+unsigned int const Tag_Names :: block_size ;
+
+unsigned int const Tag_Names :: max_blocks ;
+
+map < string , unsigned int > Tag_Names :: ids ;
+
+string * Tag_Names :: blocks [ Tag_Names :: max_blocks ] ;
+
+unsigned int Tag_Names :: nb_names = 0 ;
+
+Tag_Names :: Deleter Tag_Names :: deleter ;
+
+
+Tag_Names :: Deleter :: ~ Deleter () {
+  for ( unsigned int b = 0 ; b < max_blocks ; b ++ ) delete [] blocks [ b ] ;
+}
+
+
+namespace {
+
+  /*! Lock of \c Tag_Names . */
+  pthread_mutex_t names_mutex = PTHREAD_MUTEX_INITIALIZER ;
+
+}
+
+
+unsigned int Tag_Names :: intern ( string const & name ) {
+  pthread_mutex_lock ( & names_mutex ) ;
+  map < string , unsigned int > :: const_iterator it = ids . find ( name ) ;
+  if ( ids . end () != it ) {
+    unsigned int const id = it -> second ;
+    pthread_mutex_unlock ( & names_mutex ) ;
+    return id ;
+  }
+  unsigned int const id = nb_names ;
+  assert ( id < block_size * max_blocks ) ;
+  if ( 0 == id % block_size ) blocks [ id / block_size ] = new string [ block_size ] ;
+  blocks [ id / block_size ] [ id % block_size ] = name ;
+  ids [ name ] = id ;
+  // the name is written before the number is given
+  __sync_add_and_fetch ( & nb_names , 1 ) ;
+  pthread_mutex_unlock ( & names_mutex ) ;
+  return id ;
+}
+
+
+unsigned int Tag_Names :: find ( string const & name ) {
+  pthread_mutex_lock ( & names_mutex ) ;
+  map < string , unsigned int > :: const_iterator it = ids . find ( name ) ;
+  unsigned int const id = ( ids . end () == it ) ? none : it -> second ;
+  pthread_mutex_unlock ( & names_mutex ) ;
+  return id ;
+}
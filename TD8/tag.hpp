@@ -3,47 +3,172 @@
 
 
 /*!
- * \file 
+ * \file
  * This module provides tags for xml.
  * The base class \c tag is abstract, sub classes are
  * - \c tag_inner: can only hold more tag
  * - \c tag_data: can only hold data (string)
- * 
+ *
+ * The names of the tags are interned in \c Tag_Names (a tag holds the number of its name),
+ * and the data are \c Text in the buffer of the document (they are not copied).
+ *
  * \pre For all method, no pointer should NULL
  *
  * \author PASD
  * \date 2016
  */
 
+# include <cstddef>
+# include <map>
 # include <ostream>
 # include <sstream>
+# include <string>
 
+# include "out_buffer.hpp"
 
+
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
+/*!
+ * Table of the names of the tags, shared by all the tags:
+ * each name gets a number (0, 1…) the first time it is interned, and is then kept once.
+ * Documents may be loaded by many threads at a time (see \c Xml_Batch ):
+ * \c intern and \c find lock the table, \c get_name does not
+ * (the names are in blocks that never move, and a number is only known once its name is written).
+ */
+class Tag_Names {
+  /*! Number of names in a block. */
+  static unsigned int const block_size = 1024 ;
+  /*! Maximal number of blocks. */
+  static unsigned int const max_blocks = 1024 ;
+  /*! Number of each name. */
+  static std :: map < std :: string , unsigned int > ids ;
+  /*! Name of each number, by block of \c block_size (NULL for the blocks not used yet). */
+  static std :: string * blocks [ max_blocks ] ;
+  /*! Number of names. */
+  static unsigned int nb_names ;
+  /*! Free the blocks at the end of the program. */
+  struct Deleter {
+    ~ Deleter () ;
+  } ;
+  static Deleter deleter ;
+public :
+  /*! Number of no name. */
+  static unsigned int const none = ( unsigned int ) -1 ;
+  /*! Return the number of \c name , a new one if it was not interned yet. */
+  static unsigned int intern ( std :: string const & name ) ;
+  /*! Return the number of \c name , or \c none if it was not interned. */
+  static unsigned int find ( std :: string const & name ) ;
+  /*! Return the name of number \c id . */
+  static std :: string const & get_name ( unsigned int id ) {
+    assert ( id < size () ) ;
+    return blocks [ id / block_size ] [ id % block_size ] ;
+  }
+  /*! Number of names. */
+  static unsigned int size () {
+    return __sync_add_and_fetch ( & nb_names , 0 ) ;
+  }
+} ;
+
+
+
+/*!
+ * Characters of a buffer, that are referenced and not copied
+ * (the buffer should outlive the text).
+ */
+class Text {
+  /*! First character. */
+  char const * begin ;
+  /*! Number of characters. */
+  std :: size_t length ;
+public :
+  /*! Empty text. */
+  Text ()
+    : begin ( NULL )
+    , length ( 0 )
+  {} ;
+  /*! Characters [ \c _begin , \c _end ) . */
+  Text ( char const * _begin ,
+	 char const * _end )
+    : begin ( _begin )
+    , length ( _end - _begin )
+  {
+    assert ( _begin <= _end ) ;
+  } ;
+  /*! First character. */
+  char const * data () const {
+    return begin ;
+  }
+  /*! Number of characters. */
+  std :: size_t size () const {
+    return length ;
+  }
+  /*! Copy of the characters. */
+  std :: string str () const {
+    return std :: string ( begin , length ) ;
+  }
+} ;
+
+
+/*! Output the characters of \c text . */
+inline std :: ostream & operator << ( std :: ostream & out ,
+				      Text const & text ) {
+  return out . write ( text . data () , text . size () ) ;
+}
+
+/*! Same as above, in a buffer. */
+inline Out_Buffer & operator << ( Out_Buffer & out ,
+				  Text const & text ) {
+  out . write ( text . data () , text . size () ) ;
+  return out ;
+}
+
+
+
 /*!
  * Abstract class for representing tags of XML.
  */
 class Tag {
-  /*! tag itself */
-  std :: string tag ;
+  /*! tag itself (number of its name in \c Tag_Names ) */
+  unsigned int const id ;
 protected :
-  Tag ( std :: string & _tag )
-    : tag ( _tag ) {} ; 
+  Tag ( unsigned int _id )
+    : id ( _id ) {} ;
 public:
-  std :: string get_tag () {
-    return tag ; }
+  std :: string const & get_tag () const {
+    return Tag_Names :: get_name ( id ) ; }
+  /*! Number of the name in \c Tag_Names (equal numbers for equal names). */
+  unsigned int get_id () const {
+    return id ; }
   virtual void print_open ( std :: ostream & out ) {
-    out << "<" << tag << ">\n" ;
+    out << "<" << get_tag () << ">\n" ;
   }
   void print_close ( std :: ostream & out ) {
-    out << "</" << tag << ">\n" ;
+    out << "</" << get_tag () << ">\n" ;
+  }
+  /*! Same as \c print_open , in a buffer. */
+  virtual void write_open ( Out_Buffer & out ) const {
+    out . put ( '<' ) ;
+    out << get_tag () ;
+    out . write ( ">\n" , 2 ) ;
+  }
+  /*! Same as \c print_close , in a buffer. */
+  void write_close ( Out_Buffer & out ) const {
+    out . write ( "</" , 2 ) ;
+    out << get_tag () ;
+    out . write ( ">\n" , 2 ) ;
+  }
+  /*! Write the tag in the parenthesized form of a tree (see \c Xml :: out_put ): its name. */
+  virtual void write_name ( Out_Buffer & out ) const {
+    out << get_tag () ;
   }
   virtual bool accepts_sub_tag () = 0 ;
-  virtual ~Tag () {} 
-} ; 
+  virtual ~Tag () {}
+} ;
 
 
 
@@ -53,27 +178,30 @@ public:
  */
 class Tag_Inner : public Tag {
 public:
-  Tag_Inner ( std :: string tag ) :
-    Tag ( tag ) {} 
+  Tag_Inner ( std :: string const & tag ) :
+    Tag ( Tag_Names :: intern ( tag ) ) {}
+  Tag_Inner ( unsigned int id ) :
+    Tag ( id ) {}
   bool accepts_sub_tag () {
     return true ;
   }
-  ~ Tag_Inner () {} ; 
-} ; 
+  ~ Tag_Inner () {} ;
+} ;
 
 
 
 /*!
  * Concrete class for Tag with data only.
+ * The data are in the buffer of the document.
  */
 class Tag_Data : public Tag {
-  std :: string data ; 
+  Text data ;
 public:
-  Tag_Data ( std :: string tag ,
-	     std :: string _data ) :
-    Tag ( tag ) ,
+  Tag_Data ( unsigned int id ,
+	     Text const & _data ) :
+    Tag ( id ) ,
     data ( _data ) {}
-  std :: string get_data () {
+  Text const & get_data () const {
     return data ; }
   bool accepts_sub_tag () {
     return false ;
@@ -82,9 +210,30 @@ public:
     Tag :: print_open ( out ) ;
     out << data << "\n" ;
   }
-  ~ Tag_Data () {} ; 
-} ; 
+  void write_open ( Out_Buffer & out ) const {
+    Tag :: write_open ( out ) ;
+    out << data ;
+    out . put ( '\n' ) ;
+  }
+  /*! The name then the data between double quotes. */
+  void write_name ( Out_Buffer & out ) const {
+    out << get_tag () ;
+    out . write ( " \"" , 2 ) ;
+    out << data ;
+    out . put ( '"' ) ;
+  }
+  ~ Tag_Data () {} ;
+} ;
+
+
+
+/*! Write \c tag in the parenthesized form of a tree (see \c Tag :: write_name ). */
+inline Out_Buffer & operator << ( Out_Buffer & out ,
+				  Tag * const & tag ) {
+  tag -> write_name ( out ) ;
+  return out ;
+}
 
 
 
-# endif 
+# endif
@@ -11,6 +11,7 @@
 # include <stdlib.h>
 
 # include "tree.hpp"
+# include "flat_tree.hpp"
 
 
 # undef NDEBUG
@@ -94,12 +95,29 @@ namespace {
     return((unsigned)(next/65536) % 32768);
   }
 
+
+  /*!
+   * Build a tree of \c depth nodes, each one the son of the previous one, with a brother each,
+   * and delete it (this would overflow the stack with a recursive deletion).
+   */
+  void test_deep ( int depth ) {
+    Tree < Complex * , delete_complex > * deep = new Tree < Complex * , delete_complex > ( new Complex ( 0 , 0 ) ) ;
+    Node < Complex * , delete_complex > * node = deep -> get_root () ;
+    for ( int i = 1 ; i < depth ; i ++ ) {
+      node = node -> add_left_son ( new Complex ( i , 0 ) ) ;
+      node -> add_right_brother ( new Complex ( i , 1 ) ) ;
+    }
+    delete deep ;
+    cout << "deep " << depth << endl ;
+  }
+
 }
 
 
 
 /*!
  * Add various nodes to a tree
+ * (and the same nodes to a \c Flat_Tree , that should output the same)
  */
 int main () {
   Complex ch ( 1.0 , 1.0 ) ; 
@@ -109,6 +127,8 @@ int main () {
   Tree < Complex * , delete_complex > tree_ptr ( new Complex ( ch ) ) ; 
   Node < Complex * , delete_complex > * node_ptr_current = tree_ptr . get_root () ; 
   node_ptr_current = node_ptr_current -> add_left_son ( new Complex ( ch ) ) ;
+  Flat_Tree < Complex > flat ( ch , size + 2 ) ;
+  Flat_Tree < Complex > :: index flat_current = flat . add_left_son ( flat . get_root () , ch ) ;
   for ( int i=0 ; i < size ; i++ ) {
     float a = ( float ) my_rand () / ( float ) MY_RAND_MAX ; 
     float b = ( float ) my_rand () / ( float ) MY_RAND_MAX ; 
@@ -117,20 +137,28 @@ int main () {
     if ( i % 3 ==0 ) {
       node_current -> add_left_son ( c ) ; 
       node_ptr_current -> add_left_son ( new Complex ( c ) ) ; 
+      flat . add_left_son ( flat_current , c ) ;
     } else if ( i % 2 ==0 ) {
       ( node_current -> get_right_brother () ) -> add_left_son ( c ) ; 
       ( node_ptr_current -> get_right_brother () ) -> add_left_son ( new Complex ( c ) ) ; 
+      flat . add_left_son ( flat . get_right_brother ( flat_current ) , c ) ;
     } else if ( i % 5 ==0 ) {
       node_current = node_current -> get_left_son () ;
+      flat_current = flat . get_left_son ( flat_current ) ;
     } else {
       node_current -> add_right_brother ( c ) ; 
       node_ptr_current -> add_right_brother ( new Complex ( c ) ) ; 
+      flat . add_right_brother ( flat_current , c ) ;
     }
   }
   tree . out_put < open_sons_parent , sep_brothers_comma , close_sons_parent > ( cout ) ;
   cout << endl ; 
   tree_ptr . out_put < open_sons_parent , sep_brothers_comma , close_sons_parent > ( cout ) ;
   cout << endl ;
+  flat . out_put < open_sons_parent , sep_brothers_comma , close_sons_parent > ( cout ) ;
+  cout << endl ;
+
+  test_deep ( 1000000 ) ;
 
   return 0 ; 
 }
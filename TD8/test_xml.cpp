@@ -8,8 +8,10 @@
 
 
 # include <iostream>
+# include <vector>
 
 # include "xml.hpp"
+# include "xml_batch.hpp"
 
 
 # undef NDEBUG
@@ -32,6 +34,95 @@ void test_file ( char const * const file_name ) {
 
 
 
+/*!
+ * Handler that only counts the tags and data, and the maximal depth.
+ */
+class Tag_Counter : public Xml_Handler {
+  unsigned int nb_tags ;
+  unsigned int nb_data ;
+  unsigned int depth ;
+  unsigned int max_depth ;
+public :
+  Tag_Counter ()
+    : nb_tags ( 0 )
+    , nb_data ( 0 )
+    , depth ( 0 )
+    , max_depth ( 0 )
+  {} ;
+  bool on_open ( string const & tag ) {
+    ++ nb_tags ;
+    if ( max_depth < ++ depth ) max_depth = depth ;
+    return true ;
+  }
+  bool on_data ( Text const & data ) {
+    ++ nb_data ;
+    return true ;
+  }
+  bool on_close ( string const & tag ) {
+    -- depth ;
+    return true ;
+  }
+  friend ostream & operator << ( ostream & out ,
+				 Tag_Counter const & counter ) {
+    return out << counter . nb_tags << " tags " << counter . nb_data << " data depth " << counter . max_depth ;
+  }
+} ;
+
+
+/*!
+ * Read a Xml in a file without building it and print the counts.
+ */
+
+void test_count ( char const * const file_name ) {
+  Tag_Counter counter ;
+  bool const ok = Xml :: parse ( file_name , counter ) ;
+  cout << file_name << " " << ok << " " << counter << endl ;
+}
+
+
+
+/*!
+ * Find a path in a Xml and print the tags found, with their fathers.
+ */
+
+void test_find ( Xml const & xml ,
+		 char const * const path ) {
+  vector < Xml :: index > found ;
+  xml . find ( path , found ) ;
+  cout << path << " :" ;
+  for ( vector < Xml :: index > :: const_iterator it = found . begin () ;
+	it != found . end () ;
+	++ it ) {
+    Xml :: index const father = xml . get_tree () . get_father ( * it ) ;
+    cout << " " << * it << " " << xml . get_tag ( * it ) -> get_tag () ;
+    if ( Xml :: Tag_Tree :: none != father ) cout << "<" << xml . get_tag ( father ) -> get_tag () ;
+  }
+  cout << endl ;
+}
+
+
+
+/*!
+ * Load Xml files by threads and print, for each one, whether it was loaded and its number of tags
+ * (the times are not printed, they change from a run to the next).
+ */
+
+void test_batch ( vector < string > const & file_names ,
+		  unsigned int const nbr_threads ) {
+  Xml_Batch batch ;
+  for ( unsigned int k = 0 ; k < file_names . size () ; k ++ ) {
+    batch . add ( file_names [ k ] ) ;
+  }
+  batch . run ( nbr_threads ) ;
+  for ( unsigned int k = 0 ; k < batch . size () ; k ++ ) {
+    cout << batch . get_file_name ( k ) << " " << batch . is_loaded ( k ) ;
+    if ( batch . is_loaded ( k ) ) cout << " " << batch . get_xml ( k ) -> get_tree () . size () ;
+    cout << endl ;
+  }
+}
+
+
+
 /*!
  * Make the test with various Xml files.
  */
@@ -44,6 +135,37 @@ int main () {
   test_file ( "example_5.xml" ) ;  
   test_file ( "example_6.xml" ) ;
   test_file ( "example_7.xml" ) ;
+  {
+    Xml * xml = Xml :: load ( "example_7.xml" ) ;
+    Out_Buffer out ( cout ) ;
+    xml -> out_put < open_sons , sep_brothers , close_sons > ( out ) ;
+    out << "\n" ;
+    out . flush () ;
+    test_find ( * xml , "racine/fille1/petitefille11" ) ;
+    test_find ( * xml , "/racine/fille2" ) ;
+    test_find ( * xml , "//a" ) ;
+    test_find ( * xml , "//b/a" ) ;
+    test_find ( * xml , "racine//petitefille21/a" ) ;
+    test_find ( * xml , "fille1" ) ;
+    test_find ( * xml , "//fille1//a" ) ;
+    test_find ( * xml , "//missing" ) ;
+    delete xml ;
+  }
+  test_count ( "example_1.xml" ) ;
+  test_count ( "example_6.xml" ) ;
+  test_count ( "example_7.xml" ) ;
+  {
+    vector < string > file_names ;
+    file_names . push_back ( "example_1.xml" ) ;
+    file_names . push_back ( "example_2.xml" ) ;
+    file_names . push_back ( "example_3.xml" ) ;
+    file_names . push_back ( "example_4.xml" ) ;
+    file_names . push_back ( "missing.xml" ) ;
+    file_names . push_back ( "example_5.xml" ) ;
+    file_names . push_back ( "example_6.xml" ) ;
+    file_names . push_back ( "example_7.xml" ) ;
+    test_batch ( file_names , 3 ) ;
+  }
   return 0 ; 
 }
  
@@ -9,10 +9,13 @@
  * \date 2016
  */
 
-# include <stack>
 # include <ostream>
 
+# include "out_buffer.hpp"
+
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -99,11 +102,11 @@ public :
   Node * add_left_son ( T val ) { 
     
     if(NULL==this->left_son){
-      left_son=new Node(val,this->father);
+      left_son=new Node(val,this);
       //std::cout << "ajout" << std::endl;
     	return left_son;
   	}else{
-    	Node < T ,delete_T> * n =new Node(val,this->father);
+    	Node < T ,delete_T> * n =new Node(val,this);
     	n->right_brother = left_son;
       left_son=n;
       //std::cout << "ajout2" << std::endl;
@@ -128,8 +131,32 @@ public :
 	  }
   }
  
+  /*!
+   * Delete the node, its sons and its right brothers, and call \c delete_T on their values.
+   * There is no recursion (trees may be very deep):
+   * the left son of the current node is rotated to become its father
+   * until there is none, then the node is deleted and its right brother is next.
+   * \param n First node to delete (nothing if NULL).
+   */
+  static void delete_all ( Node * n ) {
+    while ( NULL != n ) {
+      Node * const s = n -> left_son ;
+      if ( NULL != s ) {
+	n -> left_son = s -> right_brother ;
+	s -> right_brother = n ;
+	n = s ;
+      } else {
+	Node * const b = n -> right_brother ;
+	delete_T ( n -> value ) ;
+	delete n ;
+	n = b ;
+      }
+    }
+  }
+
   /*!
    * Destructor.
+   * The sons and brothers are not deleted (see \c delete_all ).
    */
   ~ Node () { 
   } ;
@@ -152,6 +179,10 @@ class Tree {
    */
   Node < T , delete_T > * root ; 
 
+  /*! Not copyable (the nodes are deleted with the tree). */
+  Tree ( Tree const & ) ;
+  Tree & operator = ( Tree const & ) ;
+
 public:
 
   /*
@@ -179,57 +210,64 @@ public:
 
   /*!
    * Destructor.
+   * All the nodes are deleted and \c delete_T is called on their values, in linear time.
    */
   ~ Tree () { 
+    Node < T , delete_T > :: delete_all ( root ) ;
   }
 
  
+  /*!
+   * Output the tree: each value is followed by its sons between \c open_sons and \c close_sons ,
+   * brothers are separated by \c sep_brothers .
+   * The links are followed without any stack (the fathers are known).
+   */
   template < char const * const open_sons ,
 	     char const * const sep_brothers ,
 	     char const * const close_sons >
-  std :: ostream & out_put ( std :: ostream & ost 
-			     ) ;
+  void out_put ( Out_Buffer & out ) const ;
+
+  /*!
+   * Same as above, through an \c Out_Buffer on \c ost .
+   */
+  template < char const * const open_sons ,
+	     char const * const sep_brothers ,
+	     char const * const close_sons >
+  std :: ostream & out_put ( std :: ostream & ost ) const {
+    {
+      Out_Buffer out ( ost ) ;
+      out_put < open_sons , sep_brothers , close_sons > ( out ) ;
+    }
+    return ost ;
+  }
 } ; 
 
 
 
-/*
- * ???
- */
 template < class T ,
 	   void ( * delete_T ) ( T & ) >
 template < char const * const open_sons ,
 	   char const * const sep_brothers ,
 	   char const * const close_sons >
-std :: ostream & Tree < T , delete_T > :: out_put ( std :: ostream & ost ) {
-
-	std::stack < Node<T,delete_T>* > l;
-	Node <T,delete_T> * p =this->get_root();
-	while(NULL!=p){
-		ost << p->get_value();
-		if(NULL!=p->get_left_son() && NULL!=p->get_right_brother()){
-			ost << open_sons;
-			Node <T,delete_T> * p1=p->get_right_brother();
-			l.push(p1);
-			p=p->get_left_son();
-		}
-		else if(NULL!=p->get_left_son() && NULL==p->get_right_brother()){
-			ost << open_sons;
-			p=p->get_left_son();
-		}
-		else if(NULL==p->get_left_son() && NULL!=p->get_right_brother()){
-			ost << sep_brothers;
-			p=p->get_right_brother();
-		}
-		else if(0 < l.size()){
-			ost << close_sons;
-			ost << sep_brothers;
-			p=l.top();
-			l.pop();
-		}
-		else p=NULL;		
-	}
-	return ost << close_sons <<close_sons;	
+void Tree < T , delete_T > :: out_put ( Out_Buffer & out ) const {
+  Node < T , delete_T > const * n = get_root () ;
+  while ( NULL != n ) {
+    out << n -> get_value () ;
+    if ( NULL != n -> get_left_son () ) {
+      out << open_sons ;
+      n = n -> get_left_son () ;
+      continue ;
+    }
+    // go up till a node with a right brother (the sons of each node left are closed)
+    while ( NULL != n && NULL == n -> get_right_brother () ) {
+      n = n -> get_father () ;
+      if ( NULL != n ) out << close_sons ;
+    }
+    if ( NULL != n ) {
+      out << sep_brothers ;
+      n = n -> get_right_brother () ;
+    }
+  }
 }
 
 # endif 
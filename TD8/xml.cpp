@@ -1,8 +1,8 @@
 
-
-
 # include <string>
 # include <fstream>
+# include <map>
+# include <vector>
 
 # include <iostream>
 
@@ -10,11 +10,13 @@
 
 #include <sstream>
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
-using namespace std ; 
+using namespace std ;
 
 extern char const open_sons [] = " ( " ;
   /*! Separator between brothers for example.
@@ -31,253 +33,486 @@ void delete_Tag ( Tag * & t ) {
 
 namespace {
 
-  char const * const STR_SPC = " \t" ;
-  
-  /*
-   * Remove all trailing space at beginning and end.
-   * \param str string to be trimmed.
+  typedef Xml :: Tag_Tree Tag_Tree ;
+
+  /*! Size of the pieces of a file given to the scanner by \c Xml :: parse . */
+  unsigned int const chunk_size = 64 * 1024 ;
+
+  /*! Test for the spaces between tags and data. */
+  bool is_space ( char c ) {
+    return ' ' == c || '\t' == c || '\n' == c || '\r' == c ;
+  }
+
+  /*! Test for the characters of a tag name (but the first one, that should be a letter). */
+  bool is_name ( char c ) {
+    return ( 'a' <= c && c <= 'z' ) || ( 'A' <= c && c <= 'Z' ) || ( '0' <= c && c <= '9' )
+      || '_' == c || '-' == c ;
+  }
+
+  /*! Test for the first character of a tag name. */
+  bool is_name_first ( char c ) {
+    return ( 'a' <= c && c <= 'z' ) || ( 'A' <= c && c <= 'Z' ) ;
+  }
+
+
+  /*!
+   * Builder of the tree of a document, element by element (the handler of \c Xml :: load ).
+   * The \c Tag of an element is only known at its first data, son or closing
+   * (with data, it is a \c Tag_Data ), so that its node is made then.
+   * The data are kept as they are given: they should be in a buffer that outlives the tree.
    */
-  void trim ( string & str ) {
-	  for(unsigned int i=0;i<str.length();i++){
-		  if(str[i]==' ') str.erase(i,1);
+  class Tree_Builder : public Xml_Handler {
+
+    /*! An element opened and not closed yet. */
+    struct Open {
+      /*! Tag name (number in \c Tag_Names ). */
+      unsigned int tag ;
+      /*! Node of the element ( \c Tag_Tree :: none if not made yet). */
+      Tag_Tree :: index node ;
+      /*! Last son of the node ( \c Tag_Tree :: none if none). */
+      Tag_Tree :: index last_son ;
+    } ;
+
+    /*! The tree (NULL till the root is made). */
+    Tag_Tree * tree ;
+    /*! The elements opened, from the root (only the first \c depth are, the others are kept for later ones). */
+    vector < Open > opens ;
+    /*! Number of elements opened. */
+    unsigned int depth ;
+    /*! Numbers of the names met (so that \c Tag_Names is only locked for the new ones). */
+    map < string , unsigned int > names ;
+
+    /*! Make the node of the innermost element. */
+    void make_node ( Tag * tag ) {
+      Open & o = opens [ depth - 1 ] ;
+      assert ( Tag_Tree :: none == o . node ) ;
+      if ( 1 == depth ) {
+	tree = new Tag_Tree ( tag ) ;
+	o . node = tree -> get_root () ;
+	return ;
+      }
+      Open & f = opens [ depth - 2 ] ;
+      assert ( Tag_Tree :: none != f . node ) ;
+      o . node = ( Tag_Tree :: none == f . last_son )
+	? tree -> add_left_son ( f . node , tag )
+	: tree -> add_right_brother ( f . last_son , tag ) ;
+      f . last_son = o . node ;
+    }
+
+  public :
+
+    Tree_Builder ()
+      : tree ( NULL )
+      , depth ( 0 )
+    {} ;
+
+    /*!
+     * An element is opened.
+     * \return false if it is not allowed (a second root, or a sibling of data).
+     */
+    bool on_open ( string const & tag ) {
+      if ( 0 == depth ) {
+	if ( NULL != tree ) {
+	  cerr << "ERROR tag " << tag << " after the root" << endl ;
+	  return false ;
+	}
+      } else {
+	Open & f = opens [ depth - 1 ] ;
+	if ( Tag_Tree :: none == f . node ) {
+	  make_node ( new Tag_Inner ( f . tag ) ) ;
+	} else if ( ! tree -> get_value ( f . node ) -> accepts_sub_tag () ) {
+	  cerr << "ERROR tag " << tag << " in data tag " << Tag_Names :: get_name ( f . tag ) << endl ;
+	  return false ;
+	}
+      }
+      if ( opens . size () == depth ) opens . push_back ( Open () ) ;
+      Open & o = opens [ depth ++ ] ;
+      map < string , unsigned int > :: const_iterator const it = names . find ( tag ) ;
+      o . tag = ( names . end () != it ) ? it -> second : ( names [ tag ] = Tag_Names :: intern ( tag ) ) ;
+      o . node = Tag_Tree :: none ;
+      o . last_son = Tag_Tree :: none ;
+      return true ;
+    }
+
+    /*!
+     * Data for the innermost element.
+     * \return false if it is not allowed (outside the root, or with sons).
+     */
+    bool on_data ( Text const & data ) {
+      if ( 0 == depth ) {
+	cerr << "ERROR data " << data << " outside the root" << endl ;
+	return false ;
+      }
+      Open & o = opens [ depth - 1 ] ;
+      if ( Tag_Tree :: none != o . node ) {
+	cerr << "ERROR data " << data << " in tag " << Tag_Names :: get_name ( o . tag ) << " with sons" << endl ;
+	return false ;
+      }
+      make_node ( new Tag_Data ( o . tag , data ) ) ;
+      return true ;
     }
-  }
 
-  /*
-   * Test if a trimmed string is an opening tag (of the form '<' then a letter then letters and/or digits then '>')
-   * If this is an opening tag, then the string is reduced to the letters and digits. 
-   * \param str trimmed string.
-   * \return true if this is an opening tag.
+    /*!
+     * The innermost element is closed.
+     * \return false if it is not \c tag .
+     */
+    bool on_close ( string const & tag ) {
+      if ( 0 == depth ) {
+	cerr << "ERROR tag " << tag << " closed outside the root" << endl ;
+	return false ;
+      }
+      Open & o = opens [ depth - 1 ] ;
+      if ( tag != Tag_Names :: get_name ( o . tag ) ) {
+	cerr << "ERROR tag " << Tag_Names :: get_name ( o . tag ) << " is closed by " << endl ;
+	cerr << "tag " << tag << endl ;
+	return false ;
+      }
+      if ( Tag_Tree :: none == o . node ) make_node ( new Tag_Inner ( o . tag ) ) ;
+      -- depth ;
+      return true ;
+    }
+
+    /*!
+     * Give the tree built (the caller then owns it).
+     * \return NULL if there is no root or it is not closed.
+     */
+    Tag_Tree * release () {
+      if ( NULL == tree || 0 != depth ) return NULL ;
+      Tag_Tree * const t = tree ;
+      tree = NULL ;
+      return t ;
+    }
+
+    /*! The tree not given is deleted. */
+    ~ Tree_Builder () {
+      delete tree ;
+    }
+  } ;
+
+
+  /*!
+   * Scanner of a document, as a state machine on the characters:
+   * the tags and the data are given to a \c Xml_Handler as soon as they are complete.
+   * The state is kept from a call to \c scan to the next, so that the document may come by pieces.
+   * Each character is looked at once, and the strings are reused from a tag to the next
+   * (no work depends on the lines or on the length of what was read before).
+   * The data are given as the \c Text of the piece they are in (they are not copied),
+   * but for data over many pieces, that are given as a copy.
    */
-  bool is_opening_tag ( string & str ) {
-	  trim(str);
-	  if(str[0]=='<' && str[1]!='/'){
-      str.erase(0,1);
-      str.erase(str.length()-1,1);
-	    return true ; 
-    }else return false;
+  class Scanner {
+
+    enum scan_state {
+      /*! Between tags (data or spaces). */
+      in_text ,
+      /*! Just after '<'. */
+      in_tag_begin ,
+      /*! In the name of an opening tag. */
+      in_open_name ,
+      /*! In the name of a closing tag. */
+      in_close_name ,
+      /*! After the name of an opening tag (spaces till '>'). */
+      in_open_end ,
+      /*! After the name of a closing tag (spaces till '>'). */
+      in_close_end
+    } ;
+
+    scan_state state ;
+    /*! Name of the current tag. */
+    string name ;
+    /*! First character of the data in the current piece (NULL if none or if the data began in a previous piece). */
+    char const * data_begin ;
+    /*! Character after the last one of the data (but spaces) in the current piece (NULL if none). */
+    char const * data_end ;
+    /*! Beginning of the current piece. */
+    char const * piece_begin ;
+    /*! Copy of the characters of the data in the previous pieces (empty if none). */
+    string carry ;
+    /*! Length of \c carry without the spaces at the end. */
+    string :: size_type carry_length ;
+    /*! Receiver of the tags and data. */
+    Xml_Handler & handler ;
+
+    /*! Give the data read before a tag, if any. */
+    bool flush_data () {
+      if ( carry . empty () ) {
+	if ( NULL == data_begin ) return true ;
+	bool const ok = handler . on_data ( Text ( data_begin , data_end ) ) ;
+	data_begin = data_end = NULL ;
+	return ok ;
+      }
+      if ( NULL != data_end ) {
+	carry . append ( piece_begin , data_end ) ;
+	carry_length = carry . size () ;
+      }
+      bool const ok = handler . on_data ( Text ( carry . data () , carry . data () + carry_length ) ) ;
+      carry . clear () ;
+      data_begin = data_end = NULL ;
+      return ok ;
+    }
+
+    /*! Copy the data of the current piece that ends at \c end , if any. */
+    void carry_data ( char const * end ) {
+      if ( carry . empty () && NULL == data_begin ) return ;
+      carry . append ( carry . empty () ? data_begin : piece_begin , end ) ;
+      if ( NULL != data_end ) carry_length = carry . size () - ( end - data_end ) ;
+      data_begin = data_end = NULL ;
+    }
+
+  public :
+
+    Scanner ( Xml_Handler & _handler )
+      : state ( in_text )
+      , data_begin ( NULL )
+      , data_end ( NULL )
+      , piece_begin ( NULL )
+      , carry_length ( 0 )
+      , handler ( _handler )
+    {} ;
+
+    /*!
+     * Scan the characters in [ \c begin , \c end ) .
+     * \return false if the document is not well formed (the error is reported on \c cerr ).
+     */
+    bool scan ( char const * begin ,
+		char const * end ) {
+      piece_begin = begin ;
+      for ( char const * p = begin ; p != end ; ++ p ) {
+	char const c = * p ;
+	switch ( state ) {
+	case in_text :
+	  if ( '<' == c ) {
+	    if ( ! flush_data () ) return false ;
+	    state = in_tag_begin ;
+	  } else if ( ! is_space ( c ) ) {
+	    if ( NULL == data_begin && carry . empty () ) data_begin = p ;
+	    data_end = p + 1 ;
+	  }
+	  break ;
+	case in_tag_begin :
+	  name . clear () ;
+	  if ( '/' == c ) {
+	    state = in_close_name ;
+	  } else if ( is_name_first ( c ) ) {
+	    name += c ;
+	    state = in_open_name ;
+	  } else {
+	    cerr << "ERROR character " << c << " after <" << endl ;
+	    return false ;
+	  }
+	  break ;
+	case in_open_name :
+	case in_close_name :
+	  if ( is_name ( c ) && ( ! name . empty () || is_name_first ( c ) ) ) {
+	    name += c ;
+	    break ;
+	  }
+	  if ( name . empty () ) {
+	    cerr << "ERROR character " << c << " after </" << endl ;
+	    return false ;
+	  }
+	  state = ( in_open_name == state ) ? in_open_end : in_close_end ;
+	  // the character ends the name
+	  // fall through
+	case in_open_end :
+	case in_close_end :
+	  if ( '>' == c ) {
+	    if ( ! ( ( in_open_end == state ) ? handler . on_open ( name ) : handler . on_close ( name ) ) ) return false ;
+	    state = in_text ;
+	  } else if ( ! is_space ( c ) ) {
+	    cerr << "ERROR character " << c << " in tag " << name << endl ;
+	    return false ;
+	  }
+	  break ;
+	}
+      }
+      carry_data ( end ) ;
+      return true ;
+    }
+
+    /*!
+     * End of the document.
+     * \return false if it ends in a tag or with data.
+     */
+    bool finish () {
+      if ( in_text != state || ! carry . empty () ) {
+	cerr << "ERROR end of document in tag or data" << endl ;
+	return false ;
+      }
+      return true ;
+    }
+  } ;
+
+}
+
+
+# define FAIL_LOAD return NULL ;
+
+
+bool Xml :: parse ( char const * begin ,
+		   char const * end ,
+		   Xml_Handler & handler ) {
+  Scanner scanner ( handler ) ;
+  return scanner . scan ( begin , end ) && scanner . finish () ;
+}
+
+
+bool Xml :: parse ( char const * const file_name ,
+		    Xml_Handler & handler ) {
+  ifstream file ( file_name , ios :: in | ios :: binary ) ;
+  if ( ! file ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    return false ;
+  }
+  Scanner scanner ( handler ) ;
+  vector < char > buffer ( chunk_size ) ;
+  while ( file ) {
+    file . read ( & buffer [ 0 ] , chunk_size ) ;
+    if ( ! scanner . scan ( & buffer [ 0 ] , & buffer [ 0 ] + file . gcount () ) ) return false ;
   }
+  if ( ! file . eof () ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    return false ;
+  }
+  return scanner . finish () ;
+}
 
-  /*
-   * Test if a trimmed string is an closing tag (of the form "</" then a letter then letters and/or digits then '>')
-   * If this is an closing tag, then the string is reduced to the letters and digits. 
-   * \param str trimmed string.
-   * \return true if this is an closing tag.
-   */
-  bool is_closing_tag ( string & str ) { 
-    assert(2<str.length());
-    trim(str);
-    if(str[1]=='/'&&str[0]=='<'){
-      str.erase(0,2);
-      str.erase(str.length()-1,1);  
-      return true;
-    }else return false;
+
+bool Xml :: build () {
+  Tree_Builder builder ;
+  // in one piece, so that the data given to the builder are in the buffer
+  char const * const begin = buffer . empty () ? NULL : & buffer [ 0 ] ;
+  if ( ! parse ( begin , begin + buffer . size () , builder ) ) return false ;
+  tree = builder . release () ;
+  if ( NULL == tree ) {
+    cerr << "ERROR no root or root not closed" << endl ;
+    return false ;
+  }
+  // the nodes are made in document order
+  by_tag . assign ( Tag_Names :: size () , vector < index > () ) ;
+  for ( index n = 0 ; n < tree -> size () ; n ++ ) {
+    by_tag [ tree -> get_value ( n ) -> get_id () ] . push_back ( n ) ;
   }
+  return true ;
+}
 
-  enum load_state {
-    beginning ,
-    beginning_open ,
-    last_open_son ,
-    last_open_brother ,
-    last_data ,
-    last_close 
-  } ;
-    
+
+vector < Xml :: index > const & Xml :: get_nodes ( string const & tag ) const {
+  static vector < index > const no_node ;
+  unsigned int const id = Tag_Names :: find ( tag ) ;
+  if ( Tag_Names :: none == id || by_tag . size () <= id ) return no_node ;
+  return by_tag [ id ] ;
 }
 
 
-# define FAIL_LOAD return NULL ; 
+bool Xml :: matches ( vector < Step > const & steps ,
+		      unsigned int k ,
+		      index n ) const {
+  if ( tree -> get_value ( n ) -> get_id () != steps [ k ] . tag ) return false ;
+  index a = tree -> get_father ( n ) ;
+  if ( 0 == k ) return steps [ 0 ] . descendant || Tag_Tree :: none == a ;
+  if ( ! steps [ k ] . descendant ) return Tag_Tree :: none != a && matches ( steps , k - 1 , a ) ;
+  for ( ; Tag_Tree :: none != a ; a = tree -> get_father ( a ) ) {
+    if ( matches ( steps , k - 1 , a ) ) return true ;
+  }
+  return false ;
+}
 
 
-/*! This one comes with debugging outputs. */
-# define TEST_TAG( lib1 , lib2 )				\
-  if ( ( lib1 ) != ( lib2 ) ) {					\
-    cerr << "ERROR " << * xml << endl ;				\
-    cerr << "tag " << ( lib1 ) <<  " is closed by " << endl ;	\
-    cerr << "tag " << ( lib2 ) << endl  ;			\
-    FAIL_LOAD ;							\
+void Xml :: find ( string const & path ,
+		   vector < index > & result ) const {
+  result . clear () ;
+  // the steps of the path
+  vector < Step > steps ;
+  string :: size_type p = 0 ;
+  bool descendant = false ;
+  if ( 0 == path . compare ( 0 , 2 , "//" ) ) {
+    descendant = true ;
+    p = 2 ;
+  } else if ( 0 == path . compare ( 0 , 1 , "/" ) ) {
+    p = 1 ;
+  }
+  while ( true ) {
+    string :: size_type const q = path . find ( '/' , p ) ;
+    string const name = path . substr ( p , ( string :: npos == q ) ? string :: npos : q - p ) ;
+    if ( name . empty () ) return ;
+    Step const s = { Tag_Names :: find ( name ) , descendant } ;
+    if ( Tag_Names :: none == s . tag ) return ;
+    steps . push_back ( s ) ;
+    if ( string :: npos == q ) break ;
+    p = q + 1 ;
+    descendant = ( p < path . size () && '/' == path [ p ] ) ;
+    if ( descendant ) ++ p ;
+  }
+  // the candidates are the nodes of the last tag
+  vector < index > const & candidates = get_nodes ( Tag_Names :: get_name ( steps . back () . tag ) ) ;
+  for ( vector < index > :: const_iterator it = candidates . begin () ;
+	it != candidates . end () ;
+	++ it ) {
+    if ( matches ( steps , steps . size () - 1 , * it ) ) result . push_back ( * it ) ;
   }
+}
 
 
+Xml * Xml :: load ( char const * begin ,
+		    char const * end ) {
+  Xml * const xml = new Xml () ;
+  xml -> buffer . assign ( begin , end ) ;
+  if ( xml -> build () ) return xml ;
+  delete xml ;
+  FAIL_LOAD ;
+}
 
-Xml * Xml :: load ( char const * const file_name ) {
-  load_state ls=beginning;
-  string str1,str2;
-  ifstream file (file_name); 
-  
-  //getline(file,str1);
-  getline(file,str1);
-  assert(is_opening_tag(str1));
-  
-  /*Tag_Inner t = Tag_Inner(str1);
-  Tree < Tag *, delete_Tag > tree ( &t ) ;
-  Node < Tag *, delete_Tag > *node_current = tree . get_root () ;*/
-  ls=beginning;
-  bool fin=false;
-  cout << str1 << endl;
-  cout << str1 << endl;
-  Tree < Tag *, delete_Tag > * ptr_tree=NULL;
-  
-  while(!fin){
-    
-    Node < Tag *, delete_Tag > * node_current;
-    
-    getline(file,str2);
-   // is_opening_tag(str2);
-    cout << ls << endl;
-    switch(ls){
-       
-      case beginning : 
-        if(!is_opening_tag(str2)){
-          cout << str2 << "opening" << endl;
-          Tag_Inner t = Tag_Inner(str1);
-          
-          ls=last_open_son;
-          Tree < Tag *, delete_Tag > tree ( &t ) ;
-          Node < Tag *, delete_Tag > *node_current = tree . get_root () ;
-          ptr_tree=&(tree);
-          //node_current=node_current;
-        }else if(is_closing_tag(str2)){
-          cout << str2 << "closing" << endl;
-          Tag_Inner t = Tag_Inner(str1);
-          ls=last_close;
-          Tree < Tag *, delete_Tag > tree ( &t ) ;
-          Node < Tag *, delete_Tag > *node_current = tree . get_root () ;
-          ptr_tree=&(tree);
-          //node_current=&(*node_current);
-        }else{ //forcément un data
-          cout << str2 << "data" << endl;
-          //*ptr_node_current=(*ptr_node_current)->add_left_son(new Tag_Data(str1,str2));
-          Tag_Data t = Tag_Data(str1,str2);
-          ls=last_close;
-          Tree < Tag *, delete_Tag > tree ( &t ) ;
-          Node < Tag *, delete_Tag > *node_current = tree . get_root () ;
-          ptr_tree=&(tree);
-          //ptr_node_current=&(*node_current);
-          getline(file,str2);
-        }
-        str1=str2;
-        break;
-
-      /*case beginning_open :
-        if(is_opening_tag(str2)){
-          *ptr_node_current=*ptr_node_current->add_left_son(new Tag_Inner(str1));
-          ls=last_open_son;
-        }else if(is_closing_tag(str2)){
-          ls=last_close;
-        }else{ //forcément un data
-          *ptr_node_current=(*ptr_node_current)->add_left_son(=new Tag_Inner(new Tag_Data(str1,str2));
-          ls=last_close;//data
-          getline(file,str2);
-        }
-        str1=str2;
-      break;*/
-
-      case last_open_son : 
-        if(!is_opening_tag(str2)){
-          cout << str2 << " OPENING SON" <<endl;
-          
-          Tag_Inner t1 (str1);
-          cout << "ajout fils" << endl;
-          //node_current->son
-          node_current->add_left_son(&t1);
-          assert(NULL!=node_current->get_left_son());
-          node_current=node_current->get_left_son();
-          cout << "ajout fils2" << endl;
-        }else if(is_closing_tag(str2)){
-          cout << str2 << " CLOSING SON " <<endl;
-          //node_current=node_current->get_father();
-          ls=last_close;
-        }else{
-          cout << str2 << " DATA SON " <<endl;
-          (node_current)->add_left_son(new Tag_Data(str1,str2));
-          ls=last_close;
-          getline(file,str2);
-        }
-        str1=str2;
-        break;
-
-      case last_open_brother : 
-        if(!is_opening_tag(str2)){
-          node_current=(node_current)->add_left_son(new Tag_Inner(str2));
-          ls=last_open_son;
-        }else if(is_closing_tag(str2)){
-          node_current=(node_current)->get_right_brother();
-          ls=last_close;
-        }else{
-          (node_current)->add_left_son(new Tag_Data(str1,str2));
-          ls=last_close;//data
-          getline(file,str2);
-        }
-        str1=str2;
-      break;
-
-      case last_data : 
-        assert(is_opening_tag(str2));
-        //node_current=node_current->get_right_brother();
-        ls=last_close;
-        break;
-
-      case last_close :
-        cout << str2 << endl;
-        if(file.eof()){
-          fin=true;
-          break;
-        }else if(!is_opening_tag(str2)){
-          node_current=(node_current)->get_right_brother();
-          ls=last_open_brother;
-        }else if(is_closing_tag(str2)){ //forcément un data
-          node_current=(node_current)->get_father();
-          ls=last_close;
-        }else{
-          printf("GROS PROBLEME");
-        }
-        str1=str2;
-        break;
-
-      default : fin=true;
-        cout << "GROS PROBLEME";
-        break;
-    }
 
-    
+Xml * Xml :: load ( char const * const file_name ) {
+  // the whole file in the buffer of the document
+  ifstream file ( file_name , ios :: in | ios :: binary ) ;
+  if ( ! file ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    FAIL_LOAD ;
+  }
+  file . seekg ( 0 , ios :: end ) ;
+  streamoff const size = file . tellg () ;
+  file . seekg ( 0 , ios :: beg ) ;
+  Xml * const xml = new Xml () ;
+  xml -> buffer . resize ( size ) ;
+  if ( 0 < size && ! file . read ( & xml -> buffer [ 0 ] , size ) ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    delete xml ;
+    FAIL_LOAD ;
   }
-  Xml * xml = new Xml(ptr_tree);
-  file.close();
+  file . close () ;
+  if ( xml -> build () ) return xml ;
+  delete xml ;
+  FAIL_LOAD ;
+}
+
 
-  return xml;
-  
-} 
 
 
 
+void Xml :: print ( Out_Buffer & out ) const {
+  // depth first, by the links only: each tag is closed when leaving its node
+  Tag_Tree :: index n = tree -> get_root () ;
+  while ( true ) {
+    tree -> get_value ( n ) -> write_open ( out ) ;
+    if ( Tag_Tree :: none != tree -> get_left_son ( n ) ) {
+      n = tree -> get_left_son ( n ) ;
+      continue ;
+    }
+    while ( Tag_Tree :: none == tree -> get_right_brother ( n ) ) {
+      tree -> get_value ( n ) -> write_close ( out ) ;
+      n = tree -> get_father ( n ) ;
+      if ( Tag_Tree :: none == n ) return ;
+    }
+    tree -> get_value ( n ) -> write_close ( out ) ;
+    n = tree -> get_right_brother ( n ) ;
+  }
+}
 
 
 std :: ostream & operator << ( std :: ostream & out ,
-			       Xml const & xml ) {  
-  //char* open_sons_parent =  , sep_brothers_comma , close_sons_parent > (out);
-  //std::stack < Node<Tag *, delete_Tag>* > l;
-	Node <Tag *, delete_Tag> * p =xml.tree->get_root();
-	while(NULL!=p){
-		out << p->get_value()->get_tag() << endl;
-		if(NULL!=p->get_left_son() && NULL!=p->get_right_brother()){
-			p=p->get_left_son();
-		}
-		else if(NULL!=p->get_left_son() && NULL==p->get_right_brother()){
-			p=p->get_left_son();
-		}
-		else if(NULL==p->get_left_son() && NULL!=p->get_right_brother()){
-			p=p->get_right_brother();
-		}else{
-      out << p->get_value()->get_tag() << endl;
-      p=NULL;
-    } 		
-	}
-	return out;
- 
- /*
-  Node < Tag *, delete_Tag > *current = xml.tree->get_root();
-   out << (current)->get_value()->get_tag();
-  return out;*/
+			       Xml const & xml ) {
+  Out_Buffer buffer ( out ) ;
+  xml . print ( buffer ) ;
+  return out ;
 }
-
@@ -10,11 +10,16 @@
  */
 
 
-# include "tree.hpp"
+# include <string>
+# include <vector>
+
+# include "flat_tree.hpp"
 # include "tag.hpp"
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
@@ -22,27 +27,170 @@
  * For template instantiation.
  */
 extern void delete_Tag ( Tag * & t ) ;
+
+/*! Opening parenthesis, for \c Xml :: out_put . */
+extern char const open_sons [] ;
+/*! Separator between brothers, for \c Xml :: out_put . */
+extern char const sep_brothers [] ;
+/*! Closing parenthesis, for \c Xml :: out_put . */
+extern char const close_sons [] ;
   
 
+/*!
+ * Receiver of the events of the reading of a Xml document (see \c Xml :: parse ),
+ * for the consumers that need not keep the document.
+ * Each method returns false to stop the reading (the error should then be reported on \c cerr ).
+ */
+class Xml_Handler {
+public :
+  /*! Opening tag \c tag . */
+  virtual bool on_open ( std :: string const & tag ) = 0 ;
+  /*!
+   * Data \c data of the innermost tag opened (without the spaces at the beginning and at the end).
+   * The characters are only valid during the call (they are in the piece of the document read).
+   */
+  virtual bool on_data ( Text const & data ) = 0 ;
+  /*! Closing tag \c tag (that may not match the opening one). */
+  virtual bool on_close ( std :: string const & tag ) = 0 ;
+  virtual ~ Xml_Handler () {}
+} ;
+
+
 /*!
  * This class records Xml documents as Tree of Tag.
+ * The nodes are in one array (see \c Flat_Tree ), in document order.
  */
 class Xml {
 
-  Tree < Tag * , delete_Tag > * tree ;
+public :
+
+  /*! Tree of a document. */
+  typedef Flat_Tree < Tag * , delete_Tag > Tag_Tree ;
+
+  /*! Node of the tree (in document order). */
+  typedef Tag_Tree :: index index ;
+
+private :
 
-  Xml ( Tree < Tag * , delete_Tag > * tree ) :
-    tree ( tree )
+  /*! The whole document, that the data of the \c Tag_Data are in. */
+  std :: vector < char > buffer ;
+
+  Tag_Tree * tree ;
+
+  /*! The nodes of each tag, by number in \c Tag_Names , in document order (built by \c build ). */
+  std :: vector < std :: vector < index > > by_tag ;
+
+  /*! One step of a path (see \c find ). */
+  struct Step {
+    /*! Number of the tag name ( \c Tag_Names :: none if unknown). */
+    unsigned int tag ;
+    /*! Whether the node may be any descendant of the node of the previous step (else a son). */
+    bool descendant ;
+  } ;
+
+  /*!
+   * Test whether the node \c n of the first \c k + 1 steps of \c steps matches step \c k ,
+   * and its ancestors the previous ones (the first step is the root, unless it is a descendant one).
+   */
+  bool matches ( std :: vector < Step > const & steps ,
+		 unsigned int k ,
+		 index n ) const ;
+
+  Xml () :
+    tree ( NULL )
   {} ;
 
+  /*! Build the tree of the document in \c buffer (false if it is not well formed). */
+  bool build () ;
+
 public :
 
+  /*!
+   * Read a Xml document and give its tags and data to \c handler , in order.
+   * The file is read by chunks of a fixed size and scanned character by character in one pass,
+   * so that the memory used does not depend on the size of the document
+   * (tags need not be alone on their lines).
+   * \param file_name Name of the file.
+   * \param handler Receiver of the events.
+   * \return false if the file cannot be read, is not well formed or \c handler stopped the reading.
+   */
+  static bool parse ( char const * const file_name ,
+		      Xml_Handler & handler ) ;
+
+  /*!
+   * Same as above, for the document in the buffer [ \c begin , \c end ) .
+   */
+  static bool parse ( char const * begin ,
+		      char const * end ,
+		      Xml_Handler & handler ) ;
+
+  /*!
+   * Read a Xml document in a file (by \c parse , with an \c Xml_Handler that builds the tree).
+   * The whole file is kept in a buffer, so that the data are not copied (see \c Tag_Data ).
+   * The tags are of the form \c <name> and \c </name> (a letter then letters, digits, '_' or '-'),
+   * a tag holds either tags or data (spaces at the beginning and at the end of data are removed).
+   * \param file_name Name of the file.
+   * \return The document, or NULL if the file cannot be read or is not well formed
+   * (the error is reported on \c cerr ).
+   */
   static Xml * load ( char const * const file_name ) ;
 
+  /*!
+   * Same as above, for the document in the buffer [ \c begin , \c end ) (that is copied once).
+   */
+  static Xml * load ( char const * begin ,
+		      char const * end ) ;
+
   ~ Xml () {
     delete tree ;
   }
 
+  /*! The tree of the document. */
+  Tag_Tree const & get_tree () const {
+    return * tree ;
+  }
+
+  /*! The tag of node \c n . */
+  Tag const * get_tag ( index n ) const {
+    return tree -> get_value ( n ) ;
+  }
+
+  /*! The nodes of tag \c tag , in document order (e.g. for <tt>//tag</tt>). */
+  std :: vector < index > const & get_nodes ( std :: string const & tag ) const ;
+
+  /*!
+   * Find the nodes of a path, in document order, like:
+   * - <tt>racine/fille/petiteFille</tt> (or <tt>/racine/fille/petiteFille</tt>): from the root, son by son,
+   * - <tt>//petiteFille</tt>: all the nodes of a tag,
+   * - <tt>racine//a</tt> or <tt>//fille//b/a</tt>: \c // for any descendant.
+   *
+   * The candidates are the nodes of the last tag of the path (see \c get_nodes ),
+   * each one is checked by going up to its ancestors:
+   * the time does not depend on the size of the document, but on the number of these nodes.
+   * \param path The path.
+   * \param result Filled with the nodes found.
+   */
+  void find ( std :: string const & path ,
+	      std :: vector < index > & result ) const ;
+
+  /*!
+   * Write the document as Xml (see \c operator<< ), without recursion nor stack.
+   * \param out Buffer to write to (it can be reused for many documents).
+   */
+  void print ( Out_Buffer & out ) const ;
+
+  /*!
+   * Write the tree of the document in parenthesized form (see \c Flat_Tree :: out_put ),
+   * e.g. <tt>racine ( fille ( petiteFille "BBBB ! : , b fg" , petiteFilleAutre "34567890  LKJHGFDS" ) )</tt>
+   * with \c open_sons , \c sep_brothers and \c close_sons .
+   */
+  template < char const * const open_sons ,
+	     char const * const sep_brothers ,
+	     char const * const close_sons >
+  void out_put ( Out_Buffer & out ) const {
+    tree -> out_put < open_sons , sep_brothers , close_sons > ( out ) ;
+  }
+
   friend std :: ostream & operator << ( std :: ostream & out ,
 					Xml const & xml ) ;
 } ;
@@ -63,6 +211,7 @@ BBBB ! : , b fg
 </fille>
 </racine>
  * \endverbatim
+ * The output goes through an \c Out_Buffer (see \c Xml :: print ).
  * \param out The output stream to output to.
  * \param xml The xml to  output.
  * \return the output stream \c out.
@@ -0,0 +1,114 @@
+
+# include <pthread.h>
+# include <sys/time.h>
+
+# include "xml_batch.hpp"
+
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Current time, in seconds. */
+  double now () {
+    timeval t ;
+    gettimeofday ( & t , 0 ) ;
+    return t . tv_sec + 1e-6 * t . tv_usec ;
+  }
+
+
+  /*! Loading of files by threads. */
+  class Loader {
+
+    vector < string > const & file_names ;
+    vector < Xml * > & xmls ;
+    vector < double > & seconds ;
+
+    /*! Position of the next file to take. */
+    unsigned int next ;
+    pthread_mutex_t mutex ;
+
+    static void * start ( void * l ) {
+      static_cast < Loader * > ( l ) -> work () ;
+      return 0 ;
+    }
+
+  public :
+
+    Loader ( vector < string > const & _file_names ,
+	     vector < Xml * > & _xmls ,
+	     vector < double > & _seconds )
+      : file_names ( _file_names )
+      , xmls ( _xmls )
+      , seconds ( _seconds )
+      , next ( 0 )
+    {
+      pthread_mutex_init ( & mutex , 0 ) ;
+    }
+
+    ~Loader () {
+      pthread_mutex_destroy ( & mutex ) ;
+    }
+
+    /*! Loop of a thread till there is no file left. */
+    void work () {
+      while ( true ) {
+	pthread_mutex_lock ( & mutex ) ;
+	unsigned int const k = next ++ ;
+	pthread_mutex_unlock ( & mutex ) ;
+	if ( file_names . size () <= k ) return ;
+	double const begin = now () ;
+	xmls [ k ] = Xml :: load ( file_names [ k ] . c_str () ) ;
+	seconds [ k ] = now () - begin ;
+      }
+    }
+
+    /*! Start the other threads, work too and wait for them. */
+    void run ( unsigned int nbr_threads ) {
+      vector < pthread_t > threads ( nbr_threads ) ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	int const ret = pthread_create ( & threads [ t ] , 0 , start , this ) ;
+	assert ( 0 == ret ) ;
+      }
+      work () ;
+      for ( unsigned int t = 1 ; t < nbr_threads ; t ++ ) {
+	pthread_join ( threads [ t ] , 0 ) ;
+      }
+    }
+  } ;
+
+}
+
+
+void Xml_Batch :: add ( string const & file_name ) {
+  Entry const e = { file_name , NULL , 0 } ;
+  entries . push_back ( e ) ;
+}
+
+
+void Xml_Batch :: run ( unsigned int nbr_threads ) {
+  assert ( 1 <= nbr_threads ) ;
+  // each thread writes its own cells
+  vector < string > file_names ;
+  for ( unsigned int k = 0 ; k < entries . size () ; k ++ ) {
+    delete entries [ k ] . xml ;
+    entries [ k ] . xml = NULL ;
+    file_names . push_back ( entries [ k ] . file_name ) ;
+  }
+  vector < Xml * > xmls ( entries . size () , ( Xml * ) NULL ) ;
+  vector < double > seconds ( entries . size () , 0 ) ;
+  Loader loader ( file_names , xmls , seconds ) ;
+  loader . run ( nbr_threads ) ;
+  for ( unsigned int k = 0 ; k < entries . size () ; k ++ ) {
+    entries [ k ] . xml = xmls [ k ] ;
+    entries [ k ] . seconds = seconds [ k ] ;
+  }
+}
+
+
+Xml_Batch :: ~ Xml_Batch () {
+  for ( unsigned int k = 0 ; k < entries . size () ; k ++ ) {
+    delete entries [ k ] . xml ;
+  }
+}
@@ -0,0 +1,103 @@
+# ifndef __XML_BATCH_HPP_
+# define __XML_BATCH_HPP_
+
+/*!
+ * \file
+ * This module provides the loading of many Xml documents at a time, by threads.
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <string>
+# include <vector>
+
+# include "xml.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * Files to load, each one in a \c Xml of its own (with its own buffer and tree).
+ * The threads of \c run take the files one after the other till there is none left,
+ * so that a long file does not hold the others.
+ */
+class Xml_Batch {
+
+  /*! A file and the result of its loading. */
+  struct Entry {
+    /*! Name of the file. */
+    std :: string file_name ;
+    /*! The document (NULL if not loaded, or if it could not be). */
+    Xml * xml ;
+    /*! Time of the loading, in seconds. */
+    double seconds ;
+  } ;
+
+  /*! The files, in the order they were added. */
+  std :: vector < Entry > entries ;
+
+  /*! Not copyable (the documents are deleted with the batch). */
+  Xml_Batch ( Xml_Batch const & ) ;
+  Xml_Batch & operator = ( Xml_Batch const & ) ;
+
+public :
+
+  /*! Empty batch. */
+  Xml_Batch () {} ;
+
+  /*! Add a file to load. */
+  void add ( std :: string const & file_name ) ;
+
+  /*!
+   * Load all the files (those loaded before are loaded again).
+   * \param nbr_threads Number of threads (at least 1, the calling one is one of them).
+   */
+  void run ( unsigned int nbr_threads ) ;
+
+  /*! Number of files. */
+  unsigned int size () const {
+    return entries . size () ;
+  } ;
+
+  /*! Name of file \c k . */
+  std :: string const & get_file_name ( unsigned int k ) const {
+    assert ( k < entries . size () ) ;
+    return entries [ k ] . file_name ;
+  } ;
+
+  /*! \return true iff file \c k was loaded (false if it could not be, see \c cerr ). */
+  bool is_loaded ( unsigned int k ) const {
+    assert ( k < entries . size () ) ;
+    return NULL != entries [ k ] . xml ;
+  } ;
+
+  /*! The document of file \c k (NULL if not loaded), still owned by the batch. */
+  Xml const * get_xml ( unsigned int k ) const {
+    assert ( k < entries . size () ) ;
+    return entries [ k ] . xml ;
+  } ;
+
+  /*! Give the document of file \c k to the caller (NULL if not loaded). */
+  Xml * release ( unsigned int k ) {
+    assert ( k < entries . size () ) ;
+    Xml * const xml = entries [ k ] . xml ;
+    entries [ k ] . xml = NULL ;
+    return xml ;
+  } ;
+
+  /*! Time of the loading of file \c k , in seconds. */
+  double get_seconds ( unsigned int k ) const {
+    assert ( k < entries . size () ) ;
+    return entries [ k ] . seconds ;
+  } ;
+
+  /*! The documents not released are deleted. */
+  ~ Xml_Batch () ;
+} ;
+
+
+# endif
@@ -0,0 +1,336 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <assert.h>
+
+# undef NDEBUG
+
+# include "arbre_entier.h"
+
+
+/* Indice qui ne désigne aucun noeud. */
+# define AUCUN -1
+
+/* Nombre de noeuds alloués à la création, il double quand le tableau est plein. */
+# define NOEUDS_INITIAL 16
+
+
+typedef struct {
+	int cle;
+	int f_g;
+	int f_d; /* chaîne aussi les noeuds libres */
+	int hauteur; /* du sous-arbre (1 pour une feuille), tenue à jour si l'arbre est équilibré */
+} noeud;
+
+
+struct arbre_entier_struct {
+	noeud * noeuds;
+	int capacite;
+	int utilises; /* les cases [0,utilises[ ont déjà servi */
+	int libres; /* noeuds supprimés, chaînés par f_d */
+	int racine;
+	int taille;
+	bool equilibre;
+} ;
+
+
+/* Assure qu'un noeud est disponible : le tableau n'est déplacé qu'ici, avant de descendre dans l'arbre
+ (les pointeurs sur les noeuds restent donc valides pendant une insertion). */
+static void noeud_reserver ( arbre_entier a ) {
+	if(AUCUN==a->libres && a->utilises==a->capacite){
+		a->capacite*=2;
+		a->noeuds=realloc(a->noeuds,a->capacite*sizeof(noeud));
+		assert(NULL!=a->noeuds);
+	}
+}
+
+/* \pre noeud_reserver a été appelée depuis la dernière création */
+static int noeud_creer ( arbre_entier a ,int cle ) {
+	int n;
+	if(AUCUN!=a->libres){
+		n=a->libres;
+		a->libres=a->noeuds[n].f_d;
+	}
+	else{
+		assert(a->utilises<a->capacite);
+		n=a->utilises++;
+	}
+	a->noeuds[n].cle=cle;
+	a->noeuds[n].f_g=AUCUN;
+	a->noeuds[n].f_d=AUCUN;
+	a->noeuds[n].hauteur=1;
+	a->taille++;
+	return n;
+}
+
+static void noeud_liberer ( arbre_entier a ,int n ) {
+	a->noeuds[n].f_d=a->libres;
+	a->libres=n;
+	a->taille--;
+}
+
+
+/*
+ * Arbre équilibré (AVL) : les mêmes rotations que dans arbres.c, sur des indices.
+ */
+static int noeud_hauteur ( arbre_entier a ,int n ) {
+	return AUCUN==n ? 0 : a->noeuds[n].hauteur;
+}
+
+static void noeud_mettre_a_jour ( arbre_entier a ,int n ) {
+	int g=noeud_hauteur(a,a->noeuds[n].f_g);
+	int d=noeud_hauteur(a,a->noeuds[n].f_d);
+	a->noeuds[n].hauteur=1+(g>d ? g : d);
+}
+
+static int noeud_rotation_droite ( arbre_entier a ,int n ) {
+	int g=a->noeuds[n].f_g;
+	a->noeuds[n].f_g=a->noeuds[g].f_d;
+	a->noeuds[g].f_d=n;
+	noeud_mettre_a_jour(a,n);
+	noeud_mettre_a_jour(a,g);
+	return g;
+}
+
+static int noeud_rotation_gauche ( arbre_entier a ,int n ) {
+	int d=a->noeuds[n].f_d;
+	a->noeuds[n].f_d=a->noeuds[d].f_g;
+	a->noeuds[d].f_g=n;
+	noeud_mettre_a_jour(a,n);
+	noeud_mettre_a_jour(a,d);
+	return d;
+}
+
+static int noeud_equilibrer ( arbre_entier a ,int n ) {
+	noeud_mettre_a_jour(a,n);
+	noeud* x=&(a->noeuds[n]);
+	int ecart=noeud_hauteur(a,x->f_g)-noeud_hauteur(a,x->f_d);
+	if(ecart>1){
+		if(noeud_hauteur(a,a->noeuds[x->f_g].f_g)<noeud_hauteur(a,a->noeuds[x->f_g].f_d)) x->f_g=noeud_rotation_gauche(a,x->f_g);
+		return noeud_rotation_droite(a,n);
+	}
+	if(ecart<-1){
+		if(noeud_hauteur(a,a->noeuds[x->f_d].f_d)<noeud_hauteur(a,a->noeuds[x->f_d].f_g)) x->f_d=noeud_rotation_droite(a,x->f_d);
+		return noeud_rotation_gauche(a,n);
+	}
+	return n;
+}
+
+static int noeud_inserer_equilibre ( arbre_entier a ,int n ,int cle ) {
+	if(AUCUN==n) return noeud_creer(a,cle);
+	noeud* x=&(a->noeuds[n]);
+	if(cle<x->cle) x->f_g=noeud_inserer_equilibre(a,x->f_g,cle);
+	else if(cle>x->cle) x->f_d=noeud_inserer_equilibre(a,x->f_d,cle);
+	else return n;
+	return noeud_equilibrer(a,n);
+}
+
+static int noeud_extraire_minimum ( arbre_entier a ,int n ,int * min ) {
+	if(AUCUN==a->noeuds[n].f_g){
+		*min=n;
+		return a->noeuds[n].f_d;
+	}
+	a->noeuds[n].f_g=noeud_extraire_minimum(a,a->noeuds[n].f_g,min);
+	return noeud_equilibrer(a,n);
+}
+
+static int noeud_supprimer_equilibre ( arbre_entier a ,int n ,int cle ) {
+	if(AUCUN==n) return AUCUN;
+	noeud* x=&(a->noeuds[n]);
+	if(cle<x->cle) x->f_g=noeud_supprimer_equilibre(a,x->f_g,cle);
+	else if(cle>x->cle) x->f_d=noeud_supprimer_equilibre(a,x->f_d,cle);
+	else{
+		int r;
+		if(AUCUN==x->f_g) r=x->f_d;
+		else if(AUCUN==x->f_d) r=x->f_g;
+		else{
+			x->f_d=noeud_extraire_minimum(a,x->f_d,&r);
+			a->noeuds[r].f_g=x->f_g;
+			a->noeuds[r].f_d=x->f_d;
+		}
+		noeud_liberer(a,n);
+		if(AUCUN==r) return AUCUN;
+		n=r;
+	}
+	return noeud_equilibrer(a,n);
+}
+
+
+/* Place où est, ou serait, la clé : l'indice de la racine ou un champ f_g / f_d. */
+static int* arbre_chercher_position ( arbre_entier a ,int cle ) {
+	int* n=&(a->racine);
+	while(AUCUN!=*n){
+		noeud* x=&(a->noeuds[*n]);
+		if(cle<x->cle) n=&(x->f_g);
+		else if(cle>x->cle) n=&(x->f_d);
+		else return n;
+	}
+	return n;
+}
+
+
+/*
+ * Pile d'indices pour les parcours sans récursion.
+ */
+typedef struct {
+	int * elements;
+	int nombre;
+	int capacite;
+} pile;
+
+static void pile_initialiser ( pile * p ) {
+	p->elements=NULL;
+	p->nombre=0;
+	p->capacite=0;
+}
+
+static void pile_empiler ( pile * p ,int n ) {
+	if(p->nombre==p->capacite){
+		p->capacite= 0==p->capacite ? 32 : 2*p->capacite;
+		p->elements=realloc(p->elements,p->capacite*sizeof(int));
+		assert(NULL!=p->elements);
+	}
+	p->elements[p->nombre++]=n;
+}
+
+static void pile_empiler_gauche ( arbre_entier a ,pile * p ,int n ) {
+	while(AUCUN!=n){
+		pile_empiler(p,n);
+		n=a->noeuds[n].f_g;
+	}
+}
+
+
+arbre_entier arbre_entier_creer ( bool equilibre ) {
+	arbre_entier a=malloc(sizeof(struct arbre_entier_struct));
+	assert(NULL!=a);
+	a->capacite=NOEUDS_INITIAL;
+	a->noeuds=malloc(a->capacite*sizeof(noeud));
+	assert(NULL!=a->noeuds);
+	a->utilises=0;
+	a->libres=AUCUN;
+	a->racine=AUCUN;
+	a->taille=0;
+	a->equilibre=equilibre;
+	return a;
+}
+
+void arbre_entier_detruire ( arbre_entier * a ) {
+	free((*a)->noeuds);
+	free(*a);
+	*a=NULL;
+}
+
+bool arbre_entier_est_vide ( arbre_entier a ) {
+	return 0==a->taille;
+}
+
+bool arbre_entier_insertion ( arbre_entier a ,int cle ) {
+	const int taille=a->taille;
+	noeud_reserver(a);
+	if(a->equilibre) a->racine=noeud_inserer_equilibre(a,a->racine,cle);
+	else{
+		int* n=arbre_chercher_position(a,cle);
+		if(AUCUN==*n) *n=noeud_creer(a,cle);
+	}
+	return a->taille!=taille;
+}
+
+bool arbre_entier_rechercher ( arbre_entier a ,int cle ) {
+	return AUCUN!=*arbre_chercher_position(a,cle);
+}
+
+bool arbre_entier_supprimer ( arbre_entier a ,int cle ) {
+	const int taille=a->taille;
+	if(a->equilibre){
+		a->racine=noeud_supprimer_equilibre(a,a->racine,cle);
+		return a->taille!=taille;
+	}
+	int* p=arbre_chercher_position(a,cle);
+	if(AUCUN==*p) return false;
+	/* comme noeud_detruire_simple : le minimum du sous-arbre droit prend la place */
+	const int n=*p;
+	noeud* x=&(a->noeuds[n]);
+	if(AUCUN==x->f_g) *p=x->f_d;
+	else if(AUCUN==x->f_d) *p=x->f_g;
+	else{
+		int* m=&(x->f_d);
+		while(AUCUN!=a->noeuds[*m].f_g) m=&(a->noeuds[*m].f_g);
+		const int min=*m;
+		*m=a->noeuds[min].f_d;
+		a->noeuds[min].f_g=x->f_g;
+		a->noeuds[min].f_d=x->f_d;
+		*p=min;
+	}
+	noeud_liberer(a,n);
+	return true;
+}
+
+int arbre_entier_taille ( arbre_entier a ) {
+	return a->taille;
+}
+
+int arbre_entier_hauteur ( arbre_entier a ) {
+	if(a->equilibre) return noeud_hauteur(a,a->racine);
+	if(AUCUN==a->racine) return 0;
+	/* chaque noeud empilé avec sa profondeur, dans deux cases consécutives */
+	int hauteur=0;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler(&p,a->racine);
+	pile_empiler(&p,1);
+	while(p.nombre>0){
+		const int profondeur=p.elements[--p.nombre];
+		const int n=p.elements[--p.nombre];
+		if(profondeur>hauteur) hauteur=profondeur;
+		if(AUCUN!=a->noeuds[n].f_d){
+			pile_empiler(&p,a->noeuds[n].f_d);
+			pile_empiler(&p,profondeur+1);
+		}
+		if(AUCUN!=a->noeuds[n].f_g){
+			pile_empiler(&p,a->noeuds[n].f_g);
+			pile_empiler(&p,profondeur+1);
+		}
+	}
+	free(p.elements);
+	return hauteur;
+}
+
+int arbre_entier_vers_tableau ( arbre_entier a ,int * cles ) {
+	int nombre=0;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler_gauche(a,&p,a->racine);
+	while(p.nombre>0){
+		const int n=p.elements[--p.nombre];
+		cles[nombre++]=a->noeuds[n].cle;
+		pile_empiler_gauche(a,&p,a->noeuds[n].f_d);
+	}
+	free(p.elements);
+	return nombre;
+}
+
+void arbre_entier_afficher_infixe ( arbre_entier a ,FILE * f ) {
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler_gauche(a,&p,a->racine);
+	while(p.nombre>0){
+		const int n=p.elements[--p.nombre];
+		fprintf(f,"%d ",a->noeuds[n].cle);
+		pile_empiler_gauche(a,&p,a->noeuds[n].f_d);
+	}
+	free(p.elements);
+}
+
+void arbre_entier_afficher_prefixe ( arbre_entier a ,FILE * f ) {
+	if(AUCUN==a->racine) return;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler(&p,a->racine);
+	while(p.nombre>0){
+		const int n=p.elements[--p.nombre];
+		fprintf(f,"%d ",a->noeuds[n].cle);
+		if(AUCUN!=a->noeuds[n].f_d) pile_empiler(&p,a->noeuds[n].f_d);
+		if(AUCUN!=a->noeuds[n].f_g) pile_empiler(&p,a->noeuds[n].f_g);
+	}
+	free(p.elements);
+}
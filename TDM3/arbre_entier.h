@@ -0,0 +1,102 @@
+# ifndef __ARBRE_ENTIER_H
+# define __ARBRE_ENTIER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+
+/*!
+ * \file
+ * \brief Ce module est un arbre binaire de recherche spécialisé pour des clés entières (int).
+ *
+ * Il fait la même chose que arbre (arbres.h) rempli de int, sans fonction de rappel :
+ * \li les clés sont rangées dans les noeuds et comparées directement, sans appel indirect ;
+ * \li les noeuds sont les cases d'un seul tableau (qui double quand il est plein), reliés par leurs indices,
+ * il n'y a donc pas de malloc par clé et des noeuds voisins en mémoire.
+ *
+ * L'arbre peut être équilibré (AVL, comme arbre_creer_equilibre) ou non (comme arbre_creer) ;
+ * pour les mêmes insertions et suppressions, il a alors la même forme que arbre.
+ * Les parcours se font sans récursion.
+ *
+ * \copyright PASD
+ * \version 2016
+ */
+
+
+/*! La structure est manipulée par pointeur/référence.
+ */
+typedef struct arbre_entier_struct * arbre_entier;
+
+
+/*!
+ * Cette fonction retourne un arbre vide.
+ * \param equilibre vrai pour un arbre équilibré (AVL)
+ * \return un arbre vide prêt à recevoir des clés.
+ */
+arbre_entier arbre_entier_creer ( bool equilibre ) ;
+
+/*!
+ * Cette fonction détruit entièrement un arbre (une seule libération pour tous les noeuds).
+ * Le pointeur indiqué est mis à NULL.
+ */
+void arbre_entier_detruire ( arbre_entier * a ) ;
+
+/*!
+ * \return vrai ssi l'arbre ne contient aucune clé.
+ */
+bool arbre_entier_est_vide ( arbre_entier a ) ;
+
+/*!
+ * Cette fonction insère une clé, si elle n'est pas déjà dans l'arbre.
+ * \return vrai ssi la clé a été insérée.
+ */
+bool arbre_entier_insertion ( arbre_entier a ,
+			      int cle ) ;
+
+/*!
+ * \return vrai ssi la clé est dans l'arbre.
+ */
+bool arbre_entier_rechercher ( arbre_entier a ,
+			       int cle ) ;
+
+/*!
+ * Cette fonction supprime une clé, si elle est dans l'arbre.
+ * \return vrai ssi la clé a été supprimée.
+ */
+bool arbre_entier_supprimer ( arbre_entier a ,
+			      int cle ) ;
+
+/*!
+ * \return le nombre de clés (tenu à jour, en temps constant).
+ */
+int arbre_entier_taille ( arbre_entier a ) ;
+
+/*!
+ * \return le nombre de noeuds de la plus longue branche (0 pour l'arbre vide).
+ */
+int arbre_entier_hauteur ( arbre_entier a ) ;
+
+/*!
+ * Cette fonction range les clés dans l'ordre croissant dans un tableau.
+ * \pre cles a au moins arbre_entier_taille ( a ) cases
+ * \return le nombre de clés rangées.
+ */
+int arbre_entier_vers_tableau ( arbre_entier a ,
+				int * cles ) ;
+
+/*!
+ * Cette fonction affiche les clés sur une ligne selon un parcours infixe
+ * (chacune suivie d'une espace).
+ */
+void arbre_entier_afficher_infixe ( arbre_entier a ,
+				    FILE * f ) ;
+
+/*!
+ * Cette fonction affiche les clés sur une ligne selon un parcours préfixe.
+ */
+void arbre_entier_afficher_prefixe ( arbre_entier a ,
+				     FILE * f ) ;
+
+
+
+#endif
@@ -15,103 +15,363 @@ struct noeud_struct {
 	void * val;
 	noeud f_d;
 	noeud f_g; 
+	int hauteur; /* du sous-arbre (1 pour une feuille), tenue à jour si l'arbre est équilibré */
 } ; 
 
 
+/* Les valeurs en place sont après le noeud, à une adresse alignée pour tout type usuel. */
+# define ALIGNEMENT 16
+# define ARRONDI(t) ( ( (t)+ALIGNEMENT-1 ) / ALIGNEMENT * ALIGNEMENT )
+# define TAILLE_NOEUD ARRONDI(sizeof(struct noeud_struct))
+
+/* Nombre de noeuds du premier bloc de la réserve, il double d'un bloc au suivant jusqu'au maximum. */
+# define NOEUDS_PREMIER_BLOC 16
+# define NOEUDS_BLOC_MAX 4096
+
+
 struct arbre_struct {
 	noeud racine;
 	void ( * copier ) ( void * val ,void * * pt );
 	void ( * detruire ) ( void * * pt );
 	int ( *comparer) (void* val1, void* val2);
+	bool equilibre; /* AVL : les hauteurs des deux fils d'un noeud diffèrent d'au plus 1 */
+	size_t taille_en_place; /* si non nulle, les valeurs sont copiées dans le noeud (ni copier ni detruire) */
+	bool reserve; /* les noeuds sont pris dans des blocs de l'arbre plutôt qu'un par un avec malloc */
+	size_t taille_case; /* d'un noeud, valeur en place comprise */
+	void * blocs; /* chaque bloc commence par l'adresse du précédent */
+	char * case_suivante; /* première case jamais utilisée du dernier bloc */
+	char * fin_bloc;
+	size_t noeuds_par_bloc; /* du prochain bloc */
+	noeud libres; /* noeuds libérés, chaînés par f_d */
 } ; 
 
 
-static noeud noeud_creer ( void * val ,void ( * copier ) ( void * val ,void * * pt ) ) {  
-	noeud n=malloc(sizeof(struct noeud_struct));
-	copier(val,&(n->val));
+static noeud reserve_prendre ( arbre a ) {
+	if(NULL!=a->libres){
+		noeud n=a->libres;
+		a->libres=n->f_d;
+		return n;
+	}
+	if(a->case_suivante==a->fin_bloc){
+		char* bloc=malloc(ARRONDI(sizeof(void*))+a->noeuds_par_bloc*a->taille_case);
+		assert(NULL!=bloc);
+		*(void**)bloc=a->blocs;
+		a->blocs=bloc;
+		a->case_suivante=bloc+ARRONDI(sizeof(void*));
+		a->fin_bloc=a->case_suivante+a->noeuds_par_bloc*a->taille_case;
+		if(a->noeuds_par_bloc<NOEUDS_BLOC_MAX) a->noeuds_par_bloc*=2;
+	}
+	noeud n=(noeud)a->case_suivante;
+	a->case_suivante+=a->taille_case;
+	return n;
+}
+
+static void reserve_liberer ( arbre a ) {
+	while(NULL!=a->blocs){
+		void* precedent=*(void**)a->blocs;
+		free(a->blocs);
+		a->blocs=precedent;
+	}
+	a->case_suivante=NULL;
+	a->fin_bloc=NULL;
+	a->libres=NULL;
+}
+
+
+static noeud noeud_creer ( arbre a ,void * val ) {  
+	noeud n= a->reserve ? reserve_prendre(a) : malloc(a->taille_case);
+	assert(NULL!=n);
+	if(0!=a->taille_en_place){
+		n->val=(char*)n+TAILLE_NOEUD;
+		memcpy(n->val,val,a->taille_en_place);
+	}
+	else a->copier(val,&(n->val));
 	n->f_d=NULL;
 	n->f_g=NULL;
+	n->hauteur=1;
   	return n ;
 }
 
+/* Détruit la valeur et rend le noeud. */
+static void noeud_liberer ( arbre a ,noeud n ) {
+	if(0==a->taille_en_place) a->detruire(&(n->val));
+	if(a->reserve){
+		n->f_d=a->libres;
+		a->libres=n;
+	}
+	else free(n);
+}
+
 
-/* Détruit un noeud et tous les noeuds se trouvant en dessous. */
-static void noeud_detruire_recursivement ( noeud * n_pt ,void ( * detruire ) ( void * * pt ) ) {
-	if(NULL!=n_pt){
-		if(NULL!=(*n_pt)->f_d) noeud_detruire_recursivement(&((*n_pt)->f_d),detruire);
-		if(NULL!=(*n_pt)->f_g) noeud_detruire_recursivement(&((*n_pt)->f_g),detruire);
-		detruire(&((*n_pt)->val));
-		free(*n_pt);
-		*n_pt=NULL;
+/* Détruit un noeud et tous les noeuds se trouvant en dessous, sans récursion ni pile :
+ tant que le noeud courant a un fils gauche on fait une rotation à droite,
+ sinon il est détruit et on passe à son fils droit. */
+static void noeud_detruire_recursivement ( arbre a ,noeud * n_pt ) {
+	noeud n=*n_pt;
+	while(NULL!=n){
+		if(NULL!=n->f_g){
+			noeud g=n->f_g;
+			n->f_g=g->f_d;
+			g->f_d=n;
+			n=g;
+		}
+		else{
+			noeud d=n->f_d;
+			noeud_liberer(a,n);
+			n=d;
+		}
+	}
+	*n_pt=NULL;
+}
+
+/* Détruit le noeud *n_pt sans détruire les noeuds se trouvant en dessous.
+ Le minimum du sous-arbre droit prend sa place, pour garder l'ordre de l'arbre de recherche. */
+static void noeud_detruire_simple ( arbre a ,noeud * const n_pt ) {
+	noeud n=*n_pt;
+	if(NULL==n->f_g) *n_pt=n->f_d;
+	else if(NULL==n->f_d) *n_pt=n->f_g;
+	else{
+		noeud* m=&(n->f_d);
+		while(NULL!=(*m)->f_g) m=&((*m)->f_g);
+		noeud min=*m;
+		*m=min->f_d;
+		min->f_g=n->f_g;
+		min->f_d=n->f_d;
+		*n_pt=min;
 	}
+	noeud_liberer(a,n);
 }
 
-/* Détruit un noeud sans détruire les noeuds se trouvant en dessous.
- Il faut donc assurer la correcte structure de l'arbre de recherche après suppression.*/
 
-static void noeud_detruire_simple ( noeud * const n_pt ,void ( * detruire ) ( void * * pt ) ) {
-	if(NULL!=((*n_pt)->f_d)){
-		void * echange=(*n_pt)->val;
-		((*n_pt)->val)=((*n_pt)->f_d->val);
-		(*n_pt)->f_d->val=echange;
-		noeud_detruire_simple(&((*n_pt)->f_d),detruire);
+/*
+ * Arbre équilibré (AVL) : après une insertion ou une suppression dans un sous-arbre,
+ * chaque noeud du chemin est rééquilibré par une ou deux rotations.
+ */
+static int noeud_hauteur ( noeud n ) {
+	return NULL==n ? 0 : n->hauteur;
+}
+
+static void noeud_mettre_a_jour ( noeud n ) {
+	int g=noeud_hauteur(n->f_g);
+	int d=noeud_hauteur(n->f_d);
+	n->hauteur=1+(g>d ? g : d);
+}
+
+static noeud noeud_rotation_droite ( noeud n ) {
+	noeud g=n->f_g;
+	n->f_g=g->f_d;
+	g->f_d=n;
+	noeud_mettre_a_jour(n);
+	noeud_mettre_a_jour(g);
+	return g;
+}
 
+static noeud noeud_rotation_gauche ( noeud n ) {
+	noeud d=n->f_d;
+	n->f_d=d->f_g;
+	d->f_g=n;
+	noeud_mettre_a_jour(n);
+	noeud_mettre_a_jour(d);
+	return d;
+}
+
+/* Les deux fils sont équilibrés et leurs hauteurs diffèrent d'au plus 2 ; retourne la nouvelle racine. */
+static noeud noeud_equilibrer ( noeud n ) {
+	noeud_mettre_a_jour(n);
+	int ecart=noeud_hauteur(n->f_g)-noeud_hauteur(n->f_d);
+	if(ecart>1){
+		if(noeud_hauteur(n->f_g->f_g)<noeud_hauteur(n->f_g->f_d)) n->f_g=noeud_rotation_gauche(n->f_g);
+		return noeud_rotation_droite(n);
 	}
-	else if(NULL!=((*n_pt)->f_g)){
-		noeud n=*n_pt;
-		*n_pt=((*n_pt)->f_g);
-		detruire(&(n->val));
-		free(n);
-		n=NULL;
-		
-		
+	if(ecart<-1){
+		if(noeud_hauteur(n->f_d->f_d)<noeud_hauteur(n->f_d->f_g)) n->f_d=noeud_rotation_droite(n->f_d);
+		return noeud_rotation_gauche(n);
+	}
+	return n;
+}
+
+static noeud noeud_inserer_equilibre ( arbre a ,noeud n ,void * val ) {
+	if(NULL==n) return noeud_creer(a,val);
+	int comp=a->comparer(val,n->val);
+	if(comp<=-1) n->f_g=noeud_inserer_equilibre(a,n->f_g,val);
+	else if(comp>=1) n->f_d=noeud_inserer_equilibre(a,n->f_d,val);
+	else return n;
+	return noeud_equilibrer(n);
+}
+
+/* Retire le minimum du sous-arbre n (sans le détruire) et le place dans *min. */
+static noeud noeud_extraire_minimum ( noeud n ,noeud * min ) {
+	if(NULL==n->f_g){
+		*min=n;
+		return n->f_d;
 	}
+	n->f_g=noeud_extraire_minimum(n->f_g,min);
+	return noeud_equilibrer(n);
+}
+
+static noeud noeud_supprimer_equilibre ( arbre a ,noeud n ,void * val ) {
+	if(NULL==n) return NULL;
+	int comp=a->comparer(val,n->val);
+	if(comp<=-1) n->f_g=noeud_supprimer_equilibre(a,n->f_g,val);
+	else if(comp>=1) n->f_d=noeud_supprimer_equilibre(a,n->f_d,val);
 	else{
-		detruire(&((*n_pt)->val));
-		free(*n_pt);
-		*n_pt=NULL;
+		noeud r;
+		if(NULL==n->f_g) r=n->f_d;
+		else if(NULL==n->f_d) r=n->f_g;
+		else{
+			n->f_d=noeud_extraire_minimum(n->f_d,&r);
+			r->f_g=n->f_g;
+			r->f_d=n->f_d;
+		}
+		noeud_liberer(a,n);
+		if(NULL==r) return NULL;
+		n=r;
 	}
+	return noeud_equilibrer(n);
 }
 
-static void noeud_afficher_prefixe ( noeud n ,FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
-	if(n!=NULL){
-		afficher(n->val,f);
-		if(n->f_g!=NULL) noeud_afficher_prefixe(n->f_g,f,afficher);
-		if(n->f_d!=NULL) noeud_afficher_prefixe(n->f_d,f,afficher);
+
+/*
+ * Pile de noeuds pour les parcours sans récursion :
+ * elle grandit selon le besoin, un arbre dégénéré ne fait donc pas déborder la pile d'appel.
+ */
+typedef struct {
+	noeud n;
+	int profondeur;
+} element_pile;
+
+typedef struct {
+	element_pile * elements;
+	int nombre;
+	int capacite;
+} pile;
+
+static void pile_initialiser ( pile * p ) {
+	p->elements=NULL;
+	p->nombre=0;
+	p->capacite=0;
+}
+
+static void pile_liberer ( pile * p ) {
+	free(p->elements);
+	pile_initialiser(p);
+}
+
+static bool pile_est_vide ( pile * p ) {
+	return 0==p->nombre;
+}
+
+static void pile_empiler ( pile * p ,noeud n ,int profondeur ) {
+	if(p->nombre==p->capacite){
+		p->capacite= 0==p->capacite ? 32 : 2*p->capacite;
+		p->elements=realloc(p->elements,p->capacite*sizeof(element_pile));
+		assert(NULL!=p->elements);
 	}
+	p->elements[p->nombre].n=n;
+	p->elements[p->nombre].profondeur=profondeur;
+	p->nombre++;
 }
 
+static element_pile pile_depiler ( pile * p ) {
+	assert(!pile_est_vide(p));
+	p->nombre--;
+	return p->elements[p->nombre];
+}
 
+static noeud pile_sommet ( pile * p ) {
+	assert(!pile_est_vide(p));
+	return p->elements[p->nombre-1].n;
+}
 
-static void noeud_afficher_infixe ( noeud n ,FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
-	if(n!=NULL){
-		if(n->f_g!=NULL){
-			noeud_afficher_infixe(n->f_g,f,afficher);
-		}
+/* Empile n puis ses descendants gauches : le dernier empilé est le minimum du sous-arbre n. */
+static void pile_empiler_gauche ( pile * p ,noeud n ) {
+	while(NULL!=n){
+		pile_empiler(p,n,0);
+		n=n->f_g;
+	}
+}
 
+
+static void noeud_afficher_prefixe ( noeud n ,FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
+	if(NULL==n) return;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler(&p,n,0);
+	while(!pile_est_vide(&p)){
+		n=pile_depiler(&p).n;
 		afficher(n->val,f);
+		if(n->f_d!=NULL) pile_empiler(&p,n->f_d,0);
+		if(n->f_g!=NULL) pile_empiler(&p,n->f_g,0);
+	}
+	pile_liberer(&p);
+}
+
 
-		if(n->f_d!=NULL){
-			 noeud_afficher_infixe(n->f_d,f,afficher);
-		}
 
+static void noeud_afficher_infixe ( noeud n ,FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler_gauche(&p,n);
+	while(!pile_est_vide(&p)){
+		n=pile_depiler(&p).n;
+		afficher(n->val,f);
+		pile_empiler_gauche(&p,n->f_d);
 	}
-	
+	pile_liberer(&p);
 }
 
 
+/* Un noeud est affiché quand on remonte de son fils droit (ou qu'il n'en a pas). */
 static void noeud_afficher_postfixe ( noeud n , FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
-	if(n!=NULL){
-		if(n->f_g!=NULL) noeud_afficher_prefixe(n->f_g,f,afficher);
-		if(n->f_d!=NULL) noeud_afficher_prefixe(n->f_d,f,afficher);
-		afficher(n->val,f);
+	pile p;
+	pile_initialiser(&p);
+	noeud dernier=NULL;
+	pile_empiler_gauche(&p,n);
+	while(!pile_est_vide(&p)){
+		n=pile_sommet(&p);
+		if(NULL!=n->f_d && dernier!=n->f_d){
+			pile_empiler_gauche(&p,n->f_d);
+		}
+		else{
+			afficher(n->val,f);
+			dernier=pile_depiler(&p).n;
+		}
 	}
+	pile_liberer(&p);
 }
 
 
 int noeud_taille ( noeud n ) {
 	if(n==NULL) return 0;
-	else return 1+(noeud_taille(n->f_g))+noeud_taille(n->f_d);
+	int taille=0;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler(&p,n,0);
+	while(!pile_est_vide(&p)){
+		n=pile_depiler(&p).n;
+		taille++;
+		if(n->f_d!=NULL) pile_empiler(&p,n->f_d,0);
+		if(n->f_g!=NULL) pile_empiler(&p,n->f_g,0);
+	}
+	pile_liberer(&p);
+	return taille;
+}
+
+
+static int noeud_calculer_hauteur ( noeud n ) {
+	if(n==NULL) return 0;
+	int hauteur=0;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler(&p,n,1);
+	while(!pile_est_vide(&p)){
+		element_pile e=pile_depiler(&p);
+		if(e.profondeur>hauteur) hauteur=e.profondeur;
+		if(e.n->f_d!=NULL) pile_empiler(&p,e.n->f_d,e.profondeur+1);
+		if(e.n->f_g!=NULL) pile_empiler(&p,e.n->f_g,e.profondeur+1);
+	}
+	pile_liberer(&p);
+	return hauteur;
 }
 
 
@@ -121,11 +381,62 @@ arbre arbre_creer ( void ( * copier ) ( void * val ,void * * pt ) , void ( * det
 	a->copier=copier;
 	a->detruire=detruire;
 	a->comparer=comparer;
+	a->equilibre=false;
+	a->taille_en_place=0;
+	a->reserve=false;
+	a->taille_case=sizeof(struct noeud_struct);
+	a->blocs=NULL;
+	a->case_suivante=NULL;
+	a->fin_bloc=NULL;
+	a->noeuds_par_bloc=NOEUDS_PREMIER_BLOC;
+	a->libres=NULL;
+	return a ;
+}
+
+arbre arbre_creer_equilibre ( void ( * copier ) ( void * val ,void * * pt ) , void ( * detruire ) ( void * * pt ) ,int ( * comparer ) ( void * val1 , void* val2 ) ) {
+	arbre a=arbre_creer(copier,detruire,comparer);
+	a->equilibre=true;
+	return a ;
+}
+
+arbre arbre_creer_reserve ( void ( * copier ) ( void * val ,void * * pt ) , void ( * detruire ) ( void * * pt ) ,int ( * comparer ) ( void * val1 , void* val2 ) ,size_t taille_en_place ,bool equilibre ) {
+	arbre a=arbre_creer(copier,detruire,comparer);
+	a->equilibre=equilibre;
+	a->reserve=true;
+	a->taille_en_place=taille_en_place;
+	if(0!=taille_en_place) a->taille_case=TAILLE_NOEUD+ARRONDI(taille_en_place);
+	else a->taille_case=TAILLE_NOEUD;
+	return a ;
+}
+
+/* Construit le sous-arbre des valeurs [debut,fin[ (triées) : la valeur du milieu à la racine,
+ les deux moitiés en dessous, dont les tailles et donc les hauteurs diffèrent d'au plus 1. */
+static noeud noeud_construire ( arbre a ,void * * valeurs ,int debut ,int fin ) {
+	if(debut>=fin) return NULL;
+	int milieu=debut+(fin-debut)/2;
+	noeud n=noeud_creer(a,valeurs[milieu]);
+	n->f_g=noeud_construire(a,valeurs,debut,milieu);
+	n->f_d=noeud_construire(a,valeurs,milieu+1,fin);
+	noeud_mettre_a_jour(n);
+	return n;
+}
+
+void arbre_charger_tableau ( arbre a ,void * * valeurs ,int nombre ) {
+	assert(NULL==a->racine);
+	for(int i=1;i<nombre;i++) assert(a->comparer(valeurs[i-1],valeurs[i])<=-1);
+	a->racine=noeud_construire(a,valeurs,0,nombre);
+}
+
+arbre arbre_creer_depuis_tableau ( void ( * copier ) ( void * val ,void * * pt ) , void ( * detruire ) ( void * * pt ) ,int ( * comparer ) ( void * val1 , void* val2 ) ,void * * valeurs ,int nombre ) {
+	arbre a=arbre_creer_equilibre(copier,detruire,comparer);
+	arbre_charger_tableau(a,valeurs,nombre);
 	return a ;
 }
 
 void arbre_detruire ( arbre * a ) {
-	noeud_detruire_recursivement(&((*a)->racine),(*a)->detruire);
+	/* des valeurs en place dans la réserve : libérer les blocs suffit */
+	if(!((*a)->reserve && 0!=(*a)->taille_en_place)) noeud_detruire_recursivement(*a,&((*a)->racine));
+	reserve_liberer(*a);
 	free(*a);
 	*a=NULL;
 }
@@ -149,30 +460,12 @@ static noeud* arbre_chercher_position(arbre a, void* val){
 }
 
 void arbre_insertion ( arbre a ,void * val ) {
-	if(a->racine==NULL) a->racine=noeud_creer(val,a->copier);
-	else{
-		int comp=(a->comparer)(a->racine->val,val);
-		noeud racine=a->racine;
-		if(comp>=1){
-			if(a->racine->f_g==NULL){
-				(a->racine)->f_g=noeud_creer(val,a->copier);
-			}
-			else{
-				a->racine=a->racine->f_g;
-				arbre_insertion(a,val);
-			}
-		}
-		if(comp<=-1){
-			 if(a->racine->f_d==NULL){
-				(a->racine)->f_d=noeud_creer(val,a->copier);;
-			}
-			else{
-				a->racine=a->racine->f_d;
-				arbre_insertion(a,val);
-			}
-		}
-		a->racine=racine;
+	if(a->equilibre){
+		a->racine=noeud_inserer_equilibre(a,a->racine,val);
+		return;
 	}
+	noeud* n=arbre_chercher_position(a,val);
+	if(NULL==*n) *n=noeud_creer(a,val);
 }
 
 void arbre_afficher_prefixe ( arbre a ,FILE * f ,void ( * afficher ) ( void * val ,FILE * f ) ) {
@@ -198,21 +491,77 @@ int arbre_taille ( arbre a ) {
 }
 
 
+int arbre_vers_tableau ( arbre a ,void * * valeurs ) {
+	int nombre=0;
+	pile p;
+	pile_initialiser(&p);
+	pile_empiler_gauche(&p,a->racine);
+	while(!pile_est_vide(&p)){
+		noeud n=pile_depiler(&p).n;
+		valeurs[nombre++]=n->val;
+		pile_empiler_gauche(&p,n->f_d);
+	}
+	pile_liberer(&p);
+	return nombre;
+}
+
+
+int arbre_hauteur ( arbre a ) {
+	if(a->equilibre) return noeud_hauteur(a->racine);
+	return noeud_calculer_hauteur(a->racine);
+}
+
+
 
 void * arbre_rechercher ( arbre a ,void * val ) {
 	noeud* racine=arbre_chercher_position(a,val);
-	if(NULL!=racine){
+	if(NULL!=*racine){
 		 return (*racine)->val;
 	}
-	return racine;
+	return NULL;
 }
 
 
 void arbre_supprimer ( arbre a ,void * val ) {
+	if(a->equilibre){
+		a->racine=noeud_supprimer_equilibre(a,a->racine,val);
+		return;
+	}
 	noeud* n=arbre_chercher_position(a,val);
 	if((*n)!=NULL){
-		noeud_detruire_simple(n,a->detruire);
+		noeud_detruire_simple(a,n);
 	}
 }
 
 
+
+
+
+struct arbre_iterateur_struct {
+	pile p; /* le sommet est le prochain noeud, en dessous ses ancêtres pas encore parcourus */
+} ;
+
+
+arbre_iterateur arbre_iterateur_creer ( arbre a ) {
+	arbre_iterateur it=malloc(sizeof(struct arbre_iterateur_struct));
+	assert(NULL!=it);
+	pile_initialiser(&(it->p));
+	pile_empiler_gauche(&(it->p),a->racine);
+	return it;
+}
+
+bool arbre_iterateur_a_suivant ( arbre_iterateur it ) {
+	return !pile_est_vide(&(it->p));
+}
+
+void * arbre_iterateur_suivant ( arbre_iterateur it ) {
+	noeud n=pile_depiler(&(it->p)).n;
+	pile_empiler_gauche(&(it->p),n->f_d);
+	return n->val;
+}
+
+void arbre_iterateur_detruire ( arbre_iterateur * it ) {
+	pile_liberer(&((*it)->p));
+	free(*it);
+	*it=NULL;
+}
@@ -2,6 +2,7 @@
 # define __ARBRES_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 
 /*!
@@ -30,6 +31,10 @@
  */
 typedef struct arbre_struct * arbre;
 
+/*! Les itérateurs aussi.
+ */
+typedef struct arbre_iterateur_struct * arbre_iterateur;
+
 
 
 /*! 
@@ -46,6 +51,67 @@ arbre arbre_creer ( void ( * copier ) ( void * val ,
 		    int ( * comparer ) ( void * val1 ,
 					 void * val2 ) ) ;
 
+/*! 
+ * Cette fonction retourne un arbre vide qui reste équilibré (AVL) :
+ * sa hauteur reste en O(log n) même si les valeurs sont insérées dans l'ordre,
+ * et donc aussi le coût de l'insertion, de la recherche et de la suppression.
+ * Les paramètres sont ceux de arbre_creer, toutes les autres fonctions s'utilisent de la même façon.
+ * (L'ordre des parcours préfixe et postfixe dépend des rotations faites.)
+ */
+arbre arbre_creer_equilibre ( void ( * copier ) ( void * val ,
+						  void * * pt ) ,
+			      void ( * detruire ) ( void * * pt ) ,
+			      int ( * comparer ) ( void * val1 ,
+						   void * val2 ) ) ;
+
+/*! 
+ * Cette fonction retourne un arbre vide dont les noeuds sont pris dans une réserve :
+ * des blocs de noeuds de plus en plus grands, tous libérés à la destruction de l'arbre
+ * (un noeud supprimé est gardé pour la prochaine insertion).
+ * Construire et détruire un grand arbre se fait alors en quelques allocations au lieu d'une ou deux par valeur.
+ * \param copier comme pour arbre_creer, sauf si taille_en_place n'est pas nulle (peut alors être NULL)
+ * \param detruire comme pour arbre_creer, sauf si taille_en_place n'est pas nulle (peut alors être NULL)
+ * \param comparer comme pour arbre_creer
+ * \param taille_en_place si elle n'est pas nulle, les valeurs font toutes cette taille (en octets)
+ * et sont copiées (par memcpy) dans le noeud lui-même, sans copier ni detruire
+ * (les valeurs ne doivent donc pas contenir de pointeur vers de la mémoire à libérer).
+ * \param equilibre vrai pour un arbre équilibré (comme arbre_creer_equilibre)
+ */
+arbre arbre_creer_reserve ( void ( * copier ) ( void * val ,
+						void * * pt ) ,
+			    void ( * detruire ) ( void * * pt ) ,
+			    int ( * comparer ) ( void * val1 ,
+						 void * val2 ) ,
+			    size_t taille_en_place ,
+			    bool equilibre ) ;
+
+/*! 
+ * Cette fonction retourne un arbre équilibré (comme arbre_creer_equilibre) qui contient (une copie) des valeurs d'un tableau trié,
+ * en temps linéaire (chaque valeur est copiée une fois, sans comparaison).
+ * \param copier comme pour arbre_creer
+ * \param detruire comme pour arbre_creer
+ * \param comparer comme pour arbre_creer
+ * \param valeurs les valeurs, dans l'ordre strictement croissant selon comparer (par exemple remplies par arbre_vers_tableau)
+ * \param nombre nombre de valeurs
+ */
+arbre arbre_creer_depuis_tableau ( void ( * copier ) ( void * val ,
+						       void * * pt ) ,
+				   void ( * detruire ) ( void * * pt ) ,
+				   int ( * comparer ) ( void * val1 ,
+							void * val2 ) ,
+				   void * * valeurs ,
+				   int nombre ) ;
+
+/*!
+ * Cette fonction remplit un arbre vide, créé par n'importe laquelle des fonctions de création, comme arbre_creer_depuis_tableau.
+ * La hauteur est la plus petite possible en O(log n) (l'arbre reste équilibré s'il l'est).
+ * \pre l'arbre est vide
+ * \pre les valeurs sont dans l'ordre strictement croissant selon la comparaison de l'arbre
+ */
+void arbre_charger_tableau ( arbre a ,
+			     void * * valeurs ,
+			     int nombre ) ;
+
 /*!
  * Cette fonction détruit entièrement un arbre.
  * Le pointeur indiqué est mis à NULL.
@@ -70,6 +136,12 @@ void arbre_insertion ( arbre a ,
 		       void * val ) ;
 
 
+/*
+ * Les parcours, la taille, la hauteur et la destruction se font sans récursion
+ * (avec une pile qui grandit selon la hauteur de l'arbre),
+ * ils conviennent donc aussi pour les arbres dégénérés (valeurs insérées dans l'ordre dans un arbre simple).
+ */
+
 /*!
  * Cette fonction affiche les valeurs contenues dans un arbre sur une ligne selon un parcours postfixe.
  * \param f flux où afficher
@@ -105,12 +177,33 @@ void arbre_afficher_infixe ( arbre a ,
 
 /*!
  * Cette fonction permet de connaître le nombre de valeurs dans l'arbre.
- * (cela se fait par un calcul récursif.)
+ * (cela se fait par un parcours avec une pile, sans récursion.)
  * \return le nombre de noeuds qui compose l'arbre.
  */
 int arbre_taille ( arbre a ) ;
 
 
+/*!
+ * Cette fonction range les valeurs de l'arbre dans l'ordre (parcours infixe) dans un tableau,
+ * par exemple pour le reconstruire ensuite avec arbre_creer_depuis_tableau ou arbre_charger_tableau.
+ * Aucune copie n'est faite : les valeurs restent celles de l'arbre.
+ * \param a arbre à parcourir
+ * \param valeurs tableau rempli
+ * \pre valeurs a au moins arbre_taille ( a ) cases
+ * \return le nombre de valeurs rangées.
+ */
+int arbre_vers_tableau ( arbre a ,
+			 void * * valeurs ) ;
+
+
+/*!
+ * Cette fonction permet de connaître la hauteur de l'arbre (0 pour l'arbre vide, 1 pour une seule valeur).
+ * (elle est tenue à jour dans un arbre équilibré, calculée sinon.)
+ * \return le nombre de noeuds de la plus longue branche.
+ */
+int arbre_hauteur ( arbre a ) ;
+
+
 
 
 /*
@@ -134,4 +227,43 @@ void * arbre_rechercher ( arbre a ,
 
 
 
+
+/*!
+ * Cette fonction retourne un itérateur sur les valeurs de l'arbre dans l'ordre (parcours infixe),
+ * pour les parcourir sans fonction de rappel :
+ * \code
+ * arbre_iterateur it = arbre_iterateur_creer ( a ) ;
+ * while ( arbre_iterateur_a_suivant ( it ) ) {
+ *   void * val = arbre_iterateur_suivant ( it ) ;
+ *   ...
+ * }
+ * arbre_iterateur_detruire ( & it ) ;
+ * \endcode
+ * \pre l'arbre ne doit pas être modifié tant que l'itérateur est utilisé.
+ * \param a arbre à parcourir
+ * \return un itérateur placé avant la plus petite valeur.
+ */
+arbre_iterateur arbre_iterateur_creer ( arbre a ) ;
+
+/*!
+ * \return vrai ssi il reste des valeurs à parcourir.
+ */
+bool arbre_iterateur_a_suivant ( arbre_iterateur it ) ;
+
+/*!
+ * Cette fonction avance l'itérateur.
+ * Aucune copie n'est faite.
+ * \pre il reste des valeurs à parcourir (arbre_iterateur_a_suivant).
+ * \return la valeur suivante dans l'arbre.
+ */
+void * arbre_iterateur_suivant ( arbre_iterateur it ) ;
+
+/*!
+ * Cette fonction détruit un itérateur (pas l'arbre).
+ * Le pointeur indiqué est mis à NULL.
+ */
+void arbre_iterateur_detruire ( arbre_iterateur * it ) ;
+
+
+
 #endif
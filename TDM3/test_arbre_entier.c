@@ -0,0 +1,177 @@
+# define _POSIX_C_SOURCE 200809L /* open_memstream */
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# include <assert.h>
+
+# undef NDEBUG
+
+# include "arbres.h"
+# include "arbre_entier.h"
+
+# define LG 10
+# define LG_TRIE 1000
+# define LG_MESURE 200000
+
+
+
+void copier_int ( void * val ,
+		  void * * pt ) {
+  * pt = ( int * ) malloc ( sizeof ( int ) ) ;
+  assert ( NULL != * pt ) ;
+  memcpy ( * pt , val , sizeof ( int ) ) ;
+}
+
+
+void detruire_int ( void * * pt ) {
+  free ( * pt ) ;
+  * pt = NULL ;
+}
+
+
+int comparer_int ( void * val1 ,
+		   void * val2 ) {
+  int a = * ( int * ) val1 ;
+  int b = * ( int * ) val2 ;
+  return ( a > b ) - ( a < b ) ;
+}
+
+
+void afficher_int ( void * val ,
+		    FILE * f ) {
+  fprintf ( f , "%d " , * ( ( int * ) ( val ) ) ) ;
+}
+
+
+/* Mêmes insertions et suppressions dans un arbre et un arbre_entier : mêmes réponses et même forme. */
+static void comparer ( FILE * f_out ,
+		       bool equilibre ) {
+  arbre a = equilibre ? arbre_creer_equilibre ( copier_int , detruire_int , comparer_int )
+    : arbre_creer ( copier_int , detruire_int , comparer_int ) ;
+  arbre_entier e = arbre_entier_creer ( equilibre ) ;
+  srand ( 7845 ) ;
+  bool memes_reponses = true ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    int v = rand ( ) % LG_TRIE ;
+    bool present = NULL != arbre_rechercher ( a , &v ) ;
+    arbre_insertion ( a , &v ) ;
+    if ( arbre_entier_insertion ( e , v ) == present ) memes_reponses = false ;
+  }
+  for ( int i=0 ; i<LG_TRIE ; i+=3 ) {
+    bool present = NULL != arbre_rechercher ( a , &i ) ;
+    arbre_supprimer ( a , &i ) ;
+    if ( arbre_entier_supprimer ( e , i ) != present ) memes_reponses = false ;
+  }
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    if ( ( NULL != arbre_rechercher ( a , &i ) ) != arbre_entier_rechercher ( e , i ) ) memes_reponses = false ;
+  }
+  fprintf ( f_out , "%s : taille %d %d hauteur %d %d mêmes réponses %d \n" ,
+	    equilibre ? "équilibré" : "simple" ,
+	    arbre_taille ( a ) , arbre_entier_taille ( e ) ,
+	    arbre_hauteur ( a ) , arbre_entier_hauteur ( e ) , memes_reponses ) ;
+  /* l'ordre préfixe donne la forme de l'arbre */
+  char * prefixe_a ;
+  char * prefixe_e ;
+  size_t lg_a , lg_e ;
+  FILE * fa = open_memstream ( &prefixe_a , &lg_a ) ;
+  FILE * fe = open_memstream ( &prefixe_e , &lg_e ) ;
+  arbre_afficher_prefixe ( a , fa , afficher_int ) ;
+  arbre_entier_afficher_prefixe ( e , fe ) ;
+  fclose ( fa ) ;
+  fclose ( fe ) ;
+  fprintf ( f_out , "même forme %d \n" , lg_a == lg_e && 0 == strcmp ( prefixe_a , prefixe_e ) ) ;
+  free ( prefixe_a ) ;
+  free ( prefixe_e ) ;
+  arbre_detruire ( &a ) ;
+  arbre_entier_detruire ( &e ) ;
+}
+
+
+/* Temps des insertions puis des recherches de LG_MESURE clés, sur la sortie standard. */
+static void mesurer ( void ) {
+  int * cles = malloc ( LG_MESURE * sizeof ( int ) ) ;
+  assert ( NULL != cles ) ;
+  srand ( 1234 ) ;
+  for ( int i=0 ; i<LG_MESURE ; i++ ) cles [ i ] = rand ( ) ;
+  for ( int version=0 ; version<3 ; version++ ) {
+    clock_t t0 = clock ( ) ;
+    int trouves = 0 ;
+    if ( 0 == version ) {
+      arbre a = arbre_creer_equilibre ( copier_int , detruire_int , comparer_int ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) arbre_insertion ( a , cles+i ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) trouves += NULL != arbre_rechercher ( a , cles+i ) ;
+      arbre_detruire ( &a ) ;
+    }
+    else if ( 1 == version ) {
+      arbre a = arbre_creer_reserve ( NULL , NULL , comparer_int , sizeof ( int ) , true ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) arbre_insertion ( a , cles+i ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) trouves += NULL != arbre_rechercher ( a , cles+i ) ;
+      arbre_detruire ( &a ) ;
+    }
+    else {
+      arbre_entier e = arbre_entier_creer ( true ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) arbre_entier_insertion ( e , cles [ i ] ) ;
+      for ( int i=0 ; i<LG_MESURE ; i++ ) trouves += arbre_entier_rechercher ( e , cles [ i ] ) ;
+      arbre_entier_detruire ( &e ) ;
+    }
+    const char * noms [ 3 ] = { "arbre équilibré" , "arbre en place dans la réserve" , "arbre_entier équilibré" } ;
+    printf ( "%-32s %d clés trouvées en %.1f ms\n" , noms [ version ] , trouves ,
+	     ( clock ( ) - t0 ) * 1000.0 / CLOCKS_PER_SEC ) ;
+  }
+  free ( cles ) ;
+}
+
+
+
+int main ( void ) {
+  FILE * f_out = fopen ( "test_arbre_entier_out.txt" , "w" ) ;
+
+  /* Insertion, recherche, suppression et affichage */
+  arbre_entier e = arbre_entier_creer ( false ) ;
+  fprintf ( f_out , "vide %d \n" , arbre_entier_est_vide ( e ) ) ;
+  srand ( 7845 ) ;
+  int tab [ LG ] ;
+  for ( int i=0 ; i<LG ; i++ ) {
+    tab [ i ] = rand ( ) % 50 ;
+    fprintf ( f_out , "valeur insérée : %d %d \n" , tab [ i ] , arbre_entier_insertion ( e , tab [ i ] ) ) ;
+  }
+  fprintf ( f_out , "infixe : " ) ;
+  arbre_entier_afficher_infixe ( e , f_out ) ;
+  fprintf ( f_out , "\npréfixe : " ) ;
+  arbre_entier_afficher_prefixe ( e , f_out ) ;
+  fprintf ( f_out , "\nrecherche de %d : %d , de -1 : %d \n" , tab [ 3 ] ,
+	    arbre_entier_rechercher ( e , tab [ 3 ] ) , arbre_entier_rechercher ( e , -1 ) ) ;
+  bool supprime = arbre_entier_supprimer ( e , tab [ 3 ] ) ;
+  bool resupprime = arbre_entier_supprimer ( e , tab [ 3 ] ) ;
+  fprintf ( f_out , "suppression de %d : %d , puis %d \n" , tab [ 3 ] , supprime , resupprime ) ;
+  int cles [ LG ] ;
+  int nombre = arbre_entier_vers_tableau ( e , cles ) ;
+  fprintf ( f_out , "tableau de %d clés : " , nombre ) ;
+  for ( int i=0 ; i<nombre ; i++ ) fprintf ( f_out , "%d " , cles [ i ] ) ;
+  fprintf ( f_out , "\ntaille %d hauteur %d vide %d \n" ,
+	    arbre_entier_taille ( e ) , arbre_entier_hauteur ( e ) , arbre_entier_est_vide ( e ) ) ;
+  arbre_entier_detruire ( &e ) ;
+
+  /* Valeurs insérées dans l'ordre */
+  arbre_entier simple = arbre_entier_creer ( false ) ;
+  arbre_entier equilibre = arbre_entier_creer ( true ) ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    arbre_entier_insertion ( simple , i ) ;
+    arbre_entier_insertion ( equilibre , i ) ;
+  }
+  fprintf ( f_out , "insertion de 0 à %d dans l'ordre : hauteurs %d %d \n" , LG_TRIE-1 ,
+	    arbre_entier_hauteur ( simple ) , arbre_entier_hauteur ( equilibre ) ) ;
+  arbre_entier_detruire ( &simple ) ;
+  arbre_entier_detruire ( &equilibre ) ;
+
+  /* Même comportement que arbre */
+  comparer ( f_out , false ) ;
+  comparer ( f_out , true ) ;
+
+  fclose ( f_out ) ;
+
+  mesurer ( ) ;
+
+  return 0 ;
+}
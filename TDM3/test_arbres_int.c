@@ -10,6 +10,8 @@
 
 # define LG 10
 # define IDX 5
+# define LG_TRIE 1000
+# define LG_DEGENERE 20000
 
 
 
@@ -98,6 +100,150 @@ int main ( void ) {
  
   arbre_detruire ( &abr ) ;
 
+  /* Test de l'arbre équilibré : valeurs insérées dans l'ordre */
+  arbre simple = arbre_creer ( copier_int , detruire_int , comparer_int ) ;
+  arbre equilibre = arbre_creer_equilibre ( copier_int , detruire_int , comparer_int ) ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    arbre_insertion ( simple , &i ) ;
+    arbre_insertion ( equilibre , &i ) ;
+  }
+  fprintf ( f_out , "insertion de 0 à %d dans l'ordre\n" , LG_TRIE-1 ) ;
+  fprintf ( f_out , "arbre simple : taille %d hauteur %d \n" , arbre_taille ( simple ) , arbre_hauteur ( simple ) ) ;
+  fprintf ( f_out , "arbre équilibré : taille %d hauteur %d \n" , arbre_taille ( equilibre ) , arbre_hauteur ( equilibre ) ) ;
+  for ( int i=0 ; i<LG_TRIE ; i+=2 ) {
+    arbre_supprimer ( equilibre , &i ) ;
+  }
+  for ( int i=0 ; i<LG_TRIE ; i+=3 ) {
+    arbre_supprimer ( equilibre , &i ) ;
+  }
+  int present = 0 ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    if ( NULL != arbre_rechercher ( equilibre , &i ) ) present++ ;
+  }
+  fprintf ( f_out , "après la suppression des multiples de 2 et de 3 : taille %d hauteur %d trouvés %d \n" ,
+	    arbre_taille ( equilibre ) , arbre_hauteur ( equilibre ) , present ) ;
+  for ( int i=0 ; i<LG ; i++ ) {
+    arbre_insertion ( equilibre , tab+i ) ;
+  }
+  arbre_supprimer ( equilibre , tab+IDX ) ;
+  fprintf ( f_out , "début : " ) ;
+  int debut [ LG ] = { 0 , 1 , 2 , 3 , 4 , 5 , 6 , 7 , 8 , 9 } ;
+  for ( int i=0 ; i<LG ; i++ ) {
+    if ( NULL != arbre_rechercher ( equilibre , debut+i ) ) fprintf ( f_out , "%d " , i ) ;
+  }
+  fprintf ( f_out , "\n" ) ;
+  arbre_detruire ( &simple ) ;
+
+  /* Test des parcours et de l'itérateur */
+  arbre petit = arbre_creer_equilibre ( copier_int , detruire_int , comparer_int ) ;
+  for ( int i=0 ; i<LG ; i++ ) {
+    arbre_insertion ( petit , tab+i ) ;
+  }
+  fprintf ( f_out , "préfixe : " ) ;
+  arbre_afficher_prefixe ( petit , f_out , afficher_int ) ;
+  fprintf ( f_out , "\ninfixe : " ) ;
+  arbre_afficher_infixe ( petit , f_out , afficher_int ) ;
+  fprintf ( f_out , "\npostfixe : " ) ;
+  arbre_afficher_postfixe ( petit , f_out , afficher_int ) ;
+  fprintf ( f_out , "\n" ) ;
+  arbre_detruire ( &petit ) ;
+  arbre_iterateur it = arbre_iterateur_creer ( equilibre ) ;
+  int nombre = 0 ;
+  int precedent = -1 ;
+  bool ordonne = true ;
+  while ( arbre_iterateur_a_suivant ( it ) ) {
+    int v = * ( int * ) arbre_iterateur_suivant ( it ) ;
+    if ( v <= precedent ) ordonne = false ;
+    precedent = v ;
+    nombre++ ;
+  }
+  arbre_iterateur_detruire ( &it ) ;
+  fprintf ( f_out , "itérateur : %d valeurs, dans l'ordre %d \n" , nombre , ordonne ) ;
+  arbre_detruire ( &equilibre ) ;
+
+  /* Arbre dégénéré (une seule branche) : parcours, taille et destruction sans récursion */
+  arbre degenere = arbre_creer ( copier_int , detruire_int , comparer_int ) ;
+  for ( int i=LG_DEGENERE-1 ; i>=0 ; i-- ) {
+    arbre_insertion ( degenere , &i ) ;
+  }
+  long somme = 0 ;
+  it = arbre_iterateur_creer ( degenere ) ;
+  while ( arbre_iterateur_a_suivant ( it ) ) {
+    somme += * ( int * ) arbre_iterateur_suivant ( it ) ;
+  }
+  arbre_iterateur_detruire ( &it ) ;
+  fprintf ( f_out , "arbre dégénéré : taille %d hauteur %d somme %ld \n" ,
+	    arbre_taille ( degenere ) , arbre_hauteur ( degenere ) , somme ) ;
+  arbre_detruire ( &degenere ) ;
+
+  /* Test de la réserve de noeuds, avec les valeurs copiées ou en place */
+  arbre copie = arbre_creer_reserve ( copier_int , detruire_int , comparer_int , 0 , false ) ;
+  arbre en_place = arbre_creer_reserve ( NULL , NULL , comparer_int , sizeof ( int ) , true ) ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    int v = ( i * 7919 ) % LG_TRIE ;
+    arbre_insertion ( copie , &v ) ;
+    arbre_insertion ( en_place , &v ) ;
+  }
+  for ( int i=0 ; i<LG_TRIE ; i+=2 ) {
+    arbre_supprimer ( copie , &i ) ;
+    arbre_supprimer ( en_place , &i ) ;
+  }
+  for ( int i=0 ; i<LG ; i++ ) {
+    arbre_insertion ( copie , tab+i ) ;
+    arbre_insertion ( en_place , tab+i ) ;
+  }
+  arbre_iterateur it_copie = arbre_iterateur_creer ( copie ) ;
+  arbre_iterateur it_en_place = arbre_iterateur_creer ( en_place ) ;
+  bool egaux = true ;
+  while ( arbre_iterateur_a_suivant ( it_copie ) && arbre_iterateur_a_suivant ( it_en_place ) ) {
+    if ( 0 != comparer_int ( arbre_iterateur_suivant ( it_copie ) , arbre_iterateur_suivant ( it_en_place ) ) ) egaux = false ;
+  }
+  if ( arbre_iterateur_a_suivant ( it_copie ) || arbre_iterateur_a_suivant ( it_en_place ) ) egaux = false ;
+  arbre_iterateur_detruire ( &it_copie ) ;
+  arbre_iterateur_detruire ( &it_en_place ) ;
+  fprintf ( f_out , "réserve : tailles %d %d hauteur en place %d mêmes valeurs %d \n" ,
+	    arbre_taille ( copie ) , arbre_taille ( en_place ) , arbre_hauteur ( en_place ) , egaux ) ;
+  fprintf ( f_out , "début en place : " ) ;
+  for ( int i=0 ; i<LG ; i++ ) {
+    int * v = arbre_rechercher ( en_place , debut+i ) ;
+    if ( NULL != v ) fprintf ( f_out , "%d " , *v ) ;
+  }
+  fprintf ( f_out , "\n" ) ;
+
+  /* Test de la construction depuis un tableau trié et de l'export dans un tableau */
+  int valeurs [ LG_TRIE ] ;
+  void * pointeurs [ LG_TRIE ] ;
+  for ( int i=0 ; i<LG_TRIE ; i++ ) {
+    valeurs [ i ] = 2 * i ;
+    pointeurs [ i ] = valeurs + i ;
+  }
+  arbre construit = arbre_creer_depuis_tableau ( copier_int , detruire_int , comparer_int , pointeurs , LG_TRIE ) ;
+  int pair = 2 * ( LG_TRIE / 3 ) ;
+  int impair = pair + 1 ;
+  fprintf ( f_out , "depuis un tableau : taille %d hauteur %d %d présent %d %d absent %d \n" ,
+	    arbre_taille ( construit ) , arbre_hauteur ( construit ) ,
+	    pair , NULL != arbre_rechercher ( construit , &pair ) ,
+	    impair , NULL == arbre_rechercher ( construit , &impair ) ) ;
+  arbre_detruire ( &construit ) ;
+  int nombre_copie = arbre_vers_tableau ( copie , pointeurs ) ;
+  arbre restaure = arbre_creer_reserve ( NULL , NULL , comparer_int , sizeof ( int ) , true ) ;
+  arbre_charger_tableau ( restaure , pointeurs , nombre_copie ) ;
+  arbre_detruire ( &copie ) ;
+  void * restaures [ LG_TRIE ] ;
+  int nombre_restaure = arbre_vers_tableau ( restaure , restaures ) ;
+  egaux = nombre_copie == nombre_restaure ;
+  for ( int i=0 ; egaux && i<nombre_restaure ; i++ ) {
+    if ( 0 != comparer_int ( restaures [ i ] , arbre_rechercher ( en_place , restaures [ i ] ) ) ) egaux = false ;
+  }
+  fprintf ( f_out , "export puis reconstruction : %d valeurs hauteur %d mêmes valeurs %d \n" ,
+	    nombre_restaure , arbre_hauteur ( restaure ) , egaux ) ;
+  int negatif = -1 ;
+  arbre_insertion ( restaure , &negatif ) ;
+  arbre_supprimer ( restaure , &negatif ) ;
+  fprintf ( f_out , "après une insertion et une suppression : taille %d \n" , arbre_taille ( restaure ) ) ;
+  arbre_detruire ( &restaure ) ;
+  arbre_detruire ( &en_place ) ;
+
   fclose ( f_out ) ;
 
   return 0 ;
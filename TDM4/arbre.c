@@ -2,6 +2,7 @@
 # include <stdlib.h>
 # include <string.h>
 # include <assert.h>
+# include <pthread.h>
 
 # undef NDEBUG
 
@@ -33,12 +34,15 @@ typedef struct noeud_struct* noeud;
  * \li père (pour les parcours), 
  * \li son fils le plus à gauche
  * \li le frère à gauche suivant
+ * \li son fils le plus à droite et son nombre de fils (pour ajouter un fils à droite sans parcourir les frères)
  */
 struct noeud_struct {
   void* val; 
   noeud pere; 
   noeud fils_gauche; 
   noeud frere_droit; 
+  noeud dernier_fils; 
+  unsigned int nombre_fils; 
 }; 
 
 
@@ -53,6 +57,8 @@ static noeud noeud_creer_vide()
   n -> pere = NULL; 
   n -> fils_gauche = NULL; 
   n -> frere_droit = NULL; 
+  n -> dernier_fils = NULL; 
+  n -> nombre_fils = 0; 
   return n;
 }
 
@@ -76,6 +82,20 @@ static noeud noeud_creer(void* val, void(* copier)(void* val, void** ptr))
 }
 
 
+/*!
+ * pour créer un nœud qui prend une valeur (sans copie, le nœud en devient responsable)
+ * \param val la valeur du noeud à créer
+ * \return un noeud simple
+ */
+static noeud noeud_creer_sans_copie(void* val)
+{ 
+  assert(NULL != val);
+  noeud n =  noeud_creer_vide ();
+  n -> val = val; 
+  return n;
+}
+
+
 /*!
  * pour créer un nœud avec une valeur comme premier fils gauche d'un nœud
  * \param n le noeud référence pour l'ajout
@@ -87,12 +107,29 @@ static void noeud_ajouter_fils_a_gauche(noeud n, void* val, void(* copier)(void*
   if(NULL==n->fils_gauche){
     n->fils_gauche=noeud_creer(val,copier);
     n->fils_gauche->pere = n;
+    n->dernier_fils = n->fils_gauche;
   }else{
     noeud m = noeud_creer(val,copier);
     m->frere_droit = n->fils_gauche;
     m->pere = n;
     n->fils_gauche = m;
   }  
+  n->nombre_fils++;
+}
+
+
+/*!
+ * accroche un nœud (sans frère) comme dernier fils d'un nœud, en temps constant
+ * \param n le noeud référence pour l'ajout
+ * \param m le noeud à ajouter
+ */
+static void noeud_accrocher_fils(noeud n, noeud m)
+{
+  m->pere = n;
+  if(NULL==n->fils_gauche) n->fils_gauche = m;
+  else n->dernier_fils->frere_droit = m;
+  n->dernier_fils = m;
+  n->nombre_fils++;
 }
 
 
@@ -104,13 +141,13 @@ static void noeud_ajouter_fils_a_gauche(noeud n, void* val, void(* copier)(void*
  */
 static void noeud_ajouter_frere_a_droite(noeud n, void* val, void(* copier)(void* val, void** ptr))
 {
-  if(NULL==n->frere_droit){
-    noeud m = noeud_creer(val,copier);
-    m->pere = n->pere;
+  noeud m = noeud_creer(val,copier);
+  if(NULL!=n->pere) noeud_accrocher_fils(n->pere,m);
+  else{
+    /* frère de la racine : pas de père pour connaître le dernier */
+    while(NULL!=n->frere_droit) n = n->frere_droit;
     n->frere_droit = m;
-  } 
-  else  noeud_ajouter_frere_a_droite(n->frere_droit,val,copier);
-
+  }
 }
 
 
@@ -122,19 +159,7 @@ static void noeud_ajouter_frere_a_droite(noeud n, void* val, void(* copier)(void
  */
 static void noeud_ajouter_fils (noeud n, void* val, void(* copier)(void* val, void** ptr))
 {
-  if(NULL==n->fils_gauche){
-    n->fils_gauche = noeud_creer(val,copier);
-    n->fils_gauche->pere = n;
-  } 
-  else noeud_ajouter_frere_a_droite(n->fils_gauche,val,copier);
-
-
-   /* noeud* pt = &(n->fils_gauche);
-    while(NULL!=(*pt)->frere_droit){
-      *pt -> (*pt)->frere_droit;
-    }
-    (*pt)->frere_droit = noeud_creer(val,copier);
-  }*/
+  noeud_accrocher_fils(n,noeud_creer(val,copier));
 }
 
 
@@ -208,9 +233,10 @@ static void noeud_detruire(noeud* n, void(detruire )(void** val))
  */
 static noeud* noeud_chercher(noeud* n_pt, void* val, bool(*est_egal)(void* val1, void* val2)){
   if(est_egal((*n_pt)->val,val)) return n_pt;
-  else if (NULL!=(*n_pt)->fils_gauche) noeud_chercher(&((*n_pt)->fils_gauche),val,est_egal);
-  else if (NULL!=(*n_pt)->frere_droit) noeud_chercher(&((*n_pt)->frere_droit),val,est_egal);
-  else return NULL;
+  noeud* trouve = NULL;
+  if (NULL!=(*n_pt)->fils_gauche) trouve = noeud_chercher(&((*n_pt)->fils_gauche),val,est_egal);
+  if (NULL==trouve && NULL!=(*n_pt)->frere_droit) trouve = noeud_chercher(&((*n_pt)->frere_droit),val,est_egal);
+  return trouve;
 }
 
 
@@ -254,12 +280,22 @@ void arbre_inserer_racine(arbre a, void* val)
   assert(NULL != a);
   assert(NULL != val);
   noeud n = noeud_creer(val, a -> copier);
-  n -> fils_gauche = a -> racine;
+  if(NULL != a -> racine) noeud_accrocher_fils(n, a -> racine);
   a -> racine = n;
   printf("fin insertion\n");
 }
 
 
+void arbre_inserer_racine_sans_copie(arbre a, void* val)
+{ 
+  assert(NULL != a);
+  assert(NULL != val);
+  noeud n = noeud_creer_sans_copie(val);
+  if(NULL != a -> racine) noeud_accrocher_fils(n, a -> racine);
+  a -> racine = n;
+}
+
+
 void arbre_afficher(arbre a, FILE * f, void(* afficher)(void* val,FILE * f), char const * const sep)
 {
   assert(NULL != a);
@@ -286,9 +322,18 @@ arbre arbre_extraction(arbre a, void* val, bool(* est_egal)(void* val1, void* va
   assert(NULL != val);
   assert(NULL != est_egal);
   noeud* n=noeud_chercher(&(a->racine),val,est_egal);
-  if(NULL!=*n){
+  if(NULL!=n){
   	noeud e=(*n);
 	  *n=(*n)->frere_droit;
+	  if(NULL!=e->pere){
+	    noeud pere=e->pere;
+	    pere->nombre_fils--;
+	    if(pere->dernier_fils==e){
+	      /* le nouveau dernier fils est le frère gauche de e */
+	      pere->dernier_fils=NULL;
+	      for(noeud f=pere->fils_gauche;NULL!=f;f=f->frere_droit) pere->dernier_fils=f;
+	    }
+	  }
   	arbre b = arbre_creer(a->copier,a->detruire);
   	b->racine=e;
 	  b->racine->pere=NULL;
@@ -338,9 +383,11 @@ bool arbre_parcours_est_fini(arbre_parcours p){
 void arbre_parcours_suivant(arbre_parcours p){
   assert(NULL!=p);
   if(NULL!=p->courant->fils_gauche) p->courant= p->courant->fils_gauche;
-  else if(NULL!=p->courant->frere_droit) p->courant = p->courant->frere_droit;
-  else if(NULL!= p->courant->pere){
-    p->courant = p->courant->pere->frere_droit;
+  else{
+    /* premier ancêtre (ou le nœud lui-même) qui a un frère droit, fin du parcours sinon */
+    noeud n = p->courant;
+    while(NULL != n && NULL == n->frere_droit) n = n->pere;
+    p->courant = (NULL == n) ? NULL : n->frere_droit;
   }
 }
 
@@ -365,10 +412,21 @@ void arbre_parcours_aller_fils_gauche(arbre_parcours p){
 
 void arbre_parcours_aller_fils_droite(arbre_parcours p){
   assert(arbre_parcours_a_fils(p));
-  p->courant = p->courant->fils_gauche;
-  while(NULL != p->courant->frere_droit){
-    p->courant = p->courant->frere_droit;
-  }
+  p->courant = p->courant->dernier_fils;
+}
+
+
+void arbre_parcours_aller_fils(arbre_parcours p, unsigned int i){
+  assert(! arbre_parcours_est_fini(p));
+  assert(i < p -> courant -> nombre_fils);
+  p -> courant = p -> courant -> fils_gauche;
+  for(; 0 < i; i--) p -> courant = p -> courant -> frere_droit;
+}
+
+
+unsigned int arbre_parcours_nombre_fils(arbre_parcours p){
+  assert(! arbre_parcours_est_fini(p));
+  return p -> courant -> nombre_fils;
 }
 
 
@@ -419,6 +477,12 @@ void arbre_parcours_ajouter_fils_a_droite(arbre_parcours p, void* val){
 }
 
 
+void arbre_parcours_ajouter_fils_a_droite_sans_copie(arbre_parcours p, void* val){
+  assert(! arbre_parcours_est_fini(p));
+  noeud_accrocher_fils(p -> courant, noeud_creer_sans_copie(val));
+}
+
+
 void arbre_parcourir(arbre a,  void(* faire )(void* val1,va_list args),...){
   assert(NULL != a);
   assert(NULL != faire);
@@ -432,3 +496,130 @@ void arbre_parcourir(arbre a,  void(* faire )(void* val1,va_list args),...){
   }
   arbre_parcours_detruire(p);
 }
+
+
+
+/*!
+ * Nombre de sous-arbres (tâches) visé par thread pour arbre_parcourir_parallele :
+ * plusieurs par thread pour que les threads qui finissent tôt en reprennent d'autres.
+ */
+# define TACHES_PAR_THREAD 8
+
+
+/*!
+ * Applique faire à un nœud et à tous ses descendants (pas à ses frères), en préfixe, sans pile :
+ * on remonte par les pères jusqu'au premier ancêtre (sous r) qui a un frère droit.
+ */
+static void noeud_parcourir_sous_arbre(noeud r, void(* faire)(void* val, void* partiel), void* partiel)
+{
+  noeud n = r;
+  while(NULL != n){
+    faire(n->val, partiel);
+    if(NULL != n->fils_gauche) n = n->fils_gauche;
+    else{
+      while(n != r && NULL == n->frere_droit) n = n->pere;
+      n = (n == r) ? NULL : n->frere_droit;
+    }
+  }
+}
+
+
+/*!
+ * Les tâches partagées par les threads de arbre_parcourir_parallele.
+ * Chaque thread prend la tâche suivante (sous le verrou) jusqu'à ce qu'il n'y en ait plus.
+ */
+typedef struct {
+  noeud* taches;
+  unsigned int nombre_taches;
+  unsigned int suivante;
+  pthread_mutex_t verrou;
+  void(* faire)(void* val, void* partiel);
+} parcours_parallele;
+
+typedef struct {
+  parcours_parallele* partage;
+  void* partiel;
+} parcours_thread;
+
+
+static void* parcours_thread_travailler(void* arg)
+{
+  parcours_thread* t = arg;
+  parcours_parallele* pp = t->partage;
+  while(true){
+    pthread_mutex_lock(&(pp->verrou));
+    unsigned int k = pp->suivante++;
+    pthread_mutex_unlock(&(pp->verrou));
+    if(k >= pp->nombre_taches) return NULL;
+    noeud_parcourir_sous_arbre(pp->taches[k], pp->faire, t->partiel);
+  }
+}
+
+
+void arbre_parcourir_parallele(arbre a, unsigned int nombre_threads,
+			       void(* faire)(void* val, void* partiel),
+			       void* partiels[],
+			       void(* reduire)(void* partiel, void* total),
+			       void* total)
+{
+  assert(NULL != a);
+  assert(0 < nombre_threads);
+  assert(NULL != faire);
+  assert(NULL != partiels);
+  /* les niveaux du haut sont faits ici, jusqu'à avoir assez de sous-arbres pour les threads */
+  unsigned int capacite = 16;
+  unsigned int nombre = 0;
+  noeud* niveau = malloc(capacite * sizeof(noeud));
+  assert(NULL != niveau);
+  for(noeud n = a->racine; NULL != n; n = n->frere_droit){
+    if(nombre == capacite){
+      capacite *= 2;
+      niveau = realloc(niveau, capacite * sizeof(noeud));
+      assert(NULL != niveau);
+    }
+    niveau[nombre++] = n;
+  }
+  while(0 < nombre && nombre < TACHES_PAR_THREAD * nombre_threads){
+    unsigned int nombre_fils = 0;
+    for(unsigned int k = 0; k < nombre; k++) nombre_fils += niveau[k]->nombre_fils;
+    if(0 == nombre_fils) break;
+    noeud* suivant = malloc(nombre_fils * sizeof(noeud));
+    assert(NULL != suivant);
+    unsigned int j = 0;
+    for(unsigned int k = 0; k < nombre; k++){
+      faire(niveau[k]->val, partiels[0]);
+      for(noeud f = niveau[k]->fils_gauche; NULL != f; f = f->frere_droit) suivant[j++] = f;
+    }
+    assert(j == nombre_fils);
+    free(niveau);
+    niveau = suivant;
+    nombre = nombre_fils;
+  }
+  /* puis les sous-arbres du dernier niveau, par les threads (dont celui-ci) */
+  parcours_parallele pp;
+  pp.taches = niveau;
+  pp.nombre_taches = nombre;
+  pp.suivante = 0;
+  pthread_mutex_init(&(pp.verrou), NULL);
+  pp.faire = faire;
+  parcours_thread* threads = malloc(nombre_threads * sizeof(parcours_thread));
+  pthread_t* ids = malloc(nombre_threads * sizeof(pthread_t));
+  assert(NULL != threads && NULL != ids);
+  for(unsigned int t = 0; t < nombre_threads; t++){
+    threads[t].partage = &pp;
+    threads[t].partiel = partiels[t];
+  }
+  for(unsigned int t = 1; t < nombre_threads; t++){
+    int ret = pthread_create(&(ids[t]), NULL, parcours_thread_travailler, &(threads[t]));
+    assert(0 == ret);
+  }
+  parcours_thread_travailler(&(threads[0]));
+  for(unsigned int t = 1; t < nombre_threads; t++) pthread_join(ids[t], NULL);
+  pthread_mutex_destroy(&(pp.verrou));
+  free(ids);
+  free(threads);
+  free(niveau);
+  if(NULL != reduire){
+    for(unsigned int t = 0; t < nombre_threads; t++) reduire(partiels[t], total);
+  }
+}
@@ -11,6 +11,8 @@
  * Il est possible de parcourir un arbre et de s'y déplacer au moyen d'un type arbre_parcours
  *
  * Toutes les structures sont cachées dans le .c 
+ * Deux implémentations : arbre.c (chaque nœud a un fils gauche et un frère droit)
+ * et arbre_tableau.c (chaque nœud range ses fils dans un tableau, pour les nœuds qui en ont beaucoup).
  *
  * \copyright PASD
  * \version 2017
@@ -60,6 +62,16 @@ void arbre_inserer_racine(arbre a, void* val);
 
 
 
+/*!
+ * Comme arbre_inserer_racine, sans copie : l'arbre devient responsable de la valeur (qu'il détruira).
+ * \param a arbre à modifier
+ * \param val valeur à ajouter, ni à détruire ni à modifier ensuite
+ * \pre Ni a, ni val ne doivent être NULL
+ */
+void arbre_inserer_racine_sans_copie(arbre a, void* val); 
+
+
+
 
 /*!
  * Affiche toutes les valeurs contenues dans un arbre selon un parcours préfixe.
@@ -166,7 +178,7 @@ void arbre_parcours_aller_fils_gauche(arbre_parcours p);
 
 
 /*!
- * On déplace position courante sur son fils le plus à droite
+ * On déplace position courante sur son fils le plus à droite (en temps constant)
  * \param p parcours en cours
  * \pre p ne doit pas être fini
  * \pre il doit y avoir un fils
@@ -174,6 +186,26 @@ void arbre_parcours_aller_fils_gauche(arbre_parcours p);
 void arbre_parcours_aller_fils_droite(arbre_parcours p);
 
 
+/*!
+ * On déplace position courante sur son fils d'indice i (0 pour le plus à gauche)
+ * (en temps constant avec arbre_tableau.c, en passant les i premiers fils avec arbre.c)
+ * \param p parcours en cours
+ * \param i indice du fils
+ * \pre p ne doit pas être fini
+ * \pre i doit être inférieur au nombre de fils
+ */
+void arbre_parcours_aller_fils(arbre_parcours p, unsigned int i);
+
+
+/*!
+ * Pour connaître le nombre de fils de la position courante (sans les parcourir)
+ * \param p parcours en cours
+ * \pre p ne doit pas être fini
+ * \return le nombre de fils
+ */
+unsigned int arbre_parcours_nombre_fils(arbre_parcours p);
+
+
 /*!
  * Pour savoir si la position courante a un frere droit
  * \param p parcours en cours
@@ -230,6 +262,7 @@ void arbre_parcours_ajouter_fils_a_gauche(arbre_parcours p, void* val);
 
 /*!
  * Ajoute un fils complètement à droite de tous les autres à partir de la position courante
+ * (en temps constant, sans parcourir les autres fils)
  * \param p parcours en cours
  * \pre p ne doit pas être fini
  * \pre val ne doit pas être NULL
@@ -237,6 +270,16 @@ void arbre_parcours_ajouter_fils_a_gauche(arbre_parcours p, void* val);
 void arbre_parcours_ajouter_fils_a_droite(arbre_parcours p, void* val);
 
 
+/*!
+ * Comme arbre_parcours_ajouter_fils_a_droite, sans copie : l'arbre devient responsable de la valeur (qu'il détruira).
+ * \param p parcours en cours
+ * \param val valeur à ajouter, ni à détruire ni à modifier ensuite
+ * \pre p ne doit pas être fini
+ * \pre val ne doit pas être NULL
+ */
+void arbre_parcours_ajouter_fils_a_droite_sans_copie(arbre_parcours p, void* val);
+
+
 /*!
  * Permet de faire un même traitement à toutes les valeurs dans l'arbre.
  * Les valeurs sont parcourus dans l'ordre prefix.
@@ -249,4 +292,27 @@ void arbre_parcours_ajouter_fils_a_droite(arbre_parcours p, void* val);
 void arbre_parcourir(arbre a, void(* faire)(void* val1,va_list args), ...);
 
 
+/*!
+ * Comme arbre_parcourir, par plusieurs threads, quand le traitement d'une valeur ne dépend pas des autres
+ * (hachage, validation, statistiques...).
+ * Les niveaux du haut de l'arbre sont découpés en sous-arbres que les threads se répartissent
+ * (un thread qui a fini prend le sous-arbre suivant), le thread appelant étant l'un d'eux.
+ * Chaque thread a son propre résultat partiel, ils sont réduits à la fin.
+ * Les valeurs ne sont donc pas parcourues dans l'ordre préfixe.
+ * \param a arbre à parcourir
+ * \param nombre_threads nombre de threads
+ * \param faire traitement d'une valeur, qui ne doit modifier que le résultat partiel (des appels ont lieu en même temps)
+ * \param partiels les nombre_threads résultats partiels, initialisés par l'appelant
+ * \param reduire est appelé ensuite (par le thread appelant) avec chaque résultat partiel, dans l'ordre, et total ; peut être NULL
+ * \param total résultat final passé à reduire
+ * \pre a, faire et partiels ne doivent pas être NULL, nombre_threads doit être au moins 1
+ * \pre l'arbre ne doit pas être modifié pendant le parcours
+ */
+void arbre_parcourir_parallele(arbre a, unsigned int nombre_threads,
+			       void(* faire)(void* val, void* partiel),
+			       void* partiels[],
+			       void(* reduire)(void* partiel, void* total),
+			       void* total);
+
+
 # endif
@@ -0,0 +1,611 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include <pthread.h>
+
+# undef NDEBUG
+
+# include "arbre.h"
+
+/*!
+ * \file
+ * \brief Autre implémentation de arbre.h : chaque nœud range ses fils dans un tableau (au lieu de fils gauche / frère droit)
+ *
+ * Un programme se lie avec arbre_tableau.o au lieu de arbre.o, sans autre changement (voir les cibles *_tableau du Makefile).
+ * L'accès au fils d'indice i, au dernier fils, au frère suivant et le retrait d'un fils (arbre_extraction)
+ * se font sans remonter de chaîne de frères : les fils d'un nœud sont lus dans des cases consécutives.
+ * En contrepartie, ajouter un fils à gauche décale les autres et met à jour leur rang.
+ *
+ * Les racines (la racine et ses éventuels frères) sont les cases d'un tableau de l'arbre.
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+
+
+/*! Nombre de cases allouées au premier fils, il double quand le tableau est plein. */
+# define FILS_INITIAL 4
+
+
+/*!
+ * Représente un noeud de l'arbre (Pointeur/référence).
+ */
+typedef struct noeud_struct* noeud;
+
+/*!
+ * Fils d'un nœud (ou racines de l'arbre), de gauche à droite, dans les cases [0,nombre[.
+ */
+typedef struct {
+  noeud* cases;
+  unsigned int nombre;
+  unsigned int capacite;
+} fratrie;
+
+/*!
+ * Représente un noeud de l'arbre (structure).
+ * Il indique son
+ * \li père (pour les parcours),
+ * \li son rang parmi ses frères (la case où il est chez son père, pour passer au frère suivant),
+ * \li ses fils.
+ */
+struct noeud_struct {
+  void* val;
+  noeud pere;
+  unsigned int rang;
+  fratrie fils;
+};
+
+
+static void fratrie_initialiser(fratrie* f)
+{
+  f->cases = NULL;
+  f->nombre = 0;
+  f->capacite = 0;
+}
+
+
+/*!
+ * Place m au rang indiqué, les fils suivants sont décalés d'une case (et leur rang mis à jour).
+ */
+static void fratrie_inserer(fratrie* f, unsigned int rang, noeud m)
+{
+  assert(rang <= f->nombre);
+  if(f->nombre == f->capacite){
+    f->capacite = (0 == f->capacite) ? FILS_INITIAL : 2 * f->capacite;
+    f->cases = realloc(f->cases, f->capacite * sizeof(noeud));
+    assert(NULL != f->cases);
+  }
+  memmove(f->cases + rang + 1, f->cases + rang, (f->nombre - rang) * sizeof(noeud));
+  f->cases[rang] = m;
+  f->nombre++;
+  for(unsigned int k = rang; k < f->nombre; k++) f->cases[k]->rang = k;
+}
+
+
+/*!
+ * Retire le fils du rang indiqué, les suivants reviennent d'une case.
+ */
+static void fratrie_retirer(fratrie* f, unsigned int rang)
+{
+  assert(rang < f->nombre);
+  f->nombre--;
+  memmove(f->cases + rang, f->cases + rang + 1, (f->nombre - rang) * sizeof(noeud));
+  for(unsigned int k = rang; k < f->nombre; k++) f->cases[k]->rang = k;
+}
+
+
+/*!
+ *  Pour creer un nœud sans valeur
+ */
+static noeud noeud_creer_vide()
+{
+  noeud n = malloc(sizeof(struct noeud_struct));
+  assert(NULL != n);
+  n -> val = NULL;
+  n -> pere = NULL;
+  n -> rang = 0;
+  fratrie_initialiser(&(n -> fils));
+  return n;
+}
+
+
+/*!
+ * pour créer un nœud avec une valeur
+ * \param val la valeur du noeud à créer
+ * \param copier la fonction de copie pour le type de val
+ * \return un noeud simple
+ */
+static noeud noeud_creer(void* val, void(* copier)(void* val, void** ptr))
+{
+  assert(NULL != val);
+  assert(NULL != copier);
+  noeud n = noeud_creer_vide();
+  copier(val, &(n -> val));
+  return n;
+}
+
+
+/*!
+ * pour créer un nœud qui prend une valeur (sans copie, le nœud en devient responsable)
+ * \param val la valeur du noeud à créer
+ * \return un noeud simple
+ */
+static noeud noeud_creer_sans_copie(void* val)
+{
+  assert(NULL != val);
+  noeud n = noeud_creer_vide();
+  n -> val = val;
+  return n;
+}
+
+
+/*!
+ * accroche un nœud comme fils de rang donné d'un nœud
+ * \param pere le nouveau père (NULL pour une racine)
+ * \param f les fils de pere (ou les racines)
+ * \param rang la place de m parmi eux
+ * \param m le noeud à ajouter
+ */
+static void noeud_accrocher(noeud pere, fratrie* f, unsigned int rang, noeud m)
+{
+  m->pere = pere;
+  fratrie_inserer(f, rang, m);
+}
+
+
+/*!
+ * fait un affichage préfixe du sommet et de ses descendants
+ * \param n le noeud à afficher
+ * \param f le flux de sortie
+ * \param afficher la fonction d'affichage pour le type de val
+ */
+static void noeud_afficher(noeud n, FILE * f, void(* afficher)(void* val, FILE * f), char const * const sep)
+{
+  afficher(n->val,f);
+  for(unsigned int k = 0; k < n->fils.nombre; k++){
+    fputs(sep,f);
+    noeud_afficher(n->fils.cases[k],f,afficher,sep);
+  }
+}
+
+
+/*!
+ * affiche des frères (et leurs descendants) avec parenthèses et virgules pour montrer la structure arborescente
+ * \param freres les nœuds à afficher
+ * \param f le flux de sortie
+ * \param afficher la fonction d'affichage pour le type de val
+ */
+static void fratrie_afficher_tuple(fratrie* freres, FILE * f, void(* afficher )(void* val, FILE * f))
+{
+  for(unsigned int k = 0; k < freres->nombre; k++){
+    noeud n = freres->cases[k];
+    if(0 < k) fprintf(f," , ");
+    afficher(n->val,f);
+    if(0 < n->fils.nombre){
+      fprintf(f," ( ");
+      fratrie_afficher_tuple(&(n->fils),f,afficher);
+      fprintf(f," )");
+    }
+  }
+}
+
+
+/*!
+ * Détruit un nœud, ses descendants et les valeurs qu'ils contiennent
+ * \param n le noeud à détruire
+ * \param detruire la fonction pour détruire adaptée au type de val
+ */
+static void noeud_detruire(noeud n, void(detruire )(void** val))
+{
+  for(unsigned int k = 0; k < n->fils.nombre; k++) noeud_detruire(n->fils.cases[k],detruire);
+  free(n->fils.cases);
+  detruire(&(n->val));
+  free(n);
+}
+
+
+/*!
+ * Recherche préfixe, parmi des frères et leurs descendants, d'un nœud égal (au sens de la fonction en argument) à une valeur
+ * \param freres les nœuds à partir desquels se fait la recherche
+ * \param val la valeur recherchée
+ * \param est_egal la fonction adaptée au type des valeurs pour tester l'égalité
+ * \return le noeud recherché ou NULL
+ */
+static noeud fratrie_chercher(fratrie* freres, void* val, bool(*est_egal)(void* val1, void* val2)){
+  for(unsigned int k = 0; k < freres->nombre; k++){
+    noeud n = freres->cases[k];
+    if(est_egal(n->val,val)) return n;
+    noeud trouve = fratrie_chercher(&(n->fils),val,est_egal);
+    if(NULL != trouve) return trouve;
+  }
+  return NULL;
+}
+
+
+/*!
+ * structure arbre
+ * \param racines la racine de l'arbre (le noeud qui n'a pas de père) et ses frères
+ * \param copier pour copier/mettre en place une valeur
+ * \param detruire pour détruire une valeur stockée dans l'arbre
+ */
+struct arbre_struct {
+  fratrie racines;
+  void(* copier )(void* val, void* * pt);
+  void(* detruire )(void* * pt);
+};
+
+
+/*!
+ * Les frères d'un nœud, lui compris : les fils de son père ou les racines de l'arbre.
+ */
+static fratrie* noeud_freres(arbre a, noeud n)
+{
+  return (NULL == n->pere) ? &(a->racines) : &(n->pere->fils);
+}
+
+
+
+arbre arbre_creer(void(* copier )(void* val, void** pt), void(* detruire )(void** pt))
+{
+  assert(NULL != copier);
+  assert(NULL != detruire);
+  arbre n = (arbre)malloc(sizeof(struct arbre_struct));
+  assert(NULL != n);
+  fratrie_initialiser(&(n -> racines));
+  n -> copier = copier;
+  n -> detruire = detruire;
+  return n;
+}
+
+void arbre_detruire(arbre * a)
+{
+  assert(NULL != a);
+  for(unsigned int k = 0; k < (*a)->racines.nombre; k++) noeud_detruire((*a)->racines.cases[k],(*a)->detruire);
+  free((*a)->racines.cases);
+  free(* a);
+  *a = NULL;
+}
+
+
+/*!
+ * n devient l'unique racine, les anciennes racines sont ses fils.
+ */
+static void arbre_placer_racine(arbre a, noeud n)
+{
+  n->fils = a->racines;
+  for(unsigned int k = 0; k < n->fils.nombre; k++) n->fils.cases[k]->pere = n;
+  fratrie_initialiser(&(a->racines));
+  noeud_accrocher(NULL, &(a->racines), 0, n);
+}
+
+void arbre_inserer_racine(arbre a, void* val)
+{
+  assert(NULL != a);
+  assert(NULL != val);
+  arbre_placer_racine(a, noeud_creer(val, a -> copier));
+}
+
+
+void arbre_inserer_racine_sans_copie(arbre a, void* val)
+{
+  assert(NULL != a);
+  assert(NULL != val);
+  arbre_placer_racine(a, noeud_creer_sans_copie(val));
+}
+
+
+void arbre_afficher(arbre a, FILE * f, void(* afficher)(void* val,FILE * f), char const * const sep)
+{
+  assert(NULL != a);
+  assert(NULL != f);
+  assert(NULL != afficher);
+  for(unsigned int k = 0; k < a->racines.nombre; k++){
+    if(0 < k) fputs(sep, f);
+    noeud_afficher(a->racines.cases[k], f, afficher, sep);
+  }
+  fputc('\n', f);
+}
+
+void arbre_afficher_tuple(arbre a, FILE * f, void(* afficher )(void* val, FILE * f))
+{
+  assert(NULL != a);
+  assert(NULL != f);
+  assert(NULL != afficher);
+  fratrie_afficher_tuple(&(a -> racines), f, afficher);
+  fputc('\n', f);
+}
+
+
+
+arbre arbre_extraction(arbre a, void* val, bool(* est_egal)(void* val1, void* val2))
+{
+  assert(NULL != a);
+  assert(NULL != val);
+  assert(NULL != est_egal);
+  noeud e = fratrie_chercher(&(a->racines),val,est_egal);
+  if(NULL == e) return NULL;
+  fratrie_retirer(noeud_freres(a,e),e->rang);
+  arbre b = arbre_creer(a->copier,a->detruire);
+  noeud_accrocher(NULL,&(b->racines),0,e);
+  return b;
+}
+
+
+/*!
+ * structure pour enregistrer un arbre à parcourir et le nœud où en est le parcours.
+ * a l'arbre concerné
+ * courant la position dans l'arbre pour le parcours (vaut NULL quand le parcours est fini)
+ */
+struct arbre_parcours_struct {
+  arbre a;
+  noeud courant;
+};
+
+
+
+arbre_parcours arbre_creer_parcours(arbre a){
+  assert(NULL != a);
+  arbre_parcours b = malloc(sizeof(struct arbre_parcours_struct));
+  assert(NULL != b);
+  b->a = a;
+  b->courant = (0 < a->racines.nombre) ? a->racines.cases[0] : NULL;
+  return b;
+}
+
+
+void arbre_parcours_detruire(arbre_parcours p){
+  free(p);
+}
+
+
+bool arbre_parcours_est_fini(arbre_parcours p){
+  assert(NULL != p);
+  return p->courant==NULL;
+}
+
+
+void arbre_parcours_suivant(arbre_parcours p){
+  assert(NULL!=p);
+  noeud n = p->courant;
+  if(0 < n->fils.nombre){
+    p->courant = n->fils.cases[0];
+    return;
+  }
+  /* le frère suivant du premier ancêtre (n compris) qui en a un */
+  for(; NULL != n; n = n->pere){
+    fratrie* freres = noeud_freres(p->a,n);
+    if(n->rang + 1 < freres->nombre){
+      p->courant = freres->cases[n->rang + 1];
+      return;
+    }
+  }
+  p->courant = NULL;
+}
+
+
+void* arbre_parcours_valeur(arbre_parcours p){
+  assert(p!=NULL);
+  return (p->courant)->val;
+}
+
+
+bool arbre_parcours_a_fils(arbre_parcours p){
+  assert(! arbre_parcours_est_fini(p));
+  return(0 < p -> courant -> fils.nombre);
+}
+
+
+void arbre_parcours_aller_fils_gauche(arbre_parcours p){
+  assert(arbre_parcours_a_fils(p));
+  p -> courant = p -> courant -> fils.cases[0];
+}
+
+
+void arbre_parcours_aller_fils_droite(arbre_parcours p){
+  assert(arbre_parcours_a_fils(p));
+  p -> courant = p -> courant -> fils.cases[p -> courant -> fils.nombre - 1];
+}
+
+
+void arbre_parcours_aller_fils(arbre_parcours p, unsigned int i){
+  assert(! arbre_parcours_est_fini(p));
+  assert(i < p -> courant -> fils.nombre);
+  p -> courant = p -> courant -> fils.cases[i];
+}
+
+
+unsigned int arbre_parcours_nombre_fils(arbre_parcours p){
+  assert(! arbre_parcours_est_fini(p));
+  return p -> courant -> fils.nombre;
+}
+
+
+bool arbre_parcours_a_frere_droit(arbre_parcours p){
+  assert(! arbre_parcours_est_fini(p));
+  return(p -> courant -> rang + 1 < noeud_freres(p -> a, p -> courant) -> nombre);
+}
+
+
+void arbre_parcours_aller_frere_droit(arbre_parcours p){
+  assert(!arbre_parcours_est_fini(p));
+  /* comme arbre.c : jusqu'au dernier frère */
+  fratrie* freres = noeud_freres(p -> a, p -> courant);
+  p -> courant = freres -> cases[freres -> nombre - 1];
+}
+
+
+bool arbre_parcours_a_pere(arbre_parcours p){
+  assert(! arbre_parcours_est_fini(p));
+  return(NULL != p -> courant -> pere);
+}
+
+
+void arbre_parcours_aller_pere(arbre_parcours p){
+  assert(arbre_parcours_a_pere(p));
+  p -> courant = p -> courant -> pere;
+}
+
+
+void arbre_parcours_ajouter_frere_a_droite(arbre_parcours p, void* val){
+  assert(!arbre_parcours_est_fini(p));
+  assert(NULL != val);
+  fratrie* freres = noeud_freres(p -> a, p -> courant);
+  noeud_accrocher(p -> courant -> pere, freres, freres -> nombre, noeud_creer(val, p -> a -> copier));
+}
+
+
+
+void arbre_parcours_ajouter_fils_a_gauche(arbre_parcours p, void* val){
+  assert(! arbre_parcours_est_fini(p));
+  noeud_accrocher(p -> courant, &(p -> courant -> fils), 0, noeud_creer(val, p -> a -> copier));
+}
+
+
+void arbre_parcours_ajouter_fils_a_droite(arbre_parcours p, void* val){
+  assert(! arbre_parcours_est_fini(p));
+  noeud_accrocher(p -> courant, &(p -> courant -> fils), p -> courant -> fils.nombre, noeud_creer(val, p -> a -> copier));
+}
+
+
+void arbre_parcours_ajouter_fils_a_droite_sans_copie(arbre_parcours p, void* val){
+  assert(! arbre_parcours_est_fini(p));
+  noeud_accrocher(p -> courant, &(p -> courant -> fils), p -> courant -> fils.nombre, noeud_creer_sans_copie(val));
+}
+
+
+void arbre_parcourir(arbre a,  void(* faire )(void* val1,va_list args),...){
+  assert(NULL != a);
+  assert(NULL != faire);
+  arbre_parcours p = arbre_creer_parcours(a);
+  while(! arbre_parcours_est_fini(p)) {
+    va_list va;
+    va_start(va,faire);
+    (* faire)(arbre_parcours_valeur(p), va);
+    va_end(va);
+    arbre_parcours_suivant(p);
+  }
+  arbre_parcours_detruire(p);
+}
+
+
+
+/*!
+ * Nombre de sous-arbres (tâches) visé par thread pour arbre_parcourir_parallele :
+ * plusieurs par thread pour que les threads qui finissent tôt en reprennent d'autres.
+ */
+# define TACHES_PAR_THREAD 8
+
+
+/*!
+ * Applique faire à un nœud et à tous ses descendants (pas à ses frères), en préfixe, sans pile :
+ * on remonte par les pères jusqu'au premier ancêtre (sous r) qui a un frère suivant.
+ */
+static void noeud_parcourir_sous_arbre(noeud r, void(* faire)(void* val, void* partiel), void* partiel)
+{
+  noeud n = r;
+  while(NULL != n){
+    faire(n->val, partiel);
+    if(0 < n->fils.nombre) n = n->fils.cases[0];
+    else{
+      while(n != r && n->rang + 1 == n->pere->fils.nombre) n = n->pere;
+      n = (n == r) ? NULL : n->pere->fils.cases[n->rang + 1];
+    }
+  }
+}
+
+
+/*!
+ * Les tâches partagées par les threads de arbre_parcourir_parallele.
+ * Chaque thread prend la tâche suivante (sous le verrou) jusqu'à ce qu'il n'y en ait plus.
+ */
+typedef struct {
+  noeud* taches;
+  unsigned int nombre_taches;
+  unsigned int suivante;
+  pthread_mutex_t verrou;
+  void(* faire)(void* val, void* partiel);
+} parcours_parallele;
+
+typedef struct {
+  parcours_parallele* partage;
+  void* partiel;
+} parcours_thread;
+
+
+static void* parcours_thread_travailler(void* arg)
+{
+  parcours_thread* t = arg;
+  parcours_parallele* pp = t->partage;
+  while(true){
+    pthread_mutex_lock(&(pp->verrou));
+    unsigned int k = pp->suivante++;
+    pthread_mutex_unlock(&(pp->verrou));
+    if(k >= pp->nombre_taches) return NULL;
+    noeud_parcourir_sous_arbre(pp->taches[k], pp->faire, t->partiel);
+  }
+}
+
+
+void arbre_parcourir_parallele(arbre a, unsigned int nombre_threads,
+			       void(* faire)(void* val, void* partiel),
+			       void* partiels[],
+			       void(* reduire)(void* partiel, void* total),
+			       void* total)
+{
+  assert(NULL != a);
+  assert(0 < nombre_threads);
+  assert(NULL != faire);
+  assert(NULL != partiels);
+  /* les niveaux du haut sont faits ici, jusqu'à avoir assez de sous-arbres pour les threads ;
+     un niveau est la suite des tableaux de fils du niveau précédent */
+  unsigned int nombre = a->racines.nombre;
+  noeud* niveau = malloc((0 < nombre ? nombre : 1) * sizeof(noeud));
+  assert(NULL != niveau);
+  if(0 < nombre) memcpy(niveau, a->racines.cases, nombre * sizeof(noeud));
+  while(0 < nombre && nombre < TACHES_PAR_THREAD * nombre_threads){
+    unsigned int nombre_fils = 0;
+    for(unsigned int k = 0; k < nombre; k++) nombre_fils += niveau[k]->fils.nombre;
+    if(0 == nombre_fils) break;
+    noeud* suivant = malloc(nombre_fils * sizeof(noeud));
+    assert(NULL != suivant);
+    unsigned int j = 0;
+    for(unsigned int k = 0; k < nombre; k++){
+      faire(niveau[k]->val, partiels[0]);
+      if(0 < niveau[k]->fils.nombre) memcpy(suivant + j, niveau[k]->fils.cases, niveau[k]->fils.nombre * sizeof(noeud));
+      j += niveau[k]->fils.nombre;
+    }
+    assert(j == nombre_fils);
+    free(niveau);
+    niveau = suivant;
+    nombre = nombre_fils;
+  }
+  /* puis les sous-arbres du dernier niveau, par les threads (dont celui-ci) */
+  parcours_parallele pp;
+  pp.taches = niveau;
+  pp.nombre_taches = nombre;
+  pp.suivante = 0;
+  pthread_mutex_init(&(pp.verrou), NULL);
+  pp.faire = faire;
+  parcours_thread* threads = malloc(nombre_threads * sizeof(parcours_thread));
+  pthread_t* ids = malloc(nombre_threads * sizeof(pthread_t));
+  assert(NULL != threads && NULL != ids);
+  for(unsigned int t = 0; t < nombre_threads; t++){
+    threads[t].partage = &pp;
+    threads[t].partiel = partiels[t];
+  }
+  for(unsigned int t = 1; t < nombre_threads; t++){
+    int ret = pthread_create(&(ids[t]), NULL, parcours_thread_travailler, &(threads[t]));
+    assert(0 == ret);
+  }
+  parcours_thread_travailler(&(threads[0]));
+  for(unsigned int t = 1; t < nombre_threads; t++) pthread_join(ids[t], NULL);
+  pthread_mutex_destroy(&(pp.verrou));
+  free(ids);
+  free(threads);
+  free(niveau);
+  if(NULL != reduire){
+    for(unsigned int t = 0; t < nombre_threads; t++) reduire(partiels[t], total);
+  }
+}
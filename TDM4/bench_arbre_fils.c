@@ -0,0 +1,118 @@
+# define _POSIX_C_SOURCE 199309L
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# include <assert.h>
+
+# undef NDEBUG
+
+# include "arbre.h"
+
+/*!
+ * \file
+ * \brief Mesure des accès aux fils d'un nœud qui en a beaucoup,
+ * à lier avec arbre.o (bench_arbre_fils) ou arbre_tableau.o (bench_arbre_fils_tableau).
+ *
+ * Une racine reçoit nombre_fils fils, qui ont chacun un fils ; on mesure
+ * l'accès à chaque fils par son indice, le passage au dernier frère,
+ * le parcours de l'arbre et l'extraction des fils en commençant par le dernier.
+ * Les sommes affichées sont les mêmes pour les deux implémentations.
+ *
+ * usage : ./bench_arbre_fils [nombre_fils]
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+# define NOMBRE_FILS 4000
+
+static double maintenant(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+static void copier_int(void* val, void** pt){
+  *pt = malloc(sizeof(int));
+  assert(NULL != *pt);
+  memcpy(*pt, val, sizeof(int));
+}
+
+static void detruire_int(void** pt){
+  free(*pt);
+  *pt = NULL;
+}
+
+static bool est_egal_int(void* val1, void* val2){
+  return *(int*) val1 == *(int*) val2;
+}
+
+static void sommer(void* val, va_list vl){
+  long* somme = va_arg(vl, long*);
+  *somme += *(int*) val;
+}
+
+int main(int argc, char** argv){
+  const int nombre_fils = (argc > 1) ? atoi(argv[1]) : NOMBRE_FILS;
+  if(nombre_fils < 1){
+    fprintf(stderr,"usage : %s [nombre_fils]\n",argv[0]);
+    return 1;
+  }
+
+  double t0 = maintenant();
+  arbre a = arbre_creer(copier_int, detruire_int);
+  int val = -1;
+  arbre_inserer_racine(a, &val);
+  arbre_parcours p = arbre_creer_parcours(a);
+  /* les fils valent 0 .. nombre_fils-1, leur fils nombre_fils .. 2*nombre_fils-1 */
+  for(int i = 0; i < nombre_fils; i++){
+    val = i;
+    arbre_parcours_ajouter_fils_a_droite(p, &val);
+    arbre_parcours_aller_fils_droite(p);
+    val = nombre_fils + i;
+    arbre_parcours_ajouter_fils_a_droite(p, &val);
+    arbre_parcours_aller_pere(p);
+  }
+  double t1 = maintenant();
+
+  long somme_indices = 0;
+  for(int i = 0; i < nombre_fils; i++){
+    arbre_parcours_aller_fils(p, i);
+    somme_indices += *(int*) arbre_parcours_valeur(p);
+    arbre_parcours_aller_pere(p);
+  }
+  double t2 = maintenant();
+
+  long somme_derniers = 0;
+  for(int i = 0; i < nombre_fils; i++){
+    arbre_parcours_aller_fils_gauche(p);
+    arbre_parcours_aller_frere_droit(p);
+    somme_derniers += *(int*) arbre_parcours_valeur(p);
+    arbre_parcours_aller_pere(p);
+  }
+  arbre_parcours_detruire(p);
+  double t3 = maintenant();
+
+  long somme_parcours = 0;
+  arbre_parcourir(a, sommer, &somme_parcours);
+  double t4 = maintenant();
+
+  long somme_extraits = 0;
+  for(int i = nombre_fils - 1; i >= 0; i--){
+    arbre b = arbre_extraction(a, &i, est_egal_int);
+    assert(NULL != b);
+    arbre_parcourir(b, sommer, &somme_extraits);
+    arbre_detruire(&b);
+  }
+  arbre_detruire(&a);
+  double t5 = maintenant();
+
+  printf("%d fils\n", nombre_fils);
+  printf("  construction     %10.3f ms\n", (t1-t0)*1e3);
+  printf("  fils par indice  %10.3f ms  somme %ld\n", (t2-t1)*1e3, somme_indices);
+  printf("  dernier frère    %10.3f ms  somme %ld\n", (t3-t2)*1e3, somme_derniers);
+  printf("  parcours         %10.3f ms  somme %ld\n", (t4-t3)*1e3, somme_parcours);
+  printf("  extractions      %10.3f ms  somme %ld\n", (t5-t4)*1e3, somme_extraits);
+  return 0;
+}
@@ -0,0 +1,90 @@
+# define _POSIX_C_SOURCE 199309L
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# include <sys/resource.h>
+
+# include "arbre.h"
+# include "xml.h"
+
+/*!
+ * \file
+ * \brief Mesure de xml_construction_arbre sur de gros documents
+ * (par exemple ceux produits par bench_xml du TD8), du parcours de l'arbre obtenu
+ * par arbre_parcourir, de son écriture par xml_ecrire (dans un fichier temporaire) et de sa destruction.
+ *
+ * usage : ./bench_arbre_xml fichier.xml [fichier.xml ...]
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+static double maintenant(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+/* pic de mémoire résidente du processus, en Mo */
+static double pic_rss(void){
+  struct rusage ru;
+  getrusage(RUSAGE_SELF,&ru);
+  return ru.ru_maxrss/1024.0;
+}
+
+/* compte les balises */
+static void compter(void* val, va_list vl){
+  (void) val;
+  (* va_arg(vl, unsigned long*))++;
+}
+
+static bool mesurer(char* fichier){
+  FILE* f = fopen(fichier,"rb");
+  if(NULL == f) return false;
+  fseek(f,0,SEEK_END);
+  const double octets = ftell(f);
+  fclose(f);
+
+  double t0 = maintenant();
+  arbre a = xml_construction_arbre(fichier);
+  if(NULL == a) return false;
+  double t1 = maintenant();
+  unsigned long nb_balises = 0;
+  arbre_parcourir(a,compter,&nb_balises);
+  double t2 = maintenant();
+  FILE* sortie = tmpfile();
+  if(NULL == sortie){
+    arbre_detruire(&a);
+    return false;
+  }
+  xml_ecrire(a,sortie);
+  fflush(sortie);
+  double t3 = maintenant();
+  const double octets_ecrits = ftell(sortie);
+  fclose(sortie);
+  const double pic = pic_rss();
+  arbre_detruire(&a);
+  double t4 = maintenant();
+
+  printf("%s : %.1f Mo, %lu balises\n",fichier,octets*1e-6,nb_balises);
+  printf("  construction %12.3f ms  %8.1f Mo/s  pic RSS %.1f Mo\n",(t1-t0)*1e3,octets/(t1-t0)*1e-6,pic);
+  printf("  parcours     %12.3f ms  %8.1f Mo/s\n",(t2-t1)*1e3,octets/(t2-t1)*1e-6);
+  printf("  ecriture     %12.3f ms  %8.1f Mo/s  (%.1f Mo ecrits)\n",(t3-t2)*1e3,octets_ecrits/(t3-t2)*1e-6,octets_ecrits*1e-6);
+  printf("  destruction  %12.3f ms\n",(t4-t3)*1e3);
+  return true;
+}
+
+int main(int argc, char** argv){
+  if(argc<2){
+    fprintf(stderr,"usage : %s fichier.xml [fichier.xml ...]\n",argv[0]);
+    return 1;
+  }
+  int retour = 0;
+  for(int i=1;i<argc;i++){
+    if(!mesurer(argv[i])){
+      fprintf(stderr,"Lecture de %s impossible.\n",argv[i]);
+      retour = 1;
+    }
+  }
+  return retour;
+}
@@ -4,6 +4,11 @@
 #include <string.h>
 #include <assert.h>
 #include <ctype.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /*!
  * \file chaine.c
@@ -19,31 +24,80 @@
 
 chaine chaine_creer_vide(){
 	chaine ch=malloc(sizeof(struct chaine));
+	assert(NULL!=ch);
 	ch->taille=0;
-	ch->tab=NULL;
+	ch->capacite=CHAINE_TAILLE_COURTE;
+	ch->court[0]='\0';
+	ch->tab=ch->court;
+	ch->hache=0;
 	return ch;
 }
 
 chaine chaine_creer_char(char* c){
+	return chaine_creer_tableau(c,strlen(c));
+}
+
+/* la capacité est juste la taille (ou celle de court) : la plupart des chaines ne sont pas agrandies */
+chaine chaine_creer_tableau(char const* c, unsigned int taille){
 	chaine ch=chaine_creer_vide();
-	ch->tab=(char*)malloc(sizeof(char));
-	ch->taille=strlen(c);
- 	for(unsigned int i=0;i<=strlen(c)-1;i++){
-		(ch->tab)[i]=c[i];
-	}
+	chaine_reserver(ch,taille);
+	chaine_ajouter_tableau(ch,c,taille);
 	return ch;
 }
 
+/* tab finit toujours par '\0' pour chaine_afficher */
+void chaine_reserver(chaine ch, unsigned int capacite){
+	if(capacite<=ch->capacite) return;
+	if(ch->tab==ch->court){
+		ch->tab=(char*)malloc(sizeof(char)*(capacite+1));
+		assert(NULL!=ch->tab);
+		memcpy(ch->tab,ch->court,ch->taille+1);
+	}
+	else{
+		ch->tab=(char*)realloc(ch->tab,sizeof(char)*(capacite+1));
+		assert(NULL!=ch->tab);
+	}
+	ch->capacite=capacite;
+}
+
+/* double la capacité (au moins) s'il n'y a pas la place pour besoin caractères */
+static void chaine_agrandir(chaine ch, unsigned int besoin){
+	if(besoin<=ch->capacite) return;
+	unsigned int capacite= ch->capacite<8 ? 8 : 2*ch->capacite;
+	chaine_reserver(ch, besoin<capacite ? capacite : besoin);
+}
+
+void chaine_ajouter_tableau(chaine ch, char const* c, unsigned int taille){
+	chaine_agrandir(ch,ch->taille+taille);
+	memcpy(ch->tab+ch->taille,c,taille);
+	ch->taille+=taille;
+	(ch->tab)[ch->taille]='\0';
+	ch->hache=0;
+}
+
+void chaine_ajouter_char(chaine ch, const char c){
+	chaine_agrandir(ch,ch->taille+1);
+	(ch->tab)[ch->taille]=c;
+	ch->taille++;
+	(ch->tab)[ch->taille]='\0';
+	ch->hache=0;
+}
+
 void chaine_detruire(chaine* ch)
 {
-	free((*ch)->tab);
+	if((*ch)->tab!=(*ch)->court) free((*ch)->tab);
 	(*ch)->tab=NULL;
 	free(*ch);
 	(*ch) =NULL;
 }
 
 void chaine_afficher(FILE* f, chaine ch){
-	fprintf(f,"%s\n",(ch->tab));
+	chaine_ecrire(f,ch);
+	fputc('\n',f);
+}
+
+void chaine_ecrire(FILE* f, chaine ch){
+	if(0<ch->taille) fwrite(ch->tab,sizeof(char),ch->taille,f);
 }
 
 unsigned int chaine_extraire_taille(chaine ch)
@@ -57,21 +111,34 @@ bool chaine_est_vide(chaine ch)
 	return (ch->taille)==0;
 }
 
+/* FNV-1a, calculée au premier besoin puis gardée jusqu'à la prochaine modification (jamais 0) */
+static unsigned int chaine_hacher(chaine ch){
+	if(0==ch->hache){
+		unsigned int h=2166136261u;
+		for(unsigned int i=0;i<ch->taille;i++){
+			h^=(unsigned char)(ch->tab)[i];
+			h*=16777619u;
+		}
+		ch->hache= 0==h ? 1 : h;
+	}
+	return ch->hache;
+}
+
 bool chaine_est_egal(chaine ch1, chaine ch2){
-	if(ch1->tab==NULL || ch2->tab==NULL) return false;
 	if(ch1->taille!=ch2->taille) return false;
 	if(ch1->tab==ch2->tab) return true;
-	if(strcmp(ch1->tab,ch2->tab)==0) return true;
-	return false;
-	
+	if(chaine_hacher(ch1)!=chaine_hacher(ch2)) return false;
+	return 0==memcmp(ch1->tab,ch2->tab,ch1->taille);
 }
 
 void chaine_concatener(chaine ch1, chaine ch2){
-	if(ch1->tab==NULL) ch1->tab=(char*)malloc(sizeof(char));
-	if(ch2->tab==NULL) ch2->tab=(char*)malloc(sizeof(char));
-	ch1->taille=ch1->taille + ch2->taille;
-	ch1->tab=strcat(ch1->tab,ch2->tab);
-	
+	unsigned int taille=ch2->taille;
+	/* ch2 peut être ch1 : tab n'est lu qu'après l'agrandissement */
+	chaine_agrandir(ch1,ch1->taille+taille);
+	memcpy(ch1->tab+ch1->taille,ch2->tab,taille);
+	ch1->taille+=taille;
+	(ch1->tab)[ch1->taille]='\0';
+	ch1->hache=0;
 }
 
 char chaine_extraire_char_i(chaine ch, const unsigned int i){
@@ -80,45 +147,78 @@ char chaine_extraire_char_i(chaine ch, const unsigned int i){
 
 void chaine_modifier_char_i(chaine ch, const unsigned int i, const char c){
 	(ch->tab)[i]=c;
+	ch->hache=0;
 }
 
 chaine chaine_copier(chaine ch1){
-	chaine ch=chaine_creer_vide();
-	(ch->taille)=(ch1->taille);
-	ch->tab=(char *)malloc(sizeof(char));
-	strcpy(ch->tab,ch1->tab);
-	return ch;
+	return chaine_creer_tableau(ch1->tab,ch1->taille);
 }
 
-void chaine_en_minuscules(chaine ch){
-	for(unsigned int i=0;i<ch->taille;i++){
-		(ch->tab)[i]=tolower((ch->tab)[i]);
+/*
+ * Changement de casse des lettres ASCII (les autres caractères ne changent pas, comme tolower/toupper dans la locale "C") :
+ * par 32 caractères (AVX2) ou 16 (SSE2) quand le compilateur les propose, les derniers un par un.
+ * Les lettres de [debut,fin] sont changées par l'ajout (ou retrait) de 'a'-'A'.
+ */
+static void chaine_changer_casse(chaine ch, const char debut, const char fin, const int ecart){
+	unsigned int i=0;
+	char* t=ch->tab;
+#if defined(__AVX2__)
+	{
+		__m256i const avant=_mm256_set1_epi8(debut-1);
+		__m256i const apres=_mm256_set1_epi8(fin+1);
+		__m256i const decalage=_mm256_set1_epi8(ecart);
+		for(;i+32<=ch->taille;i+=32){
+			__m256i v=_mm256_loadu_si256((__m256i const*)(t+i));
+			/* comparaisons signées : les octets >= 0x80 sont négatifs, donc hors de l'intervalle */
+			__m256i lettre=_mm256_and_si256(_mm256_cmpgt_epi8(v,avant),_mm256_cmpgt_epi8(apres,v));
+			v=_mm256_add_epi8(v,_mm256_and_si256(lettre,decalage));
+			_mm256_storeu_si256((__m256i*)(t+i),v);
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	{
+		__m128i const avant=_mm_set1_epi8(debut-1);
+		__m128i const apres=_mm_set1_epi8(fin+1);
+		__m128i const decalage=_mm_set1_epi8(ecart);
+		for(;i+16<=ch->taille;i+=16){
+			__m128i v=_mm_loadu_si128((__m128i const*)(t+i));
+			__m128i lettre=_mm_and_si128(_mm_cmpgt_epi8(v,avant),_mm_cmpgt_epi8(apres,v));
+			v=_mm_add_epi8(v,_mm_and_si128(lettre,decalage));
+			_mm_storeu_si128((__m128i*)(t+i),v);
+		}
+	}
+#endif
+	for(;i<ch->taille;i++){
+		if(debut<=t[i] && t[i]<=fin) t[i]+=ecart;
 	}
+	ch->hache=0;
+}
+
+void chaine_en_minuscules(chaine ch){
+	chaine_changer_casse(ch,'A','Z','a'-'A');
 }
 
 void chaine_en_majuscules(chaine ch){
-	for(unsigned int i=0;i<ch->taille;i++){
-		(ch->tab)[i]=toupper((ch->tab)[i]);
-	}
+	chaine_changer_casse(ch,'a','z','A'-'a');
 }
 
+/* memchr est vectorisé par la bibliothèque C */
 bool chaine_appartenir(const char c, chaine ch, int* i){
-	for(unsigned int j=0;j<ch->taille;j++){
-		if((ch->tab)[j]==c){
-			*i=j;
-			return true ;
-		}
-
-	}
-	return false;
+	if(0==ch->taille) return false;
+	char const* trouve=memchr(ch->tab,c,ch->taille);
+	if(NULL==trouve) return false;
+	*i=trouve-ch->tab;
+	return true;
 }
 
 chaine chaine_lire(FILE* f, unsigned int taille){
 	chaine ch=chaine_creer_vide();
-	ch->taille=taille;
-	do{
-		(ch->tab)[taille]= fgetc(f); 
-            	taille--;
-        }while(taille>0);
+	chaine_reserver(ch,taille);
+	for(unsigned int i=0;i<taille;i++){
+		int c=fgetc(f);
+		if(EOF==c) break;
+		chaine_ajouter_char(ch,c);
+	}
 	return ch;
 }
\ No newline at end of file
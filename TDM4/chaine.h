@@ -19,18 +19,29 @@
  * Cette struture permet de créer une chaîne de caractères comme un simple tableau.
  * La taille fait partie de la structure et permet de la connaître sans calcul 
  * et de se passer d'un caractère de fin de chaîne.
- * cette structure est cachée et ne peut pas être manipulée directement.
+ * La capacité du tableau grandit géométriquement (elle double) quand on ajoute des caractères,
+ * ajouter n caractères un par un ne coûte donc que O(n) en tout.
+ * Les chaines courtes (comme les noms des balises) sont dans la structure elle-même (une seule allocation),
+ * et une valeur de hachage gardée en mémoire permet à chaine_est_egal de rejeter la plupart des chaines différentes sans les parcourir.
+ * cette structure est cachée et ne peut pas être manipulée directement
+ * (en particulier il ne faut pas modifier tab sans passer par les fonctions, la valeur de hachage ne serait plus juste).
  */
 typedef struct chaine* chaine;
 
+/*! Nombre de caractères que peut contenir une chaine sans allouer de tableau. */
+#define CHAINE_TAILLE_COURTE 15
+
 struct chaine {
   unsigned int taille;
-  char* tab;
+  unsigned int capacite; /* nombre de caractères que tab peut recevoir sans réallocation ('\0' final en plus) */
+  char* tab; /* court ou un tableau alloué */
+  unsigned int hache; /* 0 : pas encore calculée depuis la dernière modification */
+  char court[CHAINE_TAILLE_COURTE+1];
 };
 
 /*!
  * Pour créer une chaine 
- * La chaine vide est de taille 0 et tab pointe sur NULL
+ * La chaine vide est de taille 0 (tab pointe sur un '\0')
  * \return une chaine vide
  */
 chaine chaine_creer_vide();
@@ -41,6 +52,12 @@ chaine chaine_creer_vide();
  */
 chaine chaine_creer_char(char* c);
 
+/*!
+ * Pour créer une chaine à partir des taille premiers caractères de c (qui n'a pas à finir par '\0')
+ * \return une chaine de taille taille
+ */
+chaine chaine_creer_tableau(char const* c, unsigned int taille);
+
 /*!
  * Pour désallouer correctement la mémoire
  * \param ch la chaine à détruire 
@@ -55,6 +72,13 @@ void chaine_detruire(chaine* ch);
  */
 void chaine_afficher(FILE* f,chaine ch);
 
+/*!
+ * Comme chaine_afficher, sans passage à la ligne.
+ * \param f flux où écrire.
+ * \param ch chaine à écrire
+ */
+void chaine_ecrire(FILE* f,chaine ch);
+
 /*!
  * Renvoie la taille de la chaîne de caractères
  * \param ch chaine dont on demande la taille
@@ -71,6 +95,7 @@ bool chaine_est_vide(chaine ch);
 
 /*!
  * Teste si deux chaines sont identiques
+ * (les tailles puis les valeurs de hachage sont comparées d'abord, les caractères seulement si elles sont égales)
  * \param ch1 première chaîne
  * \param ch2 deuxième chaîne
  * \return vrai si ch1 et ch2 sont identiques
@@ -84,6 +109,28 @@ bool chaine_est_egal(chaine ch1, chaine ch2);
  */
 void chaine_concatener(chaine ch1, chaine ch2);
 
+/*!
+ * Prévoit la place pour que la chaine puisse contenir capacite caractères sans réallocation
+ * \param ch la chaine à agrandir
+ * \param capacite le nombre de caractères prévus (rien n'est fait s'il y a déjà la place)
+ */
+void chaine_reserver(chaine ch, unsigned int capacite);
+
+/*!
+ * Ajoute des caractères à la fin d'une chaine (en temps amorti proportionnel à leur nombre)
+ * \param ch la chaine à compléter
+ * \param c les caractères à ajouter (pas forcément finis par '\0')
+ * \param taille le nombre de caractères à ajouter
+ */
+void chaine_ajouter_tableau(chaine ch, char const* c, unsigned int taille);
+
+/*!
+ * Ajoute un caractère à la fin d'une chaine (en temps amorti constant)
+ * \param ch la chaine à compléter
+ * \param c le caractère à ajouter
+ */
+void chaine_ajouter_char(chaine ch, const char c);
+
 /*! 
  * Renvoie le caractère à la position i de la chaîne (on commence à compter à 0)
  * \param ch chaine pour laquelle on recherche le ième caractère
@@ -109,6 +156,7 @@ chaine chaine_copier(chaine ch1);
 
 /*! 
  * Convertit en minuscules
+ * (seulement les lettres ASCII, par blocs de 16 ou 32 caractères avec SSE2 ou AVX2)
  * \param ch la chaine à convertir
  * \return ch converti
  */
@@ -116,6 +164,7 @@ void chaine_en_minuscules(chaine ch);
 
 /*!
  * Convertit en majuscules
+ * (seulement les lettres ASCII, par blocs de 16 ou 32 caractères avec SSE2 ou AVX2)
  * \param ch la chaine à convertir
  * \return ch converti
  */
@@ -0,0 +1,186 @@
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+
+# undef NDEBUG
+
+# include "arbre.h"
+
+# define NOMBRE_THREADS_MAX 4
+
+# define PROFONDEUR 8
+
+/*!
+ * \file
+ * \brief Test de l'ordre préfixe de arbre_parcourir quand il faut remonter de plusieurs niveaux,
+ * à lier avec arbre.o (test_arbre_parcours) ou arbre_tableau.o (test_arbre_parcours_tableau).
+ *
+ * Après un dernier fils profond, le parcours doit reprendre au frère du premier ancêtre qui en a un
+ * (et pas seulement au frère du père), et se terminer après le dernier nœud, même pour une racine seule.
+ * arbre_parcourir_parallele doit trouver, avec 1 à NOMBRE_THREADS_MAX threads, le même nombre de nœuds
+ * et la même somme des valeurs que arbre_parcourir, sur un arbre de plusieurs niveaux.
+ * Le résultat est écrit dans test_arbre_parcours_out.txt, à comparer à test_arbre_parcours_out_a_obtenir.txt.
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+static void copier_int(void* val, void** pt){
+  *pt = malloc(sizeof(int));
+  assert(NULL != *pt);
+  memcpy(*pt, val, sizeof(int));
+}
+
+static void detruire_int(void** pt){
+  free(*pt);
+  *pt = NULL;
+}
+
+static bool est_egal_int(void* val1, void* val2){
+  return *(int*) val1 == *(int*) val2;
+}
+
+static void afficher_compter(void* val, va_list vl){
+  FILE* f = va_arg(vl, FILE*);
+  int* nombre = va_arg(vl, int*);
+  fprintf(f, " %d", *(int*) val);
+  (*nombre)++;
+}
+
+static void afficher_parcours(FILE* f, char const * const titre, arbre a){
+  int nombre = 0;
+  fprintf(f, "%s :", titre);
+  arbre_parcourir(a, afficher_compter, f, &nombre);
+  fprintf(f, " (%d noeuds)\n", nombre);
+}
+
+typedef struct {
+  long nombre;
+  long somme;
+} compte;
+
+static void compter(void* val, va_list vl){
+  compte* c = va_arg(vl, compte*);
+  c->nombre++;
+  c->somme += *(int*) val;
+}
+
+static void compter_partiel(void* val, void* partiel){
+  compte* c = partiel;
+  c->nombre++;
+  c->somme += *(int*) val;
+}
+
+static void reduire_compte(void* partiel, void* total){
+  compte* c = partiel;
+  compte* t = total;
+  t->nombre += c->nombre;
+  t->somme += c->somme;
+}
+
+static void comparer_parallele(FILE* f, char const * const titre, arbre a){
+  compte reference = { 0, 0 };
+  arbre_parcourir(a, compter, &reference);
+  fprintf(f, "%s : %ld noeuds, somme %ld\n", titre, reference.nombre, reference.somme);
+  for(unsigned int nombre_threads = 1; nombre_threads <= NOMBRE_THREADS_MAX; nombre_threads++){
+    compte comptes[NOMBRE_THREADS_MAX];
+    void* partiels[NOMBRE_THREADS_MAX];
+    for(unsigned int i = 0; i < nombre_threads; i++){
+      comptes[i] = (compte) { 0, 0 };
+      partiels[i] = &comptes[i];
+    }
+    compte total = { 0, 0 };
+    arbre_parcourir_parallele(a, nombre_threads, compter_partiel, partiels, reduire_compte, &total);
+    const bool identique = total.nombre == reference.nombre && total.somme == reference.somme;
+    fprintf(f, "  parallele, %u threads : %s\n", nombre_threads, identique ? "identique" : "DIFFERENT");
+  }
+}
+
+/* sous le nœud courant, 1 à 4 fils selon la valeur, sur profondeur niveaux ; *val est la dernière valeur donnée */
+static void construire(arbre_parcours p, int profondeur, int* val){
+  if(0 == profondeur) return;
+  const int nombre_fils = 1 + *val % 4;
+  for(int i = 0; i < nombre_fils; i++){
+    (*val)++;
+    arbre_parcours_ajouter_fils_a_droite(p, val);
+    arbre_parcours_aller_fils_droite(p);
+    construire(p, profondeur - 1, val);
+    arbre_parcours_aller_pere(p);
+  }
+}
+
+/* ajoute au nœud courant un fils à droite de valeur val et y va */
+static void descendre(arbre_parcours p, int val){
+  arbre_parcours_ajouter_fils_a_droite(p, &val);
+  arbre_parcours_aller_fils_droite(p);
+}
+
+int main(void){
+  FILE* f_out = fopen("test_arbre_parcours_out.txt", "w");
+  assert(NULL != f_out);
+  int val = 0;
+  arbre a = arbre_creer(copier_int, detruire_int);
+  arbre_inserer_racine(a, &val);
+  afficher_parcours(f_out, "racine seule", a);
+
+  /*
+   * 0
+   * ├ 1 ─ 2 ─ 3 ─ 4   (chacun dernier fils du précédent)
+   * └ 5
+   *   └ 6
+   *     ├ 7
+   *     └ 8 ─ 9
+   * 10 (frère de la racine)
+   */
+  arbre_parcours p = arbre_creer_parcours(a);
+  descendre(p, 1);
+  descendre(p, 2);
+  descendre(p, 3);
+  descendre(p, 4);
+  for(int i = 0; i < 4; i++) arbre_parcours_aller_pere(p);
+  descendre(p, 5);
+  descendre(p, 6);
+  val = 7;
+  arbre_parcours_ajouter_fils_a_droite(p, &val);
+  descendre(p, 8);
+  descendre(p, 9);
+  for(int i = 0; i < 4; i++) arbre_parcours_aller_pere(p);
+  val = 10;
+  arbre_parcours_ajouter_frere_a_droite(p, &val);
+  arbre_parcours_detruire(p);
+  afficher_parcours(f_out, "derniers fils profonds", a);
+  comparer_parallele(f_out, "derniers fils profonds", a);
+
+  val = 5;
+  arbre b = arbre_extraction(a, &val, est_egal_int);
+  assert(NULL != b);
+  afficher_parcours(f_out, "sous-arbre extrait (5)", b);
+  afficher_parcours(f_out, "sans le sous-arbre de 5", a);
+  arbre_detruire(&b);
+
+  val = 2;
+  b = arbre_extraction(a, &val, est_egal_int);
+  assert(NULL != b);
+  afficher_parcours(f_out, "sous-arbre extrait (2)", b);
+  afficher_parcours(f_out, "sans le sous-arbre de 2", a);
+  arbre_detruire(&b);
+  arbre_detruire(&a);
+
+  /* deux racines sœurs de PROFONDEUR niveaux */
+  val = 0;
+  a = arbre_creer(copier_int, detruire_int);
+  arbre_inserer_racine(a, &val);
+  comparer_parallele(f_out, "racine seule", a);
+  p = arbre_creer_parcours(a);
+  construire(p, PROFONDEUR, &val);
+  val++;
+  arbre_parcours_ajouter_frere_a_droite(p, &val);
+  arbre_parcours_aller_frere_droit(p);
+  construire(p, PROFONDEUR, &val);
+  arbre_parcours_detruire(p);
+  comparer_parallele(f_out, "plusieurs niveaux", a);
+  arbre_detruire(&a);
+  fclose(f_out);
+  return 0;
+}
@@ -20,26 +20,26 @@ struct balise_struct {
 
 
 
-balise balise_creer(char const * st){
+/*!
+ * Pour créer une balise à partir de son type et de son nom (qui n'a pas à finir par '\0')
+ * \param nom le début du nom
+ * \param taille le nombre de caractères du nom
+ */
+static balise balise_creer_nom(bool est_fermante, char const * nom, unsigned int taille){
   balise b = malloc(sizeof(struct balise_struct));
-  int i=1,j=0;
-  if('<'!=st[0]){
-    char* c = malloc(sizeof(char)*strlen(st));
-    strcpy(c,st);
-    b->nom=chaine_creer_char(c);
-    return b;
-  }
-  else if('/' ==  st[1]){
-    b->type = fermante; 
-  }else b->type = ouvrante; 
-  char* c = malloc(sizeof(char)*strlen(st));
-  for(;st[i]!='>';i++,j++){
-    c[j]=st[i];
-  }
-  c[j+1]=0;
-  b->nom = chaine_creer_char(c);
+  assert(NULL != b);
+  b->type = est_fermante ? fermante : ouvrante;
+  b->nom = chaine_creer_tableau(nom,taille);
   return b;
-  
+}
+
+
+balise balise_creer(char const * st){
+  if('<'!=st[0]) return balise_creer_nom(false,st,strlen(st));
+  bool est_fermante = '/' == st[1];
+  char const * nom = st + ( est_fermante ? 2 : 1 );
+  char const * fin = strchr(nom,'>');
+  return balise_creer_nom(est_fermante,nom, NULL==fin ? strlen(nom) : (unsigned int)(fin-nom));
 }
 
 
@@ -73,7 +73,7 @@ void balise_afficher (balise x, FILE* f) {
  */
 static void copier_balise(void* val, void** ptr){
   balise s=(balise) val;
-  balise n= balise_creer(s->nom->tab);
+  balise n= balise_creer_nom(balise_est_fermante(s),s->nom->tab,s->nom->taille);
   *ptr=n;
 }
 
@@ -97,61 +97,110 @@ bool est_egal_balise(void* val1, void* val2){
 
 
 /*!
- * Pour supprimer les espaces d'une chaine de caractères
- * \param st la chaine (au sens C) cible
- * \return une chaine (au sens C) sans espace
+ * Pour lire tout un fichier en une fois
+ * \param source le nom du fichier
+ * \param taille pour renvoyer le nombre de caractères lus
+ * \return les caractères du fichier (à libérer), NULL si le fichier ne peut pas être lu
  */
-static char* trim (char* st) {
-  char* s = malloc(sizeof(char)*strlen(st));
-  int j=0;
-  for(unsigned int i=0;i<strlen(st);i++){
-    if(st[i]!=' '){
-      s[j]=st[i];
-      j++;
-    }
+static char* lire_fichier(char const * source, size_t * taille){
+  FILE * f_in = fopen ( source , "rb" );
+  if(NULL == f_in) return NULL;
+  fseek(f_in,0,SEEK_END);
+  long fin = ftell(f_in);
+  fseek(f_in,0,SEEK_SET);
+  char * texte = NULL;
+  if(0 <= fin){
+    texte = malloc(fin+1);
+    assert(NULL != texte);
+    *taille = fread(texte,1,fin,f_in);
   }
-  return s;
+  fclose(f_in);
+  return texte;
 }
 
 
+/*
+ * Le fichier est lu en une fois puis parcouru une seule fois :
+ * chaque balise ouvrante devient une balise (créée une fois, à partir du nom dans le texte lu)
+ * donnée à l'arbre sans copie ; une balise fermante fait seulement remonter au père.
+ * Les caractères hors des balises (espaces, passages à la ligne) sont ignorés.
+ */
 arbre xml_construction_arbre(char* source){
-  
-  FILE * f_in = fopen ( source , "r" );
+  size_t taille = 0;
+  char * texte = lire_fichier(source,&taille);
+  if(NULL == texte) return NULL;
   //creation de l'arbre
   arbre a = arbre_creer(copier_balise,detruire_balise);
-
-  //on crée la racine de l'arbre
-  char* s = malloc(sizeof(char)*20);
-  fgets(s,20,f_in); 
-  s = trim(s);
-  balise b = balise_creer(s);
-  free(s);
-  s=NULL;
-  arbre_inserer_racine(a,b);
-  detruire_balise(&b);
-  
-  //on crée l'arbre de parcours
-  arbre_parcours p = arbre_creer_parcours(a);
-  
-  while(!feof(f_in)){
-    char* c = malloc(sizeof(char)*20);
-    fgets(c,20,f_in);
-    c = trim(c);
-    printf("%s",c);
-    balise b = balise_creer(c);
-    if(b->type == ouvrante){
-      arbre_parcours_ajouter_fils_a_droite(p,b);
-      arbre_parcours_aller_fils_droite(p);
+  arbre_parcours p = NULL;
+  char const * c = texte;
+  char const * const fin = texte + taille;
+  while(c < fin){
+    c = memchr(c,'<',fin-c);
+    if(NULL == c) break;
+    c++;
+    bool est_fermante = c < fin && '/' == *c;
+    if(est_fermante) c++;
+    char const * nom = c;
+    while(c < fin && '>' != *c && !isspace((unsigned char) *c)) c++;
+    unsigned int taille_nom = c - nom;
+    if(c >= fin) break;
+    c = memchr(c,'>',fin-c);
+    if(NULL == c) break;
+    c++;
+    if(!est_fermante){
+      balise b = balise_creer_nom(false,nom,taille_nom);
+      if(NULL == p){
+	//on crée la racine de l'arbre et l'arbre de parcours
+	arbre_inserer_racine_sans_copie(a,b);
+	p = arbre_creer_parcours(a);
+      }else{
+	arbre_parcours_ajouter_fils_a_droite_sans_copie(p,b);
+	arbre_parcours_aller_fils_droite(p);
+      }
     }else{
-      if(arbre_parcours_a_pere(p)) arbre_parcours_aller_pere(p);
+      if(NULL != p && arbre_parcours_a_pere(p)) arbre_parcours_aller_pere(p);
       else break;
     } 
-    free(c);
-    c=NULL;
-    detruire_balise(&b);
   }
-  arbre_parcours_detruire(p);
-  fclose(f_in);
+  if(NULL != p) arbre_parcours_detruire(p);
+  free(texte);
   return a;
 }
 
+
+/*!
+ * Écrit la balise courante du parcours, ouvrante ou fermante
+ */
+static void ecrire_balise(arbre_parcours p, bool fermante, FILE* f){
+  balise b = (balise) arbre_parcours_valeur(p);
+  fputs(fermante ? "</" : "<", f);
+  chaine_ecrire(f,b->nom);
+  fputs(">\n", f);
+}
+
+/*
+ * Ordre préfixe de arbre_parcours_suivant. Après un nœud sans fils, on referme les balises
+ * en remontant jusqu'au premier ancêtre qui a un frère droit, puis on redescend par les
+ * derniers fils (en temps constant) jusqu'à ce nœud pour que suivant passe à ce frère :
+ * chaque nœud est remonté et redescendu une seule fois, le coût reste linéaire.
+ */
+void xml_ecrire(arbre a, FILE* f){
+  assert(NULL != a);
+  assert(NULL != f);
+  arbre_parcours p = arbre_creer_parcours(a);
+  while(! arbre_parcours_est_fini(p)){
+    ecrire_balise(p,false,f);
+    if(! arbre_parcours_a_fils(p)){
+      ecrire_balise(p,true,f);
+      unsigned int remontees = 0;
+      while(! arbre_parcours_a_frere_droit(p) && arbre_parcours_a_pere(p)){
+        arbre_parcours_aller_pere(p);
+        ecrire_balise(p,true,f);
+        remontees++;
+      }
+      for(; 0 < remontees; remontees--) arbre_parcours_aller_fils_droite(p);
+    }
+    arbre_parcours_suivant(p);
+  }
+  arbre_parcours_detruire(p);
+}
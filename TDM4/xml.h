@@ -71,10 +71,20 @@ bool est_egal_balise(void* val1 , void* val2);
 /*!
  * Pour construire un arbre en lisant un fichier XML simple ne contenant qu'une série de balises 
  * on supposera ce fichier bien formé au sens XML. 
+ * Le fichier est lu en une fois, le coût est linéaire en sa taille.
  * \param source le nom du fichier contenant le document XML bien formé
- * \return un arbre "XML"
+ * \return un arbre "XML", NULL si le fichier ne peut pas être lu
  */
 
 arbre xml_construction_arbre(char* source); 
 
+/*!
+ * Écrit un arbre "XML" dans le format lu par xml_construction_arbre,
+ * une balise par ligne, sans indentation.
+ * L'arbre est parcouru sans récursion, le coût est linéaire même pour un document très profond.
+ * \param a l'arbre à écrire
+ * \param f le flux de sortie
+ */
+void xml_ecrire(arbre a, FILE* f);
+
 # endif
@@ -0,0 +1,137 @@
+/*! \file
+ * \brief This file times the operations on matrices, for sizes from 64 to 4096 (or less).
+ *
+ * usage : ./bench_matrix [max_size]
+ *
+ * Each operation is repeated on \c init_alea matrices till it takes \c min_seconds ,
+ * then its speed is given in GFLOP/s and in bytes/s.
+ * The bytes are those of the operands, read and written once each
+ * (the least traffic with the memory, whatever the caches).
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <sys/time.h>
+# include <stdlib.h> // atoi
+
+# include <iomanip>
+# include <iostream>
+
+# include "factorize_lu.hpp"
+# include "matrix.hpp"
+# include "vector.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+using namespace std ; 
+
+
+namespace {
+
+  /*! Least time of a measure, in seconds. */
+  double const min_seconds = 0.2 ;
+
+  /*! Current time, in seconds. */
+  double now () {
+    timeval t ;
+    gettimeofday ( & t , 0 ) ;
+    return t . tv_sec + 1e-6 * t . tv_usec ;
+  }
+
+  /*! Print a line of result: \c flop floating point operations and \c bytes bytes done \c runs times in \c seconds . */
+  void report ( char const * const name ,
+		unsigned int const n ,
+		double const flop ,
+		double const bytes ,
+		unsigned int const runs ,
+		double const seconds ) {
+    double const s = seconds / runs ;
+    cout << setw ( 16 ) << left << name << right
+	 << setw ( 6 ) << n
+	 << setw ( 8 ) << runs
+	 << fixed << setprecision ( 3 )
+	 << setw ( 12 ) << s * 1e3 << " ms"
+	 << setw ( 10 ) << flop / s * 1e-9 << " GFLOP/s"
+	 << setw ( 10 ) << bytes / s * 1e-9 << " GB/s" << endl ;
+  }
+
+
+  /*! Time the operations on matrices of size \c n by \c n . */
+  void bench ( unsigned int const n ) {
+    double const n2 = double ( n ) * n ;
+    double const n3 = n2 * n ;
+    double const f = sizeof ( float ) ;
+    Matrix a ( n , n ) ;
+    a . init_alea () ;
+    Matrix b ( n , n ) ;
+    b . init_alea () ;
+    Vector v ( n ) ;
+    v . init_alea () ;
+
+    unsigned int runs = 0 ;
+    double begin = now () ;
+    do {
+      Matrix const c = a * b ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "operator*" , n , 2 * n3 , 3 * n2 * f , runs , now () - begin ) ;
+
+    runs = 0 ;
+    begin = now () ;
+    do {
+      Matrix const c = a + b ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "operator+" , n , n2 , 3 * n2 * f , runs , now () - begin ) ;
+
+    runs = 0 ;
+    begin = now () ;
+    do {
+      Vector const w = a * v ;
+      runs ++ ;
+    } while ( now () - begin < min_seconds ) ;
+    report ( "matrix*vector" , n , 2 * n2 , ( n2 + 2 * n ) * f , runs , now () - begin ) ;
+
+    // the copies are not timed, a diagonal of n keeps the pivots away from zero
+    for ( unsigned int i = 0 ; i < n ; i ++ ) a ( i , i ) += n ;
+    runs = 0 ;
+    double seconds = 0 ;
+    do {
+      Matrix m ( a ) ;
+      double const start = now () ;
+      factorize_lu ( m ) ;
+      seconds += now () - start ;
+      runs ++ ;
+    } while ( seconds < min_seconds ) ;
+    report ( "factorize_lu" , n , 2 * n3 / 3 , 2 * n2 * f , runs , seconds ) ;
+
+    runs = 0 ;
+    seconds = 0 ;
+    do {
+      Matrix m ( a ) ;
+      double const start = now () ;
+      factorize_lu_pivoting ( m ) ;
+      seconds += now () - start ;
+      runs ++ ;
+    } while ( seconds < min_seconds ) ;
+    report ( "lu_pivoting" , n , 2 * n3 / 3 , 2 * n2 * f , runs , seconds ) ;
+  }
+
+}
+
+
+int main ( int argc ,
+	   char const * argv [] ) {
+  unsigned int const max_size = ( 1 < argc ) ? atoi ( argv [ 1 ] ) : 4096 ;
+  cout << setw ( 16 ) << left << "operation" << right
+       << setw ( 6 ) << "size" << setw ( 8 ) << "runs"
+       << setw ( 15 ) << "time" << setw ( 18 ) << "speed" << setw ( 15 ) << "traffic" << endl ;
+  for ( unsigned int n = 64 ; n <= max_size ; n *= 2 ) {
+    bench ( n ) ;
+  }
+  return 0 ; 
+}
@@ -0,0 +1,167 @@
+# include <fcntl.h>    // open
+# include <sys/mman.h> // mmap
+# include <sys/stat.h> // fstat
+# include <unistd.h>   // close
+
+# include <cstring>
+# include <fstream>
+# include <iostream>
+
+# include "binary_file.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+using namespace std ;
+
+
+namespace {
+
+  char const magic [ 8 ] = "PASDMAT" ;
+
+  /*! Written as is, read the other way round on a machine with the other byte order. */
+  unsigned int const binary_byte_order = 0x01020304 ;
+
+  /*! The header fits exactly in the alignment. */
+  char header_fits [ ( sizeof ( Binary_Header ) == simd_alignment ) ? 1 : -1 ] ;
+
+  /*! Size of the coefficients of a header. */
+  size_t payload ( Binary_Header const & h ) {
+    return size_t ( h . line_nbr ) * h . column_nbr * h . coefficient_size ;
+  }
+
+  /*! Check a header read from a file of \c file_size bytes. */
+  bool check ( char const * const file_name ,
+	       Binary_Header const & h ,
+	       unsigned int const coefficient_size ,
+	       size_t const file_size ) {
+    if ( 0 != memcmp ( h . magic , magic , sizeof ( magic ) ) ) {
+      cerr << "ERROR " << file_name << " is not a binary matrix" << endl ;
+      return false ;
+    }
+    if ( binary_byte_order != h . byte_order ) {
+      cerr << "ERROR " << file_name << " was written with another byte order" << endl ;
+      return false ;
+    }
+    if ( coefficient_size != h . coefficient_size ) {
+      cerr << "ERROR " << file_name << " has coefficients of " << h . coefficient_size
+	   << " bytes instead of " << coefficient_size << endl ;
+      return false ;
+    }
+    if ( sizeof ( Binary_Header ) + payload ( h ) != file_size ) {
+      cerr << "ERROR " << file_name << " has not the size of its header" << endl ;
+      return false ;
+    }
+    return true ;
+  }
+
+}
+
+
+bool binary_save ( char const * const file_name ,
+		   unsigned int const coefficient_size ,
+		   unsigned int const line_nbr ,
+		   unsigned int const column_nbr ,
+		   void const * const coefficients ) {
+  ( void ) header_fits ;
+  Binary_Header h ;
+  memset ( & h , 0 , sizeof ( h ) ) ;
+  memcpy ( h . magic , magic , sizeof ( magic ) ) ;
+  h . byte_order = binary_byte_order ;
+  h . coefficient_size = coefficient_size ;
+  h . line_nbr = line_nbr ;
+  h . column_nbr = column_nbr ;
+  ofstream file ( file_name , ios :: out | ios :: binary | ios :: trunc ) ;
+  file . write ( reinterpret_cast < char const * > ( & h ) , sizeof ( h ) ) ;
+  if ( 0 < payload ( h ) ) {
+    file . write ( static_cast < char const * > ( coefficients ) , payload ( h ) ) ;
+  }
+  file . close () ;
+  if ( ! file ) {
+    cerr << "ERROR cannot write " << file_name << endl ;
+    return false ;
+  }
+  return true ;
+}
+
+
+bool binary_load ( char const * const file_name ,
+		   unsigned int const coefficient_size ,
+		   unsigned int & line_nbr ,
+		   unsigned int & column_nbr ,
+		   void * & coefficients ) {
+  ifstream file ( file_name , ios :: in | ios :: binary | ios :: ate ) ;
+  if ( ! file ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    return false ;
+  }
+  size_t const file_size = file . tellg () ;
+  file . seekg ( 0 ) ;
+  Binary_Header h ;
+  if ( ( file_size < sizeof ( h ) )
+       || ( ! file . read ( reinterpret_cast < char * > ( & h ) , sizeof ( h ) ) )
+       || ( ! check ( file_name , h , coefficient_size , file_size ) ) ) {
+    if ( file_size < sizeof ( h ) ) cerr << "ERROR " << file_name << " is not a binary matrix" << endl ;
+    return false ;
+  }
+  void * const buffer = simd_allocate ( payload ( h ) ) ;
+  if ( ( 0 < payload ( h ) ) && ( ! file . read ( static_cast < char * > ( buffer ) , payload ( h ) ) ) ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    simd_free ( buffer ) ;
+    return false ;
+  }
+  line_nbr = h . line_nbr ;
+  column_nbr = h . column_nbr ;
+  coefficients = buffer ;
+  return true ;
+}
+
+
+bool binary_map ( char const * const file_name ,
+		  unsigned int const coefficient_size ,
+		  bool const writable ,
+		  unsigned int & line_nbr ,
+		  unsigned int & column_nbr ,
+		  void * & mapping ,
+		  size_t & length ) {
+  int const fd = open ( file_name , writable ? O_RDWR : O_RDONLY ) ;
+  struct stat s ;
+  if ( ( fd < 0 ) || ( 0 != fstat ( fd , & s ) ) ) {
+    cerr << "ERROR cannot read " << file_name << endl ;
+    if ( 0 <= fd ) close ( fd ) ;
+    return false ;
+  }
+  size_t const file_size = s . st_size ;
+  if ( file_size < sizeof ( Binary_Header ) ) {
+    cerr << "ERROR " << file_name << " is not a binary matrix" << endl ;
+    close ( fd ) ;
+    return false ;
+  }
+  // private pages are shared with the other processes till they are written
+  void * const m = mmap ( NULL , file_size , PROT_READ | PROT_WRITE ,
+			  writable ? MAP_SHARED : MAP_PRIVATE , fd , 0 ) ;
+  close ( fd ) ; // the mapping stays
+  if ( MAP_FAILED == m ) {
+    cerr << "ERROR cannot map " << file_name << endl ;
+    return false ;
+  }
+  Binary_Header const & h = * static_cast < Binary_Header const * > ( m ) ;
+  if ( ! check ( file_name , h , coefficient_size , file_size ) ) {
+    munmap ( m , file_size ) ;
+    return false ;
+  }
+  line_nbr = h . line_nbr ;
+  column_nbr = h . column_nbr ;
+  mapping = m ;
+  length = file_size ;
+  return true ;
+}
+
+
+void binary_unmap ( void * const mapping ,
+		    size_t const length ) {
+  int const ret = munmap ( mapping , length ) ;
+  assert ( 0 == ret ) ;
+}
@@ -0,0 +1,82 @@
+# ifndef __BINARY_FILE_HPP_
+# define __BINARY_FILE_HPP_
+
+/* ! \file
+ * \brief This module provides the binary files of \c Vector_T and \c Matrix_T .
+ *
+ * A file is a header of \c simd_alignment bytes (see \c Binary_Header )
+ * followed by the coefficients, line after line, as they are in memory.
+ * Since the header is as long as the alignment, a file mapped in memory
+ * gives coefficients aligned as those of \c simd_allocate , that are used in place.
+ * The files are only meant to be read on machines with the same byte order (which is checked).
+ *
+ * The functions return false if the file cannot be used, after a message on \c cerr .
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <cstddef>
+
+# include "simd.hpp"
+
+
+/*! Header of a binary file, of \c simd_alignment bytes. */
+struct Binary_Header {
+  /*! \c "PASDMAT" and a 0. */
+  char magic [ 8 ] ;
+  /*! \c binary_byte_order , as written by the machine. */
+  unsigned int byte_order ;
+  /*! Size of a coefficient, in bytes (4 for float, 8 for double). */
+  unsigned int coefficient_size ;
+  /*! Number of lines (the dimension for a vector). */
+  unsigned int line_nbr ;
+  /*! Number of columns (1 for a vector). */
+  unsigned int column_nbr ;
+  /*! Up to \c simd_alignment bytes, zeros. */
+  char padding [ 40 ] ;
+} ;
+
+
+/*!
+ * Write a file.
+ * \param coefficients The \c line_nbr times \c column_nbr coefficients, line after line.
+ */
+bool binary_save ( char const * const file_name ,
+		   unsigned int const coefficient_size ,
+		   unsigned int const line_nbr ,
+		   unsigned int const column_nbr ,
+		   void const * const coefficients ) ;
+
+/*!
+ * Read a file in a buffer of \c simd_allocate .
+ * \param coefficient_size Expected size of a coefficient.
+ * \param coefficients Set to the buffer (to be freed by \c simd_free ).
+ */
+bool binary_load ( char const * const file_name ,
+		   unsigned int const coefficient_size ,
+		   unsigned int & line_nbr ,
+		   unsigned int & column_nbr ,
+		   void * & coefficients ) ;
+
+/*!
+ * Map a file in memory, the coefficients are read (and written) in place.
+ * \param writable If true the modifications go to the file (and to the other processes that map it),
+ * otherwise the pages are only copied by the process that writes them.
+ * \param mapping Set to the mapping (to be given to \c binary_unmap ), the coefficients follow the header.
+ * \param length Set to the length of the mapping.
+ */
+bool binary_map ( char const * const file_name ,
+		  unsigned int const coefficient_size ,
+		  bool const writable ,
+		  unsigned int & line_nbr ,
+		  unsigned int & column_nbr ,
+		  void * & mapping ,
+		  std :: size_t & length ) ;
+
+/*! Unmap a file of \c binary_map . */
+void binary_unmap ( void * const mapping ,
+		    std :: size_t const length ) ;
+
+
+# endif
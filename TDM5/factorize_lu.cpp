@@ -1,22 +1,229 @@
+# include <algorithm> // min
+# include <cmath>
+# include <pthread.h>
+
 # include "factorize_lu.hpp"
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
-void factorize_lu ( Matrix & m ) { 
-    assert(m->get_column_nbr == m->get_line_nbr);
-    Matrix lu (m->get_line_nbr,m->get_column_nbr);
-    for(unsigned int k=0;k<m->get_column_nbr;k++){
-        for(unsigned int i=k+1;i<m->get_line_nbr;i++){
-            m(i,k) = m(i,k) /  m(i,j);
-            for(unsigned intj=k+1;k<m->get_column_nbr;k++){
-                m(i,j) = m(i,j) - (m(i,j)*m(k,j)); 
-            }
-        }
+namespace {
+
+  /*!
+   * Number of columns of a panel of \c factorize_lu_pivoting :
+   * a panel is decomposed column after column, then the rest of the matrix is updated at once by \c multiply_add .
+   */
+  unsigned int const panel_size = 64 ;
+
+  /*! Size of the tiles of the update of the rest of the matrix (one tile is done by one thread). */
+  unsigned int const update_tile = 256 ;
+
+
+  /*!
+   * Update of the trailing matrix, A22 -= L21 U12 , by tiles:
+   * the threads take the next tile till there is none left.
+   * Each tile is a \c multiply_add on its own part of A22, so that the result does not depend on the threads.
+   */
+  template < class T >
+  class Trailing_Update {
+
+    /*! Number of lines and columns of A22. */
+    unsigned int const size ;
+    /*! Number of columns of L21 (lines of U12). */
+    unsigned int const depth ;
+    /*! Opposite of L21, in a buffer of its own ( \c size by \c depth ). */
+    T const * const minus_l ;
+    /*! U12 and A22, in the matrix (the distance between two lines is \c ld ). */
+    T const * const u ;
+    T * const a ;
+    unsigned int const ld ;
+
+    /*! Number of tiles on a line and in all. */
+    unsigned int const tile_columns ;
+    unsigned int const tile_nbr ;
+    /*! Number of the next tile to take. */
+    unsigned int next ;
+    pthread_mutex_t mutex ;
+
+    static void * start ( void * t ) {
+      static_cast < Trailing_Update * > ( t ) -> work () ;
+      return 0 ;
+    }
+
+  public:
+
+    Trailing_Update ( unsigned int const _size ,
+		      unsigned int const _depth ,
+		      T const * _minus_l ,
+		      T const * _u ,
+		      T * _a ,
+		      unsigned int const _ld )
+      : size ( _size )
+      , depth ( _depth )
+      , minus_l ( _minus_l )
+      , u ( _u )
+      , a ( _a )
+      , ld ( _ld )
+      , tile_columns ( ( _size + update_tile - 1 ) / update_tile )
+      , tile_nbr ( tile_columns * tile_columns )
+      , next ( 0 )
+    {
+      pthread_mutex_init ( & mutex , 0 ) ;
+    }
+
+    ~Trailing_Update () {
+      pthread_mutex_destroy ( & mutex ) ;
+    }
+
+    /*! Loop of a thread till there is no tile left. */
+    void work () {
+      while ( true ) {
+	pthread_mutex_lock ( & mutex ) ;
+	unsigned int const t = next ++ ;
+	pthread_mutex_unlock ( & mutex ) ;
+	if ( tile_nbr <= t ) return ;
+	unsigned int const i0 = ( t / tile_columns ) * update_tile ;
+	unsigned int const j0 = ( t % tile_columns ) * update_tile ;
+	multiply_add ( std :: min ( update_tile , size - i0 ) , depth , std :: min ( update_tile , size - j0 ) ,
+		       minus_l + i0 * depth , depth ,
+		       u + j0 , ld ,
+		       a + i0 * ld + j0 , ld ) ;
+      }
+    }
 
+    /*! Start the other threads, work too and wait for them. */
+    void run ( unsigned int const nbr_threads ) {
+      unsigned int const nbr = std :: min ( nbr_threads , tile_nbr ) ;
+      std :: vector < pthread_t > threads ( nbr ) ;
+      for ( unsigned int t = 1 ; t < nbr ; t ++ ) {
+	int const ret = pthread_create ( & threads [ t ] , 0 , start , this ) ;
+	assert ( 0 == ret ) ;
+      }
+      work () ;
+      for ( unsigned int t = 1 ; t < nbr ; t ++ ) {
+	pthread_join ( threads [ t ] , 0 ) ;
+      }
     }
+  } ;
+
+
+  /*! Step k of the elimination: the lines under k get their multiplier and are updated. */
+  template < class T >
+  void eliminate ( Matrix_T < T > & m ,
+		   unsigned int const k ) {
+    unsigned int const n = m . get_line_nbr () ;
+    T const pivot = m ( k , k ) ;
+    assert ( 0 != pivot ) ;
+    for ( unsigned int i = k + 1 ; i < n ; i ++ ) {
+      T const l_ik = m ( i , k ) / pivot ;
+      m ( i , k ) = l_ik ;
+      for ( unsigned int j = k + 1 ; j < n ; j ++ ) {
+	m ( i , j ) -= l_ik * m ( k , j ) ;
+      }
+    }
+  }
+
+}
+
+
+template < class T >
+void factorize_lu ( Matrix_T < T > & m ) { 
+  assert ( m . get_column_nbr () == m . get_line_nbr () ) ;
+  for ( unsigned int k = 0 ; k < m . get_line_nbr () ; k ++ ) {
+    eliminate ( m , k ) ;
+  }
+}
+
+
+template < class T >
+std :: vector < unsigned int > factorize_lu_pivoting ( Matrix_T < T > & m ,
+						       unsigned int const nbr_threads ) {
+  assert ( m . get_column_nbr () == m . get_line_nbr () ) ;
+  assert ( 1 <= nbr_threads ) ;
+  unsigned int const n = m . get_line_nbr () ;
+  T * const a = m . data () ;
+  std :: vector < unsigned int > permutation ( n ) ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) {
+    permutation [ i ] = i ;
+  }
+  std :: vector < T > minus_l ;
+  for ( unsigned int k0 = 0 ; k0 < n ; k0 += panel_size ) {
+    unsigned int const k1 = std :: min ( n , k0 + panel_size ) ;
+    // the panel (columns k0 to k1), column after column
+    for ( unsigned int k = k0 ; k < k1 ; k ++ ) {
+      unsigned int p = k ;
+      for ( unsigned int i = k + 1 ; i < n ; i ++ ) {
+	if ( std :: fabs ( a [ p * n + k ] ) < std :: fabs ( a [ i * n + k ] ) ) {
+	  p = i ;
+	}
+      }
+      if ( p != k ) {
+	// the whole lines are exchanged: the multipliers of L go with them
+	std :: swap_ranges ( a + k * n , a + ( k + 1 ) * n , a + p * n ) ;
+	std :: swap ( permutation [ k ] , permutation [ p ] ) ;
+      }
+      T const pivot = a [ k * n + k ] ;
+      assert ( 0 != pivot ) ;
+      for ( unsigned int i = k + 1 ; i < n ; i ++ ) {
+	T const l_ik = a [ i * n + k ] / pivot ;
+	a [ i * n + k ] = l_ik ;
+	for ( unsigned int j = k + 1 ; j < k1 ; j ++ ) {
+	  a [ i * n + j ] -= l_ik * a [ k * n + j ] ;
+	}
+      }
+    }
+    if ( n == k1 ) break ;
+    // U12 , on the right of the panel: same elimination, by L11
+    for ( unsigned int k = k0 ; k < k1 ; k ++ ) {
+      for ( unsigned int i = k + 1 ; i < k1 ; i ++ ) {
+	T const l_ik = a [ i * n + k ] ;
+	for ( unsigned int j = k1 ; j < n ; j ++ ) {
+	  a [ i * n + j ] -= l_ik * a [ k * n + j ] ;
+	}
+      }
+    }
+    // A22 -= L21 U12 , with the opposite of L21 copied aside (next to each other in the cache)
+    unsigned int const depth = k1 - k0 ;
+    minus_l . resize ( ( n - k1 ) * depth ) ;
+    for ( unsigned int i = k1 ; i < n ; i ++ ) {
+      for ( unsigned int k = k0 ; k < k1 ; k ++ ) {
+	minus_l [ ( i - k1 ) * depth + ( k - k0 ) ] = - a [ i * n + k ] ;
+      }
+    }
+    Trailing_Update < T > update ( n - k1 , depth , & minus_l [ 0 ] , a + k0 * n + k1 , a + k1 * n + k1 , n ) ;
+    update . run ( nbr_threads ) ;
+  }
+  return permutation ;
+}
+
 
+template < class T >
+void solve_lu ( Matrix_T < T > const & lu ,
+		std :: vector < unsigned int > const & permutation ,
+		Vector_T < T > & b ) {
+  unsigned int const n = lu . get_line_nbr () ;
+  assert ( n == b . get_size () ) ;
+  assert ( n == permutation . size () ) ;
+  // L y = P b , the diagonal of L is one
+  Vector_T < T > x ( n ) ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) {
+    x [ i ] = b [ permutation [ i ] ] - ( x . view ( 0 , i ) | lu . line_view ( i , 0 , i ) ) ;
+  }
+  // U x = y
+  for ( unsigned int i = n ; 0 < i -- ; ) {
+    x [ i ] = ( x [ i ] - ( x . view ( i + 1 , n ) | lu . line_view ( i , i + 1 , n ) ) ) / lu ( i , i ) ;
+  }
+  b . swap ( x ) ;
 }
 
 
+// the two types of coefficients
+template void factorize_lu ( Matrix_T < float > & ) ;
+template void factorize_lu ( Matrix_T < double > & ) ;
+template std :: vector < unsigned int > factorize_lu_pivoting ( Matrix_T < float > & , unsigned int const ) ;
+template std :: vector < unsigned int > factorize_lu_pivoting ( Matrix_T < double > & , unsigned int const ) ;
+template void solve_lu ( Matrix_T < float > const & , std :: vector < unsigned int > const & , Vector_T < float > & ) ;
+template void solve_lu ( Matrix_T < double > const & , std :: vector < unsigned int > const & , Vector_T < double > & ) ;
@@ -9,7 +9,10 @@
  */
 
 
+# include <vector>
+
 # include "matrix.hpp"
+# include "vector.hpp"
 
 
 /*!
@@ -17,8 +20,91 @@
  * After the call, Matrix m will hold L in the upper part and U in the lower part.
  * \pre m Matrix to be replaced by its LU decomposition.
  * \pre Matrix \c m is square.
+ * \pre No pivot is zero (see \c factorize_lu_pivoting otherwise).
+ */
+template < class T >
+void factorize_lu ( Matrix_T < T > & m ) ; 
+
+
+/*!
+ * Same as \c factorize_lu , with partial pivoting:
+ * at each step, the line with the largest pivot (in absolute value) is exchanged with the current one.
+ * The factors are those of the matrix whose line \c i is line \c permutation [ i ] of \c m .
+ *
+ * The matrix is decomposed by panels of columns (right-looking blocked decomposition):
+ * after each panel, the rest of the matrix is updated by the product of matrices \c multiply_add ,
+ * by tiles shared among the threads. The result does not depend on the number of threads.
+ * \param m Matrix to be replaced by its LU decomposition.
+ * \param nbr_threads Number of threads (at least 1, the calling one is one of them).
+ * \pre Matrix \c m is square and invertible.
+ * \return The permutation of the lines.
  */
-void factorize_lu ( Matrix & m ) ; 
+template < class T >
+std :: vector < unsigned int > factorize_lu_pivoting ( Matrix_T < T > & m ,
+						       unsigned int const nbr_threads = 1 ) ;
+
+
+/*!
+ * Solve m x = b knowing the decomposition of m (forward then back substitution).
+ * \param lu Decomposition of m, by \c factorize_lu_pivoting .
+ * \param permutation Permutation returned by \c factorize_lu_pivoting .
+ * \param b Right-hand side, replaced by the solution x.
+ * \pre The dimension of \c b is the one of \c lu .
+ */
+template < class T >
+void solve_lu ( Matrix_T < T > const & lu ,
+		std :: vector < unsigned int > const & permutation ,
+		Vector_T < T > & b ) ;
+
+
+/*!
+ * Decomposition of a matrix, computed once, to solve systems with as many right-hand sides as needed.
+ * \c Factorization_LU is the one of the matrices of floats.
+ */
+template < class T >
+class Factorization_LU_T {
+
+  /*! L and U, in the same matrix (see \c factorize_lu ). */
+  Matrix_T < T > lu ;
+
+  /*! Permutation of the lines (see \c factorize_lu_pivoting ). */
+  std :: vector < unsigned int > permutation ;
+
+public:
+
+  /*!
+   * Decomposition of m, with partial pivoting.
+   * \param nbr_threads Number of threads of the decomposition (see \c factorize_lu_pivoting ).
+   * \pre Matrix \c m is square and invertible.
+   */
+  Factorization_LU_T ( Matrix_T < T > const & m ,
+		       unsigned int const nbr_threads = 1 )
+    : lu ( m )
+    , permutation ( factorize_lu_pivoting ( lu , nbr_threads ) ) {
+  }
+
+  /*! L and U, in the same matrix. */
+  Matrix_T < T > const & get_lu () const {
+    return lu ;
+  }
+
+  /*! Line \c i of the factors is line \c get_permutation () [ i ] of the matrix. */
+  std :: vector < unsigned int > const & get_permutation () const {
+    return permutation ;
+  }
+
+  /*!
+   * Solve m x = b .
+   * \param b Right-hand side, replaced by the solution x.
+   * \pre The dimension of \c b is the one of the matrix.
+   */
+  void solve ( Vector_T < T > & b ) const {
+    solve_lu ( lu , permutation , b ) ;
+  }
+} ;
+
 
+/*! Decomposition of a matrix of floats. */
+typedef Factorization_LU_T < float > Factorization_LU ;
 
 # endif
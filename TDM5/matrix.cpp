@@ -1,9 +1,15 @@
 # include <iostream>
+# include <algorithm> // min, swap
 # include <stdlib.h>  // drand48
 
+# include "binary_file.hpp"
+# include "counters.hpp"
 # include "matrix.hpp"
+# include "simd.hpp"
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 using namespace std ; 
@@ -19,41 +25,206 @@ using namespace std ;
   }						
 
 
-Matrix :: Matrix ( unsigned int const _line_nbr ,
-		   unsigned int const _column_nbr ) 
+namespace {
+
+  /*!
+   * Sizes of the blocks of the product:
+   * a block of \c block_common lines and \c block_column columns of the right matrix
+   * is used for all the lines of the left one (it stays in the cache),
+   * and \c block_line of these lines are taken at a time.
+   */
+  unsigned int const block_line = 64 ;
+  unsigned int const block_common = 128 ;
+  unsigned int const block_column = 256 ;
+
+  /*! Sizes of a tile of the result, kept in registers during the loop on the common dimension. */
+  unsigned int const tile_line = 4 ;
+  unsigned int const tile_column = 8 ;
+
+
+  /*!
+   * Full tile: c += a * b , with a \c tile_line by \c k_nbr and b \c k_nbr by \c tile_column .
+   * The \c ld_ are the distances between two lines (row-major storage).
+   */
+  template < class T >
+  inline void multiply_add_tile ( unsigned int const k_nbr ,
+				  T const * a , unsigned int const ld_a ,
+				  T const * b , unsigned int const ld_b ,
+				  T * c , unsigned int const ld_c ) {
+    T acc [ tile_line ] [ tile_column ] ;
+    for ( unsigned int i = 0 ; i < tile_line ; i ++ ) {
+      for ( unsigned int j = 0 ; j < tile_column ; j ++ ) {
+	acc [ i ] [ j ] = c [ i * ld_c + j ] ;
+      }
+    }
+    for ( unsigned int k = 0 ; k < k_nbr ; k ++ ) {
+      T const * const b_k = b + k * ld_b ;
+      for ( unsigned int i = 0 ; i < tile_line ; i ++ ) {
+	T const a_ik = a [ i * ld_a + k ] ;
+	for ( unsigned int j = 0 ; j < tile_column ; j ++ ) {
+	  acc [ i ] [ j ] += a_ik * b_k [ j ] ;
+	}
+      }
+    }
+    for ( unsigned int i = 0 ; i < tile_line ; i ++ ) {
+      for ( unsigned int j = 0 ; j < tile_column ; j ++ ) {
+	c [ i * ld_c + j ] = acc [ i ] [ j ] ;
+      }
+    }
+  }
+
+
+  /*! Same as above for the tiles cut by the border (\c i_nbr and \c j_nbr at most the tile sizes). */
+  template < class T >
+  inline void multiply_add_border ( unsigned int const i_nbr ,
+				    unsigned int const k_nbr ,
+				    unsigned int const j_nbr ,
+				    T const * a , unsigned int const ld_a ,
+				    T const * b , unsigned int const ld_b ,
+				    T * c , unsigned int const ld_c ) {
+    for ( unsigned int i = 0 ; i < i_nbr ; i ++ ) {
+      for ( unsigned int j = 0 ; j < j_nbr ; j ++ ) {
+	T acc = c [ i * ld_c + j ] ;
+	for ( unsigned int k = 0 ; k < k_nbr ; k ++ ) {
+	  acc += a [ i * ld_a + k ] * b [ k * ld_b + j ] ;
+	}
+	c [ i * ld_c + j ] = acc ;
+      }
+    }
+  }
+
+}
+
+
+template < class T >
+void multiply_add ( unsigned int const n ,
+		    unsigned int const p ,
+		    unsigned int const q ,
+		    T const * a , unsigned int const ld_a ,
+		    T const * b , unsigned int const ld_b ,
+		    T * c , unsigned int const ld_c ) {
+  for ( unsigned int j0 = 0 ; j0 < q ; j0 += block_column ) {
+    unsigned int const j1 = std :: min ( q , j0 + block_column ) ;
+    for ( unsigned int k0 = 0 ; k0 < p ; k0 += block_common ) {
+      unsigned int const k_nbr = std :: min ( p , k0 + block_common ) - k0 ;
+      for ( unsigned int i0 = 0 ; i0 < n ; i0 += block_line ) {
+	unsigned int const i1 = std :: min ( n , i0 + block_line ) ;
+	for ( unsigned int i = i0 ; i < i1 ; i += tile_line ) {
+	  unsigned int const i_nbr = std :: min ( i1 - i , tile_line ) ;
+	  for ( unsigned int j = j0 ; j < j1 ; j += tile_column ) {
+	    unsigned int const j_nbr = std :: min ( j1 - j , tile_column ) ;
+	    T const * const a_ik = a + i * ld_a + k0 ;
+	    T const * const b_kj = b + k0 * ld_b + j ;
+	    T * const c_ij = c + i * ld_c + j ;
+	    if ( ( tile_line == i_nbr ) && ( tile_column == j_nbr ) ) {
+	      multiply_add_tile ( k_nbr , a_ik , ld_a , b_kj , ld_b , c_ij , ld_c ) ;
+	    } else {
+	      multiply_add_border ( i_nbr , k_nbr , j_nbr , a_ik , ld_a , b_kj , ld_b , c_ij , ld_c ) ;
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
+
+
+template < class T >
+Matrix_T < T > :: Matrix_T ( unsigned int const _line_nbr ,
+			     unsigned int const _column_nbr ) 
   : line_nbr ( _line_nbr ) 
   , column_nbr ( _column_nbr )
-  , element ( new float [ _line_nbr * _column_nbr ] ) { 
+  , element ( static_cast < T * > ( simd_allocate ( _line_nbr * _column_nbr * sizeof ( T ) ) ) )
+  , mapping ( NULL )
+  , mapping_length ( 0 ) { 
+  for ( unsigned int i = 0 ; i < line_nbr * column_nbr ; i ++ ) {
+    element [ i ] = 0 ;
+  }
 } 
 
 
-Matrix :: Matrix ( Matrix const & m ) 
+template < class T >
+Matrix_T < T > :: Matrix_T ( Matrix_T < T > const & m ) 
   : line_nbr ( m . line_nbr ) 
   , column_nbr ( m . column_nbr ) 
-  , element ( new float [ m . column_nbr * m . line_nbr ] ) { 
+  , element ( static_cast < T * > ( simd_allocate ( m . column_nbr * m . line_nbr * sizeof ( T ) ) ) )
+  , mapping ( NULL )
+  , mapping_length ( 0 ) { 
+  init ( m . element ) ;
 } 
 
 
-Matrix :: ~ Matrix () {
-  delete [] element ; // works with NULL
+template < class T >
+Matrix_T < T > :: Matrix_T ( unsigned int const _line_nbr ,
+			     unsigned int const _column_nbr ,
+			     void * const _mapping ,
+			     size_t const _mapping_length ) 
+  : line_nbr ( _line_nbr ) 
+  , column_nbr ( _column_nbr )
+  , element ( reinterpret_cast < T * > ( static_cast < char * > ( _mapping ) + sizeof ( Binary_Header ) ) )
+  , mapping ( _mapping )
+  , mapping_length ( _mapping_length ) { 
+} 
+
+
+template < class T >
+Matrix_T < T > :: ~ Matrix_T () {
+  if ( NULL != mapping ) {
+    binary_unmap ( mapping , mapping_length ) ;
+  } else {
+    simd_free ( element ) ; // works with NULL
+  }
+}
+
+
+template < class T >
+bool Matrix_T < T > :: save ( char const * const file_name ) const {
+  return binary_save ( file_name , sizeof ( T ) , line_nbr , column_nbr , element ) ;
+}
+
+
+template < class T >
+Matrix_T < T > * Matrix_T < T > :: load ( char const * const file_name ) {
+  unsigned int l , c ;
+  void * coefficients ;
+  if ( ! binary_load ( file_name , sizeof ( T ) , l , c , coefficients ) ) return NULL ;
+  Matrix_T < T > * const m = new Matrix_T < T > ( 0 , 0 ) ;
+  m -> line_nbr = l ;
+  m -> column_nbr = c ;
+  m -> element = static_cast < T * > ( coefficients ) ;
+  return m ;
 }
 
 
-void Matrix :: init_alea () { 
+template < class T >
+Matrix_T < T > * Matrix_T < T > :: map ( char const * const file_name ,
+					 bool const writable ) {
+  unsigned int l , c ;
+  void * m ;
+  size_t length ;
+  if ( ! binary_map ( file_name , sizeof ( T ) , writable , l , c , m , length ) ) return NULL ;
+  return new Matrix_T < T > ( l , c , m , length ) ;
+}
+
+
+template < class T >
+void Matrix_T < T > :: init_alea () { 
   for ( unsigned int i = 0 ; i < column_nbr*line_nbr ; i++ ) {	
     element[ i ] = drand48 () ; 
   }				
 }
 
 
-void Matrix :: init ( float const * coefficients ) { 
+template < class T >
+void Matrix_T < T > :: init ( T const * coefficients ) { 
   for ( unsigned int i = 0 ; i < column_nbr*line_nbr ; i++ ) {	
     element[ i ] = coefficients[i]; 
   }				
 }
 
 
-void Matrix :: set_identity () { 
+template < class T >
+void Matrix_T < T > :: set_identity () { 
   assert(column_nbr == line_nbr);
   unsigned int id =0;
   for ( unsigned int i = 0 ; i < column_nbr*line_nbr; i++ ) {	
@@ -68,10 +239,11 @@ void Matrix :: set_identity () {
 }
 
 
-std :: ostream & operator << ( std :: ostream & ost , Matrix const & m ) { 
+template < class T >
+std :: ostream & operator << ( std :: ostream & ost , Matrix_T < T > const & m ) { 
               
-  for(unsigned int l=0;l<m.line_nbr;l++){
-    for(unsigned int c=0;c<m.column_nbr;c++){
+  for(unsigned int l=0;l<m.get_line_nbr();l++){
+    for(unsigned int c=0;c<m.get_column_nbr();c++){
       ost << m(l,c) << "	";
     }
     ost << endl;
@@ -80,102 +252,125 @@ std :: ostream & operator << ( std :: ostream & ost , Matrix const & m ) {
 }
 
 
-Matrix & Matrix :: operator = ( Matrix const & m ) { 
-  assert(line_nbr==m.line_nbr && column_nbr == m.column_nbr);
-  for(unsigned int i=0; i<line_nbr*column_nbr; i++){
-    element[i]=m.element[i];
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: operator = ( Matrix_T < T > const & m ) { 
+  if ( ( line_nbr != m . line_nbr ) || ( column_nbr != m . column_nbr ) ) {
+    Matrix_T < T > copy ( m ) ;
+    swap ( copy ) ;
+  } else if ( this != & m ) {
+    init ( m . element ) ;
   }
   return (*this);
 }
 
 
-Matrix Matrix :: operator + ( Matrix const & m ) const { 
+template < class T >
+void Matrix_T < T > :: swap ( Matrix_T < T > & m ) { 
+  std :: swap ( line_nbr , m . line_nbr ) ;
+  std :: swap ( column_nbr , m . column_nbr ) ;
+  std :: swap ( element , m . element ) ;
+  std :: swap ( mapping , m . mapping ) ;
+  std :: swap ( mapping_length , m . mapping_length ) ;
+}
+
+
+template < class T >
+Matrix_T < T > Matrix_T < T > :: operator + ( Matrix_T < T > const & m ) const { 
   assert((line_nbr*column_nbr) == (m.line_nbr*m.column_nbr));
-  float* tab = new float [line_nbr*column_nbr];
-  for(unsigned int i=0; i<line_nbr*column_nbr;i++){
-    tab[i]=element[i]+m.element[i];
-  }
-  Matrix res (line_nbr,column_nbr);
-  res.init(tab);
+  Matrix_T < T > res (line_nbr,column_nbr);
+  simd_add ( line_nbr * column_nbr , element , m . element , res . element ) ;
   return res; 
 
 }
 
 
-Matrix Matrix :: operator - ( Matrix const & m ) const { 
+template < class T >
+Matrix_T < T > Matrix_T < T > :: operator - ( Matrix_T < T > const & m ) const { 
   assert((line_nbr*column_nbr) == (m.line_nbr*m.column_nbr));
-  float* tab = new float [line_nbr*column_nbr];
-  for(unsigned int i=0; i<line_nbr*column_nbr;i++){
-    tab[i]=element[i]-m.element[i];
-  }
-  Matrix res (line_nbr,column_nbr);
-  res.init(tab);
+  Matrix_T < T > res (line_nbr,column_nbr);
+  simd_subtract ( line_nbr * column_nbr , element , m . element , res . element ) ;
   return res; 
 }
 
 
-Matrix Matrix :: operator * ( Matrix const & m ) const { 
-  Matrix n (line_nbr,m.column_nbr);
-  for(unsigned int l=0,i=0;l<line_nbr;l++){ 
-    for(unsigned int c2=0;c2<m.column_nbr;c2++,i++){
-      n.element[i] = (extract_ligne(l,0,column_nbr) | m.extract_col(0,line_nbr,c2));
-      
-    }
-  }
+template < class T >
+Matrix_T < T > Matrix_T < T > :: operator * ( Matrix_T < T > const & m ) const { 
+  assert ( column_nbr == m . line_nbr ) ;
+  COUNTER_ADD ( "Matrix::operator*" ) ;
+  COUNTER_ADD_N ( "Matrix::operator* flop" , 2UL * line_nbr * column_nbr * m . column_nbr ) ;
+  COUNTER_TIMER ( "Matrix::operator* ns" ) ;
+  Matrix_T < T > n ( line_nbr , m . column_nbr ) ;
+  multiply_add ( line_nbr , column_nbr , m . column_nbr ,
+		 element , column_nbr ,
+		 m . element , m . column_nbr ,
+		 n . element , n . column_nbr ) ;
   return n;
 }
 
 
-Vector Matrix :: operator * ( Vector const & v ) const { 
+template < class T >
+Vector_T < T > Matrix_T < T > :: operator * ( Vector_T < T > const & v ) const { 
   assert(column_nbr==v.get_size());
-  Vector w (line_nbr);
+  Vector_T < T > w (line_nbr);
   for ( unsigned int i=0 ; i < line_nbr ; i++ ) {
-   // cout << extract_ligne(i,0,column_nbr);
-    w[i] = (extract_ligne(i,0,column_nbr)) | v; //somme du produit entre les deux vecteurs
+    w[i] = v | line_view(i,0,column_nbr); //somme du produit entre les deux vecteurs
   }
 
   return w;
 }
 
 
-Matrix Matrix :: operator * ( const float a ) const { 
-  Matrix n (line_nbr,column_nbr);
-  for(unsigned int i=0;i<line_nbr*column_nbr;i++){ 
-    n.element[i] = element[i]*a;
-  }
+template < class T >
+Matrix_T < T > Matrix_T < T > :: operator * ( const T a ) const { 
+  Matrix_T < T > n (line_nbr,column_nbr);
+  simd_scale ( line_nbr * column_nbr , a , element , n . element ) ;
   return n;
 }
 
 
-Matrix operator * ( float const a ,
-		    Matrix const & m ) {
-  return m * a ; 
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: operator += ( Matrix_T < T > const & m ) { 
+  assert((line_nbr*column_nbr) == (m.line_nbr*m.column_nbr));
+  simd_add ( line_nbr * column_nbr , element , m . element , element ) ;
+  return (*this);
 }
 
 
-Matrix & Matrix :: operator += ( Matrix const & m ) { 
-  assert((line_nbr*column_nbr) == (m.line_nbr*m.column_nbr));
-  for(unsigned int i=0; i<line_nbr*column_nbr;i++){
-    element[i]+=m.element[i];
-  }
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: operator -= ( Matrix_T < T > const & m ) { 
+  assert ( ( line_nbr == m . line_nbr ) && ( column_nbr == m . column_nbr ) ) ;
+  simd_subtract ( line_nbr * column_nbr , element , m . element , element ) ;
   return (*this);
 }
 
 
-Matrix & Matrix :: operator *= ( Matrix const & m ) { 
-  assert(line_nbr == m.column_nbr);
-  for(unsigned int l=0,i=0;l<line_nbr;l++){ 
-    for(unsigned int c2=0;c2<m.column_nbr;c2++,i++){
-      element[i] = (extract_ligne(l,0,column_nbr) | m.extract_col(0,line_nbr,c2));
-      
-    }
-  }
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: operator *= ( T const a ) { 
+  simd_scale ( line_nbr * column_nbr , a , element , element ) ;
   return (*this);
+}
+
 
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: add_scaled ( T const a ,
+						Matrix_T < T > const & m ) { 
+  assert ( ( line_nbr == m . line_nbr ) && ( column_nbr == m . column_nbr ) ) ;
+  simd_add_scaled ( line_nbr * column_nbr , a , m . element , element ) ;
+  return (*this);
 }
 
 
-bool Matrix :: operator == ( Matrix const & m ) const { 
+template < class T >
+Matrix_T < T > & Matrix_T < T > :: operator *= ( Matrix_T < T > const & m ) { 
+  // the product is made aside, as each coefficient of this is read many times
+  Matrix_T < T > p = ( * this ) * m ;
+  swap ( p ) ;
+  return (*this);
+}
+
+
+template < class T >
+bool Matrix_T < T > :: operator == ( Matrix_T < T > const & m ) const { 
   assert((line_nbr == m.line_nbr) && (column_nbr == m.column_nbr));
   for(unsigned int i=0; i<line_nbr*column_nbr;i++){
     if(element[i]!= m.element[i]){
@@ -186,34 +381,26 @@ bool Matrix :: operator == ( Matrix const & m ) const {
 }
 
 
-Vector Matrix :: extract_ligne ( unsigned int const l ,
-				 unsigned int const c1 ,
-				 unsigned int const c2 ) const { 
-  assert(c1<=c2);
-  Vector v (c2-c1);
-  for(unsigned int i=c1,j=0;i<c2;i++,j++){
-    v[j] = element [ l * column_nbr + i ];
-  }
-  return v;
+template < class T >
+Vector_T < T > Matrix_T < T > :: extract_ligne ( unsigned int const l ,
+						 unsigned int const c1 ,
+						 unsigned int const c2 ) const { 
+  return line_view ( l , c1 , c2 ) . to_vector () ;
 }
 
 
-Vector Matrix :: extract_col ( unsigned int const l1 ,
-			       unsigned int const l2 ,
-			       unsigned int const c ) const { 
-  assert(l1<=l2);
-  Vector v (l2-l1);
-  for(unsigned int i=l1,j=0;i<l2;i++,j++){
-    v[j] = element [ i * column_nbr + c ];
-  }
-  return v;
-
+template < class T >
+Vector_T < T > Matrix_T < T > :: extract_col ( unsigned int const l1 ,
+					       unsigned int const l2 ,
+					       unsigned int const c ) const { 
+  return column_view ( l1 , l2 , c ) . to_vector () ;
 } 
 
 
-Matrix Matrix :: extract_triangular_lower_diag_one () const { 
+template < class T >
+Matrix_T < T > Matrix_T < T > :: extract_triangular_lower_diag_one () const { 
   assert(line_nbr==column_nbr);
-  Matrix x (line_nbr, column_nbr);
+  Matrix_T < T > x (line_nbr, column_nbr);
   for(unsigned int l = 0,i=0; l < line_nbr ; l++){
     for(unsigned int c = 0; c < column_nbr ; c++,i++){
       if(l<c){
@@ -229,17 +416,16 @@ Matrix Matrix :: extract_triangular_lower_diag_one () const {
 }
 
 
-Matrix Matrix :: extract_triangular_upper_diag () const { 
+template < class T >
+Matrix_T < T > Matrix_T < T > :: extract_triangular_upper_diag () const { 
   assert(line_nbr==column_nbr);
-  Matrix x (line_nbr, column_nbr);
+  Matrix_T < T > x (line_nbr, column_nbr);
   for(unsigned int l = 0,i=0; l < line_nbr ; l++){
     for(unsigned int c = 0; c < column_nbr ; c++,i++){
       if(l>c){
         x.element[i] = 0;
-      }else if(l<c){
-        x.element[i] = element[i];
       }else{
-        x.element[i] = 1;
+        x.element[i] = element[i];
       }
     }
   }
@@ -247,9 +433,10 @@ Matrix Matrix :: extract_triangular_upper_diag () const {
 }
 
 
-Matrix Matrix :: extract_diagonal () const { 
+template < class T >
+Matrix_T < T > Matrix_T < T > :: extract_diagonal () const { 
   assert(line_nbr==column_nbr);
-  Matrix x (line_nbr, column_nbr);
+  Matrix_T < T > x (line_nbr, column_nbr);
   for(unsigned int l = 0,i=0; l < line_nbr ; l++){
     for(unsigned int c = 0; c < column_nbr ; c++,i++){
       if(l==c){
@@ -262,3 +449,17 @@ Matrix Matrix :: extract_diagonal () const {
   return x;
 }
 
+
+// the two types of coefficients
+template class Matrix_T < float > ;
+template class Matrix_T < double > ;
+template std :: ostream & operator << ( std :: ostream & , Matrix_T < float > const & ) ;
+template std :: ostream & operator << ( std :: ostream & , Matrix_T < double > const & ) ;
+template void multiply_add ( unsigned int const , unsigned int const , unsigned int const ,
+			     float const * , unsigned int const ,
+			     float const * , unsigned int const ,
+			     float * , unsigned int const ) ;
+template void multiply_add ( unsigned int const , unsigned int const , unsigned int const ,
+			     double const * , unsigned int const ,
+			     double const * , unsigned int const ,
+			     double * , unsigned int const ) ;
@@ -2,21 +2,31 @@
 # define __MATRIX_HPP_
 
 /* !
- * \brief This module is made to handle (bi-dimensional) matrix of floats. 
+ * \brief This module is made to handle (bi-dimensional) matrix of floats (or doubles). 
  * 
  * \author PASD
  * \date 2016
  */
 
+# include <cstddef>
 # include <sstream>
 
 # include "vector.hpp"
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
-class Matrix {
+/*!
+ * Matrix of floats (or doubles: \c T is the type of the coefficients),
+ * in a buffer aligned for the vector instructions (see \c simd_allocate ),
+ * or in a file mapped in memory (see \c map ).
+ * \c Matrix is the matrix of floats.
+ */
+template < class T >
+class Matrix_T {
 
   /*! Number of lines */
   unsigned int line_nbr ;
@@ -25,19 +35,58 @@ class Matrix {
   unsigned int column_nbr; 
 
   /*! All the elements of the matrix stored in a 1-D array of floats. */
-  float * element ; 
+  T * element ; 
+
+  /*! The file mapped in memory that holds \c element (NULL if it was allocated). */
+  void * mapping ;
+
+  /*! Length of \c mapping , in bytes. */
+  std :: size_t mapping_length ;
+
+  /*! To construct a matrix on the coefficients of a file mapped in memory. */
+  Matrix_T ( unsigned int const _line_nbr ,
+	     unsigned int const _column_nbr ,
+	     void * const _mapping ,
+	     std :: size_t const _mapping_length ) ;
  
 public:
   
   /*! To construct a _line_nbr by _column_nbr matrix filled with zeros. */
-  Matrix ( unsigned int const _line_nbr ,
-	   unsigned int const _column_nbr ) ;
+  Matrix_T ( unsigned int const _line_nbr ,
+	     unsigned int const _column_nbr ) ;
 
   /*! Copy construct. */
-  Matrix ( Matrix const & m ) ; 
+  Matrix_T ( Matrix_T const & m ) ; 
 
-  /*! Destructor */
-  ~ Matrix () ;
+  /*! Destructor (the file of \c map is unmapped). */
+  ~ Matrix_T () ;
+
+  /*!
+   * Write the matrix in a binary file (see \c binary_file.hpp ).
+   * \return false if the file could not be written (see \c cerr ).
+   */
+  bool save ( char const * const file_name ) const ;
+
+  /*!
+   * Read a matrix from a binary file of \c save .
+   * \return A new matrix (to be deleted), NULL if the file could not be read (see \c cerr ).
+   */
+  static Matrix_T * load ( char const * const file_name ) ;
+
+  /*!
+   * Map a binary file of \c save in memory, its coefficients are used in place (nothing is read before it is used).
+   * Copies and assignments of other sizes get buffers of their own.
+   * \param writable If true the modifications are written in the file (and seen by the other processes that map it),
+   * otherwise they stay in the process.
+   * \return A new matrix (to be deleted), NULL if the file could not be mapped (see \c cerr ).
+   */
+  static Matrix_T * map ( char const * const file_name ,
+			  bool const writable = false ) ;
+
+  /*! \return true iff the coefficients are in a file mapped by \c map . */
+  bool is_mapped () const {
+    return NULL != mapping ;
+  } ;
  
   /*! To access the number of lines. */
   unsigned int get_line_nbr () const {
@@ -55,7 +104,7 @@ public:
    * \param line Line number.
    * \return A reference to the element at position (column,line).
    */
-  float & operator () ( unsigned int const line ,
+  T & operator () ( unsigned int const line ,
 			unsigned int const column ) {
     assert ( line < line_nbr ) ;
     assert ( column < column_nbr ) ;
@@ -68,13 +117,23 @@ public:
    * \param line Line number.
    * \return A reference to the element at position (column,line).
    */
-  float const & operator () ( unsigned  int const line ,
+  T const & operator () ( unsigned  int const line ,
 			      unsigned  int const column ) const {
     assert ( line < line_nbr ) ;
     assert ( column < column_nbr ) ;
     return element [ line * column_nbr + column ] ; 
   } ; 
 
+  /*! The coefficients, line after line (the distance between two lines is the number of columns). */
+  T * data () {
+    return element ;
+  } ;
+
+  /*! The coefficients, line after line (const version). */
+  T const * data () const {
+    return element ;
+  } ;
+
   /*
    * To fill the matrix with random values.
    */
@@ -85,7 +144,7 @@ public:
    * \param coefficients Pointer to the values.
    * \pre Unfortunately, the array size is impossible to test.
    */
-  void init ( float const * coefficients ) ; 
+  void init ( T const * coefficients ) ; 
   
   /*!
    * Initialize the matrix as the identity matrix (1 in the diagonal, 0 everywhere else).
@@ -99,7 +158,7 @@ public:
    * \pre The two matrices should have the same size.
    * \return A new Matrix whose coordinates are the sum of the coordinate of this and m.
    */
-  Matrix operator + ( Matrix const & m ) const ; 
+  Matrix_T operator + ( Matrix_T const & m ) const ; 
 
   /*!
    * Minus operator.
@@ -107,7 +166,7 @@ public:
    * \pre The two matrices should have the same size.
    * \return A new Matrix whose coordinates are the coordinate of this minus the coordinates of m.
    */
-  Matrix operator - ( Matrix const & m ) const ; 
+  Matrix_T operator - ( Matrix_T const & m ) const ; 
 
   /*!
    * Matrix-matrix multiplication operator.
@@ -115,7 +174,7 @@ public:
    * \pre The number of columns of this should be equal to the number of lines of m.
    * \return A new Matrix whose coordinates are the scalar product of lines of this and column of m.
    */
-  Matrix operator * ( Matrix const & m ) const ; 
+  Matrix_T operator * ( Matrix_T const & m ) const ; 
 
   /*! 
    *Matrix-vector multiplication operator.
@@ -123,21 +182,28 @@ public:
    * \pre The number of columns of this should be equal to the dimension of v.
    * \return A new Vector whose coordinates are the scalar product of lines of this and v.
    */
-  Vector operator * ( Vector const & v ) const ; 
+  Vector_T < T > operator * ( Vector_T < T > const & v ) const ; 
 
   /*! 
    * Compute the product of the matrix by a scalar a.
    * \param a Float to multiply by.
    * \return A new matrix whose coordinates are the product of the coordinate of this and a.
    */
-  Matrix operator * ( float const a ) const ; 
+  Matrix_T operator * ( T const a ) const ; 
 
   /*!
    * Affectation operator.
+   * The buffer is kept if the sizes are equal, otherwise it is replaced.
    * \param m Matrix to copy.
    * \return The matrix it-self as a reference.
    */ 
-  Matrix & operator = ( Matrix const & m ) ; 
+  Matrix_T & operator = ( Matrix_T const & m ) ; 
+
+  /*!
+   * Exchange the coefficients (and the sizes) of this and m, without copying them.
+   * \param m Matrix to exchange with.
+   */
+  void swap ( Matrix_T & m ) ;
 
   /*!
    * Modify the matrix by adding another one to it.
@@ -145,15 +211,41 @@ public:
    * \pre The two matrices should have the same size.
    * \return The matrix it-self as a reference.
    */ 
-  Matrix & operator += ( Matrix const & m ) ; 
+  Matrix_T & operator += ( Matrix_T const & m ) ; 
+
+  /*!
+   * Modify the matrix by subtracting another one from it.
+   * \param m Matrix to subtract.
+   * \pre The two matrices should have the same size.
+   * \return The matrix it-self as a reference.
+   */ 
+  Matrix_T & operator -= ( Matrix_T const & m ) ; 
+
+  /*!
+   * Modify the matrix by multiplying it by a scalar.
+   * \param a Float to multiply by.
+   * \return The matrix it-self as a reference.
+   */ 
+  Matrix_T & operator *= ( T const a ) ; 
+
+  /*!
+   * Modify the matrix by adding a times another one, in one loop (this += a * m without a temporary).
+   * \param a Float to multiply m by.
+   * \param m Matrix to add the product of.
+   * \pre The two matrices should have the same size.
+   * \return The matrix it-self as a reference.
+   */ 
+  Matrix_T & add_scaled ( T const a ,
+			  Matrix_T const & m ) ; 
 
   /*!
    * Modify the matrix by multiplying by another one.
+   * The product is computed aside, then exchanged with the coefficients of this.
    * \param m Matrix to multiply by.
    * \pre The number of columns of this should be equal to the number of lines of m.
    * \return The matrix it-self as a reference.
    */ 
-  Matrix & operator *= ( Matrix const & m ) ; 
+  Matrix_T & operator *= ( Matrix_T const & m ) ; 
  
   /*! 
    * Test whether two matrices are coefficient-wise equal.
@@ -161,8 +253,40 @@ public:
    * \pre They should have the same dimension.
    * \return true if the matrix are equal.
    */ 
-  bool operator == ( Matrix const & m ) const ; 
+  bool operator == ( Matrix_T const & m ) const ; 
  
+  /*!
+   * To see a part of a line as a vector, without copying it.
+   * \param l Line to see. 
+   * \param c1 First column to see.
+   * \param c2 Column after the last one to see.
+   * \pre arguments are valid.
+   * \pre c1 <= c2.
+   * \return A view of the coefficients (valid as long as the matrix is neither destroyed nor swapped).
+   */
+  Vector_View_T < T > line_view ( unsigned int const l ,
+				  unsigned int const c1 ,
+				  unsigned int const c2 ) const {
+    assert ( ( l < line_nbr ) && ( c1 <= c2 ) && ( c2 <= column_nbr ) ) ;
+    return Vector_View_T < T > ( element + l * column_nbr + c1 , c2 - c1 ) ;
+  } ;
+
+  /*!
+   * To see a part of a column as a vector, without copying it.
+   * \param l1 First line to see. 
+   * \param l2 Line after the last one to see. 
+   * \param c Column to see.
+   * \pre arguments are valid.
+   * \pre l1 <= l2.
+   * \return A view of the coefficients (valid as long as the matrix is neither destroyed nor swapped).
+   */
+  Vector_View_T < T > column_view ( unsigned int const l1 ,
+				    unsigned int const l2 ,
+				    unsigned int const c ) const {
+    assert ( ( c < column_nbr ) && ( l1 <= l2 ) && ( l2 <= line_nbr ) ) ;
+    return Vector_View_T < T > ( element + l1 * column_nbr + c , l2 - l1 , column_nbr ) ;
+  } ;
+
   /*!
    * To extract a vector in a line.
    * \param l Line to extract. 
@@ -170,11 +294,11 @@ public:
    * \param c2 Last column to extract.
    * \pre arguments are valid.
    * \pre c1 <= c2.
-   * \return An extracted copy.
+   * \return An extracted copy (see \c line_view to avoid the copy).
    */
-  Vector extract_ligne ( unsigned int const l ,
-			 unsigned int const c1 ,
-			 unsigned int const c2 ) const ; 
+  Vector_T < T > extract_ligne ( unsigned int const l ,
+				 unsigned int const c1 ,
+				 unsigned int const c2 ) const ; 
   /*!
    * To extract a vector in a column.
    * \param l1 First line to extract. 
@@ -182,49 +306,62 @@ public:
    * \param c column to extract.
    * \pre arguments are valid.
    * \pre l1 <= l2.
-   * \return An extracted copy.
+   * \return An extracted copy (see \c column_view to avoid the copy).
    */
-  Vector extract_col ( unsigned int const l1 ,
-		       unsigned int const l2 ,
-		       unsigned int const c ) const ; 
+  Vector_T < T > extract_col ( unsigned int const l1 ,
+			       unsigned int const l2 ,
+			       unsigned int const c ) const ; 
 
   /*!
    * Extract a matrix that is equal under the diagonal, one on the diagonal and zero everywhere else. 
    * \pre must be a square matrix.
    */
-  Matrix extract_triangular_lower_diag_one () const ;
+  Matrix_T extract_triangular_lower_diag_one () const ;
   
   /*!
    * Extract a matrix that is equal above the diagonal and the diagonal and zero everywhere else.
    * \pre must be a square matrix.
    */
-  Matrix extract_triangular_upper_diag () const ; 
+  Matrix_T extract_triangular_upper_diag () const ; 
 
   /*!
    * Extract a matrix that is equal on the diagonal and zero everywhere else. 
    * \pre must be a square matrix.
    */
-  Matrix extract_diagonal () const ; 
+  Matrix_T extract_diagonal () const ; 
 
   
-  friend Matrix operator * ( float const a ,
-			     Matrix const & m ) ; 
-
-  friend std::ostream & operator << ( std::ostream& ost ,
-				      Matrix const & m ) ; 
+  /*! 
+   * Compute the product of the matrix by a scalar a (defined here to accept any number, e.g. \c 2 * \c m ).
+   * \param a Float to multiply by.
+   * \param m Matrix to multiply.
+   * \return A new matric whose coordinates are the product of the coordinate of m and a.
+   */
+  friend Matrix_T operator * ( T const a ,
+			       Matrix_T const & m ) {
+    return m * a ;
+  }
 } ; 
 
 
 
 
-/*! 
- * Compute the product of the matrix by a scalar a.
- * \param a Float to multiply by.
- * \param m Matrix to multiply.
- * \return A new matric whose coordinates are the product of the coordinate of m and a.
+/*!
+ * Product on blocks of coefficients: c += a * b ,
+ * with a \c n by \c p , b \c p by \c q and c \c n by \c q , stored line after line.
+ * This is the cache-blocked kernel of \c Matrix :: \c operator* , for parts of matrices (see \c Matrix :: \c data ).
+ * Each coefficient of c gets the products in the order of the common index,
+ * so that the result is the same as with a scalar product of a line by a column.
+ * \param ld_a Distance between two lines of a (at least \c p ), the same for \c ld_b and \c ld_c .
+ * \pre c does not overlap a nor b .
  */
-Matrix operator * ( float const a ,
-		    Matrix const & m ) ; 
+template < class T >
+void multiply_add ( unsigned int const n ,
+		    unsigned int const p ,
+		    unsigned int const q ,
+		    T const * a , unsigned int const ld_a ,
+		    T const * b , unsigned int const ld_b ,
+		    T * c , unsigned int const ld_c ) ;
 
 
 /*!
@@ -233,8 +370,13 @@ Matrix operator * ( float const a ,
  * \param m Matrix to print.
  * \return The output stream.
  */
-std::ostream & operator << ( std::ostream& ost ,
-			     Matrix const & m ) ; 
+template < class T >
+std :: ostream & operator << ( std :: ostream& ost ,
+			     Matrix_T < T > const & m ) ; 
+
+
+/*! Matrix of floats (the default). */
+typedef Matrix_T < float > Matrix ;
 
 
 # endif
@@ -0,0 +1,315 @@
+# include <stdlib.h> // posix_memalign
+
+# include "counters.hpp"
+# include "simd.hpp"
+
+# if defined ( __x86_64__ ) || defined ( __i386__ )
+# define SIMD_AVX2
+# include <immintrin.h>
+# elif defined ( __ARM_NEON )
+# define SIMD_NEON
+# include <arm_neon.h>
+# endif
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*
+ * The AVX2 loops are compiled for AVX2 whatever the compilation options,
+ * and only called if the processor has it (tested once).
+ * NEON is always there with the compilers that define __ARM_NEON (only for floats).
+ * Each loop returns the number of coordinates done,
+ * the plain loops of the public functions do the last ones (or all of them).
+ */
+
+
+void * simd_allocate ( std :: size_t const bytes ) {
+  if ( 0 == bytes ) return NULL ;
+  COUNTER_ADD ( "simd_allocate" ) ;
+  COUNTER_ADD_N ( "simd_allocate bytes" , bytes ) ;
+  void * buffer = NULL ;
+  int const ret = posix_memalign ( & buffer , simd_alignment , bytes ) ;
+  assert ( 0 == ret ) ;
+  return buffer ;
+}
+
+
+void simd_free ( void * buffer ) {
+  free ( buffer ) ;
+}
+
+
+namespace {
+
+# ifdef SIMD_AVX2
+
+  bool has_avx2 () {
+    static bool const avx2 = __builtin_cpu_supports ( "avx2" ) ;
+    return avx2 ;
+  }
+
+# define SIMD_TARGET __attribute__ (( target ( "avx2" ) ))
+
+  /*!
+   * The AVX2 loops for values of type \c T , in registers of type \c R
+   * holding \c W values, with the intrinsics of suffix \c S ( _ps or _pd ).
+   * The scalar product keeps two sums of \c W products, to have two additions under way.
+   */
+# define SIMD_AVX2_LOOPS( T , R , W , S )				\
+  SIMD_TARGET unsigned int loop_add ( unsigned int const n ,		\
+				      T const * a ,			\
+				      T const * b ,			\
+				      T * c ) {				\
+    unsigned int i = 0 ;						\
+    for ( ; i + W <= n ; i += W ) {					\
+      _mm256_storeu ## S ( c + i , _mm256_add ## S ( _mm256_loadu ## S ( a + i ) , \
+						     _mm256_loadu ## S ( b + i ) ) ) ; \
+    }									\
+    return i ;								\
+  }									\
+									\
+  SIMD_TARGET unsigned int loop_subtract ( unsigned int const n ,	\
+					   T const * a ,		\
+					   T const * b ,		\
+					   T * c ) {			\
+    unsigned int i = 0 ;						\
+    for ( ; i + W <= n ; i += W ) {					\
+      _mm256_storeu ## S ( c + i , _mm256_sub ## S ( _mm256_loadu ## S ( a + i ) , \
+						     _mm256_loadu ## S ( b + i ) ) ) ; \
+    }									\
+    return i ;								\
+  }									\
+									\
+  SIMD_TARGET unsigned int loop_scale ( unsigned int const n ,		\
+					T const x ,			\
+					T const * a ,			\
+					T * c ) {			\
+    R const xs = _mm256_set1 ## S ( x ) ;				\
+    unsigned int i = 0 ;						\
+    for ( ; i + W <= n ; i += W ) {					\
+      _mm256_storeu ## S ( c + i , _mm256_mul ## S ( xs , _mm256_loadu ## S ( a + i ) ) ) ; \
+    }									\
+    return i ;								\
+  }									\
+									\
+  SIMD_TARGET unsigned int loop_add_scaled ( unsigned int const n ,	\
+					     T const x ,		\
+					     T const * a ,		\
+					     T * c ) {			\
+    R const xs = _mm256_set1 ## S ( x ) ;				\
+    unsigned int i = 0 ;						\
+    for ( ; i + W <= n ; i += W ) {					\
+      _mm256_storeu ## S ( c + i , _mm256_add ## S ( _mm256_loadu ## S ( c + i ) , \
+						     _mm256_mul ## S ( xs , _mm256_loadu ## S ( a + i ) ) ) ) ; \
+    }									\
+    return i ;								\
+  }									\
+									\
+  SIMD_TARGET unsigned int loop_dot ( unsigned int const n ,		\
+				      T const * a ,			\
+				      T const * b ,			\
+				      T & sum ) {			\
+    R s0 = _mm256_setzero ## S () ;					\
+    R s1 = _mm256_setzero ## S () ;					\
+    unsigned int i = 0 ;						\
+    for ( ; i + 2 * W <= n ; i += 2 * W ) {				\
+      s0 = _mm256_add ## S ( s0 , _mm256_mul ## S ( _mm256_loadu ## S ( a + i ) , \
+						    _mm256_loadu ## S ( b + i ) ) ) ; \
+      s1 = _mm256_add ## S ( s1 , _mm256_mul ## S ( _mm256_loadu ## S ( a + i + W ) , \
+						    _mm256_loadu ## S ( b + i + W ) ) ) ; \
+    }									\
+    T partial [ W ] ;							\
+    _mm256_storeu ## S ( partial , _mm256_add ## S ( s0 , s1 ) ) ;	\
+    sum = 0 ;								\
+    for ( unsigned int k = 0 ; k < W ; k ++ ) {				\
+      sum += partial [ k ] ;						\
+    }									\
+    return i ;								\
+  }
+
+  SIMD_AVX2_LOOPS ( float , __m256 , 8 , _ps )
+  SIMD_AVX2_LOOPS ( double , __m256d , 4 , _pd )
+
+# undef SIMD_AVX2_LOOPS
+# undef SIMD_TARGET
+
+  /*! Call the vector loop if there is AVX2, otherwise nothing is done. */
+# define SIMD_CALL( loop_call ) ( has_avx2 () ? loop_call : 0 )
+
+# elif defined ( SIMD_NEON )
+
+  unsigned int loop_add ( unsigned int const n ,
+			  float const * a ,
+			  float const * b ,
+			  float * c ) {
+    unsigned int i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 ) {
+      vst1q_f32 ( c + i , vaddq_f32 ( vld1q_f32 ( a + i ) , vld1q_f32 ( b + i ) ) ) ;
+    }
+    return i ;
+  }
+
+  unsigned int loop_subtract ( unsigned int const n ,
+			       float const * a ,
+			       float const * b ,
+			       float * c ) {
+    unsigned int i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 ) {
+      vst1q_f32 ( c + i , vsubq_f32 ( vld1q_f32 ( a + i ) , vld1q_f32 ( b + i ) ) ) ;
+    }
+    return i ;
+  }
+
+  unsigned int loop_scale ( unsigned int const n ,
+			    float const x ,
+			    float const * a ,
+			    float * c ) {
+    unsigned int i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 ) {
+      vst1q_f32 ( c + i , vmulq_n_f32 ( vld1q_f32 ( a + i ) , x ) ) ;
+    }
+    return i ;
+  }
+
+  unsigned int loop_add_scaled ( unsigned int const n ,
+				 float const x ,
+				 float const * a ,
+				 float * c ) {
+    unsigned int i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 ) {
+      vst1q_f32 ( c + i , vaddq_f32 ( vld1q_f32 ( c + i ) , vmulq_n_f32 ( vld1q_f32 ( a + i ) , x ) ) ) ;
+    }
+    return i ;
+  }
+
+  unsigned int loop_dot ( unsigned int const n ,
+			  float const * a ,
+			  float const * b ,
+			  float & sum ) {
+    float32x4_t s = vdupq_n_f32 ( 0 ) ;
+    unsigned int i = 0 ;
+    for ( ; i + 4 <= n ; i += 4 ) {
+      s = vaddq_f32 ( s , vmulq_f32 ( vld1q_f32 ( a + i ) , vld1q_f32 ( b + i ) ) ) ;
+    }
+    float partial [ 4 ] ;
+    vst1q_f32 ( partial , s ) ;
+    sum = partial [ 0 ] + partial [ 1 ] + partial [ 2 ] + partial [ 3 ] ;
+    return i ;
+  }
+
+  /*! The doubles are left to the plain loops. */
+  unsigned int loop_add ( unsigned int , double const * , double const * , double * ) { return 0 ; }
+  unsigned int loop_subtract ( unsigned int , double const * , double const * , double * ) { return 0 ; }
+  unsigned int loop_scale ( unsigned int , double , double const * , double * ) { return 0 ; }
+  unsigned int loop_add_scaled ( unsigned int , double , double const * , double * ) { return 0 ; }
+  unsigned int loop_dot ( unsigned int , double const * , double const * , double & sum ) { sum = 0 ; return 0 ; }
+
+# define SIMD_CALL( loop_call ) ( loop_call )
+
+# else
+
+# define SIMD_CALL( loop_call ) 0
+
+# endif
+
+
+  template < class T >
+  void add ( unsigned int const n ,
+	     T const * a ,
+	     T const * b ,
+	     T * c ) {
+    for ( unsigned int i = SIMD_CALL ( loop_add ( n , a , b , c ) ) ; i < n ; i ++ ) {
+      c [ i ] = a [ i ] + b [ i ] ;
+    }
+  }
+
+  template < class T >
+  void subtract ( unsigned int const n ,
+		  T const * a ,
+		  T const * b ,
+		  T * c ) {
+    for ( unsigned int i = SIMD_CALL ( loop_subtract ( n , a , b , c ) ) ; i < n ; i ++ ) {
+      c [ i ] = a [ i ] - b [ i ] ;
+    }
+  }
+
+  template < class T >
+  void scale ( unsigned int const n ,
+	       T const x ,
+	       T const * a ,
+	       T * c ) {
+    for ( unsigned int i = SIMD_CALL ( loop_scale ( n , x , a , c ) ) ; i < n ; i ++ ) {
+      c [ i ] = x * a [ i ] ;
+    }
+  }
+
+  template < class T >
+  void add_scaled ( unsigned int const n ,
+		    T const x ,
+		    T const * a ,
+		    T * c ) {
+    for ( unsigned int i = SIMD_CALL ( loop_add_scaled ( n , x , a , c ) ) ; i < n ; i ++ ) {
+      c [ i ] += x * a [ i ] ;
+    }
+  }
+
+  template < class T >
+  T dot ( unsigned int const n ,
+	  T const * a ,
+	  T const * b ) {
+    T sum = 0 ;
+    for ( unsigned int i = SIMD_CALL ( loop_dot ( n , a , b , sum ) ) ; i < n ; i ++ ) {
+      sum += a [ i ] * b [ i ] ;
+    }
+    return sum ;
+  }
+
+}
+
+
+void simd_add ( unsigned int const n , float const * a , float const * b , float * c ) {
+  add ( n , a , b , c ) ;
+}
+
+void simd_add ( unsigned int const n , double const * a , double const * b , double * c ) {
+  add ( n , a , b , c ) ;
+}
+
+
+void simd_subtract ( unsigned int const n , float const * a , float const * b , float * c ) {
+  subtract ( n , a , b , c ) ;
+}
+
+void simd_subtract ( unsigned int const n , double const * a , double const * b , double * c ) {
+  subtract ( n , a , b , c ) ;
+}
+
+
+void simd_scale ( unsigned int const n , float const x , float const * a , float * c ) {
+  scale ( n , x , a , c ) ;
+}
+
+void simd_scale ( unsigned int const n , double const x , double const * a , double * c ) {
+  scale ( n , x , a , c ) ;
+}
+
+
+void simd_add_scaled ( unsigned int const n , float const x , float const * a , float * c ) {
+  add_scaled ( n , x , a , c ) ;
+}
+
+void simd_add_scaled ( unsigned int const n , double const x , double const * a , double * c ) {
+  add_scaled ( n , x , a , c ) ;
+}
+
+
+float simd_dot ( unsigned int const n , float const * a , float const * b ) {
+  return dot ( n , a , b ) ;
+}
+
+double simd_dot ( unsigned int const n , double const * a , double const * b ) {
+  return dot ( n , a , b ) ;
+}
@@ -0,0 +1,98 @@
+# ifndef __SIMD_HPP_
+# define __SIMD_HPP_
+
+/* ! \file
+ * \brief This module provides the buffers and the loops on arrays of floats (or doubles) used by \c Vector_T and \c Matrix_T .
+ *
+ * Each loop uses the vector instructions of the processor
+ * (AVX2 if the processor running the program has them, NEON on ARM)
+ * and plain loops otherwise.
+ * The arrays may overlap only if they are the same (e.g. \c c is \c a ).
+ * Each function exists for \c float and for \c double .
+ *
+ * \author PASD
+ * \date 2016
+ */
+
+# include <cstddef>
+
+
+/*! Alignment of the buffers, in bytes: a cache line (more than the 32 bytes of an AVX register). */
+std :: size_t const simd_alignment = 64 ;
+
+/*!
+ * Allocate a buffer aligned on \c simd_alignment (to be freed by \c simd_free ).
+ * \param bytes Size of the buffer, in bytes (0 gives NULL).
+ */
+void * simd_allocate ( std :: size_t const bytes ) ;
+
+/*! Free a buffer of \c simd_allocate (NULL is accepted). */
+void simd_free ( void * buffer ) ;
+
+
+/*!
+ * c = a + b , coordinate-wise.
+ * \param n Number of values of each array.
+ */
+void simd_add ( unsigned int const n ,
+		float const * a ,
+		float const * b ,
+		float * c ) ;
+void simd_add ( unsigned int const n ,
+		double const * a ,
+		double const * b ,
+		double * c ) ;
+
+/*!
+ * c = a - b , coordinate-wise.
+ * \param n Number of values of each array.
+ */
+void simd_subtract ( unsigned int const n ,
+		     float const * a ,
+		     float const * b ,
+		     float * c ) ;
+void simd_subtract ( unsigned int const n ,
+		     double const * a ,
+		     double const * b ,
+		     double * c ) ;
+
+/*!
+ * c = x * a , coordinate-wise.
+ * \param n Number of values of each array.
+ */
+void simd_scale ( unsigned int const n ,
+		  float const x ,
+		  float const * a ,
+		  float * c ) ;
+void simd_scale ( unsigned int const n ,
+		  double const x ,
+		  double const * a ,
+		  double * c ) ;
+
+/*!
+ * c = c + x * a , coordinate-wise (the product is rounded before the sum).
+ * \param n Number of values of each array.
+ */
+void simd_add_scaled ( unsigned int const n ,
+		       float const x ,
+		       float const * a ,
+		       float * c ) ;
+void simd_add_scaled ( unsigned int const n ,
+		       double const x ,
+		       double const * a ,
+		       double * c ) ;
+
+/*!
+ * Scalar product of a and b .
+ * The products are summed by packets, so the rounding may differ from a plain loop.
+ * \param n Number of values of each array.
+ */
+float simd_dot ( unsigned int const n ,
+		 float const * a ,
+		 float const * b ) ;
+double simd_dot ( unsigned int const n ,
+		  double const * a ,
+		  double const * b ) ;
+
+
+# endif
@@ -0,0 +1,136 @@
+# include <algorithm> // sort, lower_bound
+
+# include "sparse_matrix.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+using namespace std ;
+
+
+namespace {
+
+  /*! Order of the coefficients: line after line, by increasing columns. */
+  template < class T >
+  bool before ( typename Sparse_Matrix_T < T > :: Entry const & e1 ,
+		typename Sparse_Matrix_T < T > :: Entry const & e2 ) {
+    return ( e1 . line < e2 . line ) || ( ( e1 . line == e2 . line ) && ( e1 . column < e2 . column ) ) ;
+  }
+
+}
+
+
+template < class T >
+Sparse_Matrix_T < T > :: Sparse_Matrix_T ( unsigned int const _line_nbr ,
+					   unsigned int const _column_nbr )
+  : line_nbr ( _line_nbr )
+  , column_nbr ( _column_nbr )
+  , line_start ( _line_nbr + 1 , 0 ) {
+}
+
+
+template < class T >
+Sparse_Matrix_T < T > :: Sparse_Matrix_T ( unsigned int const _line_nbr ,
+					   unsigned int const _column_nbr ,
+					   vector < Entry > entries )
+  : line_nbr ( _line_nbr )
+  , column_nbr ( _column_nbr )
+  , line_start ( _line_nbr + 1 , 0 ) {
+  sort ( entries . begin () , entries . end () , before < T > ) ;
+  column . reserve ( entries . size () ) ;
+  value . reserve ( entries . size () ) ;
+  for ( unsigned int k = 0 ; k < entries . size () ; ) {
+    Entry const & e = entries [ k ] ;
+    assert ( ( e . line < line_nbr ) && ( e . column < column_nbr ) ) ;
+    T sum = 0 ;
+    for ( ; ( k < entries . size () ) && ( e . line == entries [ k ] . line ) && ( e . column == entries [ k ] . column ) ; k ++ ) {
+      sum += entries [ k ] . value ;
+    }
+    if ( 0 != sum ) {
+      column . push_back ( e . column ) ;
+      value . push_back ( sum ) ;
+      line_start [ e . line + 1 ] ++ ;
+    }
+  }
+  // the numbers of coefficients of the lines become the positions
+  for ( unsigned int l = 0 ; l < line_nbr ; l ++ ) {
+    line_start [ l + 1 ] += line_start [ l ] ;
+  }
+}
+
+
+template < class T >
+Sparse_Matrix_T < T > :: Sparse_Matrix_T ( Matrix_T < T > const & m )
+  : line_nbr ( m . get_line_nbr () )
+  , column_nbr ( m . get_column_nbr () )
+  , line_start ( m . get_line_nbr () + 1 , 0 ) {
+  for ( unsigned int l = 0 ; l < line_nbr ; l ++ ) {
+    for ( unsigned int c = 0 ; c < column_nbr ; c ++ ) {
+      if ( 0 != m ( l , c ) ) {
+	column . push_back ( c ) ;
+	value . push_back ( m ( l , c ) ) ;
+      }
+    }
+    line_start [ l + 1 ] = value . size () ;
+  }
+}
+
+
+template < class T >
+T Sparse_Matrix_T < T > :: operator () ( unsigned int const line ,
+					 unsigned int const col ) const {
+  assert ( line < line_nbr ) ;
+  assert ( col < column_nbr ) ;
+  vector < unsigned int > :: const_iterator const first = column . begin () + line_start [ line ] ;
+  vector < unsigned int > :: const_iterator const last = column . begin () + line_start [ line + 1 ] ;
+  vector < unsigned int > :: const_iterator const it = lower_bound ( first , last , col ) ;
+  return ( ( last != it ) && ( col == * it ) ) ? value [ it - column . begin () ] : 0 ;
+}
+
+
+template < class T >
+Matrix_T < T > Sparse_Matrix_T < T > :: to_dense () const {
+  Matrix_T < T > m ( line_nbr , column_nbr ) ;
+  for ( unsigned int l = 0 ; l < line_nbr ; l ++ ) {
+    for ( unsigned int k = line_start [ l ] ; k < line_start [ l + 1 ] ; k ++ ) {
+      m ( l , column [ k ] ) = value [ k ] ;
+    }
+  }
+  return m ;
+}
+
+
+template < class T >
+void Sparse_Matrix_T < T > :: multiply ( Vector_T < T > const & v ,
+					 Vector_T < T > & w ) const {
+  assert ( column_nbr == v . get_size () ) ;
+  assert ( line_nbr == w . get_size () ) ;
+  assert ( & v != & w ) ;
+  // directly on the buffers: this loop is all the work of the iterative methods
+  T const * const x = v . data () ;
+  T * const y = w . data () ;
+  unsigned int const * const col = column . empty () ? NULL : & column [ 0 ] ;
+  T const * const val = value . empty () ? NULL : & value [ 0 ] ;
+  for ( unsigned int l = 0 ; l < line_nbr ; l ++ ) {
+    T sum = 0 ;
+    for ( unsigned int k = line_start [ l ] ; k < line_start [ l + 1 ] ; k ++ ) {
+      sum += val [ k ] * x [ col [ k ] ] ;
+    }
+    y [ l ] = sum ;
+  }
+}
+
+
+template < class T >
+Vector_T < T > Sparse_Matrix_T < T > :: operator * ( Vector_T < T > const & v ) const {
+  Vector_T < T > w ( line_nbr ) ;
+  multiply ( v , w ) ;
+  return w ;
+}
+
+
+// the two types of coefficients
+template class Sparse_Matrix_T < float > ;
+template class Sparse_Matrix_T < double > ;
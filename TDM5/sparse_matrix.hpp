@@ -0,0 +1,124 @@
+# ifndef __SPARSE_MATRIX_HPP_
+# define __SPARSE_MATRIX_HPP_
+
+/* !
+ * \brief This module handles sparse matrices of floats (or doubles), mostly made of zeros.
+ *
+ * Only the non-zero coefficients are stored, line after line (CSR, compressed sparse rows),
+ * so that the memory is proportional to their number and not to the size of the matrix.
+ *
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+
+# include "matrix.hpp"
+# include "vector.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+/*!
+ * Sparse matrix of floats (or doubles: \c T is the type of the coefficients).
+ * The non-zero coefficients of line \c l are \c value [ \c k ] at column \c column [ \c k ] ,
+ * for \c k from \c line_start [ \c l ] to \c line_start [ \c l + 1 ] (excluded), by increasing columns.
+ * \c Sparse_Matrix is the sparse matrix of floats.
+ */
+template < class T >
+class Sparse_Matrix_T {
+
+  /*! Number of lines. */
+  unsigned int line_nbr ;
+
+  /*! Number of columns. */
+  unsigned int column_nbr ;
+
+  /*! Position of the first coefficient of each line ( \c line_nbr + 1 of them, the last one is the number of coefficients). */
+  std :: vector < unsigned int > line_start ;
+
+  /*! Column of each coefficient. */
+  std :: vector < unsigned int > column ;
+
+  /*! Value of each coefficient. */
+  std :: vector < T > value ;
+
+public:
+
+  /*! A coefficient, to build a matrix. */
+  struct Entry {
+    unsigned int line ;
+    unsigned int column ;
+    T value ;
+  } ;
+
+  /*! To construct a \c _line_nbr by \c _column_nbr matrix of zeros. */
+  Sparse_Matrix_T ( unsigned int const _line_nbr ,
+		    unsigned int const _column_nbr ) ;
+
+  /*!
+   * To construct a \c _line_nbr by \c _column_nbr matrix from its coefficients, in any order.
+   * The coefficients at the same position are summed, those equal to zero are not kept.
+   * \pre The positions are inside the matrix.
+   */
+  Sparse_Matrix_T ( unsigned int const _line_nbr ,
+		    unsigned int const _column_nbr ,
+		    std :: vector < Entry > entries ) ;
+
+  /*! To construct the sparse version of a (dense) matrix: its coefficients that are not zero. */
+  explicit Sparse_Matrix_T ( Matrix_T < T > const & m ) ;
+
+  /*! To access the number of lines. */
+  unsigned int get_line_nbr () const {
+    return line_nbr ;
+  }
+
+  /*! To access the number of columns. */
+  unsigned int get_column_nbr () const {
+    return column_nbr ;
+  }
+
+  /*! To access the number of coefficients that are stored. */
+  unsigned int get_nonzero_nbr () const {
+    return value . size () ;
+  }
+
+  /*!
+   * To read any coefficient of the matrix (found by dichotomy in its line).
+   * \pre arguments are valid.
+   * \return The coefficient at position (line,column), zero if it is not stored.
+   */
+  T operator () ( unsigned int const line ,
+		  unsigned int const column ) const ;
+
+  /*! A dense copy (to be used only if it fits in memory). */
+  Matrix_T < T > to_dense () const ;
+
+  /*!
+   * Matrix-vector multiplication, in the place of a vector (no allocation, e.g. in iterative methods).
+   * \param v Vector to multiply by.
+   * \param w Vector to write the product in.
+   * \pre The number of columns of this should be equal to the dimension of v, the number of lines to the one of w.
+   * \pre v and w are not the same.
+   */
+  void multiply ( Vector_T < T > const & v ,
+		  Vector_T < T > & w ) const ;
+
+  /*!
+   * Matrix-vector multiplication operator.
+   * \param v Vector to multiply by.
+   * \pre The number of columns of this should be equal to the dimension of v.
+   * \return A new Vector whose coordinates are the scalar product of lines of this and v.
+   */
+  Vector_T < T > operator * ( Vector_T < T > const & v ) const ;
+} ;
+
+
+/*! Sparse matrix of floats (the default). */
+typedef Sparse_Matrix_T < float > Sparse_Matrix ;
+
+
+# endif
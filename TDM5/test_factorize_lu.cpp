@@ -50,6 +50,80 @@ namespace {
   }
 
 
+  /*!
+   * Compute the decomposition with pivoting and solve m x = b for each vector b of the basis.
+   * \param m Matrix to decompose.
+   */
+  static void test_solve ( Matrix const & m ) {
+    unsigned int const n = m . get_line_nbr () ;
+    Factorization_LU const f ( m ) ;
+    cout << "Factorisation LU avec pivot de :" << endl ; 
+    cout << m ;
+    cout << "Permutation :" ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      cout << " " << f . get_permutation () [ i ] ;
+    }
+    cout << endl ;
+    cout << "Vérification M x = b pour la base : " ;
+    bool ok = true ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      Vector b ( n ) ;
+      b [ i ] = 1 ;
+      Vector x ( b ) ;
+      f . solve ( x ) ;
+      Vector r = m * x - b ;
+      ok = ok && ( ( r | r ) < 1e-8 ) ;
+    }
+    cout << ( ok ? "yes" : "NO!" ) << endl ;
+  }
+
+
+  /*!
+   * Decompose a random matrix (by many panels) with one and with many threads,
+   * check that the factors are the same and solve a system.
+   * \param n size of the matrix.
+   * \param nbr_threads number of threads.
+   */
+  static void test_blocked ( unsigned int const n ,
+			     unsigned int const nbr_threads ) {
+    Matrix m ( n , n ) ;
+    m . init_alea () ;
+    cout << "Factorisation LU par blocs, taille " << n << ", " << nbr_threads << " threads : " ;
+    Factorization_LU const f_1 ( m ) ;
+    Factorization_LU const f_t ( m , nbr_threads ) ;
+    bool const same = ( f_1 . get_lu () == f_t . get_lu () ) && ( f_1 . get_permutation () == f_t . get_permutation () ) ;
+    Vector b ( n ) ;
+    b . init_alea () ;
+    Vector x ( b ) ;
+    f_t . solve ( x ) ;
+    Vector r = m * x - b ;
+    cout << ( same ? "same" : "DIFFERENT" ) << ", " << ( ( r | r ) < 1e-6 * ( b | b ) ? "yes" : "NO!" ) << endl ;
+  }
+
+
+  /*!
+   * Solve H x = H 1 , H being the Hilbert matrix (ill-conditioned), with coefficients of type T.
+   * \param n size of the matrix.
+   * \return true if the solution is 1 up to 1e-6 .
+   */
+  template < class T >
+  static bool test_hilbert ( unsigned int const n ) {
+    Matrix_T < T > h ( n , n ) ;
+    Vector_T < T > one ( n ) ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      one [ i ] = 1 ;
+      for ( unsigned int j = 0 ; j < n ; j ++ ) {
+	h ( i , j ) = T ( 1 ) / ( i + j + 1 ) ;
+      }
+    }
+    Vector_T < T > x = h * one ;
+    Factorization_LU_T < T > const f ( h ) ;
+    f . solve ( x ) ;
+    Vector_T < T > const e = x - one ;
+    return ( e | e ) < 1e-12 ;
+  }
+
+
   // To simplify writing to the maximum
 # define TEST_LU( n , ... )				\
   {							\
@@ -59,6 +133,14 @@ namespace {
     test_LU ( m ) ;					\
   }
 
+# define TEST_SOLVE( n , ... )				\
+  {							\
+    Matrix m ( n , n ) ;				\
+    float coefficients [ n * n ] = { __VA_ARGS__ } ;	\
+    m . init ( coefficients ) ;				\
+    test_solve ( m ) ;					\
+  }
+
 }
 
 int main ( void ) {
@@ -68,6 +150,12 @@ int main ( void ) {
   TEST_LU ( 4 , 2 , 1 , 2 , 3 , 4 , 4 , 3 , 3 , 0 , 5 , 1 , 2 , 1 , 0 , 5 , 8 ) ;
   TEST_LU ( 5 , 2 , 1 , 2 , 3 , 4 , 4 , 3 , 3 , 0 , 5 , 1 , 2 , 1 , 0 , 5 , 8 , 5 , 1 , 6 , 1 , 8 , 10 , 1 , 2 , 0 ) ;
   TEST_LU ( 6 , 2 , 1 , 2 , 3 , 4 , 4 , 3 , 3 , 0 , 5 , 1 , 2 , 1 , 0 , 5 , 8 , 5 , 1 , 6 , 1 , 8 , 10 , 1 , 2 , 0 , 16 , 12 , 5 , 13 , 16 , 2 , 8 , 10 , 7 , 3 , 25 ) ;
+  TEST_SOLVE ( 2 , 0 , 1 , 1 , 0 ) ;
+  TEST_SOLVE ( 3 , 2 , 1 , 2 , 3 , 4 , 4 , 3 , 3 , 0 ) ;
+  TEST_SOLVE ( 6 , 2 , 1 , 2 , 3 , 4 , 4 , 3 , 3 , 0 , 5 , 1 , 2 , 1 , 0 , 5 , 8 , 5 , 1 , 6 , 1 , 8 , 10 , 1 , 2 , 0 , 16 , 12 , 5 , 13 , 16 , 2 , 8 , 10 , 7 , 3 , 25 ) ;
+  test_blocked ( 300 , 4 ) ;
+  cout << "Hilbert 6 en float : " << ( test_hilbert < float > ( 6 ) ? "précis" : "imprécis" )
+       << ", en double : " << ( test_hilbert < double > ( 6 ) ? "précis" : "imprécis" ) << endl ;
   return 0 ; 
 }
 
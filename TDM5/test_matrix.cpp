@@ -5,6 +5,8 @@
  * \date 2016
  */
 
+# include <stdio.h> // remove
+
 # include "matrix.hpp"
 
 # undef NDEBUG
@@ -53,5 +55,26 @@ int main ( void ) {
   cout << "M1 + 2 fois l'identité :" << endl ; 
   cout << m1 + 2 * id ; 
 
+  // Binary files: read, mapped, and mapped for writing
+  char const * const file_name = "test_matrix.bin" ;
+  assert ( m2 . save ( file_name ) ) ;
+  Matrix * const loaded = Matrix :: load ( file_name ) ;
+  Matrix * const mapped = Matrix :: map ( file_name ) ;
+  cout << "M2 == load ( M2 ) |- " << ( m2 == * loaded ) << endl ;
+  cout << "M2 == map ( M2 ) |- " << ( m2 == * mapped ) << " , mapped |- " << mapped -> is_mapped () << endl ;
+  ( * mapped ) ( 0 , 0 ) = 42 ; // only in this process
+  Matrix * const shared = Matrix :: map ( file_name , true ) ;
+  cout << "M2 ( 0 , 0 ) == shared ( 0 , 0 ) |- " << ( m2 ( 0 , 0 ) == ( * shared ) ( 0 , 0 ) ) << endl ;
+  ( * shared ) ( 0 , 0 ) = 42 ; // in the file
+  delete shared ;
+  Matrix * const reloaded = Matrix :: load ( file_name ) ;
+  cout << "load ( M2 ) ( 0 , 0 ) after writing |- " << ( * reloaded ) ( 0 , 0 ) << endl ;
+  cout << "Wrong type |- " << ( NULL == Matrix_T < double > :: map ( file_name ) ) << endl ;
+  delete loaded ;
+  delete mapped ;
+  delete reloaded ;
+  remove ( file_name ) ;
+  cout << "No file |- " << ( NULL == Matrix :: load ( file_name ) ) << endl ;
+
   return 0 ; 
 }
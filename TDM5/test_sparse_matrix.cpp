@@ -0,0 +1,86 @@
+/*! \file
+ * \brief This file is meant to test sparse matrix implantation.
+ * 
+ * \author PASD
+ * \date 2017
+ */
+
+# include <vector>
+
+# include "sparse_matrix.hpp"
+
+# undef NDEBUG
+# include <assert.h>
+
+using namespace std ; 
+
+
+namespace {
+  const int size = 5 ;
+
+  /*! Sparse matrix of the discrete laplacian (tridiagonal -1 2 -1) of dimension n. */
+  Sparse_Matrix laplacian ( unsigned int const n ) {
+    vector < Sparse_Matrix :: Entry > entries ;
+    for ( unsigned int i = 0 ; i < n ; i ++ ) {
+      Sparse_Matrix :: Entry const diag = { i , i , 2 } ;
+      entries . push_back ( diag ) ;
+      if ( 0 < i ) {
+	Sparse_Matrix :: Entry const left = { i , i - 1 , -1 } ;
+	entries . push_back ( left ) ;
+      }
+      if ( i + 1 < n ) {
+	Sparse_Matrix :: Entry const right = { i , i + 1 , -1 } ;
+	entries . push_back ( right ) ;
+      }
+    }
+    return Sparse_Matrix ( n , n , entries ) ;
+  }
+}
+
+  
+int main ( void ) {
+
+  // Conversions from and to dense matrices
+  Matrix m1 ( size , size ) ; 
+  float tab [ size * size ] = { 4 , 0 , 0 , 3 , 0 , 0 , 3 , 0 , 0 , 5 , 8 , 0 , 12 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 10 , 0 , 23 , 25 } ; 
+  m1 . init ( tab ) ; 
+  Sparse_Matrix s1 ( m1 ) ;
+
+  cout << "Matrice M1 :" << endl ; 
+  cout << m1 ; 
+  cout << "Coefficients non nuls de M1 : " << s1 . get_nonzero_nbr () << endl ;
+  cout << "M1 == dense ( sparse ( M1 ) ) |- " << ( m1 == s1 . to_dense () ) << endl ;
+  cout << "M1 ( 4 , 3 ) = " << s1 ( 4 , 3 ) << " , M1 ( 3 , 3 ) = " << s1 ( 3 , 3 ) << endl ;
+
+  // Matrix-vector multiplication, same as the dense one
+  cout << "Product of M1 by all basis vectors:" << endl ;
+  for ( int i = 0 ; i < size ; i ++ ) {
+    Vector v ( size ) ;
+    v [ i ] = 1 ;
+    cout << s1 * v ;
+    assert ( m1 * v == s1 * v ) ;
+  }
+
+  // Construction from coefficients in any order, with duplicates and zeros
+  vector < Sparse_Matrix :: Entry > entries ;
+  Sparse_Matrix :: Entry const e [] = { { 2 , 1 , 1 } , { 0 , 3 , 2 } , { 2 , 1 , 3 } , { 1 , 0 , 0 } , { 0 , 0 , 5 } , { 1 , 2 , 1 } , { 1 , 2 , -1 } } ;
+  entries . assign ( e , e + sizeof ( e ) / sizeof ( e [ 0 ] ) ) ;
+  Sparse_Matrix s2 ( 3 , 4 , entries ) ;
+  cout << "Matrice M2 :" << endl ; 
+  cout << s2 . to_dense () ;
+  cout << "Coefficients non nuls de M2 : " << s2 . get_nonzero_nbr () << endl ;
+
+  // Large matrix, too large to be dense: laplacian of dimension 10^6
+  unsigned int const n = 1000000 ;
+  Sparse_Matrix const lap = laplacian ( n ) ;
+  Vector ones ( n ) ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) ones [ i ] = 1 ;
+  Vector w ( n ) ;
+  lap . multiply ( ones , w ) ;
+  float sum = 0 ;
+  for ( unsigned int i = 0 ; i < n ; i ++ ) sum += w [ i ] ;
+  cout << "Laplacien de dimension " << n << " : " << lap . get_nonzero_nbr () << " coefficients non nuls , "
+       << "L * 1 = ( " << w [ 0 ] << " , " << w [ 1 ] << " , ... , " << w [ n - 1 ] << " ) , somme " << sum << endl ;
+
+  return 0 ; 
+}
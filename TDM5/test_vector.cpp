@@ -5,6 +5,8 @@
  * \date 2016
  */
 
+# include <stdio.h> // remove
+
 # include "vector.hpp"
 
 
@@ -44,5 +46,13 @@ int main ( int argc ,
 
   cout << ( v4 | v4 ) << endl; 
 
+  // Binary file
+  char const * const file_name = "test_vector.bin" ;
+  assert ( v2 . save ( file_name ) ) ;
+  Vector * const loaded = Vector :: load ( file_name ) ;
+  cout << "v2 == load ( v2 ) |- " << ( v2 == * loaded ) << endl ;
+  delete loaded ;
+  remove ( file_name ) ;
+
   return 0 ; 
 }
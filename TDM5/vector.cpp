@@ -1,123 +1,219 @@
+# include <algorithm> // swap
 # include <stdlib.h>
 
+# include "binary_file.hpp"
 # include "vector.hpp"
+# include "simd.hpp"
 
 
+# ifndef RELEASE
 # undef NDEBUG
+# endif
 # include <assert.h>
 
 
 using namespace std ; 
 
 
-// Might prove usefull
-# define COPY_VECT( v_dest , v_source )					\
-  {									\
-    ( v_dest ) . size = ( v_source ) . size ;				\
-    element = new float [ size ] ;					\
-    for ( unsigned int i = 0 ; i < size ; i++ ) {			\
-      ( v_dest ) . element [ i ] = ( v_source ) . element [ i ] ;	\
-    }									\
-  }
+template < class T >
+Vector_T < T > :: Vector_T ( const Vector_T < T > & v )
+	: size ( v . size )
+	, element ( static_cast < T * > ( simd_allocate ( v . size * sizeof ( T ) ) ) ) {
+	for(unsigned int i=0;i<size;i++){
+		element[i]=v.element[i];
+	}
+}
 
 
-Vector :: Vector ( const Vector & v ) {
-	Vector w (v.size);
-	COPY_VECT(w,v);
+template < class T >
+Vector_T < T > :: ~Vector_T () { 
+	simd_free(element);
 }
 
-Vector :: ~Vector () { 
-	delete [] element;
+
+template < class T >
+bool Vector_T < T > :: save ( char const * const file_name ) const {
+	return binary_save(file_name,sizeof(T),size,1,element);
 }
 
 
-void Vector :: init_alea () { 
+template < class T >
+Vector_T < T > * Vector_T < T > :: load ( char const * const file_name ) {
+	unsigned int l,c;
+	void * coefficients;
+	if(!binary_load(file_name,sizeof(T),l,c,coefficients)) return NULL;
+	if(1!=c){
+		cerr << "ERROR " << file_name << " has " << c << " columns instead of 1" << endl;
+		simd_free(coefficients);
+		return NULL;
+	}
+	Vector_T < T > * const v = new Vector_T < T > (0);
+	v->size=l;
+	v->element=static_cast < T * > (coefficients);
+	return v;
+}
+
+
+template < class T >
+void Vector_T < T > :: init_alea () { 
   for ( unsigned int i = 0 ; i < size ; i++ ) {	
     element[ i ] = drand48 () ; 
   }					
 }
 
 
-float & Vector :: operator [] ( unsigned int const i ) { 
+template < class T >
+T & Vector_T < T > :: operator [] ( unsigned int const i ) { 
   return element[i] ;
 }
 
 
-float const & Vector :: operator [] ( unsigned int const i ) const { 
+template < class T >
+T const & Vector_T < T > :: operator [] ( unsigned int const i ) const { 
   return element[i];
 }
 
 
-std :: ostream & operator << ( std :: ostream& ost ,Vector const & v ) {
-	ost << "("<< v.element[0] <<"," ;
-	for(unsigned int i=1;i<v.size-1;i++){
-		ost << v.element[i]<<",";
+template < class T >
+std :: ostream & operator << ( std :: ostream& ost ,Vector_T < T > const & v ) {
+	ost << "("<< v[0] <<"," ;
+	for(unsigned int i=1;i<v.get_size()-1;i++){
+		ost << v[i]<<",";
 	}
-	cout << v.element[v.size-1] << ")"<< endl ;
+	ost << v[v.get_size()-1] << ")"<< endl ;
  	return ost ; 
 }
 
 
-Vector & Vector :: operator = ( Vector const & v ) {
-	*this=v;
+template < class T >
+Vector_T < T > & Vector_T < T > :: operator = ( Vector_T < T > const & v ) {
+	if(size!=v.size){
+		Vector_T < T > w(v);
+		swap(w);
+	}else if(this!=&v){
+		for(unsigned int i=0;i<size;i++){
+			element[i]=v.element[i];
+		}
+	}
   return ( * this ) ; 
 }
 
 
-Vector Vector :: operator + ( Vector const & v ) const {
+template < class T >
+void Vector_T < T > :: swap ( Vector_T < T > & v ) {
+	std::swap(size,v.size);
+	std::swap(element,v.element);
+}
+
+
+template < class T >
+Vector_T < T > & Vector_T < T > :: operator += ( Vector_T < T > const & v ) {
 	assert(size==v.size);
-	Vector s(size);
-	s.size=size;
-	for(unsigned int i=0;i<size;i++){
-		s.element[i]=element[i]+v.element[i];
-	}
+	simd_add(size,element,v.element,element);
+	return ( * this ) ;
+}
+
+
+template < class T >
+Vector_T < T > & Vector_T < T > :: operator -= ( Vector_T < T > const & v ) {
+	assert(size==v.size);
+	simd_subtract(size,element,v.element,element);
+	return ( * this ) ;
+}
+
+
+template < class T >
+Vector_T < T > & Vector_T < T > :: operator *= ( T const a ) {
+	simd_scale(size,a,element,element);
+	return ( * this ) ;
+}
+
+
+template < class T >
+Vector_T < T > & Vector_T < T > :: add_scaled ( T const a , Vector_T < T > const & v ) {
+	assert(size==v.size);
+	simd_add_scaled(size,a,v.element,element);
+	return ( * this ) ;
+}
+
+
+template < class T >
+Vector_T < T > Vector_T < T > :: operator + ( Vector_T < T > const & v ) const {
+	assert(size==v.size);
+	Vector_T < T > s(size);
+	simd_add(size,element,v.element,s.element);
 	return s ;
 }
 
 
-Vector Vector :: operator - ( Vector const & v ) const { 
+template < class T >
+Vector_T < T > Vector_T < T > :: operator - ( Vector_T < T > const & v ) const { 
 	assert(size==v.size);
-	Vector d(size);
-	d.size=size;
-	for(unsigned int i=0;i<size;i++){
-		d.element[i]=element[i]-v.element[i];
-	}
+	Vector_T < T > d(size);
+	simd_subtract(size,element,v.element,d.element);
 	return d ;
 }
 
 
-Vector Vector :: operator * ( float const a ) const {
-	Vector p (size);
-	p.size=size;
-	for(unsigned int i=0;i<size;i++){
-		p.element[i]=a*element[i];
-	}
+template < class T >
+Vector_T < T > Vector_T < T > :: operator * ( T const a ) const {
+	Vector_T < T > p (size);
+	simd_scale(size,a,element,p.element);
 	return p ;
 }
 
 
-float Vector :: operator | ( Vector const & v ) const {
+template < class T >
+T Vector_T < T > :: operator | ( Vector_T < T > const & v ) const {
+	assert(size==v.size);
+	return simd_dot(size,element,v.element);
+}
+
+
+template < class T >
+T Vector_T < T > :: operator | ( Vector_View_T < T > const & v ) const {
+	return view() | v;
+}
+
+
+template < class T >
+T Vector_View_T < T > :: operator | ( Vector_View_T < T > const & v ) const {
 	assert(size==v.size);
-	float sum=0;
-	//float prod=1;
+	if(1==stride && 1==v.stride){
+		return simd_dot(size,first,v.first);
+	}
+	T sum=0;
 	for(unsigned int i=0;i<size;i++){
-		sum+=v.element[i]*element[i];
+		sum+=first[i*stride]*v.first[i*v.stride];
 	}
 	return sum;
 }
 
 
-bool Vector :: operator == ( Vector const & v ) const {
-	assert(size==v.size);
+template < class T >
+Vector_T < T > Vector_View_T < T > :: to_vector () const {
+	Vector_T < T > v(size);
 	for(unsigned int i=0;i<size;i++){
-		if(element[i]!=v.element[i]) return false;
+		v.element[i]=first[i*stride];
 	}
-  	return true;
+	return v;
 }
 
 
-Vector operator * ( float const a ,Vector const & v ) { 
-  	return v*a;
+template < class T >
+bool Vector_T < T > :: operator == ( Vector_T < T > const & v ) const {
+	assert(size==v.size);
+	for(unsigned int i=0;i<size;i++){
+		if(element[i]!=v.element[i]) return false;
+	}
+  	return true;
 }
 
 
+// the two types of coordinates
+template class Vector_View_T < float > ;
+template class Vector_View_T < double > ;
+template class Vector_T < float > ;
+template class Vector_T < double > ;
+template std :: ostream & operator << ( std :: ostream & , Vector_T < float > const & ) ;
+template std :: ostream & operator << ( std :: ostream & , Vector_T < double > const & ) ;
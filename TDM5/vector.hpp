@@ -2,7 +2,7 @@
 # define __VECTOR_HPP_
 
 /* ! \file
- * \brief This module handles vector of floats. 
+ * \brief This module handles vector of floats (or doubles). 
  * 
  * \author PASD
  * \date 2016
@@ -11,17 +11,90 @@
 
 # include <iostream>
 
+# include "simd.hpp"
+
+# ifndef RELEASE
+# undef NDEBUG
+# endif
+# include <assert.h>
+
+
+template < class T >
+class Vector_T ;
+
+
+/*!
+ * Floats of a buffer seen as a vector, without copying them:
+ * coordinate \c i is at \c first [ \c i * \c stride ] (e.g. a line or a column of a \c Matrix ).
+ * \c Vector_View is the view of floats.
+ * The buffer should outlive the view, and is not modified through it.
+ */
+template < class T >
+class Vector_View_T {
+
+  /*! First coordinate. */
+  T const * first ;
+
+  /*! Number of coordinates. */
+  unsigned int size ;
+
+  /*! Distance between two coordinates (1 if they are next to each other). */
+  unsigned int stride ;
+
+public:
+
+  /*!
+   * View of \c _size floats from \c _first , \c _stride by \c _stride .
+   */
+  Vector_View_T ( T const * _first ,
+		  unsigned int const _size ,
+		  unsigned int const _stride = 1 )
+    : first ( _first )
+    , size ( _size )
+    , stride ( _stride ) {
+  }
+
+  /*! To access the size of the view. */
+  unsigned int get_size () const {
+    return size ;
+  }
+
+  /*! To access the distance between two coordinates. */
+  unsigned int get_stride () const {
+    return stride ;
+  }
+
+  /*! To access coordinate \c i .
+   * \pre i is a legal coordinate.
+   */
+  T const & operator [] ( unsigned int const i ) const {
+    assert ( i < size ) ;
+    return first [ i * stride ] ;
+  }
+
+  /*! Return the scalar product with another view (by the vector instructions if both are contiguous).
+   * \pre this and v have the same size.
+   */
+  T operator | ( Vector_View_T const & v ) const ;
+
+  /*! A copy of the coordinates, in a vector of their own. */
+  Vector_T < T > to_vector () const ;
+} ;
+
 
 /* ! 
- * This class records vector of floats.
+ * This class records vector of floats (or doubles: \c T is the type of the coordinates).
+ * The coordinates are in a buffer aligned for the vector instructions (see \c simd_allocate ).
+ * \c Vector is the vector of floats.
  */
-class Vector {
+template < class T >
+class Vector_T {
 
   /* ! Size of the vector. */
   unsigned int size ;
 
   /*! All the elements of the vector. */
-  float * element ; 
+  T * element ; 
  
 public:
   
@@ -29,9 +102,9 @@ public:
    * Construct a vector of size  \c _size of zeros.
    * /param _size size of the vector.
    */
-  Vector ( unsigned int const _size ) 
+  Vector_T ( unsigned int const _size ) 
     : size ( _size ) 
-    , element ( new float [ _size ]) {
+    , element ( static_cast < T * > ( simd_allocate ( _size * sizeof ( T ) ) ) ) {
       for(unsigned int i=0; i<_size;i++){
         element[i]=0;
       }
@@ -41,10 +114,22 @@ public:
    * Copy constructor.
    * \param v Vector to copy.
    */
-  Vector ( Vector const & v ) ; 
+  Vector_T ( Vector_T const & v ) ; 
  
   /*! Destructor */
-  ~Vector () ; 
+  ~Vector_T () ; 
+
+  /*!
+   * Write the vector in a binary file (see \c binary_file.hpp ), as a matrix of one column.
+   * \return false if the file could not be written (see \c cerr ).
+   */
+  bool save ( char const * const file_name ) const ;
+
+  /*!
+   * Read a vector from a binary file of \c save (or of a matrix of one column).
+   * \return A new vector (to be deleted), NULL if the file could not be read (see \c cerr ).
+   */
+  static Vector_T * load ( char const * const file_name ) ;
  
   /*! To randomly set the values of the elements.
    * The size is not changed.
@@ -56,87 +141,159 @@ public:
     return size ;
   } 
 
+  /*! The coordinates, next to each other. */
+  T * data () {
+    return element ;
+  }
+
+  /*! The coordinates, next to each other (const version). */
+  T const * data () const {
+    return element ;
+  }
+
   /*! To access any individual value of the vector using the \c v[i] syntax.
    * \param i number of the coordinate to access. 
    * \pre i is a legal coordinate.
    * \return a direct reference to the coordinate
    */
-  float & operator [] ( unsigned int const i ) ;
+  T & operator [] ( unsigned int const i ) ;
   
   /*! To access any individual value of the vector using the \c v[i] syntax (constant version). 
    * \param i number of the coordinate to access. 
    * \pre i is a legal coordinate.
    * \return a direct reference to the coordinate
    */
-  float const & operator [] ( unsigned int const i ) const ; 
+  T const & operator [] ( unsigned int const i ) const ; 
 
   /*! Affectation operator.
+   * The buffer is kept if the sizes are equal, otherwise it is replaced.
    * \param v Vector to copy the value of.
    * \return The vector itself.
    */
-  Vector & operator = ( Vector const & v ) ; 
+  Vector_T & operator = ( Vector_T const & v ) ; 
+
+  /*! Exchange the coordinates (and the sizes) of this and v, without copying them.
+   * This is the way to give a computed vector to another one, e.g. \c w . \c swap ( tmp ) .
+   * \param v Vector to exchange with.
+   */
+  void swap ( Vector_T & v ) ;
+
+  /*! Add a vector to this one, in place.
+   * \param v Vector to add the value of.
+   * \pre this and v have the same size.
+   * \return The vector itself.
+   */
+  Vector_T & operator += ( Vector_T const & v ) ;
+
+  /*! Subtract a vector from this one, in place.
+   * \param v Vector to subtract the value of.
+   * \pre this and v have the same size.
+   * \return The vector itself.
+   */
+  Vector_T & operator -= ( Vector_T const & v ) ;
+
+  /*! Multiply this vector by a scalar, in place.
+   * \param a Float to multiply by.
+   * \return The vector itself.
+   */
+  Vector_T & operator *= ( T const a ) ;
+
+  /*! Add a times v to this vector in one loop, in place (this += a * v without a temporary).
+   * \param a Float to multiply v by.
+   * \param v Vector to add the product of.
+   * \pre this and v have the same size.
+   * \return The vector itself.
+   */
+  Vector_T & add_scaled ( T const a ,
+			  Vector_T const & v ) ;
 
   /*! Compute the sum of two vectors.
    * \param v Vector to add the value of.
    * \pre this and v have the same size.
    * \return A new vector whose coordinates are the sum of the coordinate of this and v.
    */
-  Vector operator + ( Vector const & v ) const ; 
+  Vector_T operator + ( Vector_T const & v ) const ; 
 
   /*! Compute the difference of two vectors.
    * \param v Vector to subtract the value of.
    * \pre this and v have the same size.
    * \return A new vector whose coordinates are the subtractions of the coordinate of v from the ones of this.
    */
-  Vector operator - ( Vector const & v ) const  ; 
+  Vector_T operator - ( Vector_T const & v ) const  ; 
 
   /*! Compute the product of the vector by a scalar a.
    * \param a Float to multiply by.
    * \return A new vector whose coordinates are the product of the coordinate of this and a.
    */
-  Vector operator * ( float const a ) const ; 
+  Vector_T operator * ( T const a ) const ; 
  
   /*! Return the sum of the product component wise (a.k.a. scalar product)
    * \param v Vector to multiply by.
    * \pre this and v have the same.
    * \return The sum of the product of the coordinates of this and v;
    */
-  float operator | ( Vector const & v ) const ; 
+  T operator | ( Vector_T const & v ) const ; 
+
+  /*! Same as above, with a view (e.g. a line of a matrix), without copying it.
+   * \param v View to multiply by.
+   * \pre this and v have the same size.
+   * \return The sum of the product of the coordinates of this and v;
+   */
+  T operator | ( Vector_View_T < T > const & v ) const ; 
+
+  /*! To see the whole vector as a view (valid as long as the vector is neither destroyed nor swapped). */
+  Vector_View_T < T > view () const {
+    return Vector_View_T < T > ( element , size ) ;
+  }
+
+  /*! To see coordinates \c i1 to \c i2 (excluded) as a view.
+   * \pre i1 <= i2 <= size.
+   */
+  Vector_View_T < T > view ( unsigned int const i1 ,
+			     unsigned int const i2 ) const {
+    assert ( ( i1 <= i2 ) && ( i2 <= size ) ) ;
+    return Vector_View_T < T > ( element + i1 , i2 - i1 ) ;
+  }
   
   /*! To test whether two vectors are equal.
    * \param v Vector to compare
    * \pre this and v have the same.
    * \return true if the two vectors are component-wise equal.
    */
-  bool operator == ( Vector const & v ) const ; 
+  bool operator == ( Vector_T const & v ) const ; 
  
 
-  friend Vector operator * ( float const a ,
-			     Vector const & v ) ; 
+  friend class Vector_View_T < T > ;
 
-  friend std :: ostream & operator << ( std :: ostream & ost ,
-					Vector const & v ) ; 
+  /*! Multiplication by a scalar function (defined here to accept any number, e.g. \c 2 * \c v ).
+   * \param a Float to multiply by.
+   * \param v Vector to multiply.
+   * \return A new vector whose coordinates are the product of the coordinates of v by a.
+   */
+  friend Vector_T operator * ( T const a ,
+			       Vector_T const & v ) {
+    return v * a ;
+  }
  
 } ; 
 
 
 
-/*! Multiplication by a scalar function. 
- * \param a Float to multiply by.
- * \param v Vector to multiply.
- * \return A new vector whose coordinates are the product of the coordinates of v by a.
- */
-Vector operator * ( float const a ,
-		    Vector const & v ) ; 
-
-
 /*! Print a string version of the vector to a stream. 
  * \param ost Output stream to write to.
  * \param v Vector to print.
  * \return The output stream.
  */
+template < class T >
 std :: ostream & operator << ( std :: ostream& ost ,
-			       Vector const & v ) ; 
+			       Vector_T < T > const & v ) ; 
+
+
+/*! Vector of floats (the default). */
+typedef Vector_T < float > Vector ;
+
+/*! View of floats. */
+typedef Vector_View_T < float > Vector_View ;
 
 
 
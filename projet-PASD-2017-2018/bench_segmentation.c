@@ -0,0 +1,127 @@
+#define _POSIX_C_SOURCE 199309L
+#include "coloration.h"
+#include <time.h>
+#include <sys/resource.h>
+
+/* usage : ./bench k sortie.pgm image.pgm [image.pgm ...]
+ * chaque image passe par chargement, arêtes, tri, segmentation et écriture du rendu moyen,
+ * puis la segmentation est refaite avec les arêtes implicites par poids,
+ * et pour k/4, k/2, k, 2k et 4k sur les arêtes déjà triées ; enfin les statistiques des régions */
+
+/* nombre de valeurs de k de la segmentation multi-échelle */
+#define NB_ECHELLES 5
+/* nombre de bandes (et de threads) des statistiques de régions */
+#define NB_BANDES 4
+
+static double maintenant(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+/* pic de mémoire résidente du processus, en ko */
+static long pic_rss(void){
+	struct rusage ru;
+	getrusage(RUSAGE_SELF,&ru);
+	return ru.ru_maxrss;
+}
+
+static bool mesurer(const char* fichier,const char* sortie,int k){
+	double t0=maintenant();
+	pgm img=lire_image_pgm(fichier);
+	if(NULL==img) return false;
+	const int largeur=largeur_image(img);
+	const int hauteur=hauteur_image(img);
+	double t1=maintenant();
+	tableau_aretes t=lire_matrice(image_matrice(img),largeur,hauteur);
+	double t2=maintenant();
+	trier_aretes(t);
+	double t3=maintenant();
+	int nb_regions;
+	int* etiquettes=segmentation_etiquettes(t,largeur*hauteur,k,&nb_regions);
+	double t4=maintenant();
+	pgm rendu=coloration_moyenne(img,etiquettes,nb_regions);
+	bool ok=ecrire_image_pgm(sortie,rendu,NULL);
+	double t5=maintenant();
+	// mêmes étiquettes avec les arêtes implicites rangées par poids, sans tri
+	aretes_par_poids a=aretes_par_poids_creer(image_matrice(img),largeur,hauteur);
+	double t6=maintenant();
+	int nb_regions_par_poids;
+	int* etiquettes_par_poids=segmentation_etiquettes_par_poids(a,k,&nb_regions_par_poids);
+	double t7=maintenant();
+	bool identiques=nb_regions_par_poids==nb_regions;
+	for(int v=0;identiques && v<largeur*hauteur;v++) identiques=etiquettes[v]==etiquettes_par_poids[v];
+	// mêmes paquets construits depuis le tampon de pixels de l'image
+	aretes_par_poids b=aretes_par_poids_creer_image(img);
+	identiques=identiques && b->poids_max==a->poids_max
+		&& 0==memcmp(b->debut,a->debut,sizeof(int)*(a->poids_max+2))
+		&& 0==memcmp(b->codes,a->codes,sizeof(int)*a->nb_aretes);
+	aretes_par_poids_detruire(&b);
+	// plusieurs échelles sur le tableau déjà trié, séquentiellement puis sur NB_ECHELLES threads
+	int echelles[NB_ECHELLES]={k/4,k/2,k,2*k,4*k};
+	int nb_regions_echelles[NB_ECHELLES];
+	double t_echelles[2];
+	for(int e=0;e<2;e++){
+		double t8=maintenant();
+		int** multi=segmentation_multi_echelle(t,largeur*hauteur,echelles,NB_ECHELLES,nb_regions_echelles,e==0 ? 1 : NB_ECHELLES);
+		t_echelles[e]=maintenant()-t8;
+		identiques=identiques && nb_regions_echelles[2]==nb_regions;
+		for(int v=0;identiques && v<largeur*hauteur;v++) identiques=multi[2][v]==etiquettes[v];
+		for(int n=0;n<NB_ECHELLES;n++) free(multi[n]);
+		free(multi);
+	}
+	// statistiques des régions en un parcours, puis par bandes sur NB_BANDES threads
+	double t9=maintenant();
+	statistiques_regions s1=statistiques_regions_calculer(img,etiquettes,nb_regions,1);
+	double t10=maintenant();
+	statistiques_regions sb=statistiques_regions_calculer(img,etiquettes,nb_regions,NB_BANDES);
+	double t11=maintenant();
+	for(int r=0;identiques && r<nb_regions;r++){
+		identiques=s1->aire[r]==sb->aire[r] && s1->somme[r]==sb->somme[r]
+			&& s1->i_min[r]==sb->i_min[r] && s1->i_max[r]==sb->i_max[r]
+			&& s1->j_min[r]==sb->j_min[r] && s1->j_max[r]==sb->j_max[r];
+	}
+	statistiques_regions_detruire(&s1);
+	statistiques_regions_detruire(&sb);
+
+	const int nb_aretes=t->nb_aretes;
+	printf("%s : %dx%d, %d aretes, %d regions\n",fichier,largeur,hauteur,nb_aretes,nb_regions);
+	printf("  chargement   %9.3f ms\n",(t1-t0)*1e3);
+	printf("  aretes       %9.3f ms  %12.0f aretes/s\n",(t2-t1)*1e3,nb_aretes/(t2-t1));
+	printf("  tri          %9.3f ms  %12.0f aretes/s\n",(t3-t2)*1e3,nb_aretes/(t3-t2));
+	printf("  segmentation %9.3f ms  %12.0f aretes/s\n",(t4-t3)*1e3,nb_aretes/(t4-t3));
+	printf("  ecriture     %9.3f ms\n",(t5-t4)*1e3);
+	printf("  total        %9.3f ms  pic RSS %ld ko\n",(t5-t0)*1e3,pic_rss());
+	printf("  par poids    %9.3f ms  %12.0f aretes/s (paquets %.3f ms, segmentation %.3f ms), %s\n",
+	       (t7-t5)*1e3,nb_aretes/(t7-t5),(t6-t5)*1e3,(t7-t6)*1e3,identiques ? "identique" : "DIFFERENT");
+	printf("  %d echelles  %9.3f ms, %d threads %9.3f ms, regions",NB_ECHELLES,t_echelles[0]*1e3,NB_ECHELLES,t_echelles[1]*1e3);
+	for(int n=0;n<NB_ECHELLES;n++) printf(" %d",nb_regions_echelles[n]);
+	printf("\n");
+	printf("  statistiques %9.3f ms, %d bandes %9.3f ms, %s\n",(t10-t9)*1e3,NB_BANDES,(t11-t10)*1e3,identiques ? "identique" : "DIFFERENT");
+
+	detruire_image_pgm(&rendu);
+	free(etiquettes);
+	free(etiquettes_par_poids);
+	aretes_par_poids_detruire(&a);
+	tableau_aretes_detruire(&t);
+	detruire_image_pgm(&img);
+	return ok && identiques;
+}
+
+int main(int argc, char** argv) {
+
+	if(argc<4){
+		fprintf(stderr,"usage : %s k sortie.pgm image.pgm [image.pgm ...]\n",argv[0]);
+		return 1;
+	}
+	int k=atoi(argv[1]);
+	int retour=0;
+	for(int i=3;i<argc;i++){
+		if(!mesurer(argv[i],argv[2],k)){
+			fprintf(stderr,"Segmentation de %s impossible.\n",argv[i]);
+			retour=1;
+		}
+	}
+	return retour;
+
+}
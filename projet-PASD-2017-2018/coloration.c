@@ -1,2 +1,191 @@
 #include "coloration.h"
+#include "parallele.h"
+#include <assert.h>
+#include <limits.h>
 
+/* statistiques des régions sur les lignes [debut,fin), dans les tableaux partiels du thread ;
+ * les pixels sont lus dans le tampon de l'image (pixels8 ou pixels16, l'autre est NULL) */
+typedef struct tache_statistiques_struct{
+	const uint8_t* pixels8;
+	const uint16_t* pixels16;
+	int pas;
+	const int* etiquettes;
+	int largeur;
+	int debut,fin;
+	struct statistiques_regions_struct partielles;
+} tache_statistiques;
+
+static void statistiques_allouer(struct statistiques_regions_struct* s,int nb_regions){
+	const int n=nb_regions>0 ? nb_regions : 1;
+	s->nb_regions=nb_regions;
+	s->aire=malloc(sizeof(int)*n);
+	s->somme=malloc(sizeof(unsigned long long)*n);
+	s->i_min=malloc(sizeof(int)*n);
+	s->i_max=malloc(sizeof(int)*n);
+	s->j_min=malloc(sizeof(int)*n);
+	s->j_max=malloc(sizeof(int)*n);
+	assert(NULL!=s->aire && NULL!=s->somme && NULL!=s->i_min && NULL!=s->i_max && NULL!=s->j_min && NULL!=s->j_max);
+	for(int r=0;r<nb_regions;r++){
+		s->aire[r]=0;
+		s->somme[r]=0;
+		s->i_min[r]=INT_MAX;
+		s->i_max[r]=-1;
+		s->j_min[r]=INT_MAX;
+		s->j_max[r]=-1;
+	}
+}
+
+static void statistiques_liberer(struct statistiques_regions_struct* s){
+	free(s->aire);
+	free(s->somme);
+	free(s->i_min);
+	free(s->i_max);
+	free(s->j_min);
+	free(s->j_max);
+}
+
+static inline void statistiques_ajouter(struct statistiques_regions_struct* s,int r,unsigned int valeur,int i,int j){
+	assert(0<=r && r<s->nb_regions);
+	s->aire[r]++;
+	s->somme[r]+=valeur;
+	// les lignes sont parcourues dans l'ordre : la première vue est le minimum
+	if(s->i_max[r]<0) s->i_min[r]=i;
+	s->i_max[r]=i;
+	if(j<s->j_min[r]) s->j_min[r]=j;
+	if(j>s->j_max[r]) s->j_max[r]=j;
+}
+
+static void* tache_statistiques_regions(void* arg){
+	tache_statistiques* ts=arg;
+	struct statistiques_regions_struct* s=&ts->partielles;
+	for(int i=ts->debut;i<ts->fin;i++){
+		const int* e=ts->etiquettes+i*ts->largeur;
+		if(NULL!=ts->pixels8){
+			const uint8_t* ligne=ts->pixels8+(size_t)i*ts->pas;
+			for(int j=0;j<ts->largeur;j++) statistiques_ajouter(s,e[j],ligne[j],i,j);
+		}
+		else{
+			const uint16_t* ligne=ts->pixels16+(size_t)i*ts->pas;
+			for(int j=0;j<ts->largeur;j++) statistiques_ajouter(s,e[j],ligne[j],i,j);
+		}
+	}
+	return NULL;
+}
+
+statistiques_regions statistiques_regions_calculer(pgm img, const int* etiquettes, int nb_regions, int nb_threads){
+	assert(NULL!=img && NULL!=etiquettes && nb_regions>=0);
+	const int hauteur=hauteur_image(img);
+	if(nb_threads<1) nb_threads=1;
+	if(nb_threads>hauteur) nb_threads=hauteur>0 ? hauteur : 1;
+	// le tampon (1 ou 2 octets par pixel) est lu une fois, sans construire la matrice
+	const uint8_t* pixels8=(1==octets_par_pixel_image(img)) ? pixels8_image(img) : NULL;
+	const uint16_t* pixels16=(NULL==pixels8) ? pixels16_image(img) : NULL;
+	tache_statistiques* taches=malloc(sizeof(tache_statistiques)*nb_threads);
+	assert(NULL!=taches);
+	for(int p=0;p<nb_threads;p++){
+		taches[p].pixels8=pixels8;
+		taches[p].pixels16=pixels16;
+		taches[p].pas=pas_image(img);
+		taches[p].etiquettes=etiquettes;
+		taches[p].largeur=largeur_image(img);
+		taches[p].debut=parallele_debut_tranche(hauteur,nb_threads,p);
+		taches[p].fin=parallele_debut_tranche(hauteur,nb_threads,p+1);
+		statistiques_allouer(&taches[p].partielles,nb_regions);
+	}
+	parallele_executer(nb_threads,&tache_statistiques_regions,taches,sizeof(tache_statistiques));
+	// réduction dans les tableaux de la première bande
+	statistiques_regions s=malloc(sizeof(struct statistiques_regions_struct));
+	assert(NULL!=s);
+	*s=taches[0].partielles;
+	for(int p=1;p<nb_threads;p++){
+		const struct statistiques_regions_struct* b=&taches[p].partielles;
+		for(int r=0;r<nb_regions;r++){
+			if(0==b->aire[r]) continue;
+			s->aire[r]+=b->aire[r];
+			s->somme[r]+=b->somme[r];
+			if(b->i_min[r]<s->i_min[r]) s->i_min[r]=b->i_min[r];
+			if(b->i_max[r]>s->i_max[r]) s->i_max[r]=b->i_max[r];
+			if(b->j_min[r]<s->j_min[r]) s->j_min[r]=b->j_min[r];
+			if(b->j_max[r]>s->j_max[r]) s->j_max[r]=b->j_max[r];
+		}
+		statistiques_liberer(&taches[p].partielles);
+	}
+	free(taches);
+	return s;
+}
+
+unsigned int statistiques_regions_moyenne(statistiques_regions s, int region){
+	assert(0<=region && region<s->nb_regions);
+	const int aire=s->aire[region];
+	return aire>0 ? (unsigned int)((s->somme[region]+aire/2)/aire) : 0;
+}
+
+void statistiques_regions_detruire(statistiques_regions* s){
+	assert(NULL!=s && NULL!=*s);
+	statistiques_liberer(*s);
+	free(*s);
+	*s=NULL;
+}
+
+pgm coloration_moyenne(pgm img, const int* etiquettes, int nb_regions){
+	assert(NULL!=img && NULL!=etiquettes);
+	const int largeur=largeur_image(img);
+	const int hauteur=hauteur_image(img);
+	statistiques_regions s=statistiques_regions_calculer(img,etiquettes,nb_regions,1);
+	// la moyenne de chaque région est calculée une fois, puis recopiée pixel par pixel
+	unsigned int* moyenne=malloc(sizeof(unsigned int)*(nb_regions+1));
+	assert(NULL!=moyenne);
+	for(int r=0;r<nb_regions;r++) moyenne[r]=statistiques_regions_moyenne(s,r);
+	statistiques_regions_detruire(&s);
+	pgm p=initialiser_image_pgm(largeur,hauteur,valeur_max_image(img));
+	unsigned int** res=image_matrice(p);
+	for(int i=0;i<hauteur;i++){
+		for(int j=0;j<largeur;j++){
+			res[i][j]=moyenne[etiquettes[i*largeur+j]];
+		}
+	}
+	free(moyenne);
+	return p;
+}
+
+/* 97 est premier avec 256 : les 256 premières régions ont des niveaux distincts,
+ * et deux numéros consécutifs sont éloignés de 97 niveaux */
+static unsigned int niveau_etiquette(int r){
+	return (unsigned int)(r*97)%256;
+}
+
+pgm coloration_etiquettes(const int* etiquettes, int largeur, int hauteur){
+	assert(NULL!=etiquettes);
+	pgm p=initialiser_image_pgm(largeur,hauteur,255);
+	unsigned int** res=image_matrice(p);
+	for(int i=0;i<hauteur;i++){
+		for(int j=0;j<largeur;j++){
+			res[i][j]=niveau_etiquette(etiquettes[i*largeur+j]);
+		}
+	}
+	return p;
+}
+
+bool colorer_image(const char* fichier_image, const char* fichier_moyenne, const char* fichier_etiquettes, int k, int* nb_regions){
+	pgm img=lire_image_pgm(fichier_image);
+	if(NULL==img) return false;
+	const int largeur=largeur_image(img);
+	const int hauteur=hauteur_image(img);
+	tableau_aretes t=lire_matrice(image_matrice(img),largeur,hauteur);
+	int nb_r;
+	int* etiquettes=segmentation_etiquettes(t,largeur*hauteur,k,&nb_r);
+	tableau_aretes_detruire(&t);
+	if(NULL!=nb_regions) *nb_regions=nb_r;
+
+	pgm moyenne=coloration_moyenne(img,etiquettes,nb_r);
+	bool ok=ecrire_image_pgm(fichier_moyenne,moyenne,NULL);
+	detruire_image_pgm(&moyenne);
+	if(ok && NULL!=fichier_etiquettes){
+		pgm fausses=coloration_etiquettes(etiquettes,largeur,hauteur);
+		ok=ecrire_image_pgm(fichier_etiquettes,fausses,NULL);
+		detruire_image_pgm(&fausses);
+	}
+	free(etiquettes);
+	detruire_image_pgm(&img);
+	return ok;
+}
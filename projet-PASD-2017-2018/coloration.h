@@ -3,5 +3,76 @@
 
 #include "segmentation.h" 
 
-#endif
+/*! \file coloration.h
+ * \brief Rendu d'une segmentation sous forme d'image PGM.
+ *
+ * Les régions sont données par une carte d'étiquettes (un numéro de région par pixel,
+ * ligne par ligne, entre 0 et nb_regions-1), telle que la produit segmentation_etiquettes.
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+/*!
+ * Statistiques des régions d'une carte d'étiquettes, un tableau par grandeur
+ * (indexés par numéro de région) : aire en pixels, somme des intensités, et boîte
+ * englobante, lignes i_min..i_max et colonnes j_min..j_max (i_max et j_max valent -1
+ * pour une région sans pixel).
+ */
+typedef struct statistiques_regions_struct * statistiques_regions;
+
+struct statistiques_regions_struct{
+	int nb_regions;
+	int* aire;
+	unsigned long long* somme;
+	int* i_min;
+	int* i_max;
+	int* j_min;
+	int* j_max;
+};
+
+/*!
+ * Calcule les statistiques en un seul parcours des étiquettes et du tampon de pixels
+ * de img (pixels8_image/pixels16_image, sans construire la matrice).
+ * Les lignes sont réparties en bandes entre nb_threads threads, chacun remplissant
+ * ses propres tableaux, qui sont ensuite réunis (nb_threads fois nb_regions cases de chaque).
+ * \param etiquettes largeur*hauteur numéros de région entre 0 et nb_regions-1
+ */
+statistiques_regions statistiques_regions_calculer(pgm img, const int* etiquettes, int nb_regions, int nb_threads);
+
+/*!
+ * \return l'intensité moyenne (arrondie) de la région, 0 si elle est vide
+ */
+unsigned int statistiques_regions_moyenne(statistiques_regions s, int region);
 
+/*!
+ * Détruit les statistiques, le pointeur est mis à NULL.
+ */
+void statistiques_regions_detruire(statistiques_regions* s);
+
+/*!
+ * Image où chaque pixel prend l'intensité moyenne (arrondie) de sa région dans img.
+ * \param img l'image segmentée
+ * \param etiquettes largeur*hauteur numéros de région
+ * \param nb_regions nombre de régions
+ * \return l'image créée, de même taille et valeur max que img
+ */
+pgm coloration_moyenne(pgm img, const int* etiquettes, int nb_regions);
+
+/*!
+ * Image en fausses couleurs : chaque région reçoit un niveau de gris tiré de son numéro,
+ * de sorte que deux régions de numéros voisins sont bien contrastées.
+ * \return l'image créée, avec une valeur max de 255
+ */
+pgm coloration_etiquettes(const int* etiquettes, int largeur, int hauteur);
+
+/*!
+ * Segmente l'image du fichier image et écrit le rendu par intensité moyenne dans
+ * fichier_moyenne et le rendu en fausses couleurs dans fichier_etiquettes (NULL pour
+ * ne pas l'écrire).
+ * \param nb_regions si non NULL, reçoit le nombre de régions
+ * \return true si la lecture et les écritures se sont bien déroulées
+ */
+bool colorer_image(const char* fichier_image, const char* fichier_moyenne, const char* fichier_etiquettes, int k, int* nb_regions);
+
+#endif
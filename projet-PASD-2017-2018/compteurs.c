@@ -0,0 +1,58 @@
+#define _POSIX_C_SOURCE 199309L
+#include "compteurs.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* compteurs inscrits, le dernier en tête */
+static compteur* premier=NULL;
+static pthread_mutex_t verrou=PTHREAD_MUTEX_INITIALIZER;
+
+static void afficher_a_la_fin(void){
+	compteurs_afficher(stderr);
+}
+
+static void inscrire(compteur* c){
+	pthread_mutex_lock(&verrou);
+	if(!c->inscrit){
+		if(NULL==premier) atexit(afficher_a_la_fin);
+		c->suivant=premier;
+		premier=c;
+		__sync_synchronize();
+		c->inscrit=1;
+	}
+	pthread_mutex_unlock(&verrou);
+}
+
+void compteur_ajouter(compteur* c, unsigned long n){
+	if(!__sync_fetch_and_or(&c->inscrit,0)) inscrire(c);
+	__sync_add_and_fetch(&c->valeur,n);
+}
+
+unsigned long compteur_maintenant_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec*1000000000UL+ts.tv_nsec;
+}
+
+void compteurs_afficher(FILE* f){
+	pthread_mutex_lock(&verrou);
+	fprintf(f,"compteurs :\n");
+	/* chaque nom est écrit une fois, au premier compteur qui le porte */
+	for(compteur* c=premier;NULL!=c;c=c->suivant){
+		bool deja_vu=false;
+		for(compteur* d=premier;d!=c && !deja_vu;d=d->suivant){
+			deja_vu=0==strcmp(d->nom,c->nom);
+		}
+		if(deja_vu) continue;
+		unsigned long total=0;
+		for(compteur* d=c;NULL!=d;d=d->suivant){
+			if(0==strcmp(d->nom,c->nom)) total+=__sync_add_and_fetch(&d->valeur,0);
+		}
+		fprintf(f,"  %s %lu\n",c->nom,total);
+	}
+	pthread_mutex_unlock(&verrou);
+}
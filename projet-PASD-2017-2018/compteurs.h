@@ -0,0 +1,75 @@
+#ifndef COMPTEURS_H
+#define COMPTEURS_H
+
+/*! \file compteurs.h
+ * \brief Compteurs des chemins chauds (appels, allocations...) et chronomètres,
+ * pour savoir ce que fait une exécution sans profileur.
+ *
+ * Les macros ne font quelque chose qu'avec COMPTEURS défini (voir le Makefile),
+ * sinon elles sont vides et ne coûtent rien :
+ * - COMPTEUR_AJOUTER(nom) ajoute 1 au compteur nom,
+ * - COMPTEUR_AJOUTER_N(nom,n) ajoute n,
+ * - COMPTEUR_DEBUT(t) note l'instant dans la variable t et COMPTEUR_FIN(nom,t)
+ *   ajoute à nom les nanosecondes écoulées depuis.
+ *
+ * Chaque macro a son propre compteur, ceux de même nom sont additionnés par
+ * compteurs_afficher, appelée à la fin du programme (sur stderr).
+ * Les compteurs peuvent être utilisés par plusieurs threads à la fois.
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+#include <stdio.h>
+
+/*!
+ * Compteur d'un endroit du code, inscrit à sa première utilisation.
+ */
+typedef struct compteur{
+	const char* nom;
+	unsigned long valeur;
+	struct compteur* suivant;
+	/* 1 une fois dans la liste des compteurs */
+	int inscrit;
+} compteur;
+
+/*!
+ * Ajoute n au compteur c (en l'inscrivant s'il ne l'est pas encore).
+ */
+void compteur_ajouter(compteur* c, unsigned long n);
+
+/*!
+ * \return l'instant courant, en nanosecondes
+ */
+unsigned long compteur_maintenant_ns(void);
+
+/*!
+ * Écrit chaque nom de compteur et sa valeur (additionnée sur les compteurs de même nom).
+ * \param f le flux de sortie
+ */
+void compteurs_afficher(FILE* f);
+
+#ifdef COMPTEURS
+
+#define COMPTEUR_AJOUTER_N(nom,n) \
+	do{ \
+		static compteur compteur_={nom,0,NULL,0}; \
+		compteur_ajouter(&compteur_,(n)); \
+	}while(0)
+
+#define COMPTEUR_AJOUTER(nom) COMPTEUR_AJOUTER_N(nom,1)
+
+#define COMPTEUR_DEBUT(t) unsigned long t=compteur_maintenant_ns()
+
+#define COMPTEUR_FIN(nom,t) COMPTEUR_AJOUTER_N(nom,compteur_maintenant_ns()-(t))
+
+#else
+
+#define COMPTEUR_AJOUTER_N(nom,n) ((void) 0)
+#define COMPTEUR_AJOUTER(nom) ((void) 0)
+#define COMPTEUR_DEBUT(t) ((void) 0)
+#define COMPTEUR_FIN(nom,t) ((void) 0)
+
+#endif
+
+#endif
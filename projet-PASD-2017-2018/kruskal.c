@@ -1,4 +1,5 @@
 #include "kruskal.h"
+#include "parallele.h"
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
@@ -30,16 +31,46 @@ void detruire_arete ( void * * pt ) {
 	}
 }
 
-void detruire_tab_arete( arete* tab){
-	int i=0;
-	while(NULL!=tab[i]){
-		free(tab[i]);
-		(tab[i])=NULL;
-		i++;
+tableau_aretes tableau_aretes_creer(int capacite){
+	tableau_aretes t=malloc(sizeof(struct tableau_aretes_struct));
+	assert(NULL!=t);
+	t->nb_aretes=0;
+	t->poids_min=0;
+	t->poids_max=0;
+	t->sommet_max=0;
+	t->trie=true;
+	t->capacite=capacite>0 ? capacite : 1;
+	t->aretes=malloc(sizeof(struct arete)*t->capacite);
+	assert(NULL!=t->aretes);
+	return t;
+}
+
+void tableau_aretes_ajouter(tableau_aretes t,int s1,int s2,int poids){
+	assert(NULL!=t);
+	if(t->nb_aretes==t->capacite){
+		t->capacite*=2;
+		t->aretes=realloc(t->aretes,sizeof(struct arete)*t->capacite);
+		assert(NULL!=t->aretes);
 	}
-	free(tab);
-	tab=NULL;
+	t->trie=false;
+	if(0==t->nb_aretes || poids<t->poids_min) t->poids_min=poids;
+	if(0==t->nb_aretes || poids>t->poids_max) t->poids_max=poids;
+	if(s1>t->sommet_max) t->sommet_max=s1;
+	if(s2>t->sommet_max) t->sommet_max=s2;
+	struct arete* a=&(t->aretes[t->nb_aretes]);
+	a->s1=s1;
+	a->s2=s2;
+	a->poids=poids;
+	t->nb_aretes++;
+}
 
+void tableau_aretes_detruire(tableau_aretes* t){
+	assert(NULL!=t);
+	if(NULL!=*t){
+		free((*t)->aretes);
+		free(*t);
+		*t=NULL;
+	}
 }
 
 int comparer_arete(void *  val1, void * val2 ){
@@ -60,7 +91,8 @@ void copier_ensemble ( void * val ,void * * pt ) {
 	assert ( NULL != val ) ;
   	assert ( NULL != pt ) ;
 	ensemble e=(ensemble)val;
-	ensemble e1 = creer_ensemble(*(int*)e->elements->tete->val);
+	// la copie partage le pool de e, pour pouvoir lui être réunie
+	ensemble e1 = creer_ensemble_pool(*(int*)e->elements->tete->val,e->elements->pool);
 	*pt = e1;
 }
 
@@ -103,60 +135,396 @@ int comparer_ensemble(void *  val1, void * val2 ){
 	}
 }
 
-void echanger(arete *tab, int a, int b)
+void echanger(struct arete *tab, int a, int b)
 {
-		arete temp = tab[a];
+		struct arete temp = tab[a];
    		tab[a] = tab[b];
     	tab[b] = temp;    
 }
 
-void trier_arete(arete *tab,int debut,int fin){	
-	int gauche = debut-1;
-    int droite = fin+1;
+/* <0 si a1 est avant a2 (poids, puis s1, puis s2), 0 si égales, >0 sinon */
+static int ordre_arete(const struct arete* a1,const struct arete* a2){
+	if(a1->poids!=a2->poids) return a1->poids<a2->poids ? -1 : 1;
+	if(a1->s1!=a2->s1) return a1->s1<a2->s1 ? -1 : 1;
+	if(a1->s2!=a2->s2) return a1->s2<a2->s2 ? -1 : 1;
+	return 0;
+}
 
-	const arete pivot = tab[debut];
-    if(debut >= fin)
-       	return;
+/* la médiane de trois arêtes (premier, milieu et dernier élément d'une partie) */
+static const struct arete* mediane_de_trois(const struct arete* a,const struct arete* b,const struct arete* c){
+	return (ordre_arete(a,b)<0)
+		? ((ordre_arete(b,c)<0) ? b : ((ordre_arete(a,c)<0) ? c : a))
+		: ((ordre_arete(a,c)<0) ? a : ((ordre_arete(b,c)<0) ? c : b));
+}
 
-    
-    while(1){
-		do droite--; while((tab[droite])->poids > pivot->poids || ((tab[droite]->poids == pivot->poids) && (tab[droite]->s1 > pivot->s1)) || ((tab[droite]->poids == pivot->poids) && (tab[droite]->s1 == pivot->s1) && (tab[droite]->s2 > pivot->s2)));// || (tab[droite]->poids == pivot->poids && tab[gauche]->s1 > pivot->s1));
-		do gauche++; while((tab[gauche])->poids < pivot->poids || ((tab[gauche]->poids == pivot->poids) && (tab[gauche]->s1 < pivot->s1)) || ((tab[gauche]->poids == pivot->poids) && (tab[gauche]->s1 == pivot->s1) && (tab[gauche]->s2 < pivot->s2)));
-		//((tab[gauche]->poids) == (pivot->poids) && (tab[gauche])->s1 < pivot->s1);
+void trier_arete(struct arete *tab,int debut,int fin){	
+	while(debut < fin){
+		int gauche = debut-1;
+		int droite = fin+1;
 
+		// pivot : médiane de trois placée en tête, pour ne pas être quadratique sur une entrée déjà triée
+		const struct arete* m = mediane_de_trois(&tab[debut],&tab[debut+(fin-debut)/2],&tab[fin]);
+		echanger(tab, debut, (int)(m-tab));
+		const struct arete pivot = tab[debut];
 
-		if(gauche < droite){ //((tab[droite]->poids == tab[gauche]->poids) && (tab[droite]->s1 < tab[gauche]->s1)))){
-		    echanger(tab, gauche, droite);
+		while(1){
+			do droite--; while(ordre_arete(&tab[droite],&pivot)>0);
+			do gauche++; while(ordre_arete(&tab[gauche],&pivot)<0);
+
+			if(gauche < droite){
+				echanger(tab, gauche, droite);
+			}else{
+				break;
+			}
+		}
+
+		// appel récursif sur la plus petite partie, boucle sur l'autre : pile en O(log n)
+		if(droite-debut < fin-droite){
+			trier_arete(tab, debut, droite);
+			debut = droite+1;
 		}else{
-			break;
+			trier_arete(tab, droite+1, fin);
+			fin = droite;
 		}
-    }
+	}
+}
 
-	trier_arete(tab, debut, droite);
-    trier_arete(tab, droite+1, fin);
+enum cle_tri { CLE_S2, CLE_S1, CLE_POIDS };
+
+static int cle_arete(const struct arete* a,enum cle_tri cle){
+	switch(cle){
+		case CLE_S2: return a->s2;
+		case CLE_S1: return a->s1;
+		default: return a->poids;
+	}
 }
 
+/* tri par comptage stable de src vers dst selon cle, les clés sont dans [0,cle_max] */
+static void tri_comptage(const struct arete* src,struct arete* dst,int n,enum cle_tri cle,int cle_max,int* compte){
+	memset(compte,0,sizeof(int)*(cle_max+1));
+	for(int i=0;i<n;i++) compte[cle_arete(&src[i],cle)]++;
+	int debut=0;
+	for(int c=0;c<=cle_max;c++){
+		int nb=compte[c];
+		compte[c]=debut;
+		debut+=nb;
+	}
+	for(int i=0;i<n;i++) dst[compte[cle_arete(&src[i],cle)]++]=src[i];
+}
 
-liste kruskal(arete * tab,int nb_s,int nb_arete){
-	trier_arete(tab,0,nb_arete-1);
+/* vrai si tab est déjà ordonné selon (s1,s2) */
+static bool est_trie_sommets(const struct arete* tab,int n){
+	for(int i=1;i<n;i++){
+		if(tab[i-1].s1>tab[i].s1 || (tab[i-1].s1==tab[i].s1 && tab[i-1].s2>tab[i].s2)) return false;
+	}
+	return true;
+}
 
-	liste l=liste_creer(&copier_ensemble,&afficher_ensemble,&detruire_ensemble,&comparer_ensemble);
-	liste s=liste_creer(&copier_arete,&afficher_arete,&detruire_arete,&comparer_arete);
-	for(int i=0;i<nb_s;i++){
-		ensemble e=creer_ensemble(i);
-		liste_insertion_fin(l,e);
-		ensemble_detruire(&e);
+void trier_aretes(tableau_aretes t){
+	assert(NULL!=t);
+	int n=t->nb_aretes;
+	if(t->trie) return;
+	t->trie=true;
+	if(n<2) return;
+	if(t->poids_min<0 || t->poids_max>POIDS_MAX_TRI_COMPTAGE){
+		trier_arete(t->aretes,0,n-1);
+		return;
+	}
+	struct arete* tmp=malloc(sizeof(struct arete)*n);
+	int cle_max=t->poids_max>t->sommet_max ? t->poids_max : t->sommet_max;
+	int* compte=malloc(sizeof(int)*(cle_max+1));
+	assert(NULL!=tmp);
+	assert(NULL!=compte);
+	if(!est_trie_sommets(t->aretes,n)){
+		// tri par base : s2 puis s1, chaque passe étant stable
+		tri_comptage(t->aretes,tmp,n,CLE_S2,t->sommet_max,compte);
+		tri_comptage(tmp,t->aretes,n,CLE_S1,t->sommet_max,compte);
 	}
-	for(int i=0;i<nb_arete;i++){
-		ensemble e1 = trouver_ensemble(l,(tab[i])->s1);
-		ensemble e2 = trouver_ensemble(l,(tab[i])->s2);
+	tri_comptage(t->aretes,tmp,n,CLE_POIDS,t->poids_max,compte);
+	free(t->aretes);
+	t->aretes=tmp;
+	t->capacite=n;
+	free(compte);
+}
+
+/* une tranche [debut,fin) du tableau, traitée par un thread */
+typedef struct tache_tri_struct{
+	struct arete* src;
+	struct arete* dst;
+	int debut,fin;
+	// histogramme et placement
+	int* compte;
+	int poids_max;
+	bool trie;
+	// fusion de [debut,milieu) et [milieu,fin)
+	int milieu;
+} tache_tri;
+
+static void* tache_histogramme(void* arg){
+	tache_tri* tt=arg;
+	memset(tt->compte,0,sizeof(int)*(tt->poids_max+1));
+	tt->trie=true;
+	for(int i=tt->debut;i<tt->fin;i++){
+		tt->compte[tt->src[i].poids]++;
+		if(i>tt->debut && tt->trie){
+			const struct arete* a=&tt->src[i-1];
+			const struct arete* b=&tt->src[i];
+			if(a->s1>b->s1 || (a->s1==b->s1 && a->s2>b->s2)) tt->trie=false;
+		}
+	}
+	return NULL;
+}
+
+static void* tache_placement(void* arg){
+	tache_tri* tt=arg;
+	for(int i=tt->debut;i<tt->fin;i++){
+		tt->dst[tt->compte[tt->src[i].poids]++]=tt->src[i];
+	}
+	return NULL;
+}
+
+static void* tache_tri_rapide(void* arg){
+	tache_tri* tt=arg;
+	if(tt->fin-tt->debut>1) trier_arete(tt->src,tt->debut,tt->fin-1);
+	return NULL;
+}
 
-		if(e1->pere!=e2->pere){
-			union_ensemble(l,e1,e2);
-			liste_insertion_fin(s,tab[i]);
+/* fusionne src[debut,milieu) et src[milieu,fin), triés, dans dst[debut,fin) */
+static void* tache_fusion(void* arg){
+	tache_tri* tt=arg;
+	int i=tt->debut,j=tt->milieu,k=tt->debut;
+	while(i<tt->milieu && j<tt->fin){
+		tt->dst[k++]=(ordre_arete(&tt->src[j],&tt->src[i])<0) ? tt->src[j++] : tt->src[i++];
+	}
+	while(i<tt->milieu) tt->dst[k++]=tt->src[i++];
+	while(j<tt->fin) tt->dst[k++]=tt->src[j++];
+	return NULL;
+}
+
+/* tri parallèle sans borne sur les poids : nb tranches triées puis fusionnées deux à deux */
+static void trier_aretes_fusion(tableau_aretes t,int nb){
+	int n=t->nb_aretes;
+	tache_tri* taches=malloc(sizeof(tache_tri)*nb);
+	int* bornes=malloc(sizeof(int)*(nb+1));
+	struct arete* tmp=malloc(sizeof(struct arete)*n);
+	assert(NULL!=taches && NULL!=bornes && NULL!=tmp);
+	for(int p=0;p<=nb;p++) bornes[p]=parallele_debut_tranche(n,nb,p);
+	for(int p=0;p<nb;p++){
+		taches[p].src=t->aretes;
+		taches[p].debut=bornes[p];
+		taches[p].fin=bornes[p+1];
+	}
+	parallele_executer(nb,&tache_tri_rapide,taches,sizeof(tache_tri));
+	struct arete* src=t->aretes;
+	struct arete* dst=tmp;
+	for(int nb_runs=nb;nb_runs>1;nb_runs=(nb_runs+1)/2){
+		int nb_fusions=nb_runs/2;
+		for(int f=0;f<nb_fusions;f++){
+			taches[f].src=src;
+			taches[f].dst=dst;
+			taches[f].debut=bornes[2*f];
+			taches[f].milieu=bornes[2*f+1];
+			taches[f].fin=bornes[2*f+2];
 		}
+		parallele_executer(nb_fusions,&tache_fusion,taches,sizeof(tache_tri));
+		if(nb_runs%2==1){
+			memcpy(dst+bornes[nb_runs-1],src+bornes[nb_runs-1],sizeof(struct arete)*(n-bornes[nb_runs-1]));
+		}
+		for(int f=0;f<nb_fusions;f++) bornes[f]=bornes[2*f];
+		bornes[nb_fusions]=(nb_runs%2==1) ? bornes[nb_runs-1] : n;
+		bornes[(nb_runs+1)/2]=n;
+		struct arete* e=src;
+		src=dst;
+		dst=e;
+	}
+	if(src!=t->aretes){
+		free(t->aretes);
+		t->aretes=src;
+		t->capacite=n;
+	}
+	else free(tmp);
+	free(bornes);
+	free(taches);
+}
+
+void trier_aretes_parallele(tableau_aretes t,int nb_threads){
+	assert(NULL!=t);
+	int n=t->nb_aretes;
+	if(t->trie) return;
+	if(nb_threads<1) nb_threads=1;
+	if(nb_threads>n/1024) nb_threads=(n/1024>0) ? n/1024 : 1;
+	if(nb_threads==1){
+		trier_aretes(t);
+		return;
 	}
-	liste_detruire(&l);
+	t->trie=true;
+	if(t->poids_min<0 || t->poids_max>POIDS_MAX_TRI_COMPTAGE){
+		trier_aretes_fusion(t,nb_threads);
+		return;
+	}
+	const int nb_poids=t->poids_max+1;
+	tache_tri* taches=malloc(sizeof(tache_tri)*nb_threads);
+	int* comptes=malloc(sizeof(int)*nb_poids*nb_threads);
+	struct arete* tmp=malloc(sizeof(struct arete)*n);
+	assert(NULL!=taches && NULL!=comptes && NULL!=tmp);
+	for(int p=0;p<nb_threads;p++){
+		taches[p].src=t->aretes;
+		taches[p].dst=tmp;
+		taches[p].debut=parallele_debut_tranche(n,nb_threads,p);
+		taches[p].fin=parallele_debut_tranche(n,nb_threads,p+1);
+		taches[p].compte=comptes+p*nb_poids;
+		taches[p].poids_max=t->poids_max;
+	}
+	parallele_executer(nb_threads,&tache_histogramme,taches,sizeof(tache_tri));
+
+	bool trie=true;
+	for(int p=0;p<nb_threads;p++){
+		trie=trie && taches[p].trie;
+		if(p>0 && taches[p].fin>taches[p].debut && taches[p].debut>0){
+			const struct arete* a=&t->aretes[taches[p].debut-1];
+			const struct arete* b=&t->aretes[taches[p].debut];
+			if(a->s1>b->s1 || (a->s1==b->s1 && a->s2>b->s2)) trie=false;
+		}
+	}
+	if(!trie){
+		// comme trier_aretes : tri par base s2 puis s1 avant le placement stable par poids,
+		// qui laisse alors chaque paquet de même poids dans l'ordre (s1,s2)
+		int* compte=malloc(sizeof(int)*(t->sommet_max+1));
+		assert(NULL!=compte);
+		tri_comptage(t->aretes,tmp,n,CLE_S2,t->sommet_max,compte);
+		tri_comptage(tmp,t->aretes,n,CLE_S1,t->sommet_max,compte);
+		free(compte);
+		// les tranches ont changé de contenu : leurs histogrammes sont à refaire
+		parallele_executer(nb_threads,&tache_histogramme,taches,sizeof(tache_tri));
+	}
+
+	// positions de départ : par poids, puis par tranche, ce qui rend le placement stable
+	int position=0;
+	for(int c=0;c<nb_poids;c++){
+		for(int p=0;p<nb_threads;p++){
+			int nb=taches[p].compte[c];
+			taches[p].compte[c]=position;
+			position+=nb;
+		}
+	}
+	parallele_executer(nb_threads,&tache_placement,taches,sizeof(tache_tri));
+
+	free(t->aretes);
+	t->aretes=tmp;
+	t->capacite=n;
+	free(comptes);
+	free(taches);
+}
+
+/* liste d'arêtes rangées dans les maillons d'un pool qui lui est propre */
+static liste liste_aretes_creer(void){
+	pool_maillons p=pool_maillons_creer(sizeof(struct arete));
+	liste s=liste_creer_pool(&copier_arete,&afficher_arete,&detruire_arete,&comparer_arete,p);
+	pool_maillons_liberer(&p);
+	return s;
+}
+
+liste kruskal(tableau_aretes t,int nb_s){
+	trier_aretes(t);
+
+	liste s=liste_aretes_creer();
+	union_find uf=union_find_creer(nb_s);
+	for(int i=0;i<t->nb_aretes;i++){
+		int r1 = union_find_trouver(uf,t->aretes[i].s1);
+		int r2 = union_find_trouver(uf,t->aretes[i].s2);
+
+		if(r1!=r2){
+			union_find_union(uf,r1,r2);
+			liste_insertion_fin(s,&(t->aretes[i]));
+		}
+	}
+	union_find_detruire(&uf);
 	return s;
 	
 }
+
+/* en dessous de ce nombre d'arêtes, kruskal_filtre trie et traite directement */
+#define SEUIL_KRUSKAL_FILTRE 4096
+
+/* racine de val sans compression de chemin : utilisable par plusieurs threads en lecture */
+static int racine_lecture(const struct union_find_struct* uf,int val){
+	while(uf->pere[val]!=val) val=uf->pere[val];
+	return val;
+}
+
+typedef struct tache_filtre_struct{
+	const struct union_find_struct* uf;
+	const struct arete* aretes;
+	int debut,fin;
+	char* garder;
+} tache_filtre;
+
+static void* tache_filtrer(void* arg){
+	tache_filtre* tf=arg;
+	for(int i=tf->debut;i<tf->fin;i++){
+		tf->garder[i]=racine_lecture(tf->uf,tf->aretes[i].s1)!=racine_lecture(tf->uf,tf->aretes[i].s2);
+	}
+	return NULL;
+}
+
+/* retire de tab[0,n) les arêtes internes à une composante, renvoie le nombre d'arêtes gardées */
+static int filtrer_aretes(union_find uf,struct arete* tab,int n,int nb_threads,char* garder){
+	int nb=(n>=16*SEUIL_KRUSKAL_FILTRE) ? nb_threads : 1;
+	tache_filtre taches[nb];
+	for(int p=0;p<nb;p++){
+		taches[p].uf=uf;
+		taches[p].aretes=tab;
+		taches[p].debut=parallele_debut_tranche(n,nb,p);
+		taches[p].fin=parallele_debut_tranche(n,nb,p+1);
+		taches[p].garder=garder;
+	}
+	parallele_executer(nb,&tache_filtrer,taches,sizeof(tache_filtre));
+	int k=0;
+	for(int i=0;i<n;i++){
+		if(garder[i]) tab[k++]=tab[i];
+	}
+	return k;
+}
+
+static void kruskal_filtre_rec(union_find uf,struct arete* tab,int n,liste s,int nb_threads,char* garder){
+	if(n<=0) return;
+	if(n>SEUIL_KRUSKAL_FILTRE){
+		// pivot : médiane de trois, partition en (<= pivot) et (> pivot)
+		const struct arete pivot=*mediane_de_trois(&tab[0],&tab[n/2],&tab[n-1]);
+		int k=0;
+		for(int i=0;i<n;i++){
+			if(ordre_arete(&tab[i],&pivot)<=0) echanger(tab,i,k++);
+		}
+		if(k<n){
+			kruskal_filtre_rec(uf,tab,k,s,nb_threads,garder);
+			int reste=filtrer_aretes(uf,tab+k,n-k,nb_threads,garder);
+			kruskal_filtre_rec(uf,tab+k,reste,s,nb_threads,garder);
+			return;
+		}
+	}
+	trier_arete(tab,0,n-1);
+	for(int i=0;i<n;i++){
+		int r1 = union_find_trouver(uf,tab[i].s1);
+		int r2 = union_find_trouver(uf,tab[i].s2);
+		if(r1!=r2){
+			union_find_union(uf,r1,r2);
+			liste_insertion_fin(s,&(tab[i]));
+		}
+	}
+}
+
+liste kruskal_filtre(tableau_aretes t,int nb_s,int nb_threads){
+	assert(NULL!=t);
+	if(t->trie) return kruskal(t,nb_s);
+	if(nb_threads<1) nb_threads=1;
+	liste s=liste_aretes_creer();
+	union_find uf=union_find_creer(nb_s);
+	char* garder=malloc(t->nb_aretes+1);
+	assert(NULL!=garder);
+	kruskal_filtre_rec(uf,t->aretes,t->nb_aretes,s,nb_threads,garder);
+	// les arêtes ont été partitionnées : le tableau n'est plus trié
+	t->trie=false;
+	free(garder);
+	union_find_detruire(&uf);
+	return s;
+}
@@ -19,20 +19,88 @@ struct arete{
 	int s1,s2,poids;
 };
 
+/*!
+ * Tableau d'arêtes stockées par valeur dans une seule allocation.
+ * Les nb_aretes premières cases de aretes sont utilisées, capacite est la taille allouée.
+ * poids_min, poids_max et sommet_max sont tenus à jour par tableau_aretes_ajouter
+ * et servent à choisir l'algorithme de tri ; trie est vrai après trier_aretes
+ * (et remis à faux par tableau_aretes_ajouter).
+ */
+typedef struct tableau_aretes_struct * tableau_aretes;
+
+struct tableau_aretes_struct{
+	int nb_aretes;
+	int capacite;
+	int poids_min;
+	int poids_max;
+	int sommet_max;
+	bool trie;
+	struct arete* aretes;
+};
+
+/*!
+ * Poids maximal pour lequel trier_aretes utilise le tri par comptage
+ * (65535 : valeur max d'un pixel PGM sur 16 bits).
+ */
+#define POIDS_MAX_TRI_COMPTAGE 65535
+
+/*!
+ * Crée un tableau d'arêtes vide.
+ * \param capacite nombre d'arêtes prévu (le tableau s'agrandit si besoin)
+ */
+tableau_aretes tableau_aretes_creer(int capacite);
+
+/*!
+ * Ajoute l'arête (s1,s2,poids) à la fin du tableau.
+ */
+void tableau_aretes_ajouter(tableau_aretes t,int s1,int s2,int poids);
+
+/*!
+ * Détruit le tableau, le pointeur est mis à NULL.
+ */
+void tableau_aretes_detruire(tableau_aretes* t);
+
 arete creer_arete(int s1,int s2,int poids);
 
-void echanger(arete *tab, int a, int b);
+void echanger(struct arete *tab, int a, int b);
 
-void trier_arete(arete *tab,int debut,int fin);
+/*!
+ * Trie tab[debut..fin] par poids croissant, puis s1, puis s2
+ * (tri rapide, pivot médiane de trois).
+ */
+void trier_arete(struct arete *tab,int debut,int fin);
 
-liste kruskal(arete * tab,int nb_s,int nb_arete);
+/*!
+ * Trie tout le tableau dans le même ordre que trier_arete.
+ * Si les poids sont entiers entre 0 et POIDS_MAX_TRI_COMPTAGE, un tri par
+ * comptage stable (poids, puis s1, puis s2) en temps linéaire est utilisé,
+ * sinon le tri rapide trier_arete.
+ */
+void trier_aretes(tableau_aretes t);
+
+/*!
+ * Même tri que trier_aretes, réparti sur nb_threads threads.
+ * Poids bornés : si l'entrée n'est pas déjà dans l'ordre (s1,s2), tri par base
+ * s2 puis s1 comme trier_aretes, puis histogrammes et placement stable par poids
+ * en parallèle, par tranches. Sinon : tri rapide de chaque tranche puis fusions parallèles.
+ */
+void trier_aretes_parallele(tableau_aretes t,int nb_threads);
+
+liste kruskal(tableau_aretes t,int nb_s);
+
+/*!
+ * Variante Filter-Kruskal de kruskal, même résultat (mêmes arêtes, dans le même ordre).
+ * Les arêtes sont partitionnées autour d'un pivot ; la partie légère est traitée
+ * récursivement, puis les arêtes lourdes dont les extrémités sont déjà reliées
+ * sont retirées (en parallèle sur nb_threads threads) avant de traiter le reste.
+ * Seules les petites parties sont triées. Les arêtes de t sont réordonnées.
+ */
+liste kruskal_filtre(tableau_aretes t,int nb_s,int nb_threads);
 
 void copier_arete ( void * val ,void * * pt );
 
 void detruire_arete ( void * * pt ) ;
 
-void detruire_tab_arete( arete* tab);
-
 void afficher_arete(FILE* f, void* val);
 
 int comparer_arete(void *  val1, void * val2 );
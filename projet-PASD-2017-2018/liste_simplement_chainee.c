@@ -17,33 +17,112 @@
  */
 
 
-static maillon maillon_creer(void * val, void(*copier)(void* val, void** pt)) {
-	maillon m=malloc(sizeof(struct maillon_struct));
-	copier(val,&(m->val));
+/* nombre de maillons alloués d'un coup par un pool */
+#define NB_MAILLONS_BLOC 1024
+
+/* les NB_MAILLONS_BLOC maillons d'un bloc suivent son entête */
+typedef struct bloc_maillons_struct * bloc_maillons;
+
+struct bloc_maillons_struct {
+	bloc_maillons suivant;
+};
+
+struct pool_maillons_struct {
+	size_t taille_valeur;
+	size_t taille_maillon;
+	bloc_maillons blocs;
+	maillon libres;
+	int nb_references;
+};
+
+pool_maillons pool_maillons_creer(size_t taille_valeur){
+	pool_maillons p=malloc(sizeof(struct pool_maillons_struct));
+	assert(NULL!=p);
+	p->taille_valeur=taille_valeur;
+	// la valeur est rangée juste après le maillon, alignée sur un pointeur
+	p->taille_maillon=sizeof(struct maillon_struct)+taille_valeur;
+	p->taille_maillon=(p->taille_maillon+sizeof(void*)-1)/sizeof(void*)*sizeof(void*);
+	p->blocs=NULL;
+	p->libres=NULL;
+	p->nb_references=1;
+	return p;
+}
+
+void pool_maillons_liberer(pool_maillons* p){
+	assert(NULL!=p);
+	if(NULL==*p) return;
+	if(--(*p)->nb_references==0){
+		while(NULL!=(*p)->blocs){
+			bloc_maillons suivant=(*p)->blocs->suivant;
+			free((*p)->blocs);
+			(*p)->blocs=suivant;
+		}
+		free(*p);
+	}
+	*p=NULL;
+}
+
+static maillon pool_maillons_allouer(pool_maillons p){
+	if(NULL==p->libres){
+		bloc_maillons b=malloc(sizeof(struct bloc_maillons_struct)+NB_MAILLONS_BLOC*p->taille_maillon);
+		assert(NULL!=b);
+		b->suivant=p->blocs;
+		p->blocs=b;
+		char* debut=(char*)(b+1);
+		for(int i=NB_MAILLONS_BLOC-1;i>=0;i--){
+			maillon m=(maillon)(debut+i*p->taille_maillon);
+			m->suivant=p->libres;
+			p->libres=m;
+		}
+	}
+	maillon m=p->libres;
+	p->libres=m->suivant;
+	return m;
+}
+
+static maillon maillon_creer(liste l, void * val) {
+	maillon m;
+	if(NULL==l->pool){
+		m=malloc(sizeof(struct maillon_struct));
+		l->copier(val,&(m->val));
+	}
+	else{
+		m=pool_maillons_allouer(l->pool);
+		if(l->pool->taille_valeur>0){
+			m->val=(char*)m+sizeof(struct maillon_struct);
+			memcpy(m->val,val,l->pool->taille_valeur);
+		}
+		else l->copier(val,&(m->val));
+	}
 	m->suivant=NULL;
 	return m;
 	
 }
 
-static void maillon_detruire_simple(maillon* m, void(* detruire)(void** pt)) {
-	detruire(&((*m)->val));
-	free(*m);
+static void maillon_detruire_simple(liste l, maillon* m) {
+	if(NULL==l->pool){
+		l->detruire(&((*m)->val));
+		free(*m);
+	}
+	else{
+		if(0==l->pool->taille_valeur) l->detruire(&((*m)->val));
+		(*m)->suivant=l->pool->libres;
+		l->pool->libres=*m;
+	}
 	*m=NULL;
 }
 
-static void maillon_detruire(maillon* m, void(* detruire)(void** pt)) {
-	if((*m)->suivant==NULL){
-		detruire(&((*m)->val));
-		free(*m);
-		*m=NULL;
+static void maillon_detruire(liste l, maillon* m) {
+	while(NULL!=*m){
+		maillon suivant=(*m)->suivant;
+		maillon_detruire_simple(l,m);
+		*m=suivant;
 	}
-	else maillon_detruire(&((*m)->suivant),detruire);
 }
 
 
 static void maillon_afficher(FILE* f, maillon m_debut, void(* afficher )(FILE *f, void* val)) {
 	maillon curseur=m_debut;
-	assert(NULL!=curseur);
 	while(curseur!=NULL){
 		afficher(f,curseur->val);
 		//fprintf(f,"\n");
@@ -60,9 +139,10 @@ static maillon maillon_precedent(liste l,maillon m){
 	return *m1;
 }
 
-static void maillon_ajouter_avant( void* _val,maillon m, void(*copier)(void* val, void** pt)) {
-	maillon m_avant=maillon_creer(_val,copier);
+static maillon maillon_ajouter_avant(liste l, void* _val,maillon m) {
+	maillon m_avant=maillon_creer(l,_val);
 	m_avant->suivant=m;
+	return m_avant;
 }
 
 
@@ -77,6 +157,9 @@ static void maillon_ajouter_avant( void* _val,maillon m, void(*copier)(void* val
 liste liste_creer(void(*_copier)(void* val, void** pt),void(*_afficher)(FILE *f, void* val),void(* _detruire )(void** pt),int(*_comparer)(void* val1, void* val2)) {
 	liste l=malloc(sizeof(struct liste_struct));
 	l->tete=NULL;
+	l->queue=NULL;
+	l->taille=0;
+	l->pool=NULL;
 	l->copier=_copier;
 	l->afficher=_afficher;
 	l->detruire=_detruire;
@@ -84,10 +167,22 @@ liste liste_creer(void(*_copier)(void* val, void** pt),void(*_afficher)(FILE *f,
 	return l;
 }
 
+liste liste_creer_pool(void(*_copier)(void* val, void** pt),void(*_afficher)(FILE *f, void* val),void(* _detruire )(void** pt),int(*_comparer)(void* val1, void* val2),pool_maillons p) {
+	liste l=liste_creer(_copier,_afficher,_detruire,_comparer);
+	if(NULL!=p){
+		p->nb_references++;
+		l->pool=p;
+	}
+	return l;
+}
+
 
 void liste_detruire(liste* l){
 	 if (*l != NULL) {
-		maillon_detruire(&((*l)->tete),(*l)->detruire);
+		pool_maillons p=(*l)->pool;
+		// seule utilisatrice du pool, sans valeur à détruire : les blocs sont libérés d'un coup
+		if(NULL==p || 0==p->taille_valeur || p->nb_references>1) maillon_detruire(*l,&((*l)->tete));
+		pool_maillons_liberer(&p);
 	    	free(*l);
 	    	*l= NULL;
  	 }	
@@ -95,21 +190,56 @@ void liste_detruire(liste* l){
 
 
 void liste_insertion_debut(liste l, void* val){
-	if(NULL==l->tete) l->tete=maillon_creer(val,l->copier);
-	else maillon_ajouter_avant(val,l->tete,l->copier);
-	
+	if(NULL==l->tete){
+		l->tete=maillon_creer(l,val);
+		l->queue=l->tete;
+	}
+	else l->tete=maillon_ajouter_avant(l,val,l->tete);
+	l->taille++;
 }
 
 void liste_insertion_fin(liste l, void* val){
-	if(NULL==l->tete) l->tete=maillon_creer(val,l->copier);
+	if(NULL==l->tete){
+		l->tete=maillon_creer(l,val);
+		l->queue=l->tete;
+	}
 	else{
-		maillon* p=&(l->tete);
-		while(NULL!=(*p)->suivant){
-			p=&((*p)->suivant);
-		}
-		(*p)->suivant=maillon_creer(val,l->copier);
+		l->queue->suivant=maillon_creer(l,val);
+		l->queue=l->queue->suivant;
 	}
-	
+	l->taille++;
+}
+
+/* maillon qui reçoit val sans copie */
+static maillon maillon_prendre(liste l, void* val){
+	if(NULL!=l->pool && l->pool->taille_valeur>0){
+		maillon m=maillon_creer(l,val);
+		l->detruire(&val);
+		return m;
+	}
+	maillon m=(NULL==l->pool) ? malloc(sizeof(struct maillon_struct)) : pool_maillons_allouer(l->pool);
+	assert(NULL!=m);
+	m->val=val;
+	m->suivant=NULL;
+	return m;
+}
+
+void liste_insertion_debut_prendre(liste l, void* val){
+	assert(NULL!=l);
+	maillon m=maillon_prendre(l,val);
+	m->suivant=l->tete;
+	l->tete=m;
+	if(NULL==l->queue) l->queue=m;
+	l->taille++;
+}
+
+void liste_insertion_fin_prendre(liste l, void* val){
+	assert(NULL!=l);
+	maillon m=maillon_prendre(l,val);
+	if(NULL==l->tete) l->tete=m;
+	else l->queue->suivant=m;
+	l->queue=m;
+	l->taille++;
 }
 
 maillon* liste_chercher_maillon(liste l ,void* val){
@@ -124,7 +254,7 @@ void liste_copier(maillon *m,liste l){
 	maillon* curseur=&(l->tete);
 	maillon* curseur1=m;
 	while(*curseur!=NULL){
-		*curseur1=maillon_creer((*curseur)->val,l->copier);
+		*curseur1=maillon_creer(l,(*curseur)->val);
 		curseur=&((*curseur)->suivant);
 		curseur1=&((*curseur1)->suivant);
 		
@@ -134,28 +264,60 @@ void liste_copier(maillon *m,liste l){
 void liste_concatener(liste l1,liste l2){
 	assert(NULL!=l1);
 	assert(NULL!=l2);
-	maillon curseur=l1->tete;
-	while(curseur->suivant!=NULL){
-		curseur=curseur->suivant;
+	// les copies sont faites par l1 (et son pool), l2 est parcourue taille fois au plus
+	maillon m=l2->tete;
+	for(unsigned int n=l2->taille;n>0;n--){
+		liste_insertion_fin(l1,m->val);
+		m=m->suivant;
 	}
-	liste_copier(&(curseur->suivant),l2);
 	
 }
 
 void liste_supprimer_maillon(liste l,void * val){
-	if(l->tete->val==val){
-		maillon m=l->tete->suivant;
-		maillon_detruire_simple(&(l->tete),l->detruire);
-		l->tete=m;
+	maillon* m=&(l->tete);
+	maillon precedent=NULL;
+	while(NULL!=*m){
+		if((*m)->val==val){
+			maillon m1=(*m)->suivant;
+			maillon_detruire_simple(l,m);
+			*m=m1;
+			l->taille--;
+			if(NULL==m1) l->queue=precedent;
+		}
+		else{
+			precedent=*m;
+			m=&((*m)->suivant);
+		}
 	}
-	else{
-		maillon*m=&(l->tete);
-		while(NULL!=(*m)->suivant){
-			if((*m)->suivant->val==val){
-				maillon m1=(*m)->suivant->suivant;
-				maillon_detruire_simple(&((*m)->suivant),l->detruire);
-				(*m)->suivant=m1;	
-			}
+}
+
+void liste_fusionner(liste l1,liste l2){
+	assert(NULL!=l1);
+	assert(NULL!=l2);
+	assert(l1->pool==l2->pool);
+	if(NULL==l2->tete) return;
+	if(NULL==l1->tete) l1->tete=l2->tete;
+	else l1->queue->suivant=l2->tete;
+	l1->queue=l2->queue;
+	l1->taille+=l2->taille;
+	l2->tete=NULL;
+	l2->queue=NULL;
+	l2->taille=0;
+}
+
+void liste_supprimer_si(liste l,bool (*predicat)(void* val)){
+	assert(NULL!=l);
+	maillon* m=&(l->tete);
+	l->queue=NULL;
+	while(NULL!=*m){
+		if(predicat((*m)->val)){
+			maillon m1=(*m)->suivant;
+			maillon_detruire_simple(l,m);
+			*m=m1;
+			l->taille--;
+		}
+		else{
+			l->queue=*m;
 			m=&((*m)->suivant);
 		}
 	}
@@ -167,6 +329,11 @@ void liste_affichage(FILE* f,liste l){
 	fprintf(f,"]\n");
 }
 
+unsigned int liste_taille(liste l){
+	assert(NULL!=l);
+	return l->taille;
+}
+
 void * liste_valeur_tete(liste l){
 	return l->tete->val;
 }
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <stddef.h>
 
 /*! \file listes_generiques.h
  * \brief Module liste générique.
@@ -19,6 +20,12 @@ typedef struct maillon_struct * maillon;
 
 typedef struct liste_struct * liste;
 
+/*!
+ * Pool de maillons, éventuellement partagé par plusieurs listes : les maillons sont alloués
+ * par blocs contigus et les maillons supprimés sont réutilisés.
+ */
+typedef struct pool_maillons_struct * pool_maillons;
+
 struct maillon_struct {
 	void* val;
 	maillon suivant;
@@ -26,9 +33,15 @@ struct maillon_struct {
 
 /*!
  * la structure définit 3 champs supplémentaires qui sont des pointeurs sur fonction
+ * queue pointe sur le dernier maillon (NULL si la liste est vide)
+ * et taille est le nombre de maillons, tenu à jour par toutes les fonctions du module ;
+ * pool vaut NULL si chaque maillon est alloué par malloc
 */
 struct liste_struct {
 	maillon tete;
+	maillon queue;
+	unsigned int taille;
+	pool_maillons pool;
 	void ( *copier ) ( void * val , void ** pt );
 	void ( *afficher ) ( FILE * f , void * val );
 	void ( *detruire ) ( void ** pt);
@@ -38,12 +51,45 @@ struct liste_struct {
 
 liste liste_creer (void (* _copie)(void* val, void** pt), void (* _afficher)(FILE* f, void * val), void (* _detruire)(void** pt),int ( *comparer )(void* val1, void* val2)) ;
 
+/*!
+ * Crée un pool dont les maillons sont alloués par blocs.
+ * \param taille_valeur si non nul, chaque valeur (de taille_valeur octets, sans pointeur à libérer)
+ * est recopiée par memcpy dans son maillon : copier et detruire ne sont alors pas appelées.
+ * Si nul, les valeurs sont copiées et détruites par les fonctions de la liste.
+ */
+pool_maillons pool_maillons_creer(size_t taille_valeur);
+
+/*!
+ * Rend la référence du créateur, le pointeur est mis à NULL. Le pool est libéré
+ * quand il n'est plus utilisé par aucune liste.
+ */
+void pool_maillons_liberer(pool_maillons* p);
+
+/*!
+ * Comme liste_creer, les maillons étant pris dans p (liste_creer si p vaut NULL).
+ * Les listes qui partagent un pool peuvent être fusionnées par liste_fusionner.
+ */
+liste liste_creer_pool (void (* _copie)(void* val, void** pt), void (* _afficher)(FILE* f, void * val), void (* _detruire)(void** pt),int ( *comparer )(void* val1, void* val2), pool_maillons p) ;
+
+/*!
+ * Détruit la liste, le pointeur est mis à NULL. Une liste seule à utiliser un pool
+ * dont les valeurs sont rangées dans les maillons libère ses blocs sans parcours.
+ */
 void liste_detruire (liste * l);
 
 void liste_insertion_debut (liste l, void * val);
 
 void liste_insertion_fin (liste l, void * val);
 
+/*!
+ * Comme liste_insertion_debut et liste_insertion_fin, sans appel à copier :
+ * la liste devient propriétaire de val, qui sera libérée par detruire.
+ * Si le pool range les valeurs dans les maillons, val y est recopiée puis détruite.
+ */
+void liste_insertion_debut_prendre (liste l, void * val);
+
+void liste_insertion_fin_prendre (liste l, void * val);
+
 maillon* liste_chercher_maillon(liste l ,void* val);
 
 void liste_copier(maillon * m,liste l);
@@ -52,8 +98,23 @@ void liste_concatener(liste l1,liste l2);
 
 void liste_supprimer_maillon(liste l,void * val);
 
+/*!
+ * Déplace tous les maillons de l2 à la fin de l1, sans copie, en temps constant.
+ * l2 est vide après l'appel mais n'est pas détruite.
+ * \pre l1 et l2 utilisent les mêmes fonctions copier/detruire et le même pool
+ */
+void liste_fusionner(liste l1,liste l2);
+
+/*!
+ * Supprime en un seul parcours toutes les valeurs pour lesquelles predicat est vrai.
+ */
+void liste_supprimer_si(liste l,bool (*predicat)(void* val));
+
 void liste_affichage (FILE * f, liste l);
 
+/*!
+ * Nombre d'éléments de la liste, en temps constant.
+ */
 unsigned int liste_taille (liste l);
 
 void* liste_valeur_tete (liste l);
@@ -0,0 +1,263 @@
+#define _POSIX_C_SOURCE 200809L
+#include "coloration.h"
+#include <assert.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/* usage : ./lot k dossier_sortie nb_threads (image.pgm | dossier) [...]
+ * segmente chaque image (les *.pgm d'un dossier, par ordre alphabétique) et écrit son rendu
+ * par intensité moyenne sous le même nom dans dossier_sortie.
+ *
+ * Trois étages en pipeline : un thread lit les images (lire_image_pgm_tampon), nb_threads
+ * threads les segmentent, un thread écrit les rendus. Au plus MAX_EN_COURS(nb_threads) images
+ * sont en mémoire à la fois : la lecture attend qu'une écriture soit terminée. */
+
+/* images lues d'avance et rendus en attente d'écriture, en plus de celles en segmentation */
+#define MAX_EN_COURS(nb_threads) (2*(nb_threads)+2)
+
+/* une image qui traverse le pipeline */
+typedef struct travail_struct{
+	const char* entree;
+	char* sortie;
+	pgm img;
+	pgm rendu;
+	int nb_regions;
+	bool ok;
+} travail;
+
+/* file de travaux entre deux étages : la lecture ne dépassant pas MAX_EN_COURS images,
+ * une file de cette capacité n'est jamais pleine */
+typedef struct file_travaux_struct{
+	travail** cases;
+	int capacite;
+	int debut,nb;
+	int nb_producteurs;
+	pthread_mutex_t verrou;
+	pthread_cond_t non_vide;
+} file_travaux;
+
+static void file_initialiser(file_travaux* f,int capacite,int nb_producteurs){
+	f->cases=malloc(sizeof(travail*)*capacite);
+	assert(NULL!=f->cases);
+	f->capacite=capacite;
+	f->debut=0;
+	f->nb=0;
+	f->nb_producteurs=nb_producteurs;
+	pthread_mutex_init(&f->verrou,NULL);
+	pthread_cond_init(&f->non_vide,NULL);
+}
+
+static void file_liberer(file_travaux* f){
+	free(f->cases);
+	pthread_mutex_destroy(&f->verrou);
+	pthread_cond_destroy(&f->non_vide);
+}
+
+static void file_ajouter(file_travaux* f,travail* t){
+	pthread_mutex_lock(&f->verrou);
+	assert(f->nb<f->capacite);
+	f->cases[(f->debut+f->nb)%f->capacite]=t;
+	f->nb++;
+	pthread_cond_signal(&f->non_vide);
+	pthread_mutex_unlock(&f->verrou);
+}
+
+/* un producteur a fini : quand il n'en reste plus, les consommateurs en attente sont libérés */
+static void file_fermer(file_travaux* f){
+	pthread_mutex_lock(&f->verrou);
+	f->nb_producteurs--;
+	pthread_cond_broadcast(&f->non_vide);
+	pthread_mutex_unlock(&f->verrou);
+}
+
+/* NULL quand la file est vide et que tous ses producteurs ont fini */
+static travail* file_retirer(file_travaux* f){
+	pthread_mutex_lock(&f->verrou);
+	while(0==f->nb && f->nb_producteurs>0) pthread_cond_wait(&f->non_vide,&f->verrou);
+	travail* t=NULL;
+	if(f->nb>0){
+		t=f->cases[f->debut];
+		f->debut=(f->debut+1)%f->capacite;
+		f->nb--;
+	}
+	pthread_mutex_unlock(&f->verrou);
+	return t;
+}
+
+typedef struct lot_struct{
+	travail* travaux;
+	int nb_travaux;
+	int k;
+	file_travaux lues;
+	file_travaux segmentees;
+	// images lues et pas encore écrites, au plus max_en_cours
+	int en_cours;
+	int max_en_cours;
+	pthread_mutex_t verrou;
+	pthread_cond_t place_libre;
+} lot;
+
+static void* lire_images(void* arg){
+	lot* l=arg;
+	for(int n=0;n<l->nb_travaux;n++){
+		pthread_mutex_lock(&l->verrou);
+		while(l->en_cours==l->max_en_cours) pthread_cond_wait(&l->place_libre,&l->verrou);
+		l->en_cours++;
+		pthread_mutex_unlock(&l->verrou);
+		travail* t=&l->travaux[n];
+		t->img=lire_image_pgm_tampon(t->entree);
+		file_ajouter(&l->lues,t);
+	}
+	file_fermer(&l->lues);
+	return NULL;
+}
+
+static void* segmenter_images(void* arg){
+	lot* l=arg;
+	travail* t;
+	while(NULL!=(t=file_retirer(&l->lues))){
+		if(NULL!=t->img){
+			// arêtes et statistiques lues dans le tampon : la matrice n'est jamais construite
+			aretes_par_poids a=aretes_par_poids_creer_image(t->img);
+			int* etiquettes=segmentation_etiquettes_par_poids(a,l->k,&t->nb_regions);
+			aretes_par_poids_detruire(&a);
+			t->rendu=coloration_moyenne(t->img,etiquettes,t->nb_regions);
+			free(etiquettes);
+			detruire_image_pgm(&t->img);
+		}
+		file_ajouter(&l->segmentees,t);
+	}
+	file_fermer(&l->segmentees);
+	return NULL;
+}
+
+static void* ecrire_rendus(void* arg){
+	lot* l=arg;
+	travail* t;
+	while(NULL!=(t=file_retirer(&l->segmentees))){
+		if(NULL!=t->rendu){
+			t->ok=ecrire_image_pgm(t->sortie,t->rendu,NULL);
+			detruire_image_pgm(&t->rendu);
+		}
+		pthread_mutex_lock(&l->verrou);
+		l->en_cours--;
+		pthread_cond_signal(&l->place_libre);
+		pthread_mutex_unlock(&l->verrou);
+	}
+	return NULL;
+}
+
+static int comparer_noms(const void* a,const void* b){
+	return strcmp(*(char* const*)a,*(char* const*)b);
+}
+
+static bool suffixe_pgm(const char* nom){
+	size_t n=strlen(nom);
+	return n>4 && 0==strcmp(nom+n-4,".pgm");
+}
+
+static void ajouter_nom(char* nom,char*** noms,int* nb,int* capacite){
+	if(*nb==*capacite){
+		*capacite*=2;
+		*noms=realloc(*noms,sizeof(char*)*(*capacite));
+		assert(NULL!=*noms);
+	}
+	(*noms)[(*nb)++]=nom;
+}
+
+/* ajoute fichier, ou les *.pgm du dossier fichier, à la fin de noms */
+static void ajouter_entrees(const char* fichier,char*** noms,int* nb,int* capacite){
+	DIR* d=opendir(fichier);
+	if(NULL==d){
+		ajouter_nom(strdup(fichier),noms,nb,capacite);
+		return;
+	}
+	const int premier=*nb;
+	struct dirent* e;
+	while(NULL!=(e=readdir(d))){
+		// fichiers cachés ignorés (par exemple les ._*.pgm de macOS, qui ne sont pas des images)
+		if('.'==e->d_name[0] || !suffixe_pgm(e->d_name)) continue;
+		char* chemin=malloc(strlen(fichier)+strlen(e->d_name)+2);
+		assert(NULL!=chemin);
+		sprintf(chemin,"%s/%s",fichier,e->d_name);
+		ajouter_nom(chemin,noms,nb,capacite);
+	}
+	closedir(d);
+	qsort(*noms+premier,*nb-premier,sizeof(char*),&comparer_noms);
+}
+
+int main(int argc, char** argv) {
+
+	if(argc<5){
+		fprintf(stderr,"usage : %s k dossier_sortie nb_threads (image.pgm | dossier) [...]\n",argv[0]);
+		return 1;
+	}
+	const int k=atoi(argv[1]);
+	const char* dossier_sortie=argv[2];
+	int nb_threads=atoi(argv[3]);
+	if(nb_threads<1) nb_threads=1;
+
+	int capacite=16,nb=0;
+	char** noms=malloc(sizeof(char*)*capacite);
+	assert(NULL!=noms);
+	for(int i=4;i<argc;i++) ajouter_entrees(argv[i],&noms,&nb,&capacite);
+
+	lot l;
+	l.travaux=calloc(nb>0 ? nb : 1,sizeof(travail));
+	assert(NULL!=l.travaux);
+	l.nb_travaux=nb;
+	l.k=k;
+	for(int n=0;n<nb;n++){
+		const char* base=strrchr(noms[n],'/');
+		base=(NULL==base) ? noms[n] : base+1;
+		l.travaux[n].entree=noms[n];
+		l.travaux[n].sortie=malloc(strlen(dossier_sortie)+strlen(base)+2);
+		assert(NULL!=l.travaux[n].sortie);
+		sprintf(l.travaux[n].sortie,"%s/%s",dossier_sortie,base);
+	}
+	l.en_cours=0;
+	l.max_en_cours=MAX_EN_COURS(nb_threads);
+	pthread_mutex_init(&l.verrou,NULL);
+	pthread_cond_init(&l.place_libre,NULL);
+	file_initialiser(&l.lues,l.max_en_cours,1);
+	file_initialiser(&l.segmentees,l.max_en_cours,nb_threads);
+
+	struct timespec debut,fin;
+	clock_gettime(CLOCK_MONOTONIC,&debut);
+	pthread_t lecteur,ecrivain;
+	pthread_t* segmenteurs=malloc(sizeof(pthread_t)*nb_threads);
+	assert(NULL!=segmenteurs);
+	pthread_create(&lecteur,NULL,&lire_images,&l);
+	for(int p=0;p<nb_threads;p++) pthread_create(&segmenteurs[p],NULL,&segmenter_images,&l);
+	pthread_create(&ecrivain,NULL,&ecrire_rendus,&l);
+	pthread_join(lecteur,NULL);
+	for(int p=0;p<nb_threads;p++) pthread_join(segmenteurs[p],NULL);
+	pthread_join(ecrivain,NULL);
+	clock_gettime(CLOCK_MONOTONIC,&fin);
+	const double duree=(fin.tv_sec-debut.tv_sec)+(fin.tv_nsec-debut.tv_nsec)*1e-9;
+
+	int retour=0;
+	for(int n=0;n<nb;n++){
+		travail* t=&l.travaux[n];
+		if(t->ok) printf("%s : %d regions -> %s\n",t->entree,t->nb_regions,t->sortie);
+		else{
+			fprintf(stderr,"Segmentation de %s impossible.\n",t->entree);
+			retour=1;
+		}
+		free(t->sortie);
+		free(noms[n]);
+	}
+	printf("%d images en %.3f ms, %d threads, au plus %d images en memoire\n",nb,duree*1e3,nb_threads,l.max_en_cours);
+
+	free(segmenteurs);
+	file_liberer(&l.lues);
+	file_liberer(&l.segmentees);
+	pthread_mutex_destroy(&l.verrou);
+	pthread_cond_destroy(&l.place_libre);
+	free(l.travaux);
+	free(noms);
+	return retour;
+
+}
@@ -0,0 +1,36 @@
+#include "parallele.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+void parallele_executer(int nb_taches, void* (*f)(void*), void* taches, size_t taille_tache){
+	assert(nb_taches>0);
+	if(nb_taches==1){
+		f(taches);
+		return;
+	}
+	pthread_t* threads=malloc(sizeof(pthread_t)*nb_taches);
+	assert(NULL!=threads);
+	int nb_lances=0;
+	for(int i=0;i<nb_taches;i++){
+		void* arg=(char*) taches+i*taille_tache;
+		if(pthread_create(&threads[i],NULL,f,arg)==0){
+			nb_lances=i+1;
+		}
+		else{
+			// plus de threads disponibles : les tâches restantes sont faites ici
+			for(int j=i;j<nb_taches;j++) f((char*) taches+j*taille_tache);
+			break;
+		}
+	}
+	for(int i=0;i<nb_lances;i++){
+		pthread_join(threads[i],NULL);
+	}
+	free(threads);
+}
+
+int parallele_debut_tranche(int n, int nb_parts, int part){
+	assert(nb_parts>0);
+	return (int) (((long long) n*part)/nb_parts);
+}
@@ -0,0 +1,32 @@
+#ifndef PARALLELE_H
+#define PARALLELE_H
+
+#include <stddef.h>
+
+/*! \file parallele.h
+ * \brief Exécution de tâches indépendantes sur plusieurs threads (pthreads).
+ *
+ * Les tâches sont rangées dans un tableau de structures de même taille ;
+ * chaque thread reçoit un pointeur sur sa structure.
+ *
+ * \copyright PASD
+ * \version 2017
+ */
+
+/*!
+ * Lance nb_taches threads, le ième exécutant f sur la ième case de taches, et attend leur fin.
+ * Avec nb_taches == 1, f est appelée directement sans créer de thread.
+ * \param nb_taches nombre de tâches (et de threads)
+ * \param f fonction exécutée par chaque thread
+ * \param taches tableau des arguments
+ * \param taille_tache taille d'une case du tableau
+ */
+void parallele_executer(int nb_taches, void* (*f)(void*), void* taches, size_t taille_tache);
+
+/*!
+ * Découpe [0,n) en nb_parts intervalles consécutifs de tailles égales à 1 près.
+ * \return le début de la part-ième tranche (part == nb_parts donne n)
+ */
+int parallele_debut_tranche(int n, int nb_parts, int part);
+
+#endif
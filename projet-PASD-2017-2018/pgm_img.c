@@ -1,4 +1,5 @@
 #include "pgm_img.h"
+#include <assert.h>
 
 /*!
  * Structure contenant les informations de base de l'image
@@ -7,9 +8,57 @@ struct pgm_img {
     unsigned int largeur;
     unsigned int hauteur;
     unsigned int valeur_max;
+    /*! matrice des pixels, NULL tant qu'elle n'est pas construite (lecture par tampon) */
     unsigned int** image;
+    /*! vrai si toutes les lignes de image sont dans un seul bloc (image[0]) */
+    bool image_contigue;
+    /*! pixels bruts contigus, 1 ou 2 octets par pixel en ordre machine, NULL si absent */
+    void* pixels;
+    /*! vrai si la matrice a pu être modifiée depuis le dernier remplissage du tampon */
+    bool tampon_perime;
 };
 
+/*!
+ * Fonction statique allouant une matrice dont les lignes sont dans un seul bloc.
+ * \return la matrice (mise à zéro), NULL si l'allocation échoue
+ */
+static unsigned int** allouer_matrice(const unsigned int largeur, const unsigned int hauteur) {
+
+    unsigned int** image = malloc(sizeof(unsigned int*) * (hauteur > 0 ? hauteur : 1));
+    unsigned int* bloc = calloc((size_t) largeur * hauteur + 1, sizeof(unsigned int));
+    if(image == NULL || bloc == NULL) {
+        fprintf(stderr, "Allocation memoire impossible pour l'image");
+        free(image);
+        free(bloc);
+        return NULL;
+    }
+
+    for(unsigned int i = 0; i < hauteur; i++)
+        image[i] = bloc + (size_t) i * largeur;
+
+    if(hauteur == 0) image[0] = bloc;
+    return image;
+
+}
+
+/*!
+ * Fonction statique libérant la matrice de l'image (si elle existe).
+ */
+static void liberer_matrice(pgm p) {
+
+    if(p->image == NULL) return;
+
+    if(p->image_contigue)
+        free(p->image[0]);
+    else
+        for(unsigned int i = 0; i < p->hauteur; i++) 
+            free(p->image[i]);
+
+    free(p->image);
+    p->image = NULL;
+
+}
+
 /*!
  * Crée une image
  * \param _largeur la largeur de l'image
@@ -24,20 +73,11 @@ pgm initialiser_image_pgm(const unsigned int _largeur, const unsigned int _haute
     p->largeur = _largeur;
     p->hauteur = _hauteur;
     p->valeur_max = _valeur_max;
+    p->pixels = NULL;
 
-    p->image = malloc(sizeof(unsigned int*) * _hauteur);
-    if(p->image == NULL) {
-        fprintf(stderr, "Allocation memoire impossible pour l'image-hauteur");
-    }
-
-    for(unsigned int i = 0; i < _hauteur; i++) {
-        p->image[i] = malloc(sizeof(unsigned int) * _largeur);
-        if(p->image[i] == NULL) {
-            fprintf(stderr, "Allocation memoire impossible pour l'image-largeur %d", i);
-        }
-        for(unsigned int j = 0; j < _largeur; j++)
-            p->image[i][j] = 0;
-    }
+    p->image = allouer_matrice(_largeur, _hauteur);
+    p->image_contigue = true;
+    p->tampon_perime = true;
         
     return p;
 
@@ -45,7 +85,9 @@ pgm initialiser_image_pgm(const unsigned int _largeur, const unsigned int _haute
 
 pgm creer_image_pgm(const unsigned int _largeur, const unsigned int _hauteur, const unsigned int valeur_max, unsigned int** image) {
     pgm p = initialiser_image_pgm(_largeur, _hauteur, valeur_max);
+    liberer_matrice(p);
     p->image = image;
+    p->image_contigue = false;
      
     return p;
 }
@@ -69,7 +111,11 @@ static bool lire_entete_image_pgm(const FILE* fichier, unsigned int* largeur, un
 
     while(lireEntete) {
 
-        fgets(buf, MAX_LENGTH, (FILE *) fichier);
+        // fin de fichier avant la fin de l'entête (fichier qui n'est pas une image)
+        if(NULL == fgets(buf, MAX_LENGTH, (FILE *) fichier)) {
+            etat = ERROR;
+            break;
+        }
         switch(etat) {
 
             case INIT:
@@ -77,7 +123,7 @@ static bool lire_entete_image_pgm(const FILE* fichier, unsigned int* largeur, un
             break;
             case MAGIC_NUMBER_FOUND:
             while(strncmp(buf,"#",1) == 0) 
-                fgets(buf, MAX_LENGTH, (FILE *) fichier);
+                if(NULL == fgets(buf, MAX_LENGTH, (FILE *) fichier)) buf[0] = '\0';
             if(sscanf(buf,"%u %u", largeur, hauteur) == 2) etat = WIDTH_HEIGHT_FOUND; 
             else lireEntete = false;
             break;
@@ -107,32 +153,90 @@ static bool lire_entete_image_pgm(const FILE* fichier, unsigned int* largeur, un
 }
 
 /*! 
- * Fonction statique lisant une image en binaire
+ * Fonction statique lisant les données d'une image en binaire, en un seul appel à fread.
+ * Les valeurs sur 2 octets (grand-boutiste dans le fichier) sont remises en ordre machine.
  * \param fichier l'image 
- * \param valeur_max p l'image dans laquelle lire
+ * \param p l'image dont p->pixels est rempli
  * \return true si la lecture s'est bien déroulée, false sinon
  */
 static bool lire_donnees_image_pgm(const FILE* fichier, pgm p) {
 
-    const int BYTES_TO_READ = p->valeur_max < 256 ? 1 : 2;
+    const size_t BYTES_TO_READ = octets_par_pixel_image(p);
+    const size_t nb_pixels = (size_t) p->largeur * p->hauteur;
 
-    for(unsigned int i = 0; i < p->hauteur; i++) {
-        for(unsigned int j = 0; j < p->largeur; j++) {
-            if(fread(&p->image[i][j], BYTES_TO_READ, 1, (FILE*)fichier) == 0)
-                return false;
-        }
+    p->pixels = malloc(BYTES_TO_READ * nb_pixels + 1);
+    if(p->pixels == NULL) {
+        fprintf(stderr, "Allocation memoire impossible pour les pixels");
+        return false;
+    }
+
+    if(fread(p->pixels, BYTES_TO_READ, nb_pixels, (FILE*)fichier) != nb_pixels)
+        return false;
+
+    if(BYTES_TO_READ == 2) {
+        unsigned char* octets = p->pixels;
+        uint16_t* valeurs = p->pixels;
+        for(size_t k = 0; k < nb_pixels; k++)
+            valeurs[k] = (uint16_t) ((octets[2*k] << 8) | octets[2*k+1]);
     }
 
     return true;
 
 }
 
+/*! 
+ * Fonction statique remplissant la matrice à partir du tampon de pixels.
+ */
+static void tampon_vers_matrice(pgm p) {
+
+    const size_t nb_pixels = (size_t) p->largeur * p->hauteur;
+    unsigned int* bloc = p->image_contigue ? p->image[0] : NULL;
+
+    if(bloc != NULL && octets_par_pixel_image(p) == 1) {
+        const uint8_t* src = p->pixels;
+        for(size_t k = 0; k < nb_pixels; k++) bloc[k] = src[k];
+    } else if(bloc != NULL) {
+        const uint16_t* src = p->pixels;
+        for(size_t k = 0; k < nb_pixels; k++) bloc[k] = src[k];
+    } else {
+        for(unsigned int i = 0; i < p->hauteur; i++)
+            for(unsigned int j = 0; j < p->largeur; j++)
+                p->image[i][j] = octets_par_pixel_image(p) == 1
+                    ? ((const uint8_t*) p->pixels)[(size_t) i * p->largeur + j]
+                    : ((const uint16_t*) p->pixels)[(size_t) i * p->largeur + j];
+    }
+
+}
+
+/*! 
+ * Fonction statique (re)remplissant le tampon de pixels à partir de la matrice.
+ */
+static void matrice_vers_tampon(pgm p) {
+
+    if(p->pixels == NULL)
+        p->pixels = malloc(octets_par_pixel_image(p) * (size_t) p->largeur * p->hauteur + 1);
+    assert(p->pixels != NULL);
+
+    for(unsigned int i = 0; i < p->hauteur; i++) {
+        const unsigned int* ligne = p->image[i];
+        if(octets_par_pixel_image(p) == 1) {
+            uint8_t* dst = (uint8_t*) p->pixels + (size_t) i * p->largeur;
+            for(unsigned int j = 0; j < p->largeur; j++) dst[j] = (uint8_t) ligne[j];
+        } else {
+            uint16_t* dst = (uint16_t*) p->pixels + (size_t) i * p->largeur;
+            for(unsigned int j = 0; j < p->largeur; j++) dst[j] = (uint16_t) ligne[j];
+        }
+    }
+
+}
+
 /*!
- * Lit une image
+ * Fonction statique commune aux deux modes de lecture.
  * \param fichier l'image à lire
+ * \param avec_matrice construire la matrice (et libérer le tampon) ou garder seulement le tampon
  * \return l'image créée
  */
-pgm lire_image_pgm(const char* fichier) {
+static pgm lire_image_pgm_mode(const char* fichier, bool avec_matrice) {
 
     FILE* f = fopen(fichier, "rb");
         
@@ -148,7 +252,14 @@ pgm lire_image_pgm(const char* fichier) {
         return NULL;
     }
         
-    pgm p = initialiser_image_pgm(largeur, hauteur, valeur_max);
+    pgm p = malloc(sizeof(struct pgm_img));
+    p->largeur = largeur;
+    p->hauteur = hauteur;
+    p->valeur_max = valeur_max;
+    p->image = NULL;
+    p->image_contigue = true;
+    p->pixels = NULL;
+    p->tampon_perime = false;
 
     if(!lire_donnees_image_pgm(f, p)) {
         detruire_image_pgm(&p);
@@ -157,10 +268,36 @@ pgm lire_image_pgm(const char* fichier) {
     }
 
     fclose(f);
+
+    if(avec_matrice) {
+        image_matrice(p);
+        free(p->pixels);
+        p->pixels = NULL;
+        p->tampon_perime = true;
+    }
+
     return p;
  
 }
 
+/*!
+ * Lit une image
+ * \param fichier l'image à lire
+ * \return l'image créée
+ */
+pgm lire_image_pgm(const char* fichier) {
+    return lire_image_pgm_mode(fichier, true);
+}
+
+/*!
+ * Lit une image en ne gardant que le tampon de pixels
+ * \param fichier l'image à lire
+ * \return l'image créée
+ */
+pgm lire_image_pgm_tampon(const char* fichier) {
+    return lire_image_pgm_mode(fichier, false);
+}
+
 /*!
  * Ecrit une image
  * \param fichier le fichier où écrire l'image
@@ -185,19 +322,52 @@ bool ecrire_image_pgm(const char* fichier, const pgm p, void(*filtre)(pgm p)) {
     
     fprintf(img, "%u\n", p->valeur_max);
 
-    const int BYTES_TO_READ = p->valeur_max < 256 ? 1 : 2;
-
     if(filtre != NULL)
         filtre(p);
 
-    for(unsigned int i = 0; i < p->hauteur; i++) {
+    // chaque ligne est empaquetée dans un tampon puis écrite en un seul fwrite
+    // (grand-boutiste sur 2 octets si valeur max >= 256)
+    const size_t BYTES_TO_WRITE = octets_par_pixel_image(p);
+    const size_t taille_ligne = BYTES_TO_WRITE * p->largeur;
+    unsigned char* ligne = malloc(taille_ligne + 1);
+    if(ligne == NULL) {
+        fprintf(stderr, "Allocation memoire impossible pour l'ecriture");
+        fclose(img);
+        return false;
+    }
+
+    bool ok = true;
+    if(p->image == NULL && BYTES_TO_WRITE == 1) {
+        // lecture par tampon : les octets sont déjà dans l'ordre du fichier
+        const size_t taille = taille_ligne * p->hauteur;
+        ok = fwrite(p->pixels, 1, taille, img) == taille;
+    }
+    for(unsigned int i = 0; ok && p->image != NULL && i < p->hauteur; i++) {
+        const unsigned int* src = p->image[i];
+        if(BYTES_TO_WRITE == 1) {
+            for(unsigned int j = 0; j < p->largeur; j++)
+                ligne[j] = (unsigned char) src[j];
+        } else {
+            for(unsigned int j = 0; j < p->largeur; j++) {
+                ligne[2*j] = (unsigned char) (src[j] >> 8);
+                ligne[2*j+1] = (unsigned char) src[j];
+            }
+        }
+        ok = fwrite(ligne, 1, taille_ligne, img) == taille_ligne;
+    }
+    for(unsigned int i = 0; ok && p->image == NULL && BYTES_TO_WRITE == 2 && i < p->hauteur; i++) {
+        const uint16_t* src = (const uint16_t*) p->pixels + (size_t) i * p->largeur;
         for(unsigned int j = 0; j < p->largeur; j++) {
-            fwrite(&p->image[i][j], BYTES_TO_READ, 1, img);
+            ligne[2*j] = (unsigned char) (src[j] >> 8);
+            ligne[2*j+1] = (unsigned char) src[j];
         }
+        ok = fwrite(ligne, 1, taille_ligne, img) == taille_ligne;
     }
 
-    fclose(img);
-    return true;
+    free(ligne);
+    if(fclose(img) != 0) ok = false;
+    if(!ok) fprintf(stderr, "Ecriture de l'image impossible.");
+    return ok;
 
 }
 
@@ -205,9 +375,22 @@ bool ecrire_image_pgm(const char* fichier, const pgm p, void(*filtre)(pgm p)) {
  * Getteurs et accesseurs 
  */
 unsigned int** image_matrice(pgm p) {
+    if(p->image == NULL) {
+        p->image = allouer_matrice(p->largeur, p->hauteur);
+        p->image_contigue = true;
+        if(p->pixels != NULL)
+            tampon_vers_matrice(p);
+    }
+    // l'appelant peut écrire dans la matrice
+    p->tampon_perime = true;
     return p->image;
 }
 
+void image_matrice_modifiee(pgm p) {
+    if(p->image != NULL)
+        p->tampon_perime = true;
+}
+
 unsigned int largeur_image(pgm p) {
     return p->largeur;
 }
@@ -216,18 +399,124 @@ unsigned int hauteur_image(pgm p) {
     return p->hauteur;
 }
 
+unsigned int valeur_max_image(pgm p) {
+    return p->valeur_max;
+}
+
+unsigned int octets_par_pixel_image(pgm p) {
+    return p->valeur_max < 256 ? 1 : 2;
+}
+
+unsigned int pas_image(pgm p) {
+    return p->largeur;
+}
+
+/*!
+ * Fonction statique rendant le tampon à jour : la matrice fait foi si elle existe,
+ * elle n'est recopiée que si elle a pu être modifiée depuis la dernière copie.
+ */
+static void* pixels_image(pgm p) {
+    if(p->image != NULL && (p->tampon_perime || p->pixels == NULL)) {
+        matrice_vers_tampon(p);
+        p->tampon_perime = false;
+    }
+    return p->pixels;
+}
+
+const uint8_t* pixels8_image(pgm p) {
+    assert(octets_par_pixel_image(p) == 1);
+    return pixels_image(p);
+}
+
+const uint16_t* pixels16_image(pgm p) {
+    assert(octets_par_pixel_image(p) == 2);
+    return pixels_image(p);
+}
+
 /*!
  * Détruit une image
  * \param p un pointeur sur l'image à détruire
  */
 void detruire_image_pgm(pgm* p) {
     
-    for(unsigned int i = 0; i < (*p)->hauteur; i++) 
-        free((*p)->image[i]);
-                    
-    free((*p)->image);
+    liberer_matrice(*p);
+    free((*p)->pixels);
     free(*p);
     *p = NULL;
 
 }
 
+/*!
+ * Lecteur séquentiel : le fichier est positionné sur la prochaine ligne à lire.
+ */
+struct lecteur_pgm_struct {
+    FILE* f;
+    unsigned int largeur;
+    unsigned int hauteur;
+    unsigned int valeur_max;
+    unsigned int ligne_courante;
+    unsigned char* tampon;
+};
+
+lecteur_pgm lecteur_pgm_ouvrir(const char* fichier) {
+
+    FILE* f = fopen(fichier, "rb");
+    if(f == NULL) {
+        fprintf(stderr, "Impossible d'ouvrir le fichier PGM en lecture");
+        return NULL;
+    }
+
+    lecteur_pgm l = malloc(sizeof(struct lecteur_pgm_struct));
+    if(!lire_entete_image_pgm(f, &l->largeur, &l->hauteur, &l->valeur_max)) {
+        free(l);
+        fclose(f);
+        return NULL;
+    }
+    l->f = f;
+    l->ligne_courante = 0;
+    l->tampon = NULL;
+    return l;
+
+}
+
+unsigned int lecteur_pgm_largeur(lecteur_pgm l) {
+    return l->largeur;
+}
+
+unsigned int lecteur_pgm_hauteur(lecteur_pgm l) {
+    return l->hauteur;
+}
+
+unsigned int lecteur_pgm_valeur_max(lecteur_pgm l) {
+    return l->valeur_max;
+}
+
+unsigned int lecteur_pgm_lire_lignes(lecteur_pgm l, unsigned int* dst, unsigned int nb_lignes) {
+
+    const size_t BYTES_TO_READ = l->valeur_max < 256 ? 1 : 2;
+    if(nb_lignes > l->hauteur - l->ligne_courante)
+        nb_lignes = l->hauteur - l->ligne_courante;
+    if(nb_lignes == 0) return 0;
+
+    const size_t nb_pixels = (size_t) nb_lignes * l->largeur;
+    l->tampon = realloc(l->tampon, BYTES_TO_READ * nb_pixels);
+    if(l->tampon == NULL || fread(l->tampon, BYTES_TO_READ, nb_pixels, l->f) != nb_pixels)
+        return 0;
+
+    for(size_t k = 0; k < nb_pixels; k++)
+        dst[k] = BYTES_TO_READ == 1 ? l->tampon[k] : (unsigned int) ((l->tampon[2*k] << 8) | l->tampon[2*k+1]);
+
+    l->ligne_courante += nb_lignes;
+    return nb_lignes;
+
+}
+
+void lecteur_pgm_fermer(lecteur_pgm* l) {
+
+    if(*l == NULL) return;
+    fclose((*l)->f);
+    free((*l)->tampon);
+    free(*l);
+    *l = NULL;
+
+}
@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /*! \file
  * \brief Gestion simple d'images PNG (P5, binaires).
@@ -12,7 +13,9 @@
  * Les informations de base de l'image (largeur, hauteur, valeur max et valeur des pixels) 
  * sont stockées dans une structure simple.
  *
- * L'image est conservée sous forme de matrice d'unsigned int. 
+ * L'image est conservée sous forme de matrice d'unsigned int, dont les lignes sont
+ * allouées en un seul bloc, et/ou sous forme d'un tampon contigu de pixels
+ * sur 1 octet (valeur max < 256) ou 2 octets.
  * Programme basé sur la librairie PGMLib : https://github.com/joshimoo/PGMLib/blob/master/src/pgm/
  *
  * \copyright PASD
@@ -44,6 +47,15 @@ pgm creer_image_pgm(const unsigned int _largeur, const unsigned int _hauteur, co
  */
 pgm lire_image_pgm(const char* fichier);
 
+/*!
+ * Lit une image en un seul appel à fread sans construire la matrice :
+ * seul le tampon de pixels (pixels8_image/pixels16_image) est gardé.
+ * La matrice est construite au premier appel à image_matrice.
+ * \param fichier l'image à lire
+ * \return l'image créée
+ */
+pgm lire_image_pgm_tampon(const char* fichier);
+
 /*!
  * Ecrit une image
  * \param fichier le fichier où écrire l'image
@@ -59,6 +71,32 @@ bool ecrire_image_pgm(const char* fichier, const pgm p, void(*filtre)(pgm p));
 unsigned int** image_matrice(pgm p);
 unsigned int largeur_image(pgm p);
 unsigned int hauteur_image(pgm p);
+unsigned int valeur_max_image(pgm p);
+
+/*!
+ * Nombre d'octets par pixel dans le tampon : 1 si valeur max < 256, 2 sinon.
+ */
+unsigned int octets_par_pixel_image(pgm p);
+
+/*!
+ * Pas (en pixels) entre deux lignes du tampon : le pixel (i,j) est à l'indice i*pas+j.
+ */
+unsigned int pas_image(pgm p);
+
+/*!
+ * Signale que la matrice a été modifiée par un pointeur obtenu avant le dernier appel
+ * à pixels8_image/pixels16_image (image_matrice le signale déjà à chaque appel).
+ */
+void image_matrice_modifiee(pgm p);
+
+/*!
+ * Tampon contigu des pixels, pour une image sur 1 octet (resp. 2 octets, en ordre machine).
+ * Si la matrice existe, c'est elle qui fait foi : le tampon n'est recalculé à partir
+ * d'elle que si elle a pu être modifiée (appel à image_matrice ou image_matrice_modifiee)
+ * depuis le dernier calcul. Le tampon appartient à l'image.
+ */
+const uint8_t* pixels8_image(pgm p);
+const uint16_t* pixels16_image(pgm p);
 
 /*!
  * Détruit une image
@@ -66,4 +104,32 @@ unsigned int hauteur_image(pgm p);
  */
 void detruire_image_pgm(pgm* p);
 
+/*!
+ * Lecteur séquentiel d'une image PGM, ligne par ligne, sans charger l'image entière.
+ */
+typedef struct lecteur_pgm_struct* lecteur_pgm;
+
+/*!
+ * Ouvre une image et lit son entête.
+ * \param fichier l'image à lire
+ * \return le lecteur, NULL si l'ouverture ou l'entête a échoué
+ */
+lecteur_pgm lecteur_pgm_ouvrir(const char* fichier);
+
+unsigned int lecteur_pgm_largeur(lecteur_pgm l);
+unsigned int lecteur_pgm_hauteur(lecteur_pgm l);
+unsigned int lecteur_pgm_valeur_max(lecteur_pgm l);
+
+/*!
+ * Lit les nb_lignes lignes suivantes (au plus) dans dst, rangées l'une après l'autre.
+ * \param dst tableau d'au moins nb_lignes*largeur cases
+ * \return le nombre de lignes effectivement lues (0 en fin d'image ou en cas d'erreur)
+ */
+unsigned int lecteur_pgm_lire_lignes(lecteur_pgm l, unsigned int* dst, unsigned int nb_lignes);
+
+/*!
+ * Ferme le lecteur, le pointeur est mis à NULL.
+ */
+void lecteur_pgm_fermer(lecteur_pgm* l);
+
 #endif
@@ -1,69 +1,616 @@
 #include "segmentation.h"
+#include "parallele.h"
 #include <math.h>
+#include <assert.h>
+#include <limits.h>
 
 #define min(a,b) (a <= b ? a : b)
 
-arete* lire_matrice(unsigned int** matrice,int largeur, int hauteur, int* nb_arete){
+/* nombre d'arêtes produites par les lignes [0,i) dans l'ordre de lire_matrice */
+static int nb_aretes_avant_ligne(int largeur,int hauteur,int i){
+	int par_ligne=(largeur-1)+largeur+2*(largeur-1);
+	int nb=i*par_ligne;
+	if(i>=hauteur) nb-=largeur+2*(largeur-1);
+	return nb;
+}
 
-    arete* t_arete = (arete*) malloc(sizeof(struct arete)*(largeur*hauteur*4));
-    int indice = 0;
-    int cpt = 0;
+tableau_aretes lire_matrice(unsigned int** matrice,int largeur, int hauteur){
 
+    tableau_aretes t_arete = tableau_aretes_creer(nb_aretes_avant_ligne(largeur,hauteur,hauteur));
     for(int i=0; i < hauteur; i++){
         
         for(int j=0; j < largeur; j++){
+            const int v = i*largeur+j;
 
             if(j+1 < largeur){ //arete de droite
-                t_arete[cpt] = creer_arete(matrice[i][j],matrice[i][j+1],abs(matrice[i][j]-matrice[i][j+1]));
-                cpt++;
+                tableau_aretes_ajouter(t_arete,v,v+1,abs((int)matrice[i][j]-(int)matrice[i][j+1]));
             }
 
             if((i+1) < hauteur){ //arete vers le bas
-                t_arete[cpt] = creer_arete(matrice[i][j],matrice[i+1][j],abs(matrice[i][j]-matrice[i+1][j]));
-                cpt++;
+                tableau_aretes_ajouter(t_arete,v,v+largeur,abs((int)matrice[i][j]-(int)matrice[i+1][j]));
             }
 
             if((i+1) < hauteur && j-1>=0 ){ //arete diagonal en bas à gauche
-                t_arete[cpt] = creer_arete(matrice[i][j],matrice[i+1][j-1],abs(matrice[i][j]-matrice[i+1][j-1]));
-                cpt++; 
+                tableau_aretes_ajouter(t_arete,v,v+largeur-1,abs((int)matrice[i][j]-(int)matrice[i+1][j-1]));
             }
 
             if((i+1) < hauteur && (j+1) < largeur){ //arete diagonal en bas à droite
-                t_arete[cpt] = creer_arete(matrice[i][j],matrice[i+1][j+1],abs(matrice[i][j]-matrice[i+1][j+1]));
-                cpt++;
+                tableau_aretes_ajouter(t_arete,v,v+largeur+1,abs((int)matrice[i][j]-(int)matrice[i+1][j+1]));
             }
-	    indice++;
 
         }
  
     }
-    *nb_arete = cpt;
     return t_arete;
 }
 
 
-liste segmentation(unsigned int **tab1,arete * tab,int largeur,int hauteur,int nb_aretes,int k){
-	trier_arete(tab,0,nb_aretes-1);
-	liste l=liste_creer(&copier_ensemble,&afficher_ensemble,&detruire_ensemble,&comparer_ensemble);
+/* lignes [debut,fin) de l'image dont un thread produit les arêtes à partir de l'indice premiere */
+typedef struct tache_aretes_struct{
+	unsigned int** matrice;
+	int largeur,hauteur;
+	int debut,fin;
+	struct arete* aretes;
+	int premiere;
+	int poids_min,poids_max,sommet_max;
+} tache_aretes;
+
+static void* tache_lire_matrice(void* arg){
+	tache_aretes* ta=arg;
+	unsigned int** m=ta->matrice;
+	struct arete* a=ta->aretes+ta->premiere;
+	int cpt=0;
+	ta->poids_min=0;
+	ta->poids_max=0;
+	ta->sommet_max=0;
+	for(int i=ta->debut;i<ta->fin;i++){
+		for(int j=0;j<ta->largeur;j++){
+			int voisins[4][2]={{i,j+1},{i+1,j},{i+1,j-1},{i+1,j+1}};
+			for(int v=0;v<4;v++){
+				int vi=voisins[v][0],vj=voisins[v][1];
+				if(vi>=ta->hauteur || vj<0 || vj>=ta->largeur) continue;
+				struct arete* e=&a[cpt];
+				e->s1=i*ta->largeur+j;
+				e->s2=vi*ta->largeur+vj;
+				e->poids=abs((int)m[i][j]-(int)m[vi][vj]);
+				if(0==cpt || e->poids<ta->poids_min) ta->poids_min=e->poids;
+				if(e->poids>ta->poids_max) ta->poids_max=e->poids;
+				if(e->s1>ta->sommet_max) ta->sommet_max=e->s1;
+				if(e->s2>ta->sommet_max) ta->sommet_max=e->s2;
+				cpt++;
+			}
+		}
+	}
+	return NULL;
+}
+
+tableau_aretes lire_matrice_parallele(unsigned int** matrice,int largeur,int hauteur,int nb_threads){
+	if(nb_threads<1) nb_threads=1;
+	if(nb_threads>hauteur) nb_threads=hauteur>0 ? hauteur : 1;
+	const int nb=nb_aretes_avant_ligne(largeur,hauteur,hauteur);
+	tableau_aretes t=tableau_aretes_creer(nb);
+	tache_aretes* taches=malloc(sizeof(tache_aretes)*nb_threads);
+	assert(NULL!=taches);
+	for(int p=0;p<nb_threads;p++){
+		taches[p].matrice=matrice;
+		taches[p].largeur=largeur;
+		taches[p].hauteur=hauteur;
+		taches[p].debut=parallele_debut_tranche(hauteur,nb_threads,p);
+		taches[p].fin=parallele_debut_tranche(hauteur,nb_threads,p+1);
+		taches[p].aretes=t->aretes;
+		taches[p].premiere=nb_aretes_avant_ligne(largeur,hauteur,taches[p].debut);
+	}
+	parallele_executer(nb_threads,&tache_lire_matrice,taches,sizeof(tache_aretes));
+	t->nb_aretes=nb;
+	t->trie=nb<2;
+	for(int p=0;p<nb_threads;p++){
+		if(taches[p].fin==taches[p].debut || nb_aretes_avant_ligne(largeur,hauteur,taches[p].fin)==taches[p].premiere) continue;
+		if(0==p || taches[p].poids_min<t->poids_min) t->poids_min=taches[p].poids_min;
+		if(taches[p].poids_max>t->poids_max) t->poids_max=taches[p].poids_max;
+		if(taches[p].sommet_max>t->sommet_max) t->sommet_max=taches[p].sommet_max;
+	}
+	free(taches);
+	return t;
+}
+
+
+/* directions des arêtes depuis leur premier sommet, dans l'ordre croissant du second */
+enum { DIRECTION_DROITE, DIRECTION_BAS_GAUCHE, DIRECTION_BAS, DIRECTION_BAS_DROITE };
+
+/* niveau du pixel (i,j), lu dans la matrice ou dans le tampon de l'image */
+static inline unsigned int aretes_pixel(aretes_par_poids a,int i,int j){
+	if(NULL!=a->matrice) return a->matrice[i][j];
+	const size_t k=(size_t)i*a->pas+j;
+	return NULL!=a->pixels8 ? a->pixels8[k] : a->pixels16[k];
+}
+
+/* poids de l'arête (v,direction) si elle existe, -1 sinon */
+static int poids_direction(aretes_par_poids a,int i,int j,int direction){
+	const int largeur=a->largeur,hauteur=a->hauteur;
+	int vi=i+1,vj=j;
+	switch(direction){
+	case DIRECTION_DROITE: vi=i; vj=j+1; break;
+	case DIRECTION_BAS_GAUCHE: vj=j-1; break;
+	case DIRECTION_BAS_DROITE: vj=j+1; break;
+	}
+	if(vi>=hauteur || vj<0 || vj>=largeur) return -1;
+	return abs((int)aretes_pixel(a,i,j)-(int)aretes_pixel(a,vi,vj));
+}
+
+/* structure sans source de pixels, à compléter avant aretes_par_poids_remplir */
+static aretes_par_poids aretes_par_poids_allouer(int largeur,int hauteur){
+	assert(largeur>0 && hauteur>0 && (long)largeur*hauteur<=INT_MAX/4);
+	aretes_par_poids a=malloc(sizeof(struct aretes_par_poids_struct));
+	assert(NULL!=a);
+	a->matrice=NULL;
+	a->pixels8=NULL;
+	a->pixels16=NULL;
+	a->pas=largeur;
+	a->largeur=largeur;
+	a->hauteur=hauteur;
+	a->nb_aretes=nb_aretes_avant_ligne(largeur,hauteur,hauteur);
+	return a;
+}
+
+/* les deux passages sur l'image */
+static aretes_par_poids aretes_par_poids_remplir(aretes_par_poids a){
+	const int largeur=a->largeur,hauteur=a->hauteur;
+	// les poids sont bornés par l'écart entre le plus grand et le plus petit niveau de gris
+	unsigned int p_min=aretes_pixel(a,0,0),p_max=p_min;
+	for(int i=0;i<hauteur;i++){
+		for(int j=0;j<largeur;j++){
+			const unsigned int v=aretes_pixel(a,i,j);
+			if(v<p_min) p_min=v;
+			if(v>p_max) p_max=v;
+		}
+	}
+	a->poids_max=(int)(p_max-p_min);
+	a->debut=calloc(a->poids_max+2,sizeof(int));
+	a->codes=malloc(sizeof(int)*(a->nb_aretes>0 ? a->nb_aretes : 1));
+	assert(NULL!=a->debut && NULL!=a->codes);
+	// premier passage : taille des paquets, décalée d'une case pour les sommes préfixes
 	for(int i=0;i<hauteur;i++){
 		for(int j=0;j<largeur;j++){
-			ensemble e=creer_ensemble(tab1[i][j]);
-			liste_insertion_fin(l,e);
-			ensemble_detruire(&e);
+			for(int d=DIRECTION_DROITE;d<=DIRECTION_BAS_DROITE;d++){
+				int p=poids_direction(a,i,j,d);
+				if(p>=0) a->debut[p+1]++;
+			}
 		}
 	}
-	for(int i=0;i<nb_aretes;i++){
-		ensemble e1=trouver_ensemble(l,(tab[i])->s1);
-		ensemble e2=trouver_ensemble(l,(tab[i])->s2);
-		if(e1->pere!=e2->pere && (tab[i])->poids<=min(e1->poidsMax+(k/(e1->rang+1)),e2->poidsMax+(k/(e2->rang+1)))){
-            e1->poidsMax=tab[i]->poids;
-            e2->poidsMax=tab[i]->poids;
-            union_ensemble(l,e1,e2);
+	for(int p=0;p<=a->poids_max;p++) a->debut[p+1]+=a->debut[p];
+	// second passage : sommets puis directions croissants, chaque paquet est donc trié par (s1,s2)
+	int* place=malloc(sizeof(int)*(a->poids_max+1));
+	assert(NULL!=place);
+	memcpy(place,a->debut,sizeof(int)*(a->poids_max+1));
+	for(int i=0;i<hauteur;i++){
+		for(int j=0;j<largeur;j++){
+			for(int d=DIRECTION_DROITE;d<=DIRECTION_BAS_DROITE;d++){
+				int p=poids_direction(a,i,j,d);
+				if(p>=0) a->codes[place[p]++]=(i*largeur+j)*4+d;
+			}
 		}
 	}
+	free(place);
+	a->poids=0;
+	a->suivante=0;
+	return a;
+}
+
+aretes_par_poids aretes_par_poids_creer(unsigned int** matrice,int largeur,int hauteur){
+	aretes_par_poids a=aretes_par_poids_allouer(largeur,hauteur);
+	a->matrice=matrice;
+	return aretes_par_poids_remplir(a);
+}
+
+aretes_par_poids aretes_par_poids_creer_image(pgm img){
+	aretes_par_poids a=aretes_par_poids_allouer(largeur_image(img),hauteur_image(img));
+	if(1==octets_par_pixel_image(img)) a->pixels8=pixels8_image(img);
+	else a->pixels16=pixels16_image(img);
+	a->pas=pas_image(img);
+	return aretes_par_poids_remplir(a);
+}
+
+int aretes_par_poids_paquet(aretes_par_poids a,int poids,int* debut){
+	if(poids<0 || poids>a->poids_max){
+		if(NULL!=debut) *debut=a->nb_aretes;
+		return 0;
+	}
+	if(NULL!=debut) *debut=a->debut[poids];
+	return a->debut[poids+1]-a->debut[poids];
+}
+
+void aretes_par_poids_decoder(aretes_par_poids a,int indice,struct arete* e){
+	assert(indice>=0 && indice<a->nb_aretes);
+	const int code=a->codes[indice];
+	const int v=code/4;
+	const int d=code%4;
+	const int i=v/a->largeur,j=v%a->largeur;
+	const int decalage[4]={1,a->largeur-1,a->largeur,a->largeur+1};
+	e->s1=v;
+	e->s2=v+decalage[d];
+	e->poids=poids_direction(a,i,j,d);
+}
+
+void aretes_par_poids_recommencer(aretes_par_poids a){
+	a->poids=0;
+	a->suivante=0;
+}
+
+bool aretes_par_poids_suivante(aretes_par_poids a,struct arete* e){
+	if(a->suivante>=a->nb_aretes) return false;
+	while(a->debut[a->poids+1]<=a->suivante) a->poids++;
+	aretes_par_poids_decoder(a,a->suivante,e);
+	assert(e->poids==a->poids);
+	a->suivante++;
+	return true;
+}
+
+void aretes_par_poids_detruire(aretes_par_poids* a){
+	assert(NULL!=a && NULL!=*a);
+	free((*a)->debut);
+	free((*a)->codes);
+	free(*a);
+	*a=NULL;
+}
+
+
+/* seuil de fusion de Felzenszwalb : w <= min(Int(C1)+k/|C1|, Int(C2)+k/|C2|) */
+static bool critere_fusion(int poids,int diff1,int taille1,int diff2,int taille2,int k){
+	return poids<=min(diff1+k/taille1,diff2+k/taille2);
+}
+
+/* composantes d'une segmentation en cours : Int(C) et |C| indexés par racine dans uf */
+typedef struct composantes_struct{
+	union_find uf;
+	int* diff_interne;
+	int* taille;
+} composantes;
+
+static composantes composantes_creer(int nb_sommets){
+	composantes c={union_find_creer(nb_sommets),malloc(sizeof(int)*nb_sommets),malloc(sizeof(int)*nb_sommets)};
+	assert(NULL!=c.diff_interne && NULL!=c.taille);
+	for(int v=0;v<nb_sommets;v++){
+		c.diff_interne[v]=0;
+		c.taille[v]=1;
+	}
+	return c;
+}
+
+/* traite l'arête (s1,s2,poids), les arêtes étant parcourues par poids croissant */
+static void composantes_fusionner(composantes* c,int s1,int s2,int poids,int k){
+	int r1=union_find_trouver(c->uf,s1);
+	int r2=union_find_trouver(c->uf,s2);
+	if(r1!=r2 && critere_fusion(poids,c->diff_interne[r1],c->taille[r1],c->diff_interne[r2],c->taille[r2],k)){
+		int tl=c->taille[r1]+c->taille[r2];
+		int r=union_find_union(c->uf,r1,r2);
+		// arêtes triées : l'arête est la plus lourde de l'arbre couvrant de la nouvelle composante
+		c->diff_interne[r]=poids;
+		c->taille[r]=tl;
+	}
+}
+
+/* remet chaque sommet seul dans sa composante */
+static void composantes_reinitialiser(composantes* c,int nb_sommets){
+	union_find_reinitialiser(c->uf);
+	for(int v=0;v<nb_sommets;v++){
+		c->diff_interne[v]=0;
+		c->taille[v]=1;
+	}
+}
+
+static void composantes_detruire(composantes* c){
+	free(c->diff_interne);
+	free(c->taille);
+	union_find_detruire(&c->uf);
+}
+
+/* numéros de régions consécutifs, dans l'ordre du premier sommet de chaque région ;
+ * c ne sert plus qu'à être réinitialisée ou détruite */
+static int* composantes_numeroter(composantes* c,int nb_sommets,int* nb_regions){
+	int* etiquettes=malloc(sizeof(int)*nb_sommets);
+	assert(NULL!=etiquettes);
+	int nb_r=0;
+	for(int v=0;v<nb_sommets;v++) c->diff_interne[v]=-1;
+	for(int v=0;v<nb_sommets;v++){
+		int r=union_find_trouver(c->uf,v);
+		if(c->diff_interne[r]<0) c->diff_interne[r]=nb_r++;
+		etiquettes[v]=c->diff_interne[r];
+	}
+	if(NULL!=nb_regions) *nb_regions=nb_r;
+	return etiquettes;
+}
+
+/* numérotation puis destruction de c */
+static int* composantes_etiquettes(composantes* c,int nb_sommets,int* nb_regions){
+	int* etiquettes=composantes_numeroter(c,nb_sommets,nb_regions);
+	composantes_detruire(c);
+	return etiquettes;
+}
+
+int* segmentation_etiquettes(tableau_aretes t,int nb_sommets,int k,int* nb_regions){
+	assert(t->nb_aretes==0 || t->sommet_max<nb_sommets);
+	trier_aretes(t);
+	composantes c=composantes_creer(nb_sommets);
+	for(int i=0;i<t->nb_aretes;i++){
+		const struct arete a=t->aretes[i];
+		composantes_fusionner(&c,a.s1,a.s2,a.poids,k);
+	}
+	return composantes_etiquettes(&c,nb_sommets,nb_regions);
+}
+
+int* segmentation_etiquettes_par_poids(aretes_par_poids a,int k,int* nb_regions){
+	const int nb_sommets=a->largeur*a->hauteur;
+	composantes c=composantes_creer(nb_sommets);
+	struct arete e;
+	aretes_par_poids_recommencer(a);
+	while(aretes_par_poids_suivante(a,&e)){
+		composantes_fusionner(&c,e.s1,e.s2,e.poids,k);
+	}
+	return composantes_etiquettes(&c,nb_sommets,nb_regions);
+}
+
+/* valeurs de k [debut,fin) de segmentation_multi_echelle traitées par un thread */
+typedef struct tache_echelles_struct{
+	tableau_aretes t;
+	int nb_sommets;
+	const int* k;
+	int debut,fin;
+	int** etiquettes;
+	int* nb_regions;
+} tache_echelles;
+
+static void* tache_segmentation_echelles(void* arg){
+	tache_echelles* te=arg;
+	if(te->debut==te->fin) return NULL;
+	const struct arete* aretes=te->t->aretes;
+	const int nb_aretes=te->t->nb_aretes;
+	composantes c=composantes_creer(te->nb_sommets);
+	for(int n=te->debut;n<te->fin;n++){
+		if(n>te->debut) composantes_reinitialiser(&c,te->nb_sommets);
+		for(int i=0;i<nb_aretes;i++){
+			composantes_fusionner(&c,aretes[i].s1,aretes[i].s2,aretes[i].poids,te->k[n]);
+		}
+		te->etiquettes[n]=composantes_numeroter(&c,te->nb_sommets,NULL==te->nb_regions ? NULL : &te->nb_regions[n]);
+	}
+	composantes_detruire(&c);
+	return NULL;
+}
+
+int** segmentation_multi_echelle(tableau_aretes t,int nb_sommets,const int* k,int nb_k,int* nb_regions,int nb_threads){
+	assert(nb_k>=0 && (nb_k==0 || NULL!=k));
+	assert(t->nb_aretes==0 || t->sommet_max<nb_sommets);
+	trier_aretes(t);
+	int** etiquettes=malloc(sizeof(int*)*(nb_k>0 ? nb_k : 1));
+	assert(NULL!=etiquettes);
+	if(nb_threads<1) nb_threads=1;
+	if(nb_threads>nb_k) nb_threads=nb_k>0 ? nb_k : 1;
+	tache_echelles* taches=malloc(sizeof(tache_echelles)*nb_threads);
+	assert(NULL!=taches);
+	for(int p=0;p<nb_threads;p++){
+		taches[p].t=t;
+		taches[p].nb_sommets=nb_sommets;
+		taches[p].k=k;
+		taches[p].debut=parallele_debut_tranche(nb_k,nb_threads,p);
+		taches[p].fin=parallele_debut_tranche(nb_k,nb_threads,p+1);
+		taches[p].etiquettes=etiquettes;
+		taches[p].nb_regions=nb_regions;
+	}
+	parallele_executer(nb_threads,&tache_segmentation_echelles,taches,sizeof(tache_echelles));
+	free(taches);
+	return etiquettes;
+}
+
+liste segmentation(unsigned int **tab1,tableau_aretes t,int largeur,int hauteur,int k){
+	(void)tab1;
+	const int nb_sommets=largeur*hauteur;
+	int nb_r;
+	int* etiquettes=segmentation_etiquettes(t,nb_sommets,k,&nb_r);
+	liste l=liste_creer(&copier_ensemble,&afficher_ensemble,&detruire_ensemble,&comparer_ensemble);
+	ensemble* regions=malloc(sizeof(ensemble)*(nb_r+1));
+	assert(NULL!=regions);
+	// les pixels de toutes les régions partagent un pool de maillons
+	pool_maillons p=pool_maillons_creer(sizeof(int));
+	int nb_crees=0;
+	for(int v=0;v<nb_sommets;v++){
+		int n=etiquettes[v];
+		if(n==nb_crees){
+			regions[n]=creer_ensemble_pool(v,p);
+			liste_insertion_fin_prendre(l,regions[n]);
+			nb_crees++;
+		}
+		else liste_insertion_fin(regions[n]->elements,&v);
+	}
+	pool_maillons_liberer(&p);
+	free(regions);
+	free(etiquettes);
 	return l;
 }
 
+regions regions_creer(int* etiquettes,int nb_pixels,int nb_regions){
+	assert(NULL!=etiquettes && nb_pixels>=0 && nb_regions>=0);
+	regions r=malloc(sizeof(struct regions_struct));
+	assert(NULL!=r);
+	r->nb_pixels=nb_pixels;
+	r->nb_regions=nb_regions;
+	r->etiquettes=etiquettes;
+	r->debut=calloc(nb_regions+1,sizeof(int));
+	r->pixels=malloc(sizeof(int)*(nb_pixels>0 ? nb_pixels : 1));
+	assert(NULL!=r->debut && NULL!=r->pixels);
+	// tri par comptage des pixels selon leur étiquette, stable : pixels croissants dans chaque région
+	for(int v=0;v<nb_pixels;v++){
+		assert(etiquettes[v]>=0 && etiquettes[v]<nb_regions);
+		r->debut[etiquettes[v]+1]++;
+	}
+	for(int n=0;n<nb_regions;n++) r->debut[n+1]+=r->debut[n];
+	int* place=malloc(sizeof(int)*(nb_regions>0 ? nb_regions : 1));
+	assert(NULL!=place);
+	memcpy(place,r->debut,sizeof(int)*nb_regions);
+	for(int v=0;v<nb_pixels;v++) r->pixels[place[etiquettes[v]]++]=v;
+	free(place);
+	return r;
+}
+
+regions segmentation_regions(tableau_aretes t,int nb_sommets,int k){
+	int nb_r;
+	int* etiquettes=segmentation_etiquettes(t,nb_sommets,k,&nb_r);
+	return regions_creer(etiquettes,nb_sommets,nb_r);
+}
+
+int regions_etiquette(regions r,int pixel){
+	assert(pixel>=0 && pixel<r->nb_pixels);
+	return r->etiquettes[pixel];
+}
+
+int regions_taille(regions r,int region){
+	assert(region>=0 && region<r->nb_regions);
+	return r->debut[region+1]-r->debut[region];
+}
+
+const int* regions_pixels(regions r,int region){
+	assert(region>=0 && region<r->nb_regions);
+	return r->pixels+r->debut[region];
+}
+
+void regions_afficher(FILE* f,regions r){
+	fprintf(f,"[");
+	for(int n=0;n<r->nb_regions;n++){
+		fprintf(f,"[");
+		for(int p=r->debut[n];p<r->debut[n+1];p++) fprintf(f,"%d",r->pixels[p]);
+		fprintf(f,"]\n");
+	}
+	fprintf(f,"]\n");
+}
+
+void regions_detruire(regions* r){
+	assert(NULL!=r && NULL!=*r);
+	free((*r)->etiquettes);
+	free((*r)->debut);
+	free((*r)->pixels);
+	free(*r);
+	*r=NULL;
+}
+
+/* arêtes internes aux nb_lignes lignes de pixels, dans l'ordre de lire_matrice */
+static tableau_aretes aretes_bande(const unsigned int* pixels,int largeur,int nb_lignes){
+	tableau_aretes t=tableau_aretes_creer(nb_aretes_avant_ligne(largeur,nb_lignes,nb_lignes));
+	for(int i=0;i<nb_lignes;i++){
+		for(int j=0;j<largeur;j++){
+			int v=i*largeur+j;
+			int p=pixels[v];
+			if(j+1<largeur) tableau_aretes_ajouter(t,v,v+1,abs(p-(int)pixels[v+1]));
+			if(i+1<nb_lignes){
+				tableau_aretes_ajouter(t,v,v+largeur,abs(p-(int)pixels[v+largeur]));
+				if(j-1>=0) tableau_aretes_ajouter(t,v,v+largeur-1,abs(p-(int)pixels[v+largeur-1]));
+				if(j+1<largeur) tableau_aretes_ajouter(t,v,v+largeur+1,abs(p-(int)pixels[v+largeur+1]));
+			}
+		}
+	}
+	return t;
+}
+
+bool segmentation_par_bandes(const char* fichier_image,const char* fichier_etiquettes,int hauteur_bande,int k,int* nb_regions){
+	if(hauteur_bande<HAUTEUR_BANDE_MIN) return false;
+	lecteur_pgm lp=lecteur_pgm_ouvrir(fichier_image);
+	if(NULL==lp) return false;
+	FILE* provisoire=tmpfile();
+	FILE* sortie=fopen(fichier_etiquettes,"wb");
+	if(NULL==provisoire || NULL==sortie){
+		fprintf(stderr,"Ouverture des fichiers d'etiquettes impossible.");
+		if(NULL!=provisoire) fclose(provisoire);
+		if(NULL!=sortie) fclose(sortie);
+		lecteur_pgm_fermer(&lp);
+		return false;
+	}
+	const int largeur=lecteur_pgm_largeur(lp);
+	const int hauteur=lecteur_pgm_hauteur(lp);
+	const int nb_max=(LIGNES_RECOUVREMENT+hauteur_bande)*largeur;
+
+	// une fenêtre : les lignes de recouvrement gardées de la fenêtre précédente, puis la bande lue
+	unsigned int* pixels=malloc(sizeof(unsigned int)*nb_max);
+	int* etiq=malloc(sizeof(int)*nb_max);
+	int* globale=malloc(sizeof(int)*nb_max);
+	// étiquettes écrites de la dernière ligne validée par la fenêtre précédente
+	int* precedente=malloc(sizeof(int)*(largeur>0 ? largeur : 1));
+	assert(NULL!=pixels && NULL!=etiq && NULL!=globale && NULL!=precedente);
+
+	// étiquettes provisoires : une par composante de fenêtre, réunies à chaque raccord
+	union_find uf=union_find_creer(0);
+	int gardees=0;
+	int lues=0;
+	bool ok=true;
+	unsigned int nb;
+
+	while(ok && (nb=lecteur_pgm_lire_lignes(lp,pixels+gardees*largeur,hauteur_bande))>0){
+		lues+=nb;
+		const int nb_lignes=gardees+nb;
+		const int n=nb_lignes*largeur;
+		// toute la fenêtre, recouvrement compris, comme segmentation_etiquettes
+		tableau_aretes t=aretes_bande(pixels,largeur,nb_lignes);
+		trier_aretes(t);
+		composantes c=composantes_creer(n);
+		for(int i=0;i<t->nb_aretes;i++) composantes_fusionner(&c,t->aretes[i].s1,t->aretes[i].s2,t->aretes[i].poids,k);
+		tableau_aretes_detruire(&t);
+
+		// lignes validées [debut,fin) : la moitié basse du recouvrement du haut (la moitié haute
+		// l'a été par la fenêtre précédente) jusqu'à la moitié haute de celui du bas
+		const bool derniere=lues>=hauteur;
+		const int a_garder=derniere ? 0 : min(LIGNES_RECOUVREMENT,nb_lignes);
+		const int debut=gardees-gardees/2;
+		const int fin=nb_lignes-a_garder/2;
+		// la ligne debut-1 est aussi dans la fenêtre précédente : elle sert de raccord
+		const int raccord=gardees>0 ? debut-1 : debut;
+		for(int v=raccord*largeur;v<n;v++) globale[v]=-1;
+		for(int v=raccord*largeur;v<fin*largeur;v++){
+			int r=union_find_trouver(c.uf,v);
+			if(globale[r]<0) globale[r]=union_find_ajouter(uf);
+			etiq[v]=globale[r];
+		}
+		composantes_detruire(&c);
+		if(gardees>0){
+			for(int j=0;j<largeur;j++){
+				int g1=union_find_trouver(uf,precedente[j]);
+				int g2=union_find_trouver(uf,etiq[raccord*largeur+j]);
+				if(g1!=g2) union_find_union(uf,g1,g2);
+			}
+		}
+
+		ok=fwrite(etiq+debut*largeur,sizeof(int),(fin-debut)*largeur,provisoire)==(size_t)((fin-debut)*largeur);
+		memcpy(precedente,etiq+(fin-1)*largeur,sizeof(int)*largeur);
+		memmove(pixels,pixels+(nb_lignes-a_garder)*largeur,sizeof(unsigned int)*a_garder*largeur);
+		gardees=a_garder;
+		if(derniere) break;
+	}
+	ok=ok && lues==hauteur;
+
+	// deuxième passe : étiquettes provisoires -> numéros de régions consécutifs
+	int* numero=malloc(sizeof(int)*(uf->nb_elements+1));
+	assert(NULL!=numero);
+	for(int g=0;g<uf->nb_elements;g++) numero[g]=-1;
+	int nb_r=0;
+	rewind(provisoire);
+	for(int i=0;ok && i<hauteur;i++){
+		ok=fread(etiq,sizeof(int),largeur,provisoire)==(size_t)largeur;
+		for(int j=0;ok && j<largeur;j++){
+			int g=union_find_trouver(uf,etiq[j]);
+			if(numero[g]<0) numero[g]=nb_r++;
+			etiq[j]=numero[g];
+		}
+		ok=ok && fwrite(etiq,sizeof(int),largeur,sortie)==(size_t)largeur;
+	}
+	if(NULL!=nb_regions) *nb_regions=nb_r;
+
+	free(numero);
+	free(pixels);
+	free(etiq);
+	free(globale);
+	free(precedente);
+	union_find_detruire(&uf);
+	fclose(provisoire);
+	if(fclose(sortie)!=0) ok=false;
+	lecteur_pgm_fermer(&lp);
+	return ok;
+}
+
 /*
 
 arete* lire_matrice(unsigned int** matrice, unsigned int largeur, unsigned int hauteur, int* nb_arete){
@@ -78,23 +625,23 @@ arete* lire_matrice(unsigned int** matrice, unsigned int largeur, unsigned int h
             
             if(j+1 < largeur && matrice[i][j+1] ){ //arete de droite
 
-                t_arete[cpt] = creer_arete(indice,indice+1,abs(matrice[i][j]-matrice[i][j+1]));
+                t_arete[cpt] = creer_arete(indice,indice+1,abs((int)matrice[i][j]-(int)matrice[i][j+1]));
                 cpt++;
                
             }
 
             if((i+1) < hauteur && matrice[i+1][j]){ //arete vers le bas
-                t_arete[cpt] = creer_arete(indice,indice+largeur,abs(matrice[i][j]-matrice[i+1][j]));
+                t_arete[cpt] = creer_arete(indice,indice+largeur,abs((int)matrice[i][j]-(int)matrice[i+1][j]));
                 cpt++;
             }
 
             if((i+1) < hauteur && j<0 && matrice[i+1][j-1] ){ //arete diagonal en bas à gauche
-                t_arete[cpt] = creer_arete(indice,indice+largeur-1,abs(matrice[i][j]-matrice[i+1][j-1]));
+                t_arete[cpt] = creer_arete(indice,indice+largeur-1,abs((int)matrice[i][j]-(int)matrice[i+1][j-1]));
                 cpt++;
             }
 
             if((i+1) < hauteur && (j+1) < largeur && matrice[i+1][j+1]){ //arete diagonal en bas à droite
-                t_arete[cpt] = creer_arete(indice,indice+largeur+1,abs(matrice[i][j]-matrice[i+1][j+1]));
+                t_arete[cpt] = creer_arete(indice,indice+largeur+1,abs((int)matrice[i][j]-(int)matrice[i+1][j+1]));
                 cpt++;
             } 
             indice++;
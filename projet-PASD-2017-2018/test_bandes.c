@@ -0,0 +1,77 @@
+#include "segmentation.h"
+#include <assert.h>
+
+/* usage : ./bandes k image.pgm [image.pgm ...]
+ * compare segmentation_par_bandes à la segmentation de l'image entière :
+ * étiquettes identiques avec une seule bande, nombre de régions à moins de ECART_MAX %
+ * avec des bandes de HAUTEUR_BANDE lignes, échec pour des bandes de moins de HAUTEUR_BANDE_MIN lignes */
+
+#define HAUTEUR_BANDE 64
+
+#define ECART_MAX 3
+
+#define FICHIER_ETIQUETTES "test_bandes_etiquettes.bin"
+
+/* étiquettes écrites par segmentation_par_bandes, NULL en cas d'échec */
+static int* par_bandes(const char* fichier,int nb_pixels,int hauteur_bande,int k,int* nb_regions){
+	if(!segmentation_par_bandes(fichier,FICHIER_ETIQUETTES,hauteur_bande,k,nb_regions)) return NULL;
+	int* etiquettes=malloc(sizeof(int)*nb_pixels);
+	assert(NULL!=etiquettes);
+	FILE* f=fopen(FICHIER_ETIQUETTES,"rb");
+	bool lu=NULL!=f && fread(etiquettes,sizeof(int),nb_pixels,f)==(size_t)nb_pixels;
+	if(NULL!=f) fclose(f);
+	remove(FICHIER_ETIQUETTES);
+	if(!lu){
+		free(etiquettes);
+		return NULL;
+	}
+	return etiquettes;
+}
+
+static bool tester(const char* fichier,int k){
+	pgm img=lire_image_pgm(fichier);
+	if(NULL==img) return false;
+	const int largeur=largeur_image(img);
+	const int hauteur=hauteur_image(img);
+	const int nb_pixels=largeur*hauteur;
+	tableau_aretes t=lire_matrice(image_matrice(img),largeur,hauteur);
+	int nb_regions;
+	int* etiquettes=segmentation_etiquettes(t,nb_pixels,k,&nb_regions);
+	tableau_aretes_detruire(&t);
+	detruire_image_pgm(&img);
+
+	int nb_une_bande,nb_bandes;
+	int* une_bande=par_bandes(fichier,nb_pixels,hauteur,k,&nb_une_bande);
+	int* bandes=par_bandes(fichier,nb_pixels,HAUTEUR_BANDE,k,&nb_bandes);
+	const bool trop_basse=!segmentation_par_bandes(fichier,FICHIER_ETIQUETTES,HAUTEUR_BANDE_MIN-1,k,NULL);
+	bool identiques=NULL!=une_bande && nb_une_bande==nb_regions;
+	for(int v=0;identiques && v<nb_pixels;v++) identiques=une_bande[v]==etiquettes[v];
+	const int ecart=abs(nb_bandes-nb_regions);
+	const bool proche=NULL!=bandes && 100*ecart<=ECART_MAX*nb_regions;
+	printf("%s : %d regions, une bande %s, bandes de %d lignes %d regions (%.1f %%) %s, bandes de %d lignes %s\n",fichier,nb_regions,
+	       identiques ? "identique" : "DIFFERENT",HAUTEUR_BANDE,nb_bandes,100.0*ecart/nb_regions,proche ? "proche" : "TROP LOIN",
+	       HAUTEUR_BANDE_MIN-1,trop_basse ? "refusees" : "ACCEPTEES");
+
+	free(etiquettes);
+	free(une_bande);
+	free(bandes);
+	return identiques && proche && trop_basse;
+}
+
+int main(int argc, char** argv) {
+
+	if(argc<3){
+		fprintf(stderr,"usage : %s k image.pgm [image.pgm ...]\n",argv[0]);
+		return 1;
+	}
+	int k=atoi(argv[1]);
+	int retour=0;
+	for(int i=2;i<argc;i++){
+		if(!tester(argv[i],k)){
+			fprintf(stderr,"Test de %s en echec.\n",argv[i]);
+			retour=1;
+		}
+	}
+	return retour;
+
+}
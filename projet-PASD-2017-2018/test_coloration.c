@@ -1,10 +1,20 @@
 #include "coloration.h"
 
+/* usage : ./coloration [image.pgm [k [moyenne.pgm [etiquettes.pgm]]]] */
 int main(int argc, char** argv) {
 
+        const char* fichier_image = argc > 1 ? argv[1] : "images/cameraman.pgm";
+        int k = argc > 2 ? atoi(argv[2]) : 300;
+        const char* fichier_moyenne = argc > 3 ? argv[3] : "img.pgm";
+        const char* fichier_etiquettes = argc > 4 ? argv[4] : NULL;
 
+        int nb_regions;
+        if(!colorer_image(fichier_image, fichier_moyenne, fichier_etiquettes, k, &nb_regions)) {
+                fprintf(stderr, "Coloration de %s impossible.\n", fichier_image);
+                return 1;
+        }
+        printf("%d regions\n", nb_regions);
 
         return 0;
 
 }
-
@@ -4,24 +4,17 @@
 # include <assert.h>
 # include "kruskal.h"
 
-arete* lire_fichier(char* fichier, int * nb_s, int * nb_a){
+tableau_aretes lire_fichier(char* fichier, int * nb_s){
 	FILE * f = fopen(fichier,"r");
-        int nb_arete=0;
         int nb_sommet;int s1;int s2; int poids;
-        int cpt_taille=0;
            
         fscanf(f,"%d",&nb_sommet);
-    	arete* t_arete =(arete*) malloc (sizeof(struct arete)*(nb_sommet*nb_sommet));
-        
-        while(!feof(f)){
-                fscanf(f,"%d %d %d",&s1,&s2,&poids);
-		t_arete[cpt_taille] = creer_arete(s1,s2,poids);
-                nb_arete++;
-                cpt_taille++;
+    	tableau_aretes t_arete = tableau_aretes_creer(nb_sommet);
         
+        while(fscanf(f,"%d %d %d",&s1,&s2,&poids)==3){
+		tableau_aretes_ajouter(t_arete,s1,s2,poids);
         }
         *nb_s=nb_sommet;
-        *nb_a=cpt_taille-1;
         fclose(f);
         return t_arete;
 }
@@ -29,14 +22,18 @@ arete* lire_fichier(char* fichier, int * nb_s, int * nb_a){
 
 int main(int argc, char** argv) {
 
-        int nb_s,nb_arete;
+        int nb_s;
         FILE* f_out = fopen(argv[1] , "w+");
         //char* fichier = argv[1];
        // printf("\n%d\n%s \n%s\n %s\n",argc,argv[0], argv[1], argv[2]);
-	arete* t_arete=lire_fichier(argv[2],&nb_s,&nb_arete);
-	liste l =kruskal(t_arete,nb_s,nb_arete);
-	liste_affichage(f_out,l);
-	detruire_tab_arete(t_arete);
+	tableau_aretes t_arete=lire_fichier(argv[2],&nb_s);
+	// argv[3] optionnel : nombre de threads pour kruskal_filtre
+	liste l =(argc>3) ? kruskal_filtre(t_arete,nb_s,atoi(argv[3])) : kruskal(t_arete,nb_s);
+	for(maillon m=l->tete;NULL!=m;m=m->suivant){
+		afficher_arete(f_out,m->val);
+		fprintf(f_out,"\n");
+	}
+	tableau_aretes_detruire(&t_arete);
 	liste_detruire(&l);
 	fclose(f_out);
 	
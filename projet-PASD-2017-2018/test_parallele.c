@@ -0,0 +1,142 @@
+#include "segmentation.h"
+#include <string.h>
+
+/* usage : ./test_parallele image.pgm [image.pgm ...]
+ * compare les versions parallèles (2 à NB_THREADS_MAX threads) aux versions séquentielles :
+ * lire_matrice_parallele à lire_matrice, trier_aretes_parallele à trier_aretes,
+ * sur les arêtes de l'image puis sur les mêmes arêtes mélangées ;
+ * puis le tri de NB_ARETES_LARGES arêtes de poids au-delà de POIDS_MAX_TRI_COMPTAGE
+ * (tri rapide et fusions), rangées dans l'ordre, à l'envers ou mélangées */
+
+#define NB_THREADS_MAX 4
+
+#define NB_ARETES_LARGES 80000
+
+static bool memes_aretes(tableau_aretes t1,tableau_aretes t2){
+	return t1->nb_aretes==t2->nb_aretes
+		&& 0==memcmp(t1->aretes,t2->aretes,sizeof(struct arete)*t1->nb_aretes);
+}
+
+static tableau_aretes copier_aretes(tableau_aretes t){
+	tableau_aretes c=tableau_aretes_creer(t->nb_aretes);
+	for(int i=0;i<t->nb_aretes;i++) tableau_aretes_ajouter(c,t->aretes[i].s1,t->aretes[i].s2,t->aretes[i].poids);
+	return c;
+}
+
+/* mélange de Fisher-Yates, reproductible */
+static void melanger(tableau_aretes t){
+	srand(1234);
+	for(int i=t->nb_aretes-1;i>0;i--) echanger(t->aretes,i,rand()%(i+1));
+}
+
+/* vrai si t est dans l'ordre (poids, s1, s2) strictement croissant */
+static bool est_ordonne(tableau_aretes t){
+	for(int i=1;i<t->nb_aretes;i++){
+		const struct arete* a=&t->aretes[i-1];
+		const struct arete* b=&t->aretes[i];
+		if(a->poids>b->poids || (a->poids==b->poids && (a->s1>b->s1 || (a->s1==b->s1 && a->s2>=b->s2)))) return false;
+	}
+	return true;
+}
+
+/* arêtes (i,i+1) de poids croissants, tous supérieurs à POIDS_MAX_TRI_COMPTAGE, sauf quelques doublons */
+static tableau_aretes aretes_poids_larges(void){
+	tableau_aretes t=tableau_aretes_creer(NB_ARETES_LARGES);
+	for(int i=0;i<NB_ARETES_LARGES;i++) tableau_aretes_ajouter(t,i,i+1,POIDS_MAX_TRI_COMPTAGE+1+i/4);
+	return t;
+}
+
+static bool tester_poids_larges(void){
+	bool ok=true;
+	tableau_aretes entrees[3];
+	const char* noms[3]={"dans l'ordre","a l'envers","melangees"};
+	entrees[0]=aretes_poids_larges();
+	entrees[1]=tableau_aretes_creer(NB_ARETES_LARGES);
+	for(int i=NB_ARETES_LARGES-1;i>=0;i--){
+		const struct arete* a=&entrees[0]->aretes[i];
+		tableau_aretes_ajouter(entrees[1],a->s1,a->s2,a->poids);
+	}
+	entrees[2]=copier_aretes(entrees[0]);
+	melanger(entrees[2]);
+	tableau_aretes reference=copier_aretes(entrees[0]);
+	trier_aretes(reference);
+	ok=est_ordonne(reference);
+	for(int e=0;e<3;e++){
+		tableau_aretes ts=copier_aretes(entrees[e]);
+		trier_aretes(ts);
+		bool sequentiel=memes_aretes(ts,reference);
+		ok=ok && sequentiel;
+		printf("%d aretes de poids > %d %s, 1 thread : tri %s\n",NB_ARETES_LARGES,POIDS_MAX_TRI_COMPTAGE,noms[e],sequentiel ? "identique" : "DIFFERENT");
+		tableau_aretes_detruire(&ts);
+		for(int nb_threads=2;nb_threads<=NB_THREADS_MAX;nb_threads++){
+			tableau_aretes t=copier_aretes(entrees[e]);
+			trier_aretes_parallele(t,nb_threads);
+			bool tri=memes_aretes(t,reference);
+			printf("%d aretes de poids > %d %s, %d threads : tri %s\n",NB_ARETES_LARGES,POIDS_MAX_TRI_COMPTAGE,noms[e],nb_threads,tri ? "identique" : "DIFFERENT");
+			ok=ok && tri;
+			tableau_aretes_detruire(&t);
+		}
+	}
+	for(int e=0;e<3;e++) tableau_aretes_detruire(&entrees[e]);
+	tableau_aretes_detruire(&reference);
+	return ok;
+}
+
+static bool tester(const char* fichier){
+	pgm img=lire_image_pgm(fichier);
+	if(NULL==img) return false;
+	unsigned int** m=image_matrice(img);
+	const int largeur=largeur_image(img);
+	const int hauteur=hauteur_image(img);
+	bool ok=true;
+
+	tableau_aretes reference=lire_matrice(m,largeur,hauteur);
+	tableau_aretes reference_triee=copier_aretes(reference);
+	trier_aretes(reference_triee);
+	tableau_aretes melange=copier_aretes(reference);
+	melanger(melange);
+	tableau_aretes reference_melange=copier_aretes(melange);
+	trier_aretes(reference_melange);
+	for(int nb_threads=2;nb_threads<=NB_THREADS_MAX;nb_threads++){
+		tableau_aretes t=lire_matrice_parallele(m,largeur,hauteur,nb_threads);
+		bool lecture=memes_aretes(t,reference);
+		trier_aretes_parallele(t,nb_threads);
+		tableau_aretes tm=copier_aretes(melange);
+		trier_aretes_parallele(tm,nb_threads);
+		bool tri=memes_aretes(t,reference_triee);
+		bool tri_melange=memes_aretes(tm,reference_melange);
+		printf("%s, %d threads : lecture %s, tri %s, tri des aretes melangees %s\n",fichier,nb_threads,
+		       lecture ? "identique" : "DIFFERENT",tri ? "identique" : "DIFFERENT",tri_melange ? "identique" : "DIFFERENT");
+		ok=ok && lecture && tri && tri_melange;
+		tableau_aretes_detruire(&t);
+		tableau_aretes_detruire(&tm);
+	}
+
+	tableau_aretes_detruire(&reference);
+	tableau_aretes_detruire(&reference_triee);
+	tableau_aretes_detruire(&melange);
+	tableau_aretes_detruire(&reference_melange);
+	detruire_image_pgm(&img);
+	return ok;
+}
+
+int main(int argc, char** argv) {
+
+	if(argc<2){
+		fprintf(stderr,"usage : %s image.pgm [image.pgm ...]\n",argv[0]);
+		return 1;
+	}
+	int retour=0;
+	for(int i=1;i<argc;i++){
+		if(!tester(argv[i])){
+			fprintf(stderr,"Test de %s en echec.\n",argv[i]);
+			retour=1;
+		}
+	}
+	if(!tester_poids_larges()){
+		fprintf(stderr,"Test du tri des poids larges en echec.\n");
+		retour=1;
+	}
+	return retour;
+
+}
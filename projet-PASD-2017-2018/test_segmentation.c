@@ -1,52 +1,35 @@
 #include "segmentation.h"
 
+/* usage : ./segmentation [image.pgm [k [regions.txt]]] */
 int main(int argc, char** argv) {
 
+        const char* fichier_image = argc > 1 ? argv[1] : "images/cameraman.pgm";
+        int k = argc > 2 ? atoi(argv[2]) : 40;
+        const char* fichier_regions = argc > 3 ? argv[3] : "test.txt";
 
-        pgm img = lire_image_pgm("/home/bastien/Documents/Cours_C/projet-PASD-2017-2018/images/cameraman.pgm");
+        pgm img = lire_image_pgm(fichier_image);
+        if(NULL == img) {
+                fprintf(stderr, "Lecture de %s impossible.\n", fichier_image);
+                return 1;
+        }
         int largeur = largeur_image(img);
         int hauteur = hauteur_image(img);
 
-        int nb_sommets = hauteur * largeur;
-        int nb_aretes = 0;
+        tableau_aretes t_arete = lire_matrice(image_matrice(img),largeur,hauteur);
+        FILE* f_out = fopen(fichier_regions, "w");
+        if(NULL == f_out) {
+                fprintf(stderr, "Ouverture de %s impossible.\n", fichier_regions);
+                return 1;
+        }
 
-        arete* t_arete = lire_matrice(image_matrice(img),largeur_image(img),hauteur_image(img),&nb_aretes);
-        FILE* f_out = fopen("/home/bastien/Documents/Cours_C/projet-PASD-2017-2018/test.txt", "w");
-       // FILE* f_o = fopen(,w);
+        regions r = segmentation_regions(t_arete,largeur*hauteur,k);
+        regions_afficher(f_out,r);
+        fclose(f_out);
 
+        regions_detruire(&r);
+        tableau_aretes_detruire(&t_arete);
+        detruire_image_pgm(&img);
 
-        liste ensembles = segmentation(image_matrice(img),t_arete,largeur,hauteur,nb_aretes,40);
-        liste_affichage(f_out,ensembles);
-        ecrire_image_pgm("/home/bastien/Documents/Cours_C/projet-PASD-2017-2018/img.pgm",img,NULL);
-
-
-     /*   printf("%d %d \n",largeur , hauteur);
-       // ecrire_image_pgm("/home/bastien/Documents/Cours_C/projet-PASD-2017-2018/test_image/image1.pgm",img,NULL);
-
-        unsigned int** tab = image_matrice(img);
-
-        FILE* f_out = fopen("/home/bastien/Documents/Cours_C/projet-PASD-2017-2018/test.txt", "w");
-        arete* t_arete = lire_matrice(image_matrice(img),largeur_image(img),hauteur_image(img),&nb_aretes);
-        //trier_arete(t_arete, 0 , nb_aretes-1);
-
-        for(int i=0;i<nb_aretes;i++){
-                afficher_arete(f_out,t_arete[i]);
-                fprintf(f_out,"\n");
-        }*/
-        
-                
-        //liste l = kruskal(t_arete,nb_sommets,nb_aretes); //15 minutes
-
-        //liste_affichage(f_out,l);
-
-        //printf("%d",nb_aretes);
-        
-        
-        
-        
-        
-        
         return 0;
 
 }
-
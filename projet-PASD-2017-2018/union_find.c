@@ -1,4 +1,5 @@
 #include "union_find.h"
+#include "compteurs.h"
 # include <stdio.h>
 # include <stdlib.h>
 # include <string.h>
@@ -36,8 +37,13 @@ int comparer_int(void *  val1, void * val2 ){
 }
 
 ensemble creer_ensemble(int a){
+	return creer_ensemble_pool(a,NULL);
+}
+
+ensemble creer_ensemble_pool(int a, pool_maillons p){
+	COMPTEUR_AJOUTER("creer_ensemble");
 	ensemble e = malloc(sizeof(struct ensemble));
-	e->elements = liste_creer(&copier_int, &afficher_int, &detruire_int,&comparer_int);
+	e->elements = liste_creer_pool(&copier_int, &afficher_int, &detruire_int,&comparer_int,p);
 	liste_insertion_debut(e->elements,&a);
     e->pere=a;
 	e->rang=0;
@@ -46,23 +52,33 @@ ensemble creer_ensemble(int a){
 }
 
 void union_ensemble(liste l,ensemble e1, ensemble e2){
+	COMPTEUR_AJOUTER("union_ensemble");
 	assert(e1!=NULL);
 	assert(e2!=NULL);
 	assert(l!=NULL);
+	// les éléments sont déplacés sans copie, l'ensemble absorbé reste vide
+	// dans l jusqu'au prochain nettoyer_ensembles
 	if(e1->rang>e2->rang || (e1->rang==e2->rang && e1->pere>e2->pere)){
-        	liste_concatener(e1->elements,e2->elements);
+        	liste_fusionner(e1->elements,e2->elements);
 		e2->pere=e1->pere;
-        	liste_supprimer_maillon(l,e2);
 		e1->rang+=e2->rang;
     }else{
-        	liste_concatener(e2->elements,e1->elements);
+        	liste_fusionner(e2->elements,e1->elements);
 		e1->pere=e2->pere;
-        	liste_supprimer_maillon(l,e1);
-		e2->rang+=e2->rang;
+		e2->rang+=e1->rang;
     }
 	
 }
 
+static bool est_vide_ensemble(void* val){
+	return liste_est_tete(((ensemble) val)->elements);
+}
+
+void nettoyer_ensembles(liste l){
+	assert(l!=NULL);
+	liste_supprimer_si(l,&est_vide_ensemble);
+}
+
 int cherche_valeur(ensemble e, int val){
 	maillon* m=&(e->elements->tete);
 	while(NULL!=*m){
@@ -73,6 +89,7 @@ int cherche_valeur(ensemble e, int val){
 }
 
 ensemble trouver_ensemble(liste l,int val){
+		COMPTEUR_AJOUTER("trouver_ensemble");
     	maillon* m=&(l->tete);
     	while(*m!=NULL){
        		ensemble e=(ensemble) ((*m)->val);
@@ -80,4 +97,88 @@ ensemble trouver_ensemble(liste l,int val){
       		m=&((*m)->suivant);
 		}
 		return NULL;
-}
\ No newline at end of file
+}
+
+union_find union_find_creer(int nb_elements){
+	assert(nb_elements>=0);
+	COMPTEUR_AJOUTER("union_find allocations");
+	union_find uf = malloc(sizeof(struct union_find_struct));
+	assert(NULL!=uf);
+	uf->nb_elements=nb_elements;
+	uf->capacite=nb_elements>0 ? nb_elements : 1;
+	uf->pere=malloc(sizeof(int)*uf->capacite);
+	uf->rang=calloc(uf->capacite,sizeof(int));
+	assert(NULL!=uf->pere);
+	assert(NULL!=uf->rang);
+	for(int i=0;i<nb_elements;i++){
+		uf->pere[i]=i;
+	}
+	return uf;
+}
+
+void union_find_detruire(union_find* uf){
+	assert(NULL!=uf);
+	if(NULL!=*uf){
+		free((*uf)->pere);
+		free((*uf)->rang);
+		free(*uf);
+		*uf=NULL;
+	}
+}
+
+int union_find_trouver(union_find uf,int val){
+	assert(NULL!=uf);
+	assert(val>=0 && val<uf->nb_elements);
+	COMPTEUR_AJOUTER("union_find_trouver");
+	int racine=val;
+	while(uf->pere[racine]!=racine){
+		racine=uf->pere[racine];
+	}
+	// compression de chemin : tous les noeuds parcourus pointent sur la racine
+	while(uf->pere[val]!=racine){
+		int suivant=uf->pere[val];
+		uf->pere[val]=racine;
+		val=suivant;
+	}
+	return racine;
+}
+
+int union_find_union(union_find uf,int r1,int r2){
+	assert(NULL!=uf);
+	assert(uf->pere[r1]==r1);
+	assert(uf->pere[r2]==r2);
+	assert(r1!=r2);
+	COMPTEUR_AJOUTER("union_find_union");
+	if(uf->rang[r1]<uf->rang[r2]){
+		uf->pere[r1]=r2;
+		return r2;
+	}
+	uf->pere[r2]=r1;
+	if(uf->rang[r1]==uf->rang[r2]) uf->rang[r1]++;
+	return r1;
+}
+
+int union_find_ajouter(union_find uf){
+	assert(NULL!=uf);
+	if(uf->nb_elements==uf->capacite){
+		COMPTEUR_AJOUTER("union_find allocations");
+		uf->capacite*=2;
+		uf->pere=realloc(uf->pere,sizeof(int)*uf->capacite);
+		uf->rang=realloc(uf->rang,sizeof(int)*uf->capacite);
+		assert(NULL!=uf->pere);
+		assert(NULL!=uf->rang);
+	}
+	int val=uf->nb_elements;
+	uf->pere[val]=val;
+	uf->rang[val]=0;
+	uf->nb_elements++;
+	return val;
+}
+
+void union_find_reinitialiser(union_find uf){
+	assert(NULL!=uf);
+	for(int i=0;i<uf->nb_elements;i++){
+		uf->pere[i]=i;
+		uf->rang[i]=0;
+	}
+}
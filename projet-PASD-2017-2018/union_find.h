@@ -23,14 +23,86 @@ struct ensemble{
 
 ensemble creer_ensemble(int a);
 
+/*!
+ * Comme creer_ensemble, la liste des éléments prenant ses maillons dans p :
+ * les ensembles d'un même pool peuvent être réunis par union_ensemble.
+ * \param p pool créé pour des valeurs de sizeof(int) octets, ou NULL
+ */
+ensemble creer_ensemble_pool(int a, pool_maillons p);
+
 void copier_int ( void * val ,void * * pt ) ;
 
 void detruire_int ( void * * pt ) ;
 
 void afficher_int( FILE * f , void * val );
 
+/*!
+ * Réunit e1 et e2 : les éléments de l'ensemble de plus petit rang sont déplacés
+ * sans copie à la fin de l'autre, dont le rang devient la somme des deux.
+ * L'ensemble absorbé n'est pas retiré de l : il y reste vide jusqu'à l'appel de
+ * nettoyer_ensembles, qui les retire tous en un passage. D'ici là, liste_taille(l)
+ * et l'affichage de l comptent ces ensembles vides (trouver_ensemble ne les renvoie jamais).
+ * \pre e1 et e2 sont deux ensembles distincts de l
+ */
 void union_ensemble(liste l,ensemble e1, ensemble e2);
 
+/*!
+ * Retire de l les ensembles vidés par union_ensemble.
+ */
+void nettoyer_ensembles(liste l);
+
 ensemble trouver_ensemble(liste l,int val);
-    
-#endif
\ No newline at end of file
+
+/*!
+ * Union-Find sur tableaux : pere[i] est le père de l'élément i,
+ * rang[i] un majorant de la hauteur de l'arbre enraciné en i.
+ * Les éléments sont les entiers de 0 à nb_elements-1,
+ * capacite est la taille allouée des tableaux.
+ */
+typedef struct union_find_struct * union_find;
+
+struct union_find_struct{
+	int nb_elements;
+	int capacite;
+	int* pere;
+	int* rang;
+};
+
+/*!
+ * Crée une partition où chaque élément est seul dans son ensemble.
+ * \param nb_elements nombre d'éléments
+ * \return la structure créée
+ */
+union_find union_find_creer(int nb_elements);
+
+/*!
+ * Détruit la structure, le pointeur est mis à NULL.
+ */
+void union_find_detruire(union_find* uf);
+
+/*!
+ * Cherche le représentant de l'ensemble contenant val (compression de chemin).
+ * \pre 0 <= val < nb_elements
+ * \return la racine de l'ensemble de val
+ */
+int union_find_trouver(union_find uf,int val);
+
+/*!
+ * Réunit les ensembles de racines r1 et r2 (union par rang).
+ * \pre r1 et r2 sont des racines distinctes
+ * \return la racine de l'ensemble obtenu
+ */
+int union_find_union(union_find uf,int r1,int r2);
+
+/*!
+ * Ajoute un nouvel élément, seul dans son ensemble (les tableaux s'agrandissent si besoin).
+ * \return l'élément ajouté (nb_elements avant l'appel)
+ */
+int union_find_ajouter(union_find uf);
+
+/*!
+ * Replace chaque élément seul dans son ensemble, sans réallouer les tableaux.
+ */
+void union_find_reinitialiser(union_find uf);
+
+#endif